@@ -0,0 +1,171 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/BufferPool.h"
+
+#include "carla/Debug.h"
+
+#include <algorithm>
+
+namespace carla {
+
+  /// Classes of the same power of two, each one a quarter bigger than the
+  /// previous.
+  static constexpr size_t CLASSES_PER_POWER_OF_TWO = 4u;
+
+  static constexpr size_t MIN_CLASS_EXPONENT = 8u;
+
+  static size_t FloorLog2(size_t value) {
+    DEBUG_ASSERT(value > 0u);
+    size_t result = 0u;
+    while (value >>= 1u) {
+      ++result;
+    }
+    return result;
+  }
+
+  size_t BufferPool::GetClassForSize(const size_t size) {
+    static_assert(MIN_CLASS_SIZE == (size_t(1u) << MIN_CLASS_EXPONENT), "Invalid min class size");
+    if (size <= MIN_CLASS_SIZE) {
+      return 1u;
+    }
+    const size_t exponent = FloorLog2(size);
+    const size_t base = size_t(1u) << exponent;
+    const size_t step_size = base / CLASSES_PER_POWER_OF_TWO;
+    const size_t step = (size - base + step_size - 1u) / step_size;
+    const size_t index = 1u + (exponent - MIN_CLASS_EXPONENT) * CLASSES_PER_POWER_OF_TWO + step;
+    return index < NUMBER_OF_SIZE_CLASSES ? index : NUMBER_OF_SIZE_CLASSES;
+  }
+
+  size_t BufferPool::GetClassForCapacity(const size_t capacity) {
+    if (capacity < MIN_CLASS_SIZE) {
+      return 0u;
+    }
+    const size_t exponent = FloorLog2(capacity);
+    const size_t base = size_t(1u) << exponent;
+    const size_t step = (capacity - base) / (base / CLASSES_PER_POWER_OF_TWO);
+    const size_t index = 1u + (exponent - MIN_CLASS_EXPONENT) * CLASSES_PER_POWER_OF_TWO + step;
+    DEBUG_ASSERT(index < NUMBER_OF_SIZE_CLASSES);
+    return index;
+  }
+
+  size_t BufferPool::GetClassCapacity(const size_t index) {
+    DEBUG_ASSERT(index > 0u);
+    DEBUG_ASSERT(index < NUMBER_OF_SIZE_CLASSES);
+    const size_t exponent = MIN_CLASS_EXPONENT + (index - 1u) / CLASSES_PER_POWER_OF_TWO;
+    const size_t base = size_t(1u) << exponent;
+    const size_t step = (index - 1u) % CLASSES_PER_POWER_OF_TWO;
+    return base + step * (base / CLASSES_PER_POWER_OF_TWO);
+  }
+
+  Buffer BufferPool::Pop() {
+    size_t index;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      index = _last_class;
+    }
+    return PopFromClass(index, 0u, false);
+  }
+
+  Buffer BufferPool::Pop(const size_t size) {
+    return PopFromClass(GetClassForSize(size), size, true);
+  }
+
+  Buffer BufferPool::PopFromClass(const size_t index, const size_t size, const bool reset_size) {
+    Buffer item;
+    if (index < NUMBER_OF_SIZE_CLASSES) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto &size_class = _classes[index];
+      size_class.last_used = ++_clock;
+      if (!size_class.buffers.empty()) {
+        item = std::move(size_class.buffers.back());
+        size_class.buffers.pop_back();
+        ++_statistics.hits;
+        --_statistics.buffers_held;
+        _statistics.bytes_held -= item._capacity;
+      } else {
+        ++_statistics.misses;
+      }
+    } else {
+      std::lock_guard<std::mutex> lock(_mutex);
+      ++_statistics.misses;
+    }
+    if (reset_size) {
+      if ((item._capacity == 0u) && (index > 0u) && (index < NUMBER_OF_SIZE_CLASSES)) {
+        // Allocate the whole class so the buffer serves any request of the
+        // class when it comes back.
+        item.reset(static_cast<uint64_t>(GetClassCapacity(index)));
+      }
+      item.reset(static_cast<uint64_t>(size));
+    }
+#if __cplusplus >= 201703L // C++17
+    item._parent_pool = weak_from_this();
+#else
+    item._parent_pool = shared_from_this();
+#endif
+    return item;
+  }
+
+  void BufferPool::Push(Buffer &&buffer) {
+    // Pooled buffers don't belong to any pool until popped again, this way
+    // evicted buffers are simply deleted.
+    buffer._parent_pool.reset();
+    const size_t capacity = buffer._capacity;
+    std::vector<Buffer> evicted;
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (capacity > _max_bytes_held) {
+      ++_statistics.evictions;
+      return;
+    }
+    TrimLocked(_max_bytes_held - capacity, evicted);
+    const size_t index = GetClassForCapacity(capacity);
+    _classes[index].buffers.emplace_back(std::move(buffer));
+    _last_class = index;
+    ++_statistics.buffers_held;
+    _statistics.bytes_held += capacity;
+    _statistics.bytes_held_high_water_mark =
+        std::max(_statistics.bytes_held_high_water_mark, _statistics.bytes_held);
+  }
+
+  void BufferPool::SetMaxBytesHeld(const size_t max_bytes_held) {
+    std::vector<Buffer> evicted;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _max_bytes_held = max_bytes_held;
+    TrimLocked(max_bytes_held, evicted);
+  }
+
+  void BufferPool::Trim(const size_t max_bytes) {
+    std::vector<Buffer> evicted;
+    std::lock_guard<std::mutex> lock(_mutex);
+    TrimLocked(max_bytes, evicted);
+  }
+
+  BufferPoolStatistics BufferPool::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _statistics;
+  }
+
+  void BufferPool::TrimLocked(const size_t max_bytes, std::vector<Buffer> &evicted) {
+    while (_statistics.bytes_held > max_bytes) {
+      // Evict from the least recently requested class, the biggest one on a
+      // tie.
+      SizeClass *victim = nullptr;
+      for (auto it = _classes.rbegin(); it != _classes.rend(); ++it) {
+        if (!it->buffers.empty() && ((victim == nullptr) || (it->last_used < victim->last_used))) {
+          victim = &*it;
+        }
+      }
+      DEBUG_ASSERT(victim != nullptr);
+      const size_t capacity = victim->buffers.back()._capacity;
+      evicted.emplace_back(std::move(victim->buffers.back()));
+      victim->buffers.pop_back();
+      ++_statistics.evictions;
+      --_statistics.buffers_held;
+      _statistics.bytes_held -= capacity;
+    }
+  }
+
+} // namespace carla
@@ -8,53 +8,105 @@
 
 #include "carla/Buffer.h"
 
-#if defined(__clang__)
-#  pragma clang diagnostic push
-#  pragma clang diagnostic ignored "-Wold-style-cast"
-#endif
-#include "moodycamel/ConcurrentQueue.h"
-#if defined(__clang__)
-#  pragma clang diagnostic pop
-#endif
-
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace carla {
 
+  /// Counters of a BufferPool.
+  struct BufferPoolStatistics {
+    /// Pops served with a buffer from the pool.
+    uint64_t hits = 0u;
+    /// Pops that had to create a new buffer.
+    uint64_t misses = 0u;
+    /// Buffers released instead of kept to stay under the byte cap.
+    uint64_t evictions = 0u;
+    size_t buffers_held = 0u;
+    size_t bytes_held = 0u;
+    /// Maximum value reached by bytes_held.
+    size_t bytes_held_high_water_mark = 0u;
+  };
+
   /// A pool of Buffer. Buffers popped from this pool automatically return to
   /// the pool on destruction so the allocated memory can be reused.
   ///
-  /// @warning Buffers adjust their size only by growing, they never shrink
-  /// unless explicitly cleared. The allocated memory is only deleted when this
-  /// pool is destroyed.
+  /// Buffers are kept in size classes, four per power of two, so a request
+  /// is served by a buffer of about its size instead of by whatever buffer
+  /// was returned last. The memory held by the pool is bounded by
+  /// @a max_bytes_held; when returning a buffer would exceed it, buffers of
+  /// the least recently requested size classes are released first.
   class BufferPool : public std::enable_shared_from_this<BufferPool> {
   public:
 
-    BufferPool() = default;
+    static constexpr size_t DEFAULT_MAX_BYTES_HELD = 256u * 1024u * 1024u;
+
+    explicit BufferPool(size_t max_bytes_held = DEFAULT_MAX_BYTES_HELD)
+      : _max_bytes_held(max_bytes_held) {}
+
+    /// Pop a Buffer from the size class of the last buffer returned to the
+    /// pool, creates a new one if there is none. Optimized for pools whose
+    /// buffers have all about the same size.
+    Buffer Pop();
 
-    explicit BufferPool(size_t estimated_size) : _queue(estimated_size) {}
+    /// Pop a Buffer of @a size bytes, reusing a pooled buffer with enough
+    /// capacity if there is one.
+    Buffer Pop(size_t size);
 
-    /// Pop a Buffer from the queue, creates a new one if the queue is empty.
-    Buffer Pop() {
-      Buffer item;
-      _queue.try_dequeue(item); // we don't care if it fails.
-#if __cplusplus >= 201703L // C++17
-      item._parent_pool = weak_from_this();
-#else
-      item._parent_pool = shared_from_this();
-#endif
-      return item;
-    }
+    /// Set the maximum number of bytes held by the pool, trimming the pool if
+    /// necessary.
+    void SetMaxBytesHeld(size_t max_bytes_held);
+
+    /// Release pooled buffers until the pool holds at most @a max_bytes bytes.
+    void Trim(size_t max_bytes);
+
+    BufferPoolStatistics GetStatistics() const;
 
   private:
 
     friend class Buffer;
 
-    void Push(Buffer &&buffer) {
-      _queue.enqueue(std::move(buffer));
-    }
+    struct SizeClass {
+      std::vector<Buffer> buffers;
+      /// Value of _clock the last time this class was requested.
+      uint64_t last_used = 0u;
+    };
+
+    /// Sizes below this share a single class.
+    static constexpr size_t MIN_CLASS_SIZE = 256u;
+
+    static constexpr size_t NUMBER_OF_SIZE_CLASSES = 1u + (32u - 8u) * 4u;
+
+    /// Smallest class whose buffers can hold @a size bytes.
+    static size_t GetClassForSize(size_t size);
+
+    /// Class a buffer with @a capacity bytes belongs to.
+    static size_t GetClassForCapacity(size_t capacity);
+
+    /// Capacity allocated for new buffers of the class.
+    static size_t GetClassCapacity(size_t index);
+
+    Buffer PopFromClass(size_t index, size_t size, bool reset_size);
+
+    void Push(Buffer &&buffer);
+
+    /// Moves pooled buffers to @a evicted until the pool holds at most
+    /// @a max_bytes bytes. Must be called with the mutex locked.
+    void TrimLocked(size_t max_bytes, std::vector<Buffer> &evicted);
+
+    mutable std::mutex _mutex;
+
+    std::array<SizeClass, NUMBER_OF_SIZE_CLASSES> _classes;
+
+    size_t _max_bytes_held;
+
+    size_t _last_class = 0u;
+
+    uint64_t _clock = 0u;
 
-    moodycamel::ConcurrentQueue<Buffer> _queue;
+    BufferPoolStatistics _statistics;
   };
 
 } // namespace carla
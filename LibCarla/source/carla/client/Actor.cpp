@@ -36,6 +36,11 @@ namespace client {
     return GetEpisode().Lock()->GetActorComponentWorldTransform(*this, componentName);
   }
 
+  std::vector<geom::Transform> Actor::GetComponentWorldTransforms(
+      const std::vector<std::string> &component_names) const {
+    return GetEpisode().Lock()->GetActorComponentWorldTransforms(*this, component_names);
+  }
+
   geom::Transform Actor::GetComponentRelativeTransform(const std::string componentName) const {
     return GetEpisode().Lock()->GetActorComponentRelativeTransform(*this, componentName);
   }
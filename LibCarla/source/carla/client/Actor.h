@@ -62,6 +62,11 @@ namespace client {
 
     geom::Transform GetComponentWorldTransform(const std::string componentName) const;
 
+    /// Same as GetComponentWorldTransform for several components, retrieved
+    /// from the simulator in a single request.
+    std::vector<geom::Transform> GetComponentWorldTransforms(
+        const std::vector<std::string> &component_names) const;
+
     geom::Transform GetComponentRelativeTransform(const std::string componentName) const;
 
     std::vector<geom::Transform> GetBoneWorldTransforms() const;
@@ -41,6 +41,13 @@ namespace client {
       return _simulator->GetNetworkingTimeout();
     }
 
+    /// Read the sensors listened from now on through a single connection to
+    /// the simulator, instead of a connection per sensor. Simulators that
+    /// don't support it are still read with a connection per sensor.
+    void SetStreamMultiplexing(bool enabled) {
+      _simulator->SetStreamMultiplexing(enabled);
+    }
+
     /// Return the version string of this client API.
     std::string GetClientVersion() const {
       return _simulator->GetClientVersion();
@@ -175,6 +182,27 @@ namespace client {
       return responses;
     }
 
+    /// Apply batches of commands stored as columns, each batch with commands
+    /// of a single type.
+    void ApplyCommandBatch(
+        std::vector<rpc::CommandBatch> batches,
+        bool do_tick_cue = false) const {
+      _simulator->ApplyCommandBatch(std::move(batches), do_tick_cue);
+    }
+
+    /// Apply batches of commands stored as columns and return the indices of
+    /// the commands that failed, counting the commands of all the batches in
+    /// order.
+    std::vector<uint32_t> ApplyCommandBatchSync(
+        std::vector<rpc::CommandBatch> batches,
+        bool do_tick_cue = false) const {
+      auto failed = _simulator->ApplyCommandBatchSync(std::move(batches), false);
+      if (do_tick_cue)
+        _simulator->Tick(_simulator->GetNetworkingTimeout());
+
+      return failed;
+    }
+
   private:
 
     std::shared_ptr<detail::Simulator> _simulator;
@@ -8,19 +8,19 @@
 
 #include "carla/client/Junction.h"
 #include "carla/client/Waypoint.h"
-#include "carla/opendrive/OpenDriveParser.h"
+#include "carla/client/detail/MapCache.h"
 #include "carla/road/Map.h"
 #include "carla/road/RoadTypes.h"
 #include "carla/trafficmanager/InMemoryMap.h"
 
 #include <sstream>
+#include <stdexcept>
 
 namespace carla {
 namespace client {
 
   static auto MakeMap(const std::string &opendrive_contents) {
-    auto stream = std::istringstream(opendrive_contents);
-    auto map = opendrive::OpenDriveParser::Load(stream.str());
+    auto map = detail::MapCache::Load(opendrive_contents);
     if (!map.has_value()) {
       throw_exception(std::runtime_error("failed to generate map"));
     }
@@ -56,6 +56,22 @@ namespace client {
     nullptr;
   }
 
+  std::vector<SharedPtr<Waypoint>> Map::GetWaypoints(
+      const std::vector<geom::Location> &locations,
+      bool project_to_road,
+      int32_t lane_type) const {
+    std::vector<boost::optional<road::element::Waypoint>> waypoints;
+    _map.GetWaypoints(locations, waypoints, project_to_road, lane_type);
+    std::vector<SharedPtr<Waypoint>> result;
+    result.reserve(waypoints.size());
+    for (const auto &waypoint : waypoints) {
+      result.emplace_back(waypoint.has_value() ?
+          SharedPtr<Waypoint>(new Waypoint{shared_from_this(), *waypoint}) :
+          nullptr);
+    }
+    return result;
+  }
+
   SharedPtr<Waypoint> Map::GetWaypointXODR(
       carla::road::RoadId road_id,
       carla::road::LaneId lane_id,
@@ -102,6 +118,50 @@ namespace client {
     return result;
   }
 
+  std::vector<SharedPtr<Waypoint>> Map::GetNext(
+      const std::vector<SharedPtr<Waypoint>> &waypoints,
+      const std::vector<double> &distances,
+      std::vector<size_t> &offsets) const {
+    return GetWaypointBatch(waypoints, distances, true, offsets);
+  }
+
+  std::vector<SharedPtr<Waypoint>> Map::GetPrevious(
+      const std::vector<SharedPtr<Waypoint>> &waypoints,
+      const std::vector<double> &distances,
+      std::vector<size_t> &offsets) const {
+    return GetWaypointBatch(waypoints, distances, false, offsets);
+  }
+
+  std::vector<SharedPtr<Waypoint>> Map::GetWaypointBatch(
+      const std::vector<SharedPtr<Waypoint>> &waypoints,
+      const std::vector<double> &distances,
+      const bool next,
+      std::vector<size_t> &offsets) const {
+    if (waypoints.size() != distances.size()) {
+      throw_exception(std::invalid_argument(
+          "the number of waypoints and distances must match"));
+    }
+    std::vector<road::element::Waypoint> queries;
+    queries.reserve(waypoints.size());
+    for (const auto &waypoint : waypoints) {
+      DEBUG_ASSERT(waypoint != nullptr);
+      queries.emplace_back(waypoint->_waypoint);
+    }
+    road::Map::WaypointBatch batch;
+    if (next) {
+      _map.GetNext(queries, distances, batch);
+    } else {
+      _map.GetPrevious(queries, distances, batch);
+    }
+    std::vector<SharedPtr<Waypoint>> result;
+    result.reserve(batch.waypoints.size());
+    for (const auto &waypoint : batch.waypoints) {
+      result.emplace_back(SharedPtr<Waypoint>(new Waypoint{shared_from_this(), waypoint}));
+    }
+    offsets = std::move(batch.offsets);
+    return result;
+  }
+
   std::vector<road::element::LaneMarking> Map::CalculateCrossedLanes(
   const geom::Location &origin,
   const geom::Location &destination) const {
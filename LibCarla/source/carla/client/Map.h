@@ -56,6 +56,13 @@ namespace client {
         bool project_to_road = true,
         int32_t lane_type = static_cast<uint32_t>(road::Lane::LaneType::Driving)) const;
 
+    /// Batched version of GetWaypoint, answered in parallel. The result has a
+    /// waypoint per location, nullptr where there is none.
+    std::vector<SharedPtr<Waypoint>> GetWaypoints(
+        const std::vector<geom::Location> &locations,
+        bool project_to_road = true,
+        int32_t lane_type = static_cast<uint32_t>(road::Lane::LaneType::Driving)) const;
+
     SharedPtr<Waypoint> GetWaypointXODR(
       carla::road::RoadId road_id,
       carla::road::LaneId lane_id,
@@ -67,6 +74,20 @@ namespace client {
 
     std::vector<SharedPtr<Waypoint>> GenerateWaypoints(double distance) const;
 
+    /// Batched version of Waypoint::GetNext. The waypoints at @a distances[i]
+    /// from @a waypoints[i] are returned at indices offsets[i] to
+    /// offsets[i + 1] (not included) of the result.
+    std::vector<SharedPtr<Waypoint>> GetNext(
+        const std::vector<SharedPtr<Waypoint>> &waypoints,
+        const std::vector<double> &distances,
+        std::vector<size_t> &offsets) const;
+
+    /// Batched version of Waypoint::GetPrevious, see GetNext.
+    std::vector<SharedPtr<Waypoint>> GetPrevious(
+        const std::vector<SharedPtr<Waypoint>> &waypoints,
+        const std::vector<double> &distances,
+        std::vector<size_t> &offsets) const;
+
     std::vector<road::element::LaneMarking> CalculateCrossedLanes(
         const geom::Location &origin,
         const geom::Location &destination) const;
@@ -99,6 +120,12 @@ namespace client {
 
   private:
 
+    std::vector<SharedPtr<Waypoint>> GetWaypointBatch(
+        const std::vector<SharedPtr<Waypoint>> &waypoints,
+        const std::vector<double> &distances,
+        bool next,
+        std::vector<size_t> &offsets) const;
+
     std::string open_drive_file;
 
     const rpc::MapInfo _description;
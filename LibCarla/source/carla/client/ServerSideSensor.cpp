@@ -37,12 +37,20 @@ namespace client {
   }
 
   void ServerSideSensor::Listen(CallbackFunctionType callback) {
+    Listen(std::move(callback), streaming::DeliveryOptions{});
+  }
+
+  void ServerSideSensor::Listen(CallbackFunctionType callback, streaming::DeliveryOptions options) {
     log_debug("calling sensor Listen() ", GetDisplayId());
     log_debug(GetDisplayId(), ": subscribing to stream");
-    GetEpisode().Lock()->SubscribeToSensor(*this, std::move(callback));
+    GetEpisode().Lock()->SubscribeToSensor(*this, std::move(callback), options);
     listening_mask.set(0);
   }
 
+  streaming::DeliveryStats ServerSideSensor::GetDeliveryStats() const {
+    return GetEpisode().Lock()->GetSensorDeliveryStats(*this);
+  }
+
   void ServerSideSensor::Stop() {
     log_debug("calling sensor Stop() ", GetDisplayId());
     if (!IsListening()) {
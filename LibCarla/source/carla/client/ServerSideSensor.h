@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/client/Sensor.h"
+#include "carla/streaming/DeliveryPolicy.h"
 #include <bitset>
 
 namespace carla {
@@ -28,6 +29,15 @@ namespace client {
     /// the same sensor in the simulator.
     void Listen(CallbackFunctionType callback) override;
 
+    /// Register a @a callback to be executed each time a new measurement is
+    /// received, dropping the measurements that arrive while the callback is
+    /// busy as set by @a options.
+    void Listen(CallbackFunctionType callback, streaming::DeliveryOptions options);
+
+    /// Return the delivery counters of the measurements received since the
+    /// last call to Listen.
+    streaming::DeliveryStats GetDeliveryStats() const;
+
     /// Stop listening for new measurements.
     void Stop() override;
 
@@ -41,6 +41,11 @@ namespace client {
     return _episode.Lock()->GetVehiclesLightStates();
   }
 
+  std::vector<rpc::VehiclePhysicsControl> World::GetVehiclesPhysicsControl(
+      const std::vector<ActorId> &vehicle_ids) const {
+    return _episode.Lock()->GetVehiclesPhysicsControl(vehicle_ids);
+  }
+
   boost::optional<geom::Location> World::GetRandomLocationFromNavigation() const {
     return _episode.Lock()->GetRandomLocationFromNavigation();
   }
@@ -76,6 +76,11 @@ namespace client {
     /// and the second one is the light state
     rpc::VehicleLightStateList GetVehiclesLightStates() const;
 
+    /// Returns the physics control of each of the vehicles in @a vehicle_ids,
+    /// retrieved from the simulator in a single request.
+    std::vector<rpc::VehiclePhysicsControl> GetVehiclesPhysicsControl(
+        const std::vector<ActorId> &vehicle_ids) const;
+
     /// Get a random location from the pedestrians navigation mesh
     boost::optional<geom::Location> GetRandomLocationFromNavigation() const;
 
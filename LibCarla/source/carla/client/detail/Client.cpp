@@ -15,6 +15,7 @@
 #include "carla/rpc/BoneTransformDataIn.h"
 #include "carla/rpc/Client.h"
 #include "carla/rpc/DebugShape.h"
+#include "carla/rpc/MultiCall.h"
 #include "carla/rpc/Response.h"
 #include "carla/rpc/VehicleAckermannControl.h"
 #include "carla/rpc/VehicleControl.h"
@@ -26,6 +27,7 @@
 
 #include <rpc/rpc_error.h>
 
+#include <future>
 #include <thread>
 
 namespace carla {
@@ -66,15 +68,58 @@ namespace detail {
       }
     }
 
+    template <typename T>
+    static auto GetValue(carla::rpc::Response<T> &response) {
+      if (response.HasError()) {
+        throw_exception(std::runtime_error(response.GetError().What()));
+      }
+      return Get(response);
+    }
+
     template <typename T, typename ... Args>
     auto CallAndWait(const std::string &function, Args && ... args) {
       auto object = RawCall(function, std::forward<Args>(args) ...);
       using R = typename carla::rpc::Response<T>;
       auto response = object.template as<R>();
-      if (response.HasError()) {
-        throw_exception(std::runtime_error(response.GetError().What()));
+      return GetValue(response);
+    }
+
+    /// Same as CallAndWait but returns a future instead of waiting for the
+    /// response, so several calls can be in flight at once. The future is
+    /// deferred, it waits for the response (or the timeout) on get().
+    template <typename T, typename ... Args>
+    auto AsyncCallAndWait(const std::string &function, Args && ... args) {
+      auto future = rpc_client.async_call_with_response(function, std::forward<Args>(args) ...);
+      return std::async(std::launch::deferred, [this, future=std::move(future)]() mutable {
+        if (future.wait_for(GetTimeout().to_chrono()) == std::future_status::timeout) {
+          throw_exception(TimeoutException(endpoint, GetTimeout()));
+        }
+        using R = typename carla::rpc::Response<T>;
+        auto response = future.get().template as<R>();
+        return GetValue(response);
+      });
+    }
+
+    /// Send all the @a calls in a single request, the server runs them in a
+    /// single slot of the game thread. Every call must return @a T.
+    template <typename T>
+    std::vector<T> MultiCallAndWait(const std::vector<rpc::CallRequest> &calls) {
+      std::vector<T> values;
+      if (calls.empty()) {
+        return values;
       }
-      return Get(response);
+      auto object = RawCall(rpc::CallRequest::GetMultiCallFunctionName(), calls);
+      const auto results = object.template as<std::vector<rpc::CallResult>>();
+      DEBUG_ASSERT(results.size() == calls.size());
+      values.reserve(results.size());
+      for (const auto &result : results) {
+        if (result.HasError()) {
+          throw_exception(std::runtime_error(result.GetError().What()));
+        }
+        auto response = result.template As<carla::rpc::Response<T>>();
+        values.emplace_back(GetValue(response));
+      }
+      return values;
     }
 
     template <typename ... Args>
@@ -208,15 +253,23 @@ namespace detail {
 
     if (download) {
 
-      // For each required file, check if it exists and request it otherwise
+      // For each required file, check if it exists and request it otherwise.
+      // All the requests are sent before waiting for the first response.
+      using content_t = std::vector<uint8_t>;
+      std::vector<std::pair<std::string, std::future<content_t>>> requests;
       for (auto requiredFile : requiredFiles) {
         if (!FileTransfer::FileExists(requiredFile)) {
-          RequestFile(requiredFile);
+          requests.emplace_back(
+              requiredFile,
+              _pimpl->AsyncCallAndWait<content_t>("request_file", requiredFile));
           log_info("Could not find the required file in cache, downloading... ", requiredFile);
         } else {
           log_info("Found the required file in cache! ", requiredFile);
         }
       }
+      for (auto &request : requests) {
+        FileTransfer::WriteFile(request.first, request.second.get());
+      }
     }
     return requiredFiles;
   }
@@ -278,6 +331,16 @@ namespace detail {
     return _pimpl->CallAndWait<carla::rpc::VehiclePhysicsControl>("get_physics_control", vehicle);
   }
 
+  std::vector<rpc::VehiclePhysicsControl> Client::GetVehiclesPhysicsControl(
+      const std::vector<rpc::ActorId> &vehicles) const {
+    std::vector<rpc::CallRequest> calls;
+    calls.reserve(vehicles.size());
+    for (auto vehicle : vehicles) {
+      calls.emplace_back("get_physics_control", vehicle);
+    }
+    return _pimpl->MultiCallAndWait<rpc::VehiclePhysicsControl>(calls);
+  }
+
   rpc::VehicleLightState Client::GetVehicleLightState(
       rpc::ActorId vehicle) const {
     return _pimpl->CallAndWait<carla::rpc::VehicleLightState>("get_vehicle_light_state", vehicle);
@@ -414,6 +477,17 @@ namespace detail {
     return _pimpl->CallAndWait<geom::Transform>("get_actor_component_world_transform", actor, componentName);
   }
 
+  std::vector<geom::Transform> Client::GetActorComponentWorldTransforms(
+      rpc::ActorId actor,
+      const std::vector<std::string> &component_names) {
+    std::vector<rpc::CallRequest> calls;
+    calls.reserve(component_names.size());
+    for (const auto &component_name : component_names) {
+      calls.emplace_back("get_actor_component_world_transform", actor, component_name);
+    }
+    return _pimpl->MultiCallAndWait<geom::Transform>(calls);
+  }
+
   geom::Transform Client::GetActorComponentRelativeTransform(rpc::ActorId actor, const std::string componentName) {
     return _pimpl->CallAndWait<geom::Transform>("get_actor_component_relative_transform", actor, componentName);
   }
@@ -628,10 +702,19 @@ namespace detail {
 
   void Client::SubscribeToStream(
       const streaming::Token &token,
-      std::function<void(Buffer)> callback) {
+      std::function<void(Buffer)> callback,
+      streaming::DeliveryOptions options) {
     carla::streaming::detail::token_type thisToken(token);
     streaming::Token receivedToken = _pimpl->CallAndWait<streaming::Token>("get_sensor_token", thisToken.get_stream_id());
-    _pimpl->streaming_client.Subscribe(receivedToken, std::move(callback));
+    _pimpl->streaming_client.Subscribe(receivedToken, std::move(callback), options);
+  }
+
+  streaming::DeliveryStats Client::GetStreamDeliveryStats(const streaming::Token &token) const {
+    return _pimpl->streaming_client.GetDeliveryStats(token);
+  }
+
+  void Client::SetStreamMultiplexing(bool enabled) {
+    _pimpl->streaming_client.SetMultiplexing(enabled);
   }
 
   void Client::UnSubscribeFromStream(const streaming::Token &token) {
@@ -689,6 +772,17 @@ namespace detail {
     return result.as<std::vector<rpc::CommandResponse>>();
   }
 
+  void Client::ApplyCommandBatch(std::vector<rpc::CommandBatch> batches, bool do_tick_cue) {
+    _pimpl->AsyncCall("apply_command_batch", std::move(batches), do_tick_cue);
+  }
+
+  std::vector<uint32_t> Client::ApplyCommandBatchSync(
+      std::vector<rpc::CommandBatch> batches,
+      bool do_tick_cue) {
+    auto result = _pimpl->RawCall("apply_command_batch", std::move(batches), do_tick_cue);
+    return result.as<std::vector<uint32_t>>();
+  }
+
   uint64_t Client::SendTickCue() {
     return _pimpl->CallAndWait<uint64_t>("tick_cue");
   }
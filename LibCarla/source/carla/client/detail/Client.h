@@ -15,6 +15,7 @@
 #include "carla/rpc/ActorDefinition.h"
 #include "carla/rpc/AttachmentType.h"
 #include "carla/rpc/Command.h"
+#include "carla/rpc/CommandBatch.h"
 #include "carla/rpc/CommandResponse.h"
 #include "carla/rpc/EnvironmentObject.h"
 #include "carla/rpc/EpisodeInfo.h"
@@ -33,6 +34,7 @@
 #include "carla/rpc/WeatherParameters.h"
 #include "carla/rpc/Texture.h"
 #include "carla/rpc/MaterialParameter.h"
+#include "carla/streaming/DeliveryPolicy.h"
 
 #include <functional>
 #include <memory>
@@ -153,6 +155,10 @@ namespace detail {
 
     rpc::VehiclePhysicsControl GetVehiclePhysicsControl(rpc::ActorId vehicle) const;
 
+    /// Physics control of several vehicles, retrieved in a single request.
+    std::vector<rpc::VehiclePhysicsControl> GetVehiclesPhysicsControl(
+        const std::vector<rpc::ActorId> &vehicles) const;
+
     rpc::VehicleLightState GetVehicleLightState(rpc::ActorId vehicle) const;
 
     void ApplyPhysicsControlToVehicle(
@@ -237,6 +243,12 @@ namespace detail {
         rpc::ActorId actor,
         const std::string componentName);
 
+    /// World transform of several components of @a actor, retrieved in a
+    /// single request.
+    std::vector<geom::Transform> GetActorComponentWorldTransforms(
+        rpc::ActorId actor,
+        const std::vector<std::string> &component_names);
+
     geom::Transform GetActorComponentRelativeTransform(
         rpc::ActorId actor,
         const std::string componentName);
@@ -402,7 +414,12 @@ namespace detail {
 
     void SubscribeToStream(
         const streaming::Token &token,
-        std::function<void(Buffer)> callback);
+        std::function<void(Buffer)> callback,
+        streaming::DeliveryOptions options = streaming::DeliveryOptions{});
+
+    streaming::DeliveryStats GetStreamDeliveryStats(const streaming::Token &token) const;
+
+    void SetStreamMultiplexing(bool enabled);
 
     void SubscribeToGBuffer(
         rpc::ActorId ActorId,
@@ -431,6 +448,16 @@ namespace detail {
         std::vector<rpc::Command> commands,
         bool do_tick_cue);
 
+    void ApplyCommandBatch(
+        std::vector<rpc::CommandBatch> batches,
+        bool do_tick_cue);
+
+    /// Returns the indices of the commands that failed, counting the commands
+    /// of all the batches in order.
+    std::vector<uint32_t> ApplyCommandBatchSync(
+        std::vector<rpc::CommandBatch> batches,
+        bool do_tick_cue);
+
     uint64_t SendTickCue();
 
     std::vector<rpc::LightState> QueryLightsStateToServer() const;
@@ -20,9 +20,9 @@ namespace detail {
 
 using namespace std::chrono_literals;
 
-  static auto &CastData(const sensor::SensorData &data) {
+  static auto CastData(SharedPtr<sensor::SensorData> data) {
     using target_t = const sensor::data::RawEpisodeState;
-    return static_cast<target_t &>(data);
+    return boost::static_pointer_cast<target_t>(std::move(data));
   }
 
   template <typename RangeT>
@@ -58,7 +58,12 @@ using namespace std::chrono_literals;
       if (self != nullptr) {
 
         auto data = sensor::Deserializer::Deserialize(std::move(buffer));
-        auto next = std::make_shared<const EpisodeState>(CastData(*data));
+        auto raw_state = self->ResolveDeltaFrame(CastData(std::move(data)));
+        if (raw_state == nullptr) {
+          // Delta frames are useless until a keyframe is received.
+          return;
+        }
+        auto next = std::make_shared<const EpisodeState>(std::move(raw_state));
         auto prev = self->GetState();
 
         // TODO: Update how the map change is detected
@@ -141,6 +146,25 @@ using namespace std::chrono_literals;
     traffic_manager::TrafficManager::Reset();
   }
 
+  SharedPtr<const sensor::data::RawEpisodeState> Episode::ResolveDeltaFrame(
+      SharedPtr<const sensor::data::RawEpisodeState> state) {
+    using Serializer = sensor::s11n::EpisodeStateSerializer;
+    std::lock_guard<std::mutex> lock(_keyframe_mutex);
+    if (!state->IsDeltaFrame()) {
+      _keyframe = state;
+      return state;
+    }
+    if (_keyframe == nullptr) {
+      return nullptr;
+    }
+    auto buffer = Serializer::ApplyDelta(*_keyframe, *state);
+    if (buffer.empty()) {
+      log_debug("episode state: missing keyframe", state->GetKeyframe(), "for frame", state->GetFrame());
+      return nullptr;
+    }
+    return CastData(sensor::Deserializer::Deserialize(std::move(buffer)));
+  }
+
   bool Episode::HasMapChangedSinceLastCall() {
     if(_should_update_map) {
       _should_update_map = false;
@@ -16,7 +16,9 @@
 #include "carla/client/detail/EpisodeState.h"
 #include "carla/client/detail/EpisodeProxy.h"
 #include "carla/rpc/EpisodeInfo.h"
+#include "carla/sensor/data/RawEpisodeState.h"
 
+#include <mutex>
 #include <vector>
 
 namespace carla {
@@ -109,6 +111,11 @@ namespace detail {
 
     void OnEpisodeChanged();
 
+    /// Rebuild the full frame of a delta frame of the episode state stream.
+    /// Returns nullptr if its keyframe was not received.
+    SharedPtr<const sensor::data::RawEpisodeState> ResolveDeltaFrame(
+        SharedPtr<const sensor::data::RawEpisodeState> state);
+
     Client &_client;
 
     AtomicSharedPtr<const EpisodeState> _state;
@@ -127,6 +134,11 @@ namespace detail {
 
     AtomicSharedPtr<WalkerNavigation> _walker_navigation;
 
+    std::mutex _keyframe_mutex;
+
+    /// Last keyframe received, delta frames are applied to it.
+    SharedPtr<const sensor::data::RawEpisodeState> _keyframe;
+
     const streaming::Token _token;
 
     bool _pending_exceptions = false;
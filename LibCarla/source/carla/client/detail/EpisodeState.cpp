@@ -6,33 +6,80 @@
 
 #include "carla/client/detail/EpisodeState.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace carla {
 namespace client {
 namespace detail {
 
-  EpisodeState::EpisodeState(const sensor::data::RawEpisodeState &state)
-    : _episode_id(state.GetEpisodeId()),
+  EpisodeState::EpisodeState(SharedPtr<const RawState> state)
+    : _episode_id(state->GetEpisodeId()),
       _timestamp(
-          state.GetFrame(),
-          state.GetGameTimeStamp(),
-          state.GetDeltaSeconds(),
-          state.GetPlatformTimeStamp()),
-      _map_origin(state.GetMapOrigin()),
-      _simulation_state(state.GetSimulationState()) {
-    _actors.reserve(state.size());
-    for (auto &&actor : state) {
-      DEBUG_ONLY(auto result = )
-      _actors.emplace(
-          actor.id,
-          ActorSnapshot{
-              actor.id,
-              actor.actor_state,
-              actor.transform,
-              actor.velocity,
-              actor.angular_velocity,
-              actor.acceleration,
-              actor.state});
-      DEBUG_ASSERT(result.second);
+          state->GetFrame(),
+          state->GetGameTimeStamp(),
+          state->GetDeltaSeconds(),
+          state->GetPlatformTimeStamp()),
+      _map_origin(state->GetMapOrigin()),
+      _simulation_state(state->GetSimulationState()),
+      _state(std::move(state)) {
+    DEBUG_ASSERT(!_state->IsDeltaFrame());
+  }
+
+  /// Empty slot of the dense index.
+  static constexpr uint32_t NO_ACTOR = std::numeric_limits<uint32_t>::max();
+
+  const sensor::data::ActorDynamicState *EpisodeState::FindActor(const ActorId id) const {
+    std::call_once(_index_built, [this]() { BuildIndex(); });
+    if (!_dense_index.empty()) {
+      const ActorId offset = id - _min_actor_id;
+      if ((id < _min_actor_id) || (offset >= _dense_index.size()) || (_dense_index[offset] == NO_ACTOR)) {
+        return nullptr;
+      }
+      return ActorsBegin() + _dense_index[offset];
+    }
+    auto it = std::lower_bound(_sorted_index.begin(), _sorted_index.end(), id, [](const auto &lhs, ActorId rhs) {
+      return lhs.first < rhs;
+    });
+    if ((it == _sorted_index.end()) || (it->first != id)) {
+      return nullptr;
+    }
+    return ActorsBegin() + it->second;
+  }
+
+  void EpisodeState::BuildIndex() const {
+    const size_t count = size();
+    if (count == 0u) {
+      return;
+    }
+    DEBUG_ASSERT(count < NO_ACTOR);
+    const ActorDynamicState *actors = ActorsBegin();
+    ActorId min_id = actors[0u].id;
+    ActorId max_id = actors[0u].id;
+    for (size_t i = 1u; i < count; ++i) {
+      min_id = std::min(min_id, actors[i].id);
+      max_id = std::max(max_id, actors[i].id);
+    }
+    // Actor ids are usually consecutive, a table indexed by id gives constant
+    // time look-ups with little memory. Otherwise fall back to binary search.
+    const size_t range = static_cast<size_t>(max_id - min_id) + 1u;
+    if (range <= 4u * count) {
+      _min_actor_id = min_id;
+      _dense_index.assign(range, NO_ACTOR);
+      for (size_t i = 0u; i < count; ++i) {
+        auto &slot = _dense_index[actors[i].id - min_id];
+        DEBUG_ASSERT(slot == NO_ACTOR);
+        slot = static_cast<uint32_t>(i);
+      }
+    } else {
+      _sorted_index.reserve(count);
+      for (size_t i = 0u; i < count; ++i) {
+        _sorted_index.emplace_back(actors[i].id, static_cast<uint32_t>(i));
+      }
+      std::sort(_sorted_index.begin(), _sorted_index.end());
+      DEBUG_ASSERT(std::adjacent_find(_sorted_index.begin(), _sorted_index.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first == rhs.first;
+      }) == _sorted_index.end());
     }
   }
 
@@ -6,35 +6,64 @@
 
 #pragma once
 
-#include "carla/Iterator.h"
 #include "carla/ListView.h"
+#include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/client/ActorSnapshot.h"
 #include "carla/client/Timestamp.h"
 #include "carla/geom/Vector3DInt.h"
 #include "carla/sensor/data/RawEpisodeState.h"
 
+#include <boost/iterator/transform_iterator.hpp>
 #include <boost/optional.hpp>
 
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <vector>
 
 namespace carla {
 namespace client {
 namespace detail {
 
   /// Represents the state of all the actors of an episode at a given frame.
+  ///
+  /// The actors are read in place from the buffer received from the
+  /// simulator, which is kept alive by this object. The index used for the
+  /// look-ups by id is built the first time it is needed.
   class EpisodeState
     : public std::enable_shared_from_this<EpisodeState>,
       private NonCopyable {
 
       using SimulationState = sensor::s11n::EpisodeStateSerializer::SimulationState;
 
+      using RawState = sensor::data::RawEpisodeState;
+
+      using ActorDynamicState = sensor::data::ActorDynamicState;
+
+      struct GetActorId {
+        ActorId operator()(const ActorDynamicState &actor) const {
+          return actor.id;
+        }
+      };
+
+      struct MakeActorSnapshot {
+        ActorSnapshot operator()(const ActorDynamicState &actor) const {
+          return ActorSnapshot{
+              actor.id,
+              actor.actor_state,
+              actor.transform,
+              actor.velocity,
+              actor.angular_velocity,
+              actor.acceleration,
+              actor.state};
+        }
+      };
+
   public:
 
     explicit EpisodeState(uint64_t episode_id) : _episode_id(episode_id) {}
 
-    explicit EpisodeState(const sensor::data::RawEpisodeState &state);
+    explicit EpisodeState(SharedPtr<const RawState> state);
 
     auto GetEpisodeId() const {
       return _episode_id;
@@ -61,7 +90,7 @@ namespace detail {
     }
 
     bool ContainsActorSnapshot(ActorId actor_id) const {
-      return _actors.find(actor_id) != _actors.end();
+      return FindActor(actor_id) != nullptr;
     }
 
     ActorSnapshot GetActorSnapshot(ActorId id) const {
@@ -78,32 +107,45 @@ namespace detail {
 
     auto GetActorIds() const {
       return MakeListView(
-          iterator::make_map_keys_const_iterator(_actors.begin()),
-          iterator::make_map_keys_const_iterator(_actors.end()));
+          boost::make_transform_iterator(ActorsBegin(), GetActorId{}),
+          boost::make_transform_iterator(ActorsEnd(), GetActorId{}));
     }
 
     size_t size() const {
-      return _actors.size();
+      return static_cast<size_t>(ActorsEnd() - ActorsBegin());
     }
 
     auto begin() const {
-      return iterator::make_map_values_const_iterator(_actors.begin());
+      return boost::make_transform_iterator(ActorsBegin(), MakeActorSnapshot{});
     }
 
     auto end() const {
-      return iterator::make_map_values_const_iterator(_actors.end());
+      return boost::make_transform_iterator(ActorsEnd(), MakeActorSnapshot{});
     }
 
   private:
 
     template <typename T>
     void CopyActorSnapshotIfPresent(ActorId id, T &value) const {
-      auto it = _actors.find(id);
-      if (it != _actors.end()) {
-        value = it->second;
+      const ActorDynamicState *actor = FindActor(id);
+      if (actor != nullptr) {
+        value = MakeActorSnapshot{}(*actor);
       }
     }
 
+    const ActorDynamicState *ActorsBegin() const {
+      return _state != nullptr ? _state->begin() : nullptr;
+    }
+
+    const ActorDynamicState *ActorsEnd() const {
+      return _state != nullptr ? _state->end() : nullptr;
+    }
+
+    /// Returns nullptr if the actor is not present.
+    const ActorDynamicState *FindActor(ActorId id) const;
+
+    void BuildIndex() const;
+
     const uint64_t _episode_id;
 
     const Timestamp _timestamp;
@@ -112,7 +154,19 @@ namespace detail {
 
     SimulationState _simulation_state;
 
-    std::unordered_map<ActorId, ActorSnapshot> _actors;
+    SharedPtr<const RawState> _state;
+
+    /// Position in the buffer of each actor, indexed by id minus
+    /// _min_actor_id. Used when the ids are dense enough.
+    mutable std::vector<uint32_t> _dense_index;
+
+    mutable ActorId _min_actor_id = 0u;
+
+    /// Pairs of actor id and position in the buffer, sorted by id. Used
+    /// otherwise.
+    mutable std::vector<std::pair<ActorId, uint32_t>> _sorted_index;
+
+    mutable std::once_flag _index_built;
   };
 
 } // namespace detail
@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/MapCache.h"
+
+#include "carla/FileSystem.h"
+#include "carla/Logging.h"
+#include "carla/Version.h"
+#include "carla/client/FileTransfer.h"
+#include "carla/opendrive/OpenDriveParser.h"
+#include "carla/road/MapSerializer.h"
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  namespace fs = boost::filesystem;
+  namespace bip = boost::interprocess;
+
+  static boost::optional<road::Map> ReadFromCache(const std::string &path, uint64_t hash) {
+    try {
+      boost::system::error_code ec;
+      if (!fs::exists(path, ec) || (fs::file_size(path, ec) == 0u) || ec) {
+        return boost::none;
+      }
+      // The map is restored directly from the mapped file, no copies.
+      bip::file_mapping file(path.c_str(), bip::read_only);
+      bip::mapped_region region(file, bip::read_only);
+      auto map = road::MapSerializer::Deserialize(
+          static_cast<const uint8_t *>(region.get_address()),
+          region.get_size(),
+          hash);
+      if (!map.has_value()) {
+        log_warning("ignoring invalid or outdated map cache file", path);
+      }
+      return map;
+    } catch (const std::exception &e) {
+      log_warning("failed to read map cache file", path, ':', e.what());
+      return boost::none;
+    }
+  }
+
+  static void WriteToCache(std::string path, const std::vector<uint8_t> &data) {
+    if (data.empty()) {
+      return;
+    }
+    std::string temp_path;
+    try {
+      FileSystem::ValidateFilePath(path);
+      // Write to a temporary file and rename it, so other clients never map a
+      // partially written file.
+      temp_path = path + fs::unique_path(".%%%%-%%%%-%%%%.tmp").string();
+      {
+        std::ofstream out(temp_path, std::ios::trunc | std::ios::binary);
+        out.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out.good()) {
+          throw std::runtime_error("failed to write file");
+        }
+      }
+      fs::rename(temp_path, path);
+    } catch (const std::exception &e) {
+      log_warning("failed to write map cache file", path, ':', e.what());
+      boost::system::error_code ec;
+      fs::remove(temp_path, ec);
+    }
+  }
+
+  std::string MapCache::GetFilePath(const uint64_t hash) {
+    std::ostringstream path;
+    path << FileTransfer::GetFilesBaseFolder() << '/' << ::carla::version()
+         << "/MapCache/" << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+    return path.str();
+  }
+
+  boost::optional<road::Map> MapCache::Load(const std::string &opendrive) {
+    const uint64_t hash = road::MapSerializer::HashOpenDrive(opendrive);
+    const std::string path = GetFilePath(hash);
+    auto map = ReadFromCache(path, hash);
+    if (map.has_value()) {
+      return map;
+    }
+    map = opendrive::OpenDriveParser::Load(opendrive);
+    if (map.has_value()) {
+      WriteToCache(path, road::MapSerializer::Serialize(*map, hash));
+    }
+    return map;
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,38 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/road/Map.h"
+
+#include <boost/optional.hpp>
+
+#include <string>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Cache of built road maps in the files folder of the client (see
+  /// FileTransfer), keyed by the hash of their OpenDRIVE contents. Clients
+  /// loading a map already in the cache skip parsing the OpenDRIVE file.
+  class MapCache {
+  public:
+
+    MapCache() = delete;
+
+    /// Load the map of @a opendrive from the cache, or parse it and add it to
+    /// the cache if missing. Returns an empty optional if the OpenDRIVE file
+    /// cannot be parsed.
+    static boost::optional<road::Map> Load(const std::string &opendrive);
+
+    /// Path of the cached map of the OpenDRIVE file with hash @a hash.
+    static std::string GetFilePath(uint64_t hash);
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -393,7 +393,8 @@ EpisodeProxy Simulator::GetCurrentEpisode() {
 
   void Simulator::SubscribeToSensor(
       const Sensor &sensor,
-      std::function<void(SharedPtr<sensor::SensorData>)> callback) {
+      std::function<void(SharedPtr<sensor::SensorData>)> callback,
+      streaming::DeliveryOptions options) {
     DEBUG_ASSERT(_episode != nullptr);
     _client.SubscribeToStream(
         sensor.GetActorDescription().GetStreamToken(),
@@ -401,7 +402,12 @@ EpisodeProxy Simulator::GetCurrentEpisode() {
           auto data = sensor::Deserializer::Deserialize(std::move(buffer));
           data->_episode = ep.TryLock();
           cb(std::move(data));
-        });
+        },
+        options);
+  }
+
+  streaming::DeliveryStats Simulator::GetSensorDeliveryStats(const Sensor &sensor) const {
+    return _client.GetStreamDeliveryStats(sensor.GetActorDescription().GetStreamToken());
   }
 
   void Simulator::UnSubscribeFromSensor(Actor &sensor) {
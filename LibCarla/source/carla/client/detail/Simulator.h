@@ -263,6 +263,11 @@ namespace detail {
       return _client.GetVehiclePhysicsControl(vehicle.GetId());
     }
 
+    std::vector<rpc::VehiclePhysicsControl> GetVehiclesPhysicsControl(
+        const std::vector<ActorId> &vehicle_ids) const {
+      return _client.GetVehiclesPhysicsControl(vehicle_ids);
+    }
+
     rpc::VehicleLightState GetVehicleLightState(const Vehicle &vehicle) const {
       return _client.GetVehicleLightState(vehicle.GetId());
     }
@@ -443,6 +448,12 @@ namespace detail {
       return _client.GetActorComponentWorldTransform(actor.GetId(), componentName);
     }
 
+    std::vector<geom::Transform> GetActorComponentWorldTransforms(
+        const Actor &actor,
+        const std::vector<std::string> &component_names) {
+      return _client.GetActorComponentWorldTransforms(actor.GetId(), component_names);
+    }
+
     geom::Transform GetActorComponentRelativeTransform(const Actor &actor, std::string componentName) {
       return _client.GetActorComponentRelativeTransform(actor.GetId(), componentName);
     }
@@ -660,7 +671,14 @@ namespace detail {
 
     void SubscribeToSensor(
         const Sensor &sensor,
-        std::function<void(SharedPtr<sensor::SensorData>)> callback);
+        std::function<void(SharedPtr<sensor::SensorData>)> callback,
+        streaming::DeliveryOptions options = streaming::DeliveryOptions{});
+
+    streaming::DeliveryStats GetSensorDeliveryStats(const Sensor &sensor) const;
+
+    void SetStreamMultiplexing(bool enabled) {
+      _client.SetStreamMultiplexing(enabled);
+    }
 
     void UnSubscribeFromSensor(Actor &sensor);
 
@@ -745,6 +763,14 @@ namespace detail {
       return _client.ApplyBatchSync(std::move(commands), do_tick_cue);
     }
 
+    void ApplyCommandBatch(std::vector<rpc::CommandBatch> batches, bool do_tick_cue) {
+      _client.ApplyCommandBatch(std::move(batches), do_tick_cue);
+    }
+
+    auto ApplyCommandBatchSync(std::vector<rpc::CommandBatch> batches, bool do_tick_cue) {
+      return _client.ApplyCommandBatchSync(std::move(batches), do_tick_cue);
+    }
+
     /// @}
     // =========================================================================
     /// @name Operations lights
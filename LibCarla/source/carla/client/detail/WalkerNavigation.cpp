@@ -12,6 +12,7 @@
 #include "carla/client/detail/Simulator.h"
 #include "carla/nav/Navigation.h"
 #include "carla/rpc/Command.h"
+#include "carla/rpc/CommandBatch.h"
 #include "carla/rpc/DebugShape.h"
 #include "carla/rpc/WalkerControl.h"
 
@@ -45,28 +46,27 @@ namespace detail {
     // add/update/delete all vehicles in crowd
     UpdateVehiclesInCrowd(episode, false);
 
-    // update crowd in navigation module
-    _nav.UpdateCrowd(*state);
+    // update crowd in navigation module, reading all the walkers at once
+    _nav.UpdateCrowd(*state, _walker_states);
 
-    carla::geom::Transform trans;
+    // send the new states as a single columnar batch
     using Cmd = rpc::Command;
-    std::vector<Cmd> commands;
-    commands.reserve(walkers->size());
-    for (auto handle : *walkers) {
-      // get the transform of the walker
-      if (_nav.GetWalkerTransform(handle.walker, trans)) {
-        float speed = _nav.GetWalkerSpeed(handle.walker);
-        commands.emplace_back(Cmd::ApplyWalkerState{ handle.walker, trans, speed });
-      }
+    rpc::CommandBatch batch(rpc::CommandBatch::Type::ApplyWalkerState, _walker_states.size());
+    for (size_t i = 0u; i < _walker_states.size(); ++i) {
+      const auto &walker = _walker_states[i];
+      batch.Set(i, Cmd::ApplyWalkerState{ walker.id, walker.transform, walker.speed });
     }
-    _simulator.lock()->ApplyBatchSync(std::move(commands), false);
+    std::vector<rpc::CommandBatch> batches;
+    batches.emplace_back(std::move(batch));
+    _simulator.lock()->ApplyCommandBatchSync(std::move(batches), false);
 
     // check if any agent has been killed
-    bool alive;
-    for (auto handle : *walkers) {
-      // get the agent state
-      if (_nav.IsWalkerAlive(handle.walker, alive)) {
-        if (!alive) {
+    for (const auto &walker : _walker_states) {
+      if (walker.alive) {
+        continue;
+      }
+      for (auto handle : *walkers) {
+        if (handle.walker == walker.id) {
           _simulator.lock()->SetActorCollisions(handle.walker, true);
           _simulator.lock()->SetActorDead(handle.walker);
           // remove from the crowd
@@ -75,6 +75,7 @@ namespace detail {
           _simulator.lock()->DestroyActor(handle.controller);
           // unregister from list
           UnregisterWalker(handle.walker, handle.controller);
+          break;
         }
       }
     }
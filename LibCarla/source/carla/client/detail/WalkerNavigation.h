@@ -103,6 +103,9 @@ namespace detail {
 
     AtomicList<WalkerHandle> _walkers;
 
+    /// state of the walkers read in the last tick, reused between ticks
+    std::vector<carla::nav::WalkerState> _walker_states;
+
     /// check a few walkers and if they don't exist then remove from the crowd
     void CheckIfWalkerExist(std::vector<WalkerHandle> walkers, const EpisodeState &state);
     /// add/update/delete all vehicles in crowd
@@ -102,6 +102,13 @@ namespace geom {
       _rtree.insert(elements.begin(), elements.end());
     }
 
+    /// Replace the contents of the tree with @a elements, bulk-loaded with
+    /// the packing algorithm (STR). Faster than inserting the elements one at
+    /// a time, and the nodes overlap less, so queries visit fewer of them.
+    void BulkLoad(const std::vector<TreeElement> &elements) {
+      RtreeType(elements.begin(), elements.end()).swap(_rtree);
+    }
+
     /// Return nearest neighbors with a user defined filter.
     /// The filter reveices as an argument a TreeElement value and needs to
     /// return a bool to accept or reject the value
@@ -144,9 +151,16 @@ namespace geom {
       return _rtree.size();
     }
 
+    /// Returns all the elements of the tree.
+    std::vector<TreeElement> GetElements() const {
+      return std::vector<TreeElement>(_rtree.begin(), _rtree.end());
+    }
+
   private:
 
-    boost::geometry::index::rtree<TreeElement, boost::geometry::index::linear<16>> _rtree;
+    using RtreeType = boost::geometry::index::rtree<TreeElement, boost::geometry::index::linear<16>>;
+
+    RtreeType _rtree;
 
   };
 
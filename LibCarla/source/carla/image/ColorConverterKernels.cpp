@@ -0,0 +1,492 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/image/ColorConverterKernels.h"
+
+#include "carla/Debug.h"
+#include "carla/ThreadGroup.h"
+#include "carla/image/BoostGil.h"
+#include "carla/image/ColorConverter.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <thread>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define LIBCARLA_COLOR_CONVERTER_WITH_SIMD
+#  define LIBCARLA_TARGET(isa) __attribute__((target(isa)))
+#  include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  define LIBCARLA_COLOR_CONVERTER_WITH_SIMD
+#  define LIBCARLA_TARGET(isa)
+#  include <intrin.h>
+#  include <immintrin.h>
+#endif
+
+namespace carla {
+namespace image {
+
+  using InstructionSet = ColorConverterKernels::InstructionSet;
+
+  using Pixel = boost::gil::bgra8_pixel_t;
+
+  static_assert(sizeof(Pixel) == 4u, "Invalid pixel size.");
+
+  using Kernel = void (*)(uint8_t *data, size_t count);
+
+  // ===========================================================================
+  // -- Scalar kernels ---------------------------------------------------------
+  // ===========================================================================
+
+  // The scalar conversions go through the same functors used by ImageView, so
+  // the vectorized kernels only need to match these.
+
+  static void ConvertPixel(ColorConverter::Depth, const Pixel &src, Pixel &dst) {
+    ColorConverter::Depth()(src, dst);
+  }
+
+  static void ConvertPixel(ColorConverter::LogarithmicDepth, const Pixel &src, Pixel &dst) {
+    boost::gil::gray32f_pixel_t depth;
+    ColorConverter::Depth()(src, depth);
+    ColorConverter::LogarithmicLinear()(depth, dst);
+  }
+
+  static void ConvertPixel(ColorConverter::CityScapesPalette, const Pixel &src, Pixel &dst) {
+    ColorConverter::CityScapesPalette()(src, dst);
+  }
+
+  template <typename CC>
+  static void ConvertPixels(uint8_t *data, size_t count) {
+    auto *pixels = reinterpret_cast<Pixel *>(data);
+    for (auto i = 0u; i < count; ++i) {
+      const Pixel src = pixels[i];
+      ConvertPixel(CC(), src, pixels[i]);
+    }
+  }
+
+#ifdef LIBCARLA_COLOR_CONVERTER_WITH_SIMD
+
+  // ===========================================================================
+  // -- Shared constants -------------------------------------------------------
+  // ===========================================================================
+
+  static constexpr float MAX_DEPTH = static_cast<float>(256 * 256 * 256 - 1);
+
+  static constexpr float LOGARITHMIC_SCALE = 5.70378f;
+
+  static constexpr float MIN_LOGARITHMIC_VALUE = 0.005f;
+
+  /// The vectorized logarithm is off by a few ulp, lanes whose channel value
+  /// lands this close to a rounding boundary are recomputed with the scalar
+  /// conversion.
+  static constexpr float ROUNDING_MARGIN = 1e-3f;
+
+  /// Color of each tag in BGRA8, indexed by the red channel.
+  static const int32_t *GetPaletteTable() {
+    static const auto table = []() {
+      std::array<int32_t, 256u> result;
+      for (auto tag = 0u; tag < result.size(); ++tag) {
+        Pixel src{0u, 0u, 0u, 0u};
+        boost::gil::get_color(src, boost::gil::red_t()) = static_cast<uint8_t>(tag);
+        Pixel dst;
+        ConvertPixel(ColorConverter::CityScapesPalette(), src, dst);
+        std::memcpy(&result[tag], &dst, sizeof(dst));
+      }
+      return result;
+    }();
+    return table.data();
+  }
+
+  template <typename CC>
+  static void FixLanes(int mask, const Pixel *src, uint8_t *data) {
+    auto *dst = reinterpret_cast<Pixel *>(data);
+    for (auto lane = 0; mask != 0; ++lane, mask >>= 1) {
+      if ((mask & 1) != 0) {
+        ConvertPixel(CC(), src[lane], dst[lane]);
+      }
+    }
+  }
+
+  // ===========================================================================
+  // -- SSE4.1 kernels ---------------------------------------------------------
+  // ===========================================================================
+
+  /// R + G * 256 + B * 256 * 256 of each pixel, normalized to [0, 1].
+  LIBCARLA_TARGET("sse4.1")
+  static inline __m128 NormalizedDepth128(__m128i pixels) {
+    const __m128i to_depth = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const __m128 depth = _mm_cvtepi32_ps(_mm_shuffle_epi8(pixels, to_depth));
+    return _mm_div_ps(depth, _mm_set1_ps(MAX_DEPTH));
+  }
+
+  /// Same rounding as Boost.GIL float to 8-bit channel conversion, before
+  /// truncating.
+  LIBCARLA_TARGET("sse4.1")
+  static inline __m128 ChannelValue128(__m128 x) {
+    return _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+  }
+
+  LIBCARLA_TARGET("sse4.1")
+  static inline __m128i GrayToBGRA128(__m128 channel) {
+    const __m128i to_bgr = _mm_setr_epi8(0, 0, 0, -1, 4, 4, 4, -1, 8, 8, 8, -1, 12, 12, 12, -1);
+    const __m128i alpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    return _mm_or_si128(_mm_shuffle_epi8(_mm_cvttps_epi32(channel), to_bgr), alpha);
+  }
+
+  /// Natural logarithm of positive values, Cephes polynomial approximation.
+  LIBCARLA_TARGET("sse4.1")
+  static inline __m128 Log128(__m128 x) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    x = _mm_max_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x00800000)));
+    const __m128i exponent = _mm_sub_epi32(
+        _mm_srli_epi32(_mm_castps_si128(x), 23),
+        _mm_set1_epi32(0x7F));
+    x = _mm_or_ps(
+        _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(~0x7F800000))),
+        _mm_set1_ps(0.5f));
+    __m128 e = _mm_add_ps(_mm_cvtepi32_ps(exponent), one);
+    const __m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+    const __m128 tmp = _mm_and_ps(x, mask);
+    x = _mm_sub_ps(x, one);
+    e = _mm_sub_ps(e, _mm_and_ps(one, mask));
+    x = _mm_add_ps(x, tmp);
+    const __m128 z = _mm_mul_ps(x, x);
+    __m128 y = _mm_set1_ps(7.0376836292e-2f);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+    y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+    y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+    y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    x = _mm_add_ps(x, y);
+    return _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+  }
+
+  LIBCARLA_TARGET("sse4.1")
+  static inline __m128 LogarithmicLinear128(__m128 depth) {
+    const __m128 value = _mm_add_ps(
+        _mm_set1_ps(1.0f),
+        _mm_div_ps(Log128(depth), _mm_set1_ps(LOGARITHMIC_SCALE)));
+    return _mm_max_ps(
+        _mm_min_ps(value, _mm_set1_ps(1.0f)),
+        _mm_set1_ps(MIN_LOGARITHMIC_VALUE));
+  }
+
+  LIBCARLA_TARGET("sse4.1")
+  static inline int NearRounding128(__m128 channel) {
+    const __m128 fraction = _mm_sub_ps(channel, _mm_floor_ps(channel));
+    return _mm_movemask_ps(_mm_or_ps(
+        _mm_cmplt_ps(fraction, _mm_set1_ps(ROUNDING_MARGIN)),
+        _mm_cmpgt_ps(fraction, _mm_set1_ps(1.0f - ROUNDING_MARGIN))));
+  }
+
+  LIBCARLA_TARGET("sse4.1")
+  static void DepthSSE41(uint8_t *data, size_t count) {
+    size_t i = 0u;
+    for (; i + 4u <= count; i += 4u) {
+      auto *pixels = reinterpret_cast<__m128i *>(data + 4u * i);
+      const __m128 depth = NormalizedDepth128(_mm_loadu_si128(pixels));
+      _mm_storeu_si128(pixels, GrayToBGRA128(ChannelValue128(depth)));
+    }
+    ConvertPixels<ColorConverter::Depth>(data + 4u * i, count - i);
+  }
+
+  LIBCARLA_TARGET("sse4.1")
+  static void LogarithmicDepthSSE41(uint8_t *data, size_t count) {
+    size_t i = 0u;
+    for (; i + 4u <= count; i += 4u) {
+      auto *pixels = reinterpret_cast<__m128i *>(data + 4u * i);
+      const __m128i src = _mm_loadu_si128(pixels);
+      const __m128 channel = ChannelValue128(LogarithmicLinear128(NormalizedDepth128(src)));
+      _mm_storeu_si128(pixels, GrayToBGRA128(channel));
+      const int mask = NearRounding128(channel);
+      if (mask != 0) {
+        Pixel original[4u];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(original), src);
+        FixLanes<ColorConverter::LogarithmicDepth>(mask, original, data + 4u * i);
+      }
+    }
+    ConvertPixels<ColorConverter::LogarithmicDepth>(data + 4u * i, count - i);
+  }
+
+  LIBCARLA_TARGET("sse4.1")
+  static void CityScapesPaletteSSE41(uint8_t *data, size_t count) {
+    const int32_t *table = GetPaletteTable();
+    const __m128i red_mask = _mm_set1_epi32(0xFF);
+    size_t i = 0u;
+    for (; i + 4u <= count; i += 4u) {
+      auto *pixels = reinterpret_cast<__m128i *>(data + 4u * i);
+      const __m128i tags = _mm_and_si128(_mm_srli_epi32(_mm_loadu_si128(pixels), 16), red_mask);
+      _mm_storeu_si128(pixels, _mm_setr_epi32(
+          table[_mm_extract_epi32(tags, 0)],
+          table[_mm_extract_epi32(tags, 1)],
+          table[_mm_extract_epi32(tags, 2)],
+          table[_mm_extract_epi32(tags, 3)]));
+    }
+    ConvertPixels<ColorConverter::CityScapesPalette>(data + 4u * i, count - i);
+  }
+
+  // ===========================================================================
+  // -- AVX2 kernels -----------------------------------------------------------
+  // ===========================================================================
+
+  LIBCARLA_TARGET("avx2")
+  static inline __m256 NormalizedDepth256(__m256i pixels) {
+    const __m256i to_depth = _mm256_setr_epi8(
+        2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1,
+        2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const __m256 depth = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pixels, to_depth));
+    return _mm256_div_ps(depth, _mm256_set1_ps(MAX_DEPTH));
+  }
+
+  LIBCARLA_TARGET("avx2")
+  static inline __m256 ChannelValue256(__m256 x) {
+    return _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f));
+  }
+
+  LIBCARLA_TARGET("avx2")
+  static inline __m256i GrayToBGRA256(__m256 channel) {
+    const __m256i to_bgr = _mm256_setr_epi8(
+        0, 0, 0, -1, 4, 4, 4, -1, 8, 8, 8, -1, 12, 12, 12, -1,
+        0, 0, 0, -1, 4, 4, 4, -1, 8, 8, 8, -1, 12, 12, 12, -1);
+    const __m256i alpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    return _mm256_or_si256(_mm256_shuffle_epi8(_mm256_cvttps_epi32(channel), to_bgr), alpha);
+  }
+
+  /// Same approximation as Log128.
+  LIBCARLA_TARGET("avx2")
+  static inline __m256 Log256(__m256 x) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    x = _mm256_max_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x00800000)));
+    const __m256i exponent = _mm256_sub_epi32(
+        _mm256_srli_epi32(_mm256_castps_si256(x), 23),
+        _mm256_set1_epi32(0x7F));
+    x = _mm256_or_ps(
+        _mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(~0x7F800000))),
+        _mm256_set1_ps(0.5f));
+    __m256 e = _mm256_add_ps(_mm256_cvtepi32_ps(exponent), one);
+    const __m256 mask = _mm256_cmp_ps(x, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+    const __m256 tmp = _mm256_and_ps(x, mask);
+    x = _mm256_sub_ps(x, one);
+    e = _mm256_sub_ps(e, _mm256_and_ps(one, mask));
+    x = _mm256_add_ps(x, tmp);
+    const __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(7.0376836292e-2f);
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(-1.1514610310e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.1676998740e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(-1.2420140846e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.4249322787e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(-1.6668057665e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(2.0000714765e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(-2.4999993993e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(3.3333331174e-1f));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+    y = _mm256_add_ps(y, _mm256_mul_ps(e, _mm256_set1_ps(-2.12194440e-4f)));
+    y = _mm256_sub_ps(y, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+    x = _mm256_add_ps(x, y);
+    return _mm256_add_ps(x, _mm256_mul_ps(e, _mm256_set1_ps(0.693359375f)));
+  }
+
+  LIBCARLA_TARGET("avx2")
+  static inline __m256 LogarithmicLinear256(__m256 depth) {
+    const __m256 value = _mm256_add_ps(
+        _mm256_set1_ps(1.0f),
+        _mm256_div_ps(Log256(depth), _mm256_set1_ps(LOGARITHMIC_SCALE)));
+    return _mm256_max_ps(
+        _mm256_min_ps(value, _mm256_set1_ps(1.0f)),
+        _mm256_set1_ps(MIN_LOGARITHMIC_VALUE));
+  }
+
+  LIBCARLA_TARGET("avx2")
+  static inline int NearRounding256(__m256 channel) {
+    const __m256 fraction = _mm256_sub_ps(channel, _mm256_floor_ps(channel));
+    return _mm256_movemask_ps(_mm256_or_ps(
+        _mm256_cmp_ps(fraction, _mm256_set1_ps(ROUNDING_MARGIN), _CMP_LT_OQ),
+        _mm256_cmp_ps(fraction, _mm256_set1_ps(1.0f - ROUNDING_MARGIN), _CMP_GT_OQ)));
+  }
+
+  LIBCARLA_TARGET("avx2")
+  static void DepthAVX2(uint8_t *data, size_t count) {
+    size_t i = 0u;
+    for (; i + 8u <= count; i += 8u) {
+      auto *pixels = reinterpret_cast<__m256i *>(data + 4u * i);
+      const __m256 depth = NormalizedDepth256(_mm256_loadu_si256(pixels));
+      _mm256_storeu_si256(pixels, GrayToBGRA256(ChannelValue256(depth)));
+    }
+    // The scalar tail and the code after the kernel use SSE encodings, which
+    // stall while the upper halves of the AVX registers are dirty.
+    _mm256_zeroupper();
+    ConvertPixels<ColorConverter::Depth>(data + 4u * i, count - i);
+  }
+
+  LIBCARLA_TARGET("avx2")
+  static void LogarithmicDepthAVX2(uint8_t *data, size_t count) {
+    size_t i = 0u;
+    for (; i + 8u <= count; i += 8u) {
+      auto *pixels = reinterpret_cast<__m256i *>(data + 4u * i);
+      const __m256i src = _mm256_loadu_si256(pixels);
+      const __m256 channel = ChannelValue256(LogarithmicLinear256(NormalizedDepth256(src)));
+      _mm256_storeu_si256(pixels, GrayToBGRA256(channel));
+      const int mask = NearRounding256(channel);
+      if (mask != 0) {
+        Pixel original[8u];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(original), src);
+        FixLanes<ColorConverter::LogarithmicDepth>(mask, original, data + 4u * i);
+      }
+    }
+    _mm256_zeroupper();
+    ConvertPixels<ColorConverter::LogarithmicDepth>(data + 4u * i, count - i);
+  }
+
+  LIBCARLA_TARGET("avx2")
+  static void CityScapesPaletteAVX2(uint8_t *data, size_t count) {
+    const int32_t *table = GetPaletteTable();
+    const __m256i red_mask = _mm256_set1_epi32(0xFF);
+    size_t i = 0u;
+    for (; i + 8u <= count; i += 8u) {
+      auto *pixels = reinterpret_cast<__m256i *>(data + 4u * i);
+      const __m256i tags = _mm256_and_si256(_mm256_srli_epi32(_mm256_loadu_si256(pixels), 16), red_mask);
+      _mm256_storeu_si256(pixels, _mm256_i32gather_epi32(table, tags, 4));
+    }
+    _mm256_zeroupper();
+    ConvertPixels<ColorConverter::CityScapesPalette>(data + 4u * i, count - i);
+  }
+
+  static InstructionSet DetectInstructionSet() {
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return InstructionSet::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+      return InstructionSet::SSE41;
+    }
+#else
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool has_sse41 = (info[2] & (1 << 19)) != 0;
+    // AVX registers must be enabled by the OS too.
+    const bool has_os_avx = ((info[2] & (1 << 27)) != 0) && ((_xgetbv(0) & 6u) == 6u);
+    if (has_os_avx && (max_leaf >= 7)) {
+      __cpuidex(info, 7, 0);
+      if ((info[1] & (1 << 5)) != 0) {
+        return InstructionSet::AVX2;
+      }
+    }
+    if (has_sse41) {
+      return InstructionSet::SSE41;
+    }
+#endif
+    return InstructionSet::Scalar;
+  }
+
+#else
+
+  static InstructionSet DetectInstructionSet() {
+    return InstructionSet::Scalar;
+  }
+
+#endif // LIBCARLA_COLOR_CONVERTER_WITH_SIMD
+
+  static Kernel GetKernel(ColorConverterKernels::Conversion conversion, InstructionSet instructions) {
+    using Conversion = ColorConverterKernels::Conversion;
+#ifdef LIBCARLA_COLOR_CONVERTER_WITH_SIMD
+    switch (instructions) {
+      case InstructionSet::AVX2:
+        switch (conversion) {
+          case Conversion::Depth:             return DepthAVX2;
+          case Conversion::LogarithmicDepth:  return LogarithmicDepthAVX2;
+          case Conversion::CityScapesPalette: return CityScapesPaletteAVX2;
+        }
+        break;
+      case InstructionSet::SSE41:
+        switch (conversion) {
+          case Conversion::Depth:             return DepthSSE41;
+          case Conversion::LogarithmicDepth:  return LogarithmicDepthSSE41;
+          case Conversion::CityScapesPalette: return CityScapesPaletteSSE41;
+        }
+        break;
+      case InstructionSet::Scalar:
+        break;
+    }
+#else
+    DEBUG_ASSERT(instructions == InstructionSet::Scalar);
+    (void) instructions;
+#endif // LIBCARLA_COLOR_CONVERTER_WITH_SIMD
+    switch (conversion) {
+      case Conversion::Depth:             return ConvertPixels<ColorConverter::Depth>;
+      case Conversion::LogarithmicDepth:  return ConvertPixels<ColorConverter::LogarithmicDepth>;
+      case Conversion::CityScapesPalette: return ConvertPixels<ColorConverter::CityScapesPalette>;
+    }
+    DEBUG_ERROR;
+    return ConvertPixels<ColorConverter::Depth>;
+  }
+
+  /// Below this number of pixels per thread, starting the threads costs more
+  /// than what they save.
+  static constexpr size_t MIN_PIXELS_PER_THREAD = 1u << 18u;
+
+  static size_t GetNumberOfThreads(size_t pixels) {
+    const size_t concurrency = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<size_t>(1u, std::min(concurrency, pixels / MIN_PIXELS_PER_THREAD));
+  }
+
+  ColorConverterKernels::InstructionSet ColorConverterKernels::GetSupportedInstructionSet() {
+    static const InstructionSet instructions = DetectInstructionSet();
+    return instructions;
+  }
+
+  void ColorConverterKernels::ConvertInPlace(
+      const Conversion conversion,
+      uint8_t *data,
+      size_t width,
+      size_t height,
+      const std::ptrdiff_t row_size,
+      const InstructionSet instructions) {
+    DEBUG_ASSERT(data != nullptr || width * height == 0u);
+    const Kernel kernel = GetKernel(conversion, instructions);
+    // Contiguous rows are converted as a single one.
+    if (row_size == static_cast<std::ptrdiff_t>(sizeof(Pixel) * width)) {
+      width *= height;
+      height = 1u;
+    }
+    const auto convert_rows = [=](size_t begin, size_t end) {
+      for (auto y = begin; y < end; ++y) {
+        kernel(data + static_cast<std::ptrdiff_t>(y) * row_size, width);
+      }
+    };
+    const size_t threads = GetNumberOfThreads(width * height);
+    if (threads == 1u) {
+      convert_rows(0u, height);
+      return;
+    }
+    ThreadGroup workers;
+    if (height == 1u) {
+      const size_t stripe = (width + threads - 1u) / threads;
+      for (size_t begin = 0u; begin < width; begin += stripe) {
+        const size_t count = std::min(stripe, width - begin);
+        workers.CreateThread([=]() { kernel(data + sizeof(Pixel) * begin, count); });
+      }
+    } else {
+      const size_t stripe = (height + threads - 1u) / threads;
+      for (size_t begin = 0u; begin < height; begin += stripe) {
+        const size_t end = std::min(begin + stripe, height);
+        workers.CreateThread([=]() { convert_rows(begin, end); });
+      }
+    }
+    workers.JoinAll();
+  }
+
+} // namespace image
+} // namespace carla
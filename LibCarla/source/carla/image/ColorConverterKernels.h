@@ -0,0 +1,51 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace carla {
+namespace image {
+
+  /// Vectorized implementations of the ColorConverter conversions for BGRA8
+  /// images. The results are the same as converting the pixels one by one
+  /// through the color-converted views of ImageView.
+  class ColorConverterKernels {
+  public:
+
+    enum class Conversion {
+      Depth,
+      LogarithmicDepth,
+      CityScapesPalette
+    };
+
+    enum class InstructionSet {
+      Scalar,
+      SSE41,
+      AVX2
+    };
+
+    /// Best instruction set supported by this CPU, detected once at runtime.
+    static InstructionSet GetSupportedInstructionSet();
+
+    /// Convert in place a BGRA8 image of @a width x @a height pixels, whose
+    /// rows are @a row_size bytes apart. Large images are split in stripes
+    /// converted in parallel.
+    ///
+    /// @pre @a instructions is supported by this CPU.
+    static void ConvertInPlace(
+        Conversion conversion,
+        uint8_t *data,
+        size_t width,
+        size_t height,
+        std::ptrdiff_t row_size,
+        InstructionSet instructions = GetSupportedInstructionSet());
+  };
+
+} // namespace image
+} // namespace carla
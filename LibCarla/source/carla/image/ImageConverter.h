@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "carla/image/ColorConverterKernels.h"
 #include "carla/image/ImageView.h"
 
 namespace carla {
@@ -28,6 +29,42 @@ namespace image {
           ImageView::MakeColorConvertedView<MutableImageView, DstPixelT>(image_view, converter),
           image_view);
     }
+
+    /// @name BGRA8 images
+    ///
+    /// Converted with the vectorized ColorConverterKernels, with the same
+    /// result as the color-converted view above.
+    /// @{
+
+    static void ConvertInPlace(boost::gil::bgra8_view_t &image_view, ColorConverter::Depth) {
+      ConvertInPlaceWithKernels(image_view, ColorConverterKernels::Conversion::Depth);
+    }
+
+    static void ConvertInPlace(boost::gil::bgra8_view_t &image_view, ColorConverter::LogarithmicDepth) {
+      ConvertInPlaceWithKernels(image_view, ColorConverterKernels::Conversion::LogarithmicDepth);
+    }
+
+    static void ConvertInPlace(boost::gil::bgra8_view_t &image_view, ColorConverter::CityScapesPalette) {
+      ConvertInPlaceWithKernels(image_view, ColorConverterKernels::Conversion::CityScapesPalette);
+    }
+
+    /// @}
+
+  private:
+
+    static void ConvertInPlaceWithKernels(
+        boost::gil::bgra8_view_t &image_view,
+        ColorConverterKernels::Conversion conversion) {
+      if (image_view.empty()) {
+        return;
+      }
+      ColorConverterKernels::ConvertInPlace(
+          conversion,
+          boost::gil::interleaved_view_get_raw_data(image_view),
+          static_cast<size_t>(image_view.width()),
+          static_cast<size_t>(image_view.height()),
+          image_view.pixels().row_size());
+    }
   };
 
 } // namespace image
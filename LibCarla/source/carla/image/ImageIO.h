@@ -21,7 +21,16 @@ namespace image {
 
     template <typename ViewT, typename IO = io::any>
     static std::string WriteView(std::string out_filename, const ViewT &image_view, IO = IO()) {
-      IO::write_view(out_filename, image_view);
+      return WriteView(std::move(out_filename), image_view, io::write_options(), IO());
+    }
+
+    template <typename ViewT, typename IO = io::any>
+    static std::string WriteView(
+        std::string out_filename,
+        const ViewT &image_view,
+        const io::write_options &options,
+        IO = IO()) {
+      IO::write_view(out_filename, image_view, options);
       return out_filename;
     }
   };
@@ -91,6 +91,15 @@ namespace io {
       "LIBCARLA_IMAGE_WITH_PNG_SUPPORT, LIBCARLA_IMAGE_WITH_JPEG_SUPPORT, "
       "or LIBCARLA_IMAGE_WITH_TIFF_SUPPORT");
 
+  /// Encoder settings used when writing images, each format takes the ones
+  /// that apply to it. The defaults match the ones of Boost.GIL.
+  struct write_options {
+    /// zlib compression level of PNG files, from 0 (none) to 9 (smallest).
+    int png_compression_level = 3;
+    /// Quality of JPEG files, from 0 to 100.
+    int jpeg_quality = 100;
+  };
+
 namespace detail {
 
   template <typename ViewT, typename IOTag>
@@ -119,8 +128,10 @@ namespace detail {
     }
 
     template <typename Str, typename ViewT>
-    static void write_view(Str &&out_filename, const ViewT &view) {
-      boost::gil::write_view(std::forward<Str>(out_filename), view, boost::gil::png_tag());
+    static void write_view(Str &&out_filename, const ViewT &view, const write_options &options) {
+      boost::gil::image_write_info<boost::gil::png_tag> info;
+      info._compression_level = options.png_compression_level;
+      boost::gil::write_view(std::forward<Str>(out_filename), view, info);
     }
 
 #endif // LIBCARLA_IMAGE_WITH_PNG_SUPPORT
@@ -149,17 +160,20 @@ namespace detail {
 
     template <typename Str, typename ViewT>
     static typename std::enable_if<is_write_supported<ViewT, boost::gil::jpeg_tag>::value>::type
-    write_view(Str &&out_filename, const ViewT &view) {
-      boost::gil::write_view(std::forward<Str>(out_filename), view, boost::gil::jpeg_tag());
+    write_view(Str &&out_filename, const ViewT &view, const write_options &options) {
+      boost::gil::write_view(
+          std::forward<Str>(out_filename),
+          view,
+          boost::gil::image_write_info<boost::gil::jpeg_tag>(options.jpeg_quality));
     }
 
     template <typename Str, typename ViewT>
     static typename std::enable_if<!is_write_supported<ViewT, boost::gil::jpeg_tag>::value>::type
-    write_view(Str &&out_filename, const ViewT &view) {
+    write_view(Str &&out_filename, const ViewT &view, const write_options &options) {
       boost::gil::write_view(
           std::forward<Str>(out_filename),
           boost::gil::color_converted_view<boost::gil::rgb8_pixel_t>(view),
-          boost::gil::jpeg_tag());
+          boost::gil::image_write_info<boost::gil::jpeg_tag>(options.jpeg_quality));
     }
 
 #endif // LIBCARLA_IMAGE_WITH_JPEG_SUPPORT
@@ -187,13 +201,13 @@ namespace detail {
 
     template <typename Str, typename ViewT>
     static typename std::enable_if<is_write_supported<ViewT, boost::gil::tiff_tag>::value>::type
-    write_view(Str &&out_filename, const ViewT &view) {
+    write_view(Str &&out_filename, const ViewT &view, const write_options &) {
       boost::gil::write_view(std::forward<Str>(out_filename), view, boost::gil::tiff_tag());
     }
 
     template <typename Str, typename ViewT>
     static typename std::enable_if<!is_write_supported<ViewT, boost::gil::tiff_tag>::value>::type
-    write_view(Str &&out_filename, const ViewT &view) {
+    write_view(Str &&out_filename, const ViewT &view, const write_options &) {
       boost::gil::write_view(
           std::forward<Str>(out_filename),
           boost::gil::color_converted_view<boost::gil::rgb8_pixel_t>(view),
@@ -680,8 +680,8 @@ namespace nav {
       }
       _walker_manager.RemoveWalker(id);
       // remove from mapping
-      _mapped_walkers_id.erase(it);
       _mapped_by_index.erase(it->second);
+      _mapped_walkers_id.erase(it);
 
       return true;
     }
@@ -696,8 +696,8 @@ namespace nav {
         _crowd->removeAgent(it->second);
       }
       // remove from mapping
-      _mapped_vehicles_id.erase(it);
       _mapped_by_index.erase(it->second);
+      _mapped_vehicles_id.erase(it);
 
       return true;
     }
@@ -832,6 +832,20 @@ namespace nav {
 
   // update all walkers in crowd
   void Navigation::UpdateCrowd(const client::detail::EpisodeState &state) {
+    StepCrowd(state, nullptr);
+  }
+
+  // update all walkers in crowd and read their state
+  void Navigation::UpdateCrowd(const client::detail::EpisodeState &state, std::vector<WalkerState> &walkers) {
+    StepCrowd(state, &walkers);
+  }
+
+  // update the crowd, and read the walkers if requested
+  void Navigation::StepCrowd(const client::detail::EpisodeState &state, std::vector<WalkerState> *walkers) {
+
+    if (walkers != nullptr) {
+      walkers->clear();
+    }
 
     // check if all is ready
     if (!_ready) {
@@ -853,72 +867,103 @@ namespace nav {
 
     // update the time to check for blocked agents
     _time_to_unblock += _delta_seconds;
+    const bool check_blocked = (_time_to_unblock >= AGENT_UNBLOCK_TIME);
 
-    // check all active agents
-    int total_unblocked = 0;
-    int total_agents;
+    // read all the agents in a single pass, the blocked ones get a new target
+    // later, as that queries the navmesh again
+    std::vector<int> blocked;
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      total_agents = _crowd->getAgentCount();
-    }
-    const dtCrowdAgent *ag;
-    for (int i = 0; i < total_agents; ++i) {
-      {
-        // critical section, force single thread running this
-        std::lock_guard<std::mutex> lock(_mutex);
-        ag = _crowd->getAgent(i);
+      const int total_agents = _crowd->getAgentCount();
+      if (walkers != nullptr) {
+        walkers->reserve(_mapped_walkers_id.size());
       }
+      for (int i = 0; i < total_agents; ++i) {
+        const dtCrowdAgent *agent = _crowd->getAgent(i);
 
-      if (!ag->active || ag->paused || ag->dead) {
-        continue;
-      }
+        // only pedestrians, no vehicles
+        if (!agent->active || agent->params.useObb) {
+          continue;
+        }
 
-      // check only pedestrians not paused, and no vehicles
-      if (!ag->params.useObb && !ag->paused) {
-        bool reset_target_pos = false;
-        bool use_same_filter = false;
+        if (walkers != nullptr) {
+          auto it = _mapped_by_index.find(i);
+          if (it != _mapped_by_index.end()) {
+            WalkerState walker;
+            walker.id = it->second;
+            ReadWalkerTransform(*agent, walker.id, walker.transform);
+            walker.speed = GetAgentSpeed(*agent);
+            walker.alive = !agent->dead;
+            walkers->emplace_back(walker);
+          }
+        }
 
-        // check for unblocking actors
-        if (_time_to_unblock >= AGENT_UNBLOCK_TIME) {
+        // check for unblocking actors, only the ones not paused
+        if (check_blocked && !agent->paused && !agent->dead) {
           // get the distance moved by each actor
           carla::geom::Vector3D previous = _walkers_blocked_position[i];
-          carla::geom::Vector3D current = carla::geom::Vector3D(ag->npos[0], ag->npos[1], ag->npos[2]);
+          carla::geom::Vector3D current = carla::geom::Vector3D(agent->npos[0], agent->npos[1], agent->npos[2]);
           carla::geom::Vector3D distance = current - previous;
-          float d = distance.SquaredLength();
-          if (d < AGENT_UNBLOCK_DISTANCE_SQUARED) {
-            ++total_unblocked;
-            reset_target_pos = true;
-            use_same_filter = true;
+          if (distance.SquaredLength() < AGENT_UNBLOCK_DISTANCE_SQUARED) {
+            blocked.emplace_back(i);
           }
           // update with current position
           _walkers_blocked_position[i] = current;
-
-          // check to assign a new target position
-          if (reset_target_pos) {
-            // set if the agent can cross roads or not
-            if (!use_same_filter) {
-              if (frand() <= _probability_crossing) {
-                SetAgentFilter(i, 1);
-              } else {
-                SetAgentFilter(i, 0);
-              }
-            }
-            // set a new random target
-            carla::geom::Location location;
-            GetRandomLocation(location, nullptr);
-            _walker_manager.SetWalkerRoute(_mapped_by_index[i], location);
-          }
         }
       }
     }
 
+    // set a new random target to the blocked agents, keeping their filter
+    for (int i : blocked) {
+      carla::geom::Location location;
+      GetRandomLocation(location, nullptr);
+      _walker_manager.SetWalkerRoute(_mapped_by_index[i], location);
+    }
+
     // check for resetting time
-    if (_time_to_unblock >= AGENT_UNBLOCK_TIME) {
+    if (check_blocked) {
       _time_to_unblock = 0.0f;
     }
   }
 
+  // compute the transform of an agent in Unreal coordinates, interpolating
+  // its yaw from the previous tick
+  void Navigation::ReadWalkerTransform(const dtCrowdAgent &agent, ActorId id, carla::geom::Transform &trans) {
+
+    // set its position in Unreal coordinates
+    trans.location.x = agent.npos[0];
+    trans.location.y = agent.npos[2];
+    trans.location.z = agent.npos[1];
+
+    // set its rotation
+    float yaw;
+    float speed = 0.0f;
+    float min = 0.1f;
+    if (agent.vel[0] < -min || agent.vel[0] > min ||
+        agent.vel[2] < -min || agent.vel[2] > min) {
+      yaw = atan2f(agent.vel[2], agent.vel[0]) * (180.0f / static_cast<float>(M_PI));
+      speed = sqrtf(agent.vel[0] * agent.vel[0] + agent.vel[1] * agent.vel[1] + agent.vel[2] * agent.vel[2]);
+    } else {
+      yaw = atan2f(agent.dvel[2], agent.dvel[0]) * (180.0f / static_cast<float>(M_PI));
+      speed = sqrtf(agent.dvel[0] * agent.dvel[0] + agent.dvel[1] * agent.dvel[1] + agent.dvel[2] * agent.dvel[2]);
+    }
+
+    // interpolate current and target angle
+    float &previous_yaw = _yaw_walkers[id];
+    float shortest_angle = fmod(yaw - previous_yaw + 540.0f, 360.0f) - 180.0f;
+    float per = (speed / 1.5f);
+    if (per > 1.0f) per = 1.0f;
+    float rotation_speed = per * 6.0f;
+    trans.rotation.yaw = previous_yaw +
+    (shortest_angle * rotation_speed * static_cast<float>(_delta_seconds));
+    previous_yaw = trans.rotation.yaw;
+  }
+
+  float Navigation::GetAgentSpeed(const dtCrowdAgent &agent) {
+    return sqrtf(agent.vel[0] * agent.vel[0] + agent.vel[1] * agent.vel[1] + agent.vel[2] * agent.vel[2]);
+  }
+
   // get the walker current transform
   bool Navigation::GetWalkerTransform(ActorId id, carla::geom::Transform &trans) {
 
@@ -953,32 +998,7 @@ namespace nav {
       return false;
     }
 
-    // set its position in Unreal coordinates
-    trans.location.x = agent->npos[0];
-    trans.location.y = agent->npos[2];
-    trans.location.z = agent->npos[1];
-
-    // set its rotation
-    float yaw;
-    float speed = 0.0f;
-    float min = 0.1f;
-    if (agent->vel[0] < -min || agent->vel[0] > min ||
-        agent->vel[2] < -min || agent->vel[2] > min) {
-      yaw = atan2f(agent->vel[2], agent->vel[0]) * (180.0f / static_cast<float>(M_PI));
-      speed = sqrtf(agent->vel[0] * agent->vel[0] + agent->vel[1] * agent->vel[1] + agent->vel[2] * agent->vel[2]);
-    } else {
-      yaw = atan2f(agent->dvel[2], agent->dvel[0]) * (180.0f / static_cast<float>(M_PI));
-      speed = sqrtf(agent->dvel[0] * agent->dvel[0] + agent->dvel[1] * agent->dvel[1] + agent->dvel[2] * agent->dvel[2]);
-    }
-
-    // interpolate current and target angle
-    float shortest_angle = fmod(yaw - _yaw_walkers[id] + 540.0f, 360.0f) - 180.0f;
-    float per = (speed / 1.5f);
-    if (per > 1.0f) per = 1.0f;
-    float rotation_speed = per * 6.0f;
-    trans.rotation.yaw = _yaw_walkers[id] +
-    (shortest_angle * rotation_speed * static_cast<float>(_delta_seconds));
-    _yaw_walkers[id] = trans.rotation.yaw;
+    ReadWalkerTransform(*agent, id, trans);
 
     return true;
   }
@@ -1054,8 +1074,7 @@ namespace nav {
       agent = _crowd->getAgent(index);
     }
 
-    return sqrt(agent->vel[0] * agent->vel[0] + agent->vel[1] * agent->vel[1] + agent->vel[2] *
-    agent->vel[2]);
+    return GetAgentSpeed(*agent);
   }
 
   // get a random location for navigation
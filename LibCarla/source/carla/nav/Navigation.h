@@ -50,6 +50,14 @@ namespace nav {
     carla::geom::BoundingBox bounding;
   };
 
+  /// state of a walker after a crowd update, in Unreal coordinates
+  struct WalkerState {
+    carla::rpc::ActorId id;
+    carla::geom::Transform transform;
+    float speed;
+    bool alive;
+  };
+
   /// Manage the pedestrians navigation, using the Recast & Detour library for low level calculations.
   ///
   /// This class gets the binary content of the map from the server, which is required for the path finding.
@@ -100,6 +108,9 @@ namespace nav {
     float GetWalkerSpeed(ActorId id);
     /// update all walkers in crowd
     void UpdateCrowd(const client::detail::EpisodeState &state);
+    /// update all walkers in crowd and return the state of each one in
+    /// @a walkers, reading the whole crowd at once
+    void UpdateCrowd(const client::detail::EpisodeState &state, std::vector<WalkerState> &walkers);
     /// get a random location for navigation
     bool GetRandomLocation(carla::geom::Location &location, dtQueryFilter * filter = nullptr) const;
     /// set the probability that an agent could cross the roads in its path following
@@ -150,6 +161,12 @@ namespace nav {
 
     /// assign a filter index to an agent
     void SetAgentFilter(int agent_index, int filter_index);
+    /// update the crowd, and read the walkers if @a walkers is not null
+    void StepCrowd(const client::detail::EpisodeState &state, std::vector<WalkerState> *walkers);
+    /// get the transform of an agent, updating its yaw angle
+    void ReadWalkerTransform(const dtCrowdAgent &agent, ActorId id, carla::geom::Transform &trans);
+    /// get the speed of an agent
+    static float GetAgentSpeed(const dtCrowdAgent &agent);
   };
 
 } // namespace nav
@@ -25,6 +25,12 @@ namespace carla {
 namespace opendrive {
 
   boost::optional<road::Map> OpenDriveParser::Load(const std::string &opendrive) {
+    return Load(opendrive, road::element::GeometryLookupTableSettings{});
+  }
+
+  boost::optional<road::Map> OpenDriveParser::Load(
+      const std::string &opendrive,
+      const road::element::GeometryLookupTableSettings &geometry_settings) {
     pugi::xml_document xml;
     pugi::xml_parse_result parse_result = xml.load_string(opendrive.c_str());
 
@@ -34,6 +40,7 @@ namespace opendrive {
     }
 
     carla::road::MapBuilder map_builder;
+    map_builder.SetGeometryLookupTableSettings(geometry_settings);
 
     parser::GeoReferenceParser::Parse(xml, map_builder);
     parser::RoadParser::Parse(xml, map_builder);
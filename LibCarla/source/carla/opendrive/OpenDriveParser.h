@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/road/Map.h"
+#include "carla/road/element/Geometry.h"
 
 #include <boost/optional.hpp>
 
@@ -19,6 +20,12 @@ namespace opendrive {
   public:
 
     static boost::optional<road::Map> Load(const std::string &opendrive);
+
+    /// Same as Load, with custom settings for the arc-length lookup tables
+    /// of the road geometries.
+    static boost::optional<road::Map> Load(
+        const std::string &opendrive,
+        const road::element::GeometryLookupTableSettings &geometry_settings);
   };
 
 } // namespace opendrive
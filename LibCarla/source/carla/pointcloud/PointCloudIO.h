@@ -11,39 +11,88 @@
 #include <fstream>
 #include <iterator>
 #include <iomanip>
+#include <memory>
+#include <type_traits>
 
 namespace carla {
 namespace pointcloud {
 
+  class PointCloudWriter;
+
   class PointCloudIO {
 
   public:
+
+    enum class Format {
+      Ascii,
+      /// The points are written as laid out in memory, which is little-endian
+      /// in every platform CARLA runs on.
+      BinaryLittleEndian
+    };
+
     template <typename PointIt>
-    static void Dump(std::ostream &out, PointIt begin, PointIt end) {
-      WriteHeader(out, begin, end);
-      for (; begin != end; ++begin) {
-        begin->WriteDetection(out);
-        out << '\n';
-      }
+    static void Dump(std::ostream &out, PointIt begin, PointIt end, Format format = Format::Ascii) {
+      DEBUG_ASSERT(std::distance(begin, end) >= 0);
+      using PointT = typename std::iterator_traits<PointIt>::value_type;
+      WriteHeader<PointT>(out, format, std::to_string(static_cast<size_t>(std::distance(begin, end))));
+      WritePoints(out, begin, end, format);
     }
 
     template <typename PointIt>
-    static std::string SaveToDisk(std::string path, PointIt begin, PointIt end) {
+    static std::string SaveToDisk(std::string path, PointIt begin, PointIt end, Format format = Format::Ascii) {
       FileSystem::ValidateFilePath(path, ".ply");
-      std::ofstream out(path);
-      Dump(out, begin, end);
+      std::ofstream out(path, GetOpenMode(format));
+      Dump(out, begin, end, format);
       return path;
     }
 
   private:
-    template <typename PointIt> static void WriteHeader(std::ostream &out, PointIt begin, PointIt end) {
-      DEBUG_ASSERT(std::distance(begin, end) >= 0);
+
+    friend PointCloudWriter;
+
+    static std::ios::openmode GetOpenMode(Format format) {
+      return format == Format::Ascii ? std::ios::out : (std::ios::out | std::ios::binary);
+    }
+
+    template <typename PointT>
+    static void WriteHeader(std::ostream &out, Format format, const std::string &vertex_count) {
       out << "ply\n"
-           "format ascii 1.0\n"
-           "element vertex " << std::to_string(static_cast<size_t>(std::distance(begin, end))) << "\n";
-      begin->WritePlyHeaderInfo(out);
+           "format " << (format == Format::Ascii ? "ascii" : "binary_little_endian") << " 1.0\n"
+           "element vertex " << vertex_count << "\n";
+      PointT{}.WritePlyHeaderInfo(out);
       out << "\nend_header\n";
-      out << std::fixed << std::setprecision(4u);
+      if (format == Format::Ascii) {
+        out << std::fixed << std::setprecision(4u);
+      }
+    }
+
+    template <typename PointIt>
+    static void WritePoints(std::ostream &out, PointIt begin, PointIt end, Format format) {
+      if (format == Format::Ascii) {
+        for (; begin != end; ++begin) {
+          begin->WriteDetection(out);
+          out << '\n';
+        }
+      } else {
+        WriteBinary(out, begin, end);
+      }
+    }
+
+    /// Contiguous points are written with a single call.
+    template <typename PointT>
+    static void WriteBinary(std::ostream &out, PointT *begin, PointT *end) {
+      static_assert(std::is_trivially_copyable<std::remove_cv_t<PointT>>::value, "Invalid point type.");
+      out.write(
+          reinterpret_cast<const char *>(begin),
+          static_cast<std::streamsize>(sizeof(PointT)) * (end - begin));
+    }
+
+    template <typename PointIt>
+    static void WriteBinary(std::ostream &out, PointIt begin, PointIt end) {
+      for (; begin != end; ++begin) {
+        const auto *point = std::addressof(*begin);
+        WriteBinary(out, point, point + 1);
+      }
     }
   };
 
@@ -0,0 +1,132 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Exception.h"
+#include "carla/NonCopyable.h"
+#include "carla/pointcloud/PointCloudIO.h"
+
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace carla {
+namespace pointcloud {
+
+  /// Appends the points of many sweeps to a single PLY file, which stays open
+  /// between sweeps. The vertex count in the header is rewritten after each
+  /// sweep, so the file can be read at any time. Thread-safe.
+  class PointCloudWriter : private NonCopyable {
+  public:
+
+    using Format = PointCloudIO::Format;
+
+    explicit PointCloudWriter(std::string path, Format format = Format::BinaryLittleEndian)
+      : _format(format) {
+      FileSystem::ValidateFilePath(path, ".ply");
+      // Always binary, text mode would break the offsets of the header.
+      _out.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!_out.is_open()) {
+        throw_exception(std::runtime_error("unable to open " + path));
+      }
+      _path = std::move(path);
+    }
+
+    const std::string &GetPath() const {
+      return _path;
+    }
+
+    Format GetFormat() const {
+      return _format;
+    }
+
+    size_t GetPointCount() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _point_count;
+    }
+
+    /// Append the points in [begin, end). All the sweeps written to the same
+    /// file must have the same point type.
+    template <typename PointIt>
+    void Write(PointIt begin, PointIt end) {
+      using PointT = typename std::iterator_traits<PointIt>::value_type;
+      DEBUG_ASSERT(std::distance(begin, end) >= 0);
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!_out.is_open()) {
+        throw_exception(std::runtime_error(_path + ": writer is closed"));
+      }
+      if (_header.empty()) {
+        WriteHeader<PointT>();
+      } else if (_header != MakeHeader<PointT>(_format)) {
+        throw_exception(std::invalid_argument(_path + ": all the sweeps must have the same point type"));
+      }
+      PointCloudIO::WritePoints(_out, begin, end, _format);
+      _point_count += static_cast<size_t>(std::distance(begin, end));
+      UpdateVertexCount();
+    }
+
+    void Flush() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _out.flush();
+    }
+
+    void Close() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _out.close();
+    }
+
+  private:
+
+    /// Width reserved for the vertex count, enough for any size_t.
+    static constexpr size_t VERTEX_COUNT_WIDTH = 20u;
+
+    template <typename PointT>
+    static std::string MakeHeader(Format format) {
+      std::ostringstream header;
+      PointCloudIO::WriteHeader<PointT>(header, format, std::string(VERTEX_COUNT_WIDTH, ' '));
+      return header.str();
+    }
+
+    template <typename PointT>
+    void WriteHeader() {
+      _header = MakeHeader<PointT>(_format);
+      _vertex_count_position = static_cast<std::streamoff>(_header.find("element vertex ") + 15u);
+      _out << _header;
+      if (_format == Format::Ascii) {
+        _out << std::fixed << std::setprecision(4u);
+      }
+    }
+
+    /// PLY readers split the header in whitespace, so the count is padded with
+    /// trailing spaces.
+    void UpdateVertexCount() {
+      std::string count = std::to_string(_point_count);
+      count.resize(VERTEX_COUNT_WIDTH, ' ');
+      const auto end = _out.tellp();
+      _out.seekp(_vertex_count_position);
+      _out << count;
+      _out.seekp(end);
+    }
+
+    mutable std::mutex _mutex;
+
+    std::ofstream _out;
+
+    std::string _path;
+
+    const Format _format;
+
+    std::string _header;
+
+    std::streamoff _vertex_count_position = 0;
+
+    size_t _point_count = 0u;
+  };
+
+} // namespace pointcloud
+} // namespace carla
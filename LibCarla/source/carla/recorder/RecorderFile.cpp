@@ -0,0 +1,471 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/recorder/RecorderFile.h"
+
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace carla {
+namespace recorder {
+
+  namespace bip = boost::interprocess;
+
+  static constexpr char INDEX_MAGIC[8] = {'C', 'R', 'E', 'C', 'I', 'D', 'X', '\0'};
+
+  static constexpr uint32_t INDEX_VERSION = 1u;
+
+  static constexpr size_t FRAME_RECORD_SIZE =
+      sizeof(uint64_t) + sizeof(double) + sizeof(double);
+
+  static constexpr size_t INDEX_ENTRY_SIZE =
+      sizeof(uint64_t) + sizeof(double) + sizeof(double) + sizeof(uint64_t) + sizeof(uint32_t);
+
+  // ===========================================================================
+  // -- Reader -----------------------------------------------------------------
+  // ===========================================================================
+
+  /// Bounds-checked reads of unaligned values. Reading past the end marks the
+  /// reader as failed and returns zeros.
+  class Reader {
+  public:
+
+    Reader(const uint8_t *data, size_t size) : _data(data), _size(size) {}
+
+    template <typename T>
+    T Read() {
+      T value{};
+      if (Require(sizeof(T))) {
+        std::memcpy(&value, _data + _offset, sizeof(T));
+        _offset += sizeof(T);
+      }
+      return value;
+    }
+
+    geom::Vector3D ReadVector() {
+      const float x = Read<float>();
+      const float y = Read<float>();
+      const float z = Read<float>();
+      return {x, y, z};
+    }
+
+    std::string ReadString() {
+      const auto length = Read<uint16_t>();
+      std::string result;
+      if (Require(length)) {
+        result.assign(reinterpret_cast<const char *>(_data + _offset), length);
+        _offset += length;
+      }
+      return result;
+    }
+
+    size_t GetOffset() const {
+      return _offset;
+    }
+
+    bool Good() const {
+      return _good;
+    }
+
+  private:
+
+    bool Require(size_t size) {
+      _good = _good && (size <= _size - _offset);
+      return _good;
+    }
+
+    const uint8_t *_data;
+
+    size_t _size;
+
+    size_t _offset = 0u;
+
+    bool _good = true;
+  };
+
+  static RecorderActor ReadEventAdd(Reader &in) {
+    RecorderActor actor;
+    actor.id = in.Read<uint32_t>();
+    actor.type = in.Read<uint8_t>();
+    actor.location = in.ReadVector();
+    actor.rotation = in.ReadVector();
+    in.Read<uint32_t>(); // description uid
+    actor.type_id = in.ReadString();
+    const auto attributes = in.Read<uint16_t>();
+    for (auto i = 0u; i < attributes && in.Good(); ++i) {
+      in.Read<uint8_t>();
+      in.ReadString();
+      in.ReadString();
+    }
+    return actor;
+  }
+
+  // ===========================================================================
+  // -- RecorderFile -----------------------------------------------------------
+  // ===========================================================================
+
+  struct RecorderFile::Mapping {
+    bip::file_mapping file;
+    bip::mapped_region region;
+
+    explicit Mapping(const std::string &path)
+      : file(path.c_str(), bip::read_only),
+        region(file, bip::read_only) {}
+  };
+
+  RecorderFile::RecorderFile(const std::string &path, const bool use_index_file)
+    : _path(path) {
+    try {
+      _mapping = std::make_unique<Mapping>(path);
+    } catch (const std::exception &e) {
+      throw_exception(std::runtime_error("cannot open recorder file " + path + ": " + e.what()));
+    }
+    _data = static_cast<const uint8_t *>(_mapping->region.get_address());
+    _size = _mapping->region.get_size();
+    ReadInfo();
+    if (!use_index_file || !ReadIndexFile()) {
+      BuildIndex();
+    }
+  }
+
+  RecorderFile::~RecorderFile() = default;
+
+  std::string RecorderFile::GetIndexFilePath(const std::string &path) {
+    return path + ".idx";
+  }
+
+  void RecorderFile::ReadInfo() {
+    Reader in{_data, _size};
+    _info.version = in.Read<uint16_t>();
+    _info.magic = in.ReadString();
+    _info.date = static_cast<std::time_t>(in.Read<int64_t>());
+    _info.map_file = in.ReadString();
+    if (!in.Good() || _info.magic != "CARLA_RECORDER") {
+      throw_exception(std::runtime_error(_path + " is not a CARLA recorder file"));
+    }
+    _first_packet = in.GetOffset();
+  }
+
+  void RecorderFile::BuildIndex() {
+    _frames.clear();
+    RecorderFrame frame{};
+    bool in_frame = false;
+    size_t offset = _first_packet;
+    while (offset + PacketHeaderSize <= _size) {
+      const uint8_t id = _data[offset];
+      uint32_t size;
+      std::memcpy(&size, _data + offset + 1u, sizeof(size));
+      const size_t payload = offset + PacketHeaderSize;
+      if (size > _size - payload) {
+        break;
+      }
+      if (id == static_cast<uint8_t>(PacketId::FrameStart)) {
+        Reader in{_data + payload, size};
+        frame.id = in.Read<uint64_t>();
+        frame.duration = in.Read<double>();
+        frame.elapsed = in.Read<double>();
+        frame.offset = offset;
+        frame.packets = 0u;
+        in_frame = in.Good();
+      } else if (id == static_cast<uint8_t>(PacketId::FrameEnd)) {
+        if (in_frame) {
+          _frames.emplace_back(frame);
+        }
+        in_frame = false;
+      } else if (in_frame && id < static_cast<uint8_t>(PacketId::SIZE) && size > sizeof(uint16_t)) {
+        // A packet with just its count of records holds no data.
+        frame.packets |= PacketMask(static_cast<PacketId>(id));
+      }
+      offset = payload + size;
+    }
+    // The duration of each frame is written when the next one starts, the
+    // last one keeps a placeholder.
+    if (!_frames.empty() && _frames.back().duration < 0.0) {
+      _frames.back().duration = 0.0;
+    }
+  }
+
+  bool RecorderFile::ReadIndexFile() {
+    std::ifstream file(GetIndexFilePath(_path), std::ios::binary);
+    if (!file.is_open()) {
+      return false;
+    }
+    std::vector<uint8_t> buffer{
+        std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>()};
+    Reader in{buffer.data(), buffer.size()};
+    char magic[sizeof(INDEX_MAGIC)];
+    for (auto &c : magic) {
+      c = in.Read<char>();
+    }
+    const auto version = in.Read<uint32_t>();
+    const auto size = in.Read<uint64_t>();
+    const auto date = in.Read<int64_t>();
+    const auto count = in.Read<uint64_t>();
+    if (!in.Good() ||
+        !std::equal(std::begin(magic), std::end(magic), std::begin(INDEX_MAGIC)) ||
+        (version != INDEX_VERSION) ||
+        (size != _size) ||
+        (date != static_cast<int64_t>(_info.date)) ||
+        (count > buffer.size() / INDEX_ENTRY_SIZE)) {
+      return false;
+    }
+    std::vector<RecorderFrame> frames;
+    frames.reserve(count);
+    size_t previous = 0u;
+    for (auto i = 0u; i < count; ++i) {
+      RecorderFrame frame;
+      frame.id = in.Read<uint64_t>();
+      frame.duration = in.Read<double>();
+      frame.elapsed = in.Read<double>();
+      frame.offset = in.Read<uint64_t>();
+      frame.packets = in.Read<uint32_t>();
+      // Each entry must point at the FrameStart packet of the same frame.
+      uint64_t id;
+      if (!in.Good() ||
+          (frame.offset < _first_packet) ||
+          (frame.offset < previous) ||
+          (frame.offset + PacketHeaderSize + FRAME_RECORD_SIZE > _size) ||
+          (_data[frame.offset] != static_cast<uint8_t>(PacketId::FrameStart))) {
+        log_warning("ignoring invalid recorder index file", GetIndexFilePath(_path));
+        return false;
+      }
+      std::memcpy(&id, _data + frame.offset + PacketHeaderSize, sizeof(id));
+      if (id != frame.id) {
+        log_warning("ignoring outdated recorder index file", GetIndexFilePath(_path));
+        return false;
+      }
+      previous = frame.offset + 1u;
+      frames.emplace_back(frame);
+    }
+    _frames = std::move(frames);
+    _index_from_file = true;
+    return true;
+  }
+
+  bool RecorderFile::WriteIndexFile() const {
+    std::ofstream file(GetIndexFilePath(_path), std::ios::trunc | std::ios::binary);
+    auto write = [&](const auto &value) {
+      file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    file.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    write(INDEX_VERSION);
+    write(static_cast<uint64_t>(_size));
+    write(static_cast<int64_t>(_info.date));
+    write(static_cast<uint64_t>(_frames.size()));
+    for (const auto &frame : _frames) {
+      write(frame.id);
+      write(frame.duration);
+      write(frame.elapsed);
+      write(frame.offset);
+      write(frame.packets);
+    }
+    return file.good();
+  }
+
+  size_t RecorderFile::FindFrameByTime(const double seconds) const {
+    auto it = std::lower_bound(_frames.begin(), _frames.end(), seconds,
+        [](const RecorderFrame &frame, double time) { return frame.elapsed < time; });
+    return static_cast<size_t>(it - _frames.begin());
+  }
+
+  size_t RecorderFile::FindFrameById(const uint64_t frame_id) const {
+    auto it = std::lower_bound(_frames.begin(), _frames.end(), frame_id,
+        [](const RecorderFrame &frame, uint64_t id) { return frame.id < id; });
+    if ((it == _frames.end()) || (it->id != frame_id)) {
+      return _frames.size();
+    }
+    return static_cast<size_t>(it - _frames.begin());
+  }
+
+  std::vector<RecorderActor> RecorderFile::GetActors() const {
+    std::vector<RecorderActor> actors;
+    ForEachPacket(0u, _frames.size(), PacketMask(PacketId::EventAdd),
+        [&](const RecorderFrame &, PacketId, const uint8_t *data, uint32_t size) {
+      Reader in{data, size};
+      const auto total = in.Read<uint16_t>();
+      for (auto i = 0u; i < total && in.Good(); ++i) {
+        auto actor = ReadEventAdd(in);
+        if (in.Good()) {
+          actors.emplace_back(std::move(actor));
+        }
+      }
+    });
+    return actors;
+  }
+
+  std::vector<RecorderCollision> RecorderFile::QueryCollisions(
+      const char category1,
+      const char category2) const {
+    struct ActorInfo {
+      char category;
+      std::string type_id;
+    };
+    std::unordered_map<uint32_t, ActorInfo> actors;
+    auto get_actor = [&](uint32_t id) -> const ActorInfo & {
+      static const ActorInfo other{'o', ""};
+      auto it = actors.find(id);
+      return (it != actors.end()) ? it->second : other;
+    };
+    auto category_of = [](uint8_t type) {
+      switch (type) {
+        case 1u: return 'v';
+        case 2u: return 'w';
+        case 3u: return 't';
+        default: return 'o';
+      }
+    };
+    auto passes = [](char filter, char category, bool is_hero) {
+      return (filter == 'a') || (filter == category) || (filter == 'h' && is_hero);
+    };
+
+    struct PairHash {
+      size_t operator()(const std::pair<uint32_t, uint32_t> &pair) const {
+        return (static_cast<size_t>(pair.first) << 32u) ^ pair.second;
+      }
+    };
+    using CollisionSet = std::unordered_set<std::pair<uint32_t, uint32_t>, PairHash>;
+    CollisionSet previous_collisions;
+    CollisionSet current_collisions;
+    uint64_t current_frame = 0u;
+
+    std::vector<RecorderCollision> result;
+    const uint32_t mask =
+        PacketMask(PacketId::EventAdd) |
+        PacketMask(PacketId::EventDel) |
+        PacketMask(PacketId::Collision);
+    ForEachPacket(0u, _frames.size(), mask,
+        [&](const RecorderFrame &frame, PacketId id, const uint8_t *data, uint32_t size) {
+      Reader in{data, size};
+      const auto total = in.Read<uint16_t>();
+      if (id == PacketId::EventAdd) {
+        for (auto i = 0u; i < total && in.Good(); ++i) {
+          auto actor = ReadEventAdd(in);
+          actors[actor.id] = ActorInfo{category_of(actor.type), std::move(actor.type_id)};
+        }
+      } else if (id == PacketId::EventDel) {
+        for (auto i = 0u; i < total && in.Good(); ++i) {
+          actors.erase(in.Read<uint32_t>());
+        }
+      } else {
+        // A collision continues only if it was also in the previous frame,
+        // frames without collisions are not visited.
+        if (frame.id != current_frame) {
+          const bool consecutive = (frame.id == current_frame + 1u);
+          previous_collisions = consecutive ? std::move(current_collisions) : CollisionSet{};
+          current_collisions.clear();
+          current_frame = frame.id;
+        }
+        for (auto i = 0u; i < total && in.Good(); ++i) {
+          in.Read<uint32_t>(); // collision id
+          const auto id1 = in.Read<uint32_t>();
+          const auto id2 = in.Read<uint32_t>();
+          const auto hero1 = in.Read<bool>();
+          const auto hero2 = in.Read<bool>();
+          const ActorInfo &actor1 = get_actor(id1);
+          const ActorInfo &actor2 = get_actor(id2);
+          if (!in.Good() ||
+              !passes(category1, actor1.category, hero1) ||
+              !passes(category2, actor2.category, hero2)) {
+            continue;
+          }
+          const auto pair = std::make_pair(id1, id2);
+          if (previous_collisions.count(pair) == 0u) {
+            result.emplace_back(RecorderCollision{
+                frame.id, frame.elapsed,
+                id1, id2,
+                actor1.category, actor2.category,
+                actor1.type_id, actor2.type_id});
+          }
+          current_collisions.insert(pair);
+        }
+      }
+    });
+    return result;
+  }
+
+  std::vector<RecorderBlockedActor> RecorderFile::QueryBlocked(
+      const double min_time,
+      const double min_distance) const {
+    struct ActorInfo {
+      std::string type_id;
+      geom::Vector3D last_position;
+      double time = 0.0;
+      double duration = 0.0;
+    };
+    std::unordered_map<uint32_t, ActorInfo> actors;
+    std::multimap<double, RecorderBlockedActor, std::greater<double>> blocked;
+    auto add_if_blocked = [&](uint32_t id, const ActorInfo &actor) {
+      if (actor.duration >= min_time) {
+        blocked.emplace(actor.duration, RecorderBlockedActor{id, actor.type_id, actor.time, actor.duration});
+      }
+    };
+
+    const uint32_t mask =
+        PacketMask(PacketId::EventAdd) |
+        PacketMask(PacketId::EventDel) |
+        PacketMask(PacketId::Position);
+    ForEachPacket(0u, _frames.size(), mask,
+        [&](const RecorderFrame &frame, PacketId id, const uint8_t *data, uint32_t size) {
+      Reader in{data, size};
+      const auto total = in.Read<uint16_t>();
+      if (id == PacketId::EventAdd) {
+        for (auto i = 0u; i < total && in.Good(); ++i) {
+          auto actor = ReadEventAdd(in);
+          actors[actor.id].type_id = std::move(actor.type_id);
+        }
+      } else if (id == PacketId::EventDel) {
+        for (auto i = 0u; i < total && in.Good(); ++i) {
+          actors.erase(in.Read<uint32_t>());
+        }
+      } else {
+        for (auto i = 0u; i < total && in.Good(); ++i) {
+          const auto actor_id = in.Read<uint32_t>();
+          const auto location = in.ReadVector();
+          in.ReadVector(); // rotation
+          ActorInfo &actor = actors[actor_id];
+          if ((location - actor.last_position).Length() < min_distance) {
+            // actor stopped
+            if (actor.duration == 0.0) {
+              actor.time = frame.elapsed;
+            }
+            actor.duration += frame.duration;
+          } else {
+            // actor moving again
+            add_if_blocked(actor_id, actor);
+            actor.duration = 0.0;
+            actor.last_position = location;
+          }
+        }
+      }
+    });
+
+    // actors still stopped at the end of the recording
+    for (const auto &actor : actors) {
+      add_if_blocked(actor.first, actor.second);
+    }
+
+    std::vector<RecorderBlockedActor> result;
+    result.reserve(blocked.size());
+    for (auto &item : blocked) {
+      result.emplace_back(std::move(item.second));
+    }
+    return result;
+  }
+
+} // namespace recorder
+} // namespace carla
@@ -0,0 +1,254 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/geom/Vector3D.h"
+
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace recorder {
+
+  /// Packet types of the recorder file, same values as written by the
+  /// simulator.
+  enum class PacketId : uint8_t {
+    FrameStart = 0,
+    FrameEnd,
+    EventAdd,
+    EventDel,
+    EventParent,
+    Collision,
+    Position,
+    State,
+    AnimVehicle,
+    AnimWalker,
+    VehicleLight,
+    SceneLight,
+    Kinematics,
+    BoundingBox,
+    PlatformTime,
+    PhysicsControl,
+    TrafficLightTime,
+    TriggerVolume,
+    FrameCounter,
+    WalkerBones,
+    VisualTime,
+    VehicleDoor,
+    AnimVehicleWheels,
+    AnimBiker,
+    SIZE
+  };
+
+  /// Bit of @a id in RecorderFrame::packets.
+  constexpr uint32_t PacketMask(PacketId id) {
+    return 1u << static_cast<uint8_t>(id);
+  }
+
+  /// General information at the start of a recorder file.
+  struct RecorderInfo {
+    uint16_t version = 0u;
+    std::string magic;
+    std::time_t date = 0;
+    std::string map_file;
+  };
+
+  /// Entry of the frame index of a recorder file.
+  struct RecorderFrame {
+    uint64_t id;
+    double duration;
+    double elapsed;
+    /// Offset of the FrameStart packet in the file.
+    uint64_t offset;
+    /// PacketMask of the packets of the frame holding any data.
+    uint32_t packets;
+  };
+
+  /// Actor created during a recording, as found in its EventAdd packet.
+  struct RecorderActor {
+    uint32_t id;
+    /// Type of actor in the simulator: other, vehicle, walker, traffic
+    /// light, traffic sign or sensor.
+    uint8_t type;
+    geom::Vector3D location;
+    geom::Vector3D rotation;
+    std::string type_id;
+  };
+
+  /// Start of a collision between two actors found by
+  /// RecorderFile::QueryCollisions.
+  struct RecorderCollision {
+    uint64_t frame;
+    double time;
+    uint32_t actor1;
+    uint32_t actor2;
+    char category1;
+    char category2;
+    std::string type_id1;
+    std::string type_id2;
+  };
+
+  /// Period in which an actor has not moved found by
+  /// RecorderFile::QueryBlocked.
+  struct RecorderBlockedActor {
+    uint32_t id;
+    std::string type_id;
+    double time;
+    double duration;
+  };
+
+  /// Reader of the binary files written by the recorder of the simulator,
+  /// usable without the engine.
+  ///
+  /// The file is memory-mapped and indexed by frame on construction, so
+  /// seeking to a frame or a time is a binary search and queries only visit
+  /// the frames holding the packets they need. The index can be saved to a
+  /// sidecar file next to the recording and is then loaded instead of
+  /// scanning the file again. Recordings truncated in the middle of a frame
+  /// are read up to their last complete frame.
+  class RecorderFile : private NonCopyable {
+  public:
+
+    /// Open and index the recording at @a path. If @a use_index_file, the
+    /// index is loaded from the sidecar file when it exists and matches the
+    /// recording.
+    ///
+    /// @throw std::runtime_error if the file cannot be read or is not a
+    /// recorder file.
+    explicit RecorderFile(const std::string &path, bool use_index_file = true);
+
+    ~RecorderFile();
+
+    /// Path of the sidecar index file of the recording at @a path.
+    static std::string GetIndexFilePath(const std::string &path);
+
+    /// Save the frame index to the sidecar file. Returns false if it could
+    /// not be written.
+    bool WriteIndexFile() const;
+
+    /// Whether the index was loaded from the sidecar file.
+    bool IsIndexFromFile() const {
+      return _index_from_file;
+    }
+
+    const RecorderInfo &GetInfo() const {
+      return _info;
+    }
+
+    const std::vector<RecorderFrame> &GetFrames() const {
+      return _frames;
+    }
+
+    /// Elapsed time at the last frame, in seconds.
+    double GetDuration() const {
+      return _frames.empty() ? 0.0 : _frames.back().elapsed;
+    }
+
+    /// Index of the first frame at or after @a seconds from the start of the
+    /// recording, or the number of frames if there is none.
+    size_t FindFrameByTime(double seconds) const;
+
+    /// Index of the frame with @a frame_id, or the number of frames if there
+    /// is none.
+    size_t FindFrameById(uint64_t frame_id) const;
+
+    /// Call @a callback(frame, packet_id, data, size) for every packet of the
+    /// frames in [@a first, @a last), with @a data pointing to the payload of
+    /// the packet inside the mapped file. Frames not holding any of the
+    /// packets in @a mask are skipped without being visited.
+    template <typename Functor>
+    void ForEachPacket(size_t first, size_t last, uint32_t mask, Functor &&callback) const;
+
+    /// All the actors created during the recording, in order of creation.
+    std::vector<RecorderActor> GetActors() const;
+
+    /// Collisions between actors of @a category1 and @a category2, as in
+    /// Client::ShowRecorderCollisions: 'v' vehicle, 'w' walker, 't' traffic
+    /// light, 'o' other, 'h' hero or 'a' any. Only the first frame of each
+    /// collision is reported.
+    std::vector<RecorderCollision> QueryCollisions(char category1, char category2) const;
+
+    /// Actors that moved less than @a min_distance (in recorder units) for at
+    /// least @a min_time seconds, sorted by decreasing duration, as in
+    /// Client::ShowRecorderActorsBlocked.
+    std::vector<RecorderBlockedActor> QueryBlocked(double min_time, double min_distance) const;
+
+  private:
+
+    struct Mapping;
+
+    static constexpr size_t PacketHeaderSize = sizeof(uint8_t) + sizeof(uint32_t);
+
+    void ReadInfo();
+
+    void BuildIndex();
+
+    bool ReadIndexFile();
+
+    std::string _path;
+
+    std::unique_ptr<Mapping> _mapping;
+
+    const uint8_t *_data = nullptr;
+
+    size_t _size = 0u;
+
+    /// Offset of the first packet, after the general information.
+    size_t _first_packet = 0u;
+
+    RecorderInfo _info;
+
+    std::vector<RecorderFrame> _frames;
+
+    bool _index_from_file = false;
+  };
+
+  template <typename Functor>
+  void RecorderFile::ForEachPacket(
+      const size_t first,
+      const size_t last,
+      const uint32_t mask,
+      Functor &&callback) const {
+    const size_t end = last < _frames.size() ? last : _frames.size();
+    for (size_t i = first; i < end; ++i) {
+      const RecorderFrame &frame = _frames[i];
+      if ((frame.packets & mask) == 0u) {
+        continue;
+      }
+      // Every frame of the index is complete, from its FrameStart packet up
+      // to its FrameEnd packet.
+      const size_t frame_end = (i + 1u < _frames.size()) ?
+          _frames[i + 1u].offset :
+          _size;
+      size_t offset = frame.offset;
+      while (offset + PacketHeaderSize <= frame_end) {
+        const auto id = static_cast<PacketId>(_data[offset]);
+        uint32_t size;
+        std::memcpy(&size, _data + offset + 1u, sizeof(size));
+        offset += PacketHeaderSize;
+        if (offset + size > frame_end) {
+          break;
+        }
+        if (id < PacketId::SIZE && id != PacketId::FrameStart &&
+            id != PacketId::FrameEnd && (PacketMask(id) & mask) != 0u) {
+          callback(frame, id, _data + offset, size);
+        }
+        offset += size;
+        if (id == PacketId::FrameEnd) {
+          break;
+        }
+      }
+    }
+  }
+
+} // namespace recorder
+} // namespace carla
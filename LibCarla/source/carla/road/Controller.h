@@ -15,6 +15,7 @@ namespace carla {
 namespace road {
 
   class MapBuilder;
+  class MapSerializer;
 
   class Controller : private MovableNonCopyable {
 
@@ -51,6 +52,7 @@ namespace road {
   private:
 
     friend MapBuilder;
+    friend MapSerializer;
 
     ContId _id;
     std::string _name;
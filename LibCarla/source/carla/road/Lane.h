@@ -20,6 +20,7 @@ namespace road {
 
   class LaneSection;
   class MapBuilder;
+  class MapSerializer;
   class Road;
 
   class Lane : private MovableNonCopyable {
@@ -122,6 +123,7 @@ namespace road {
   private:
 
     friend MapBuilder;
+    friend MapSerializer;
 
     LaneSection *_lane_section = nullptr;
 
@@ -20,6 +20,7 @@ namespace road {
 
   class Road;
   class MapBuilder;
+  class MapSerializer;
 
   class LaneSection : private MovableNonCopyable {
   public:
@@ -51,6 +52,7 @@ namespace road {
   private:
 
     friend MapBuilder;
+    friend MapSerializer;
 
     const SectionId _id = 0u;
 
@@ -6,6 +6,7 @@
 
 #include "carla/road/Map.h"
 #include "carla/Exception.h"
+#include "carla/ThreadGroup.h"
 #include "carla/geom/Math.h"
 #include "carla/geom/Vector3D.h"
 #include "carla/road/MeshFactory.h"
@@ -22,6 +23,7 @@
 
 #include "marchingcube/MeshReconstruction.h"
 
+#include <atomic>
 #include <vector>
 #include <unordered_map>
 #include <stdexcept>
@@ -39,6 +41,10 @@ namespace road {
   /// sections to avoid floating point precision errors.
   static constexpr double EPSILON = 10.0 * std::numeric_limits<double>::epsilon();
 
+  /// Number of locations of a GetWaypoints batch answered by each task, enough
+  /// to make up for starting the threads.
+  static constexpr size_t WAYPOINT_QUERIES_PER_TASK = 512u;
+
   // ===========================================================================
   // -- Static local methods ---------------------------------------------------
   // ===========================================================================
@@ -55,6 +61,45 @@ namespace road {
     return dst;
   }
 
+  /// Calls @a func for every index in [0, count) from at most @a max_threads
+  /// threads, zero uses the hardware concurrency. Callers store the results
+  /// by index so the output doesn't depend on the scheduling.
+  template <typename FuncT>
+  static void ParallelFor(const size_t count, size_t max_threads, FuncT &&func) {
+    if (max_threads == 0u) {
+      max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const size_t number_of_threads = std::min(count, max_threads);
+    if (number_of_threads <= 1u) {
+      for (size_t i = 0u; i < count; ++i) {
+        func(i);
+      }
+      return;
+    }
+    std::atomic_size_t next_index{0u};
+    ThreadGroup workers;
+    workers.CreateThreads(number_of_threads, [&]() {
+      for (size_t i = next_index++; i < count; i = next_index++) {
+        func(i);
+      }
+    });
+    workers.JoinAll();
+  }
+
+  /// Appends the meshes of @a source to the lists of the same lane type in
+  /// @a destination.
+  static void MoveMeshesByLaneType(
+      std::map<Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>> &source,
+      std::map<Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>> &destination) {
+    for (auto &&pair : source) {
+      auto &meshes = destination[pair.first];
+      meshes.insert(
+          meshes.end(),
+          std::make_move_iterator(pair.second.begin()),
+          std::make_move_iterator(pair.second.end()));
+    }
+  }
+
   static double GetDistanceAtStartOfLane(const Lane &lane) {
     if (lane.GetId() <= 0) {
       return lane.GetDistance() + 10.0 * EPSILON;
@@ -230,6 +275,27 @@ namespace road {
     return boost::optional<Waypoint>{};
   }
 
+  void Map::GetWaypoints(
+      const std::vector<geom::Location> &locations,
+      std::vector<boost::optional<Waypoint>> &result,
+      const bool project_to_road,
+      const int32_t lane_type,
+      const size_t max_threads) const {
+    result.clear();
+    result.resize(locations.size());
+    const size_t number_of_tasks =
+        (locations.size() + WAYPOINT_QUERIES_PER_TASK - 1u) / WAYPOINT_QUERIES_PER_TASK;
+    ParallelFor(number_of_tasks, max_threads, [&](const size_t task) {
+      const size_t begin = task * WAYPOINT_QUERIES_PER_TASK;
+      const size_t end = std::min(begin + WAYPOINT_QUERIES_PER_TASK, locations.size());
+      for (size_t i = begin; i < end; ++i) {
+        result[i] = project_to_road ?
+            GetClosestWaypointOnRoad(locations[i], lane_type) :
+            GetWaypoint(locations[i], lane_type);
+      }
+    });
+  }
+
   boost::optional<Waypoint> Map::GetWaypoint(
       RoadId road_id,
       LaneId lane_id,
@@ -554,75 +620,47 @@ namespace road {
   std::vector<Waypoint> Map::GetNext(
       const Waypoint waypoint,
       const double distance) const {
-    RELEASE_ASSERT(distance > 0.0);
-    if (distance <= EPSILON) {
-      return {waypoint};
-    }
-    const auto &lane = GetLane(waypoint);
-    const bool forward = (waypoint.lane_id <= 0);
-    const double signed_distance = forward ? distance : -distance;
-    const double relative_s = waypoint.s - lane.GetDistance();
-    const double remaining_lane_length = forward ? lane.GetLength() - relative_s : relative_s;
-    DEBUG_ASSERT(remaining_lane_length >= 0.0);
-
-    // If after subtracting the distance we are still in the same lane, return
-    // same waypoint with the extra distance.
-    if (distance <= remaining_lane_length) {
-      Waypoint result = waypoint;
-      result.s += signed_distance;
-      result.s += forward ? -EPSILON : EPSILON;
-      RELEASE_ASSERT(result.s > 0.0);
-      return { result };
-    }
-
-    // If we run out of remaining_lane_length we have to go to the successors.
     std::vector<Waypoint> result;
-    for (const auto &successor : GetSuccessors(waypoint)) {
-      DEBUG_ASSERT(
-          successor.road_id != waypoint.road_id ||
-          successor.section_id != waypoint.section_id ||
-          successor.lane_id != waypoint.lane_id);
-      result = ConcatVectors(result, GetNext(successor, distance - remaining_lane_length));
-    }
+    WalkLanes(waypoint, distance, true, result);
     return result;
   }
 
   std::vector<Waypoint> Map::GetPrevious(
       const Waypoint waypoint,
       const double distance) const {
-    RELEASE_ASSERT(distance > 0.0);
-    if (distance <= EPSILON) {
-      return {waypoint};
-    }
-    const auto &lane = GetLane(waypoint);
-    const bool forward = !(waypoint.lane_id <= 0);
-    const double signed_distance = forward ? distance : -distance;
-    const double relative_s = waypoint.s - lane.GetDistance();
-    const double remaining_lane_length = forward ? lane.GetLength() - relative_s : relative_s;
-    DEBUG_ASSERT(remaining_lane_length >= 0.0);
-
-    // If after subtracting the distance we are still in the same lane, return
-    // same waypoint with the extra distance.
-    if (distance <= remaining_lane_length) {
-      Waypoint result = waypoint;
-      result.s += signed_distance;
-      result.s += forward ? -EPSILON : EPSILON;
-      RELEASE_ASSERT(result.s > 0.0);
-      return { result };
-    }
-
-    // If we run out of remaining_lane_length we have to go to the successors.
     std::vector<Waypoint> result;
-    for (const auto &successor : GetPredecessors(waypoint)) {
-      DEBUG_ASSERT(
-          successor.road_id != waypoint.road_id ||
-          successor.section_id != waypoint.section_id ||
-          successor.lane_id != waypoint.lane_id);
-      result = ConcatVectors(result, GetPrevious(successor, distance - remaining_lane_length));
-    }
+    WalkLanes(waypoint, distance, false, result);
     return result;
   }
 
+  void Map::GetNext(
+      const Waypoint waypoint,
+      const double distance,
+      std::vector<Waypoint> &result) const {
+    WalkLanes(waypoint, distance, true, result);
+  }
+
+  void Map::GetPrevious(
+      const Waypoint waypoint,
+      const double distance,
+      std::vector<Waypoint> &result) const {
+    WalkLanes(waypoint, distance, false, result);
+  }
+
+  void Map::GetNext(
+      const std::vector<Waypoint> &waypoints,
+      const std::vector<double> &distances,
+      WaypointBatch &result) const {
+    WalkLanes(waypoints, distances, true, result);
+  }
+
+  void Map::GetPrevious(
+      const std::vector<Waypoint> &waypoints,
+      const std::vector<double> &distances,
+      WaypointBatch &result) const {
+    WalkLanes(waypoints, distances, false, result);
+  }
+
   boost::optional<Waypoint> Map::GetRight(Waypoint waypoint) const {
     RELEASE_ASSERT(waypoint.lane_id != 0);
     if (waypoint.lane_id > 0) {
@@ -884,6 +922,132 @@ namespace road {
     }
   }
 
+  void Map::CreateLaneLinks() {
+    _lane_links.clear();
+    _lane_link_targets.clear();
+    _lane_link_indices.clear();
+    // First pass, give an index to every lane.
+    for (const auto &pair : _data.GetRoads()) {
+      const auto &road = pair.second;
+      for (const auto &lane_section : road.GetLaneSections()) {
+        for (const auto &lane_pair : lane_section.GetLanes()) {
+          const auto &lane = lane_pair.second;
+          const auto index = static_cast<uint32_t>(_lane_links.size());
+          _lane_link_indices.emplace(&lane, index);
+          LaneLinks links;
+          links.road_id = road.GetId();
+          links.section_id = lane_section.GetId();
+          links.lane_id = lane.GetId();
+          links.distance = lane.GetDistance();
+          links.length = lane.GetLength();
+          links.start_s = GetDistanceAtStartOfLane(lane);
+          links.end_s = GetDistanceAtEndOfLane(lane);
+          _lane_links.emplace_back(links);
+        }
+      }
+    }
+    // Second pass, link every lane to its successors and predecessors.
+    auto add_targets = [this](const std::vector<Lane *> &lanes) {
+      for (auto *lane : lanes) {
+        RELEASE_ASSERT(lane != nullptr);
+        auto it = _lane_link_indices.find(lane);
+        RELEASE_ASSERT(it != _lane_link_indices.end());
+        _lane_link_targets.emplace_back(it->second);
+      }
+      return static_cast<uint32_t>(_lane_link_targets.size());
+    };
+    for (const auto &pair : _data.GetRoads()) {
+      for (const auto &lane_section : pair.second.GetLaneSections()) {
+        for (const auto &lane_pair : lane_section.GetLanes()) {
+          const auto &lane = lane_pair.second;
+          auto &links = _lane_links[_lane_link_indices.at(&lane)];
+          links.successors_begin = static_cast<uint32_t>(_lane_link_targets.size());
+          links.successors_end = add_targets(lane.GetNextLanes());
+          links.predecessors_begin = links.successors_end;
+          links.predecessors_end = add_targets(lane.GetPreviousLanes());
+        }
+      }
+    }
+  }
+
+  uint32_t Map::GetLaneLinksIndex(const Waypoint waypoint) const {
+    auto it = _lane_link_indices.find(&GetLane(waypoint));
+    RELEASE_ASSERT(it != _lane_link_indices.end());
+    return it->second;
+  }
+
+  void Map::WalkLanes(
+      const Waypoint waypoint,
+      const double distance,
+      const bool next,
+      std::vector<Waypoint> &result) const {
+    RELEASE_ASSERT(distance > 0.0);
+    WalkLanesFrom(GetLaneLinksIndex(waypoint), waypoint.s, distance, next, result);
+  }
+
+  void Map::WalkLanesFrom(
+      const uint32_t lane_index,
+      const double s,
+      const double distance,
+      const bool next,
+      std::vector<Waypoint> &result) const {
+    const auto &links = _lane_links[lane_index];
+    const Waypoint waypoint{links.road_id, links.section_id, links.lane_id, s};
+    if (distance <= EPSILON) {
+      result.emplace_back(waypoint);
+      return;
+    }
+    // Lanes with positive id go in the opposite direction of the road.
+    const bool forward = ((waypoint.lane_id <= 0) == next);
+    const double signed_distance = forward ? distance : -distance;
+    const double relative_s = s - links.distance;
+    const double remaining_lane_length = forward ? links.length - relative_s : relative_s;
+    DEBUG_ASSERT(remaining_lane_length >= 0.0);
+
+    // If after subtracting the distance we are still in the same lane, return
+    // same waypoint with the extra distance.
+    if (distance <= remaining_lane_length) {
+      Waypoint end_waypoint = waypoint;
+      end_waypoint.s += signed_distance;
+      end_waypoint.s += forward ? -EPSILON : EPSILON;
+      RELEASE_ASSERT(end_waypoint.s > 0.0);
+      result.emplace_back(end_waypoint);
+      return;
+    }
+
+    // If we run out of remaining_lane_length we have to go to the successors.
+    const auto begin = next ? links.successors_begin : links.predecessors_begin;
+    const auto end = next ? links.successors_end : links.predecessors_end;
+    for (auto i = begin; i < end; ++i) {
+      const auto target = _lane_link_targets[i];
+      DEBUG_ASSERT(target != lane_index);
+      const auto &target_links = _lane_links[target];
+      RELEASE_ASSERT(target_links.lane_id != 0);
+      WalkLanesFrom(
+          target,
+          next ? target_links.start_s : target_links.end_s,
+          distance - remaining_lane_length,
+          next,
+          result);
+    }
+  }
+
+  void Map::WalkLanes(
+      const std::vector<Waypoint> &waypoints,
+      const std::vector<double> &distances,
+      const bool next,
+      WaypointBatch &result) const {
+    RELEASE_ASSERT(waypoints.size() == distances.size());
+    result.waypoints.clear();
+    result.offsets.clear();
+    result.offsets.reserve(waypoints.size() + 1u);
+    for (auto i = 0u; i < waypoints.size(); ++i) {
+      result.offsets.emplace_back(result.waypoints.size());
+      WalkLanes(waypoints[i], distances[i], next, result.waypoints);
+    }
+    result.offsets.emplace_back(result.waypoints.size());
+  }
+
   void Map::CreateRtree() {
     const double epsilon = 0.000001; // small delta in the road (set to 1
                                      // micrometer to prevent numeric errors)
@@ -991,7 +1155,7 @@ namespace road {
       }
     }
     // Add segments to Rtree
-    _rtree.InsertElements(rtree_elements);
+    _rtree.BulkLoad(rtree_elements);
   }
 
   Junction* Map::GetJunction(JuncId id) {
@@ -1005,7 +1169,8 @@ namespace road {
   geom::Mesh Map::GenerateMesh(
       const double distance,
       const float extra_width,
-      const  bool smooth_junctions) const {
+      const  bool smooth_junctions,
+      const size_t max_threads) const {
     RELEASE_ASSERT(distance > 0.0);
     geom::MeshFactory mesh_factory;
     geom::Mesh out_mesh;
@@ -1013,18 +1178,26 @@ namespace road {
     mesh_factory.road_param.resolution = static_cast<float>(distance);
     mesh_factory.road_param.extra_lane_width = extra_width;
 
-    // Generate roads outside junctions
+    std::vector<const Road *> roads;
     for (auto &&pair : _data.GetRoads()) {
-      const auto &road = pair.second;
-      if (road.IsJunction()) {
-        continue;
+      if (!pair.second.IsJunction()) {
+        roads.emplace_back(&pair.second);
       }
-      out_mesh += *mesh_factory.Generate(road);
     }
-
-    // Generate roads within junctions and smooth them
+    std::vector<const Junction *> junctions;
     for (const auto &junc_pair : _data.GetJunctions()) {
-      const auto &junction = junc_pair.second;
+      junctions.emplace_back(&junc_pair.second);
+    }
+
+    // Generate roads outside junctions, and roads within junctions smoothed,
+    // as independent tasks. The results are merged in order afterwards.
+    std::vector<std::unique_ptr<geom::Mesh>> meshes(roads.size() + junctions.size());
+    ParallelFor(meshes.size(), max_threads, [&](const size_t index) {
+      if (index < roads.size()) {
+        meshes[index] = mesh_factory.Generate(*roads[index]);
+        return;
+      }
+      const auto &junction = *junctions[index - roads.size()];
       std::vector<std::unique_ptr<geom::Mesh>> lane_meshes;
       for(const auto &connection_pair : junction.GetConnections()) {
         const auto &connection = connection_pair.second;
@@ -1036,16 +1209,19 @@ namespace road {
         }
       }
       if(smooth_junctions) {
-        out_mesh += *mesh_factory.MergeAndSmooth(lane_meshes);
+        meshes[index] = mesh_factory.MergeAndSmooth(lane_meshes);
       } else {
-        geom::Mesh junction_mesh;
+        auto junction_mesh = std::make_unique<geom::Mesh>();
         for(auto& lane : lane_meshes) {
-          junction_mesh += *lane;
+          *junction_mesh += *lane;
         }
-        out_mesh += junction_mesh;
+        meshes[index] = std::move(junction_mesh);
       }
-    }
+    });
 
+    for (auto &mesh : meshes) {
+      out_mesh += *mesh;
+    }
     return out_mesh;
   }
 
@@ -1053,25 +1229,29 @@ namespace road {
   std::vector<std::unique_ptr<geom::Mesh>> Map::GenerateChunkedMesh(
       const rpc::OpendriveGenerationParameters& params) const {
     geom::MeshFactory mesh_factory(params);
-    std::vector<std::unique_ptr<geom::Mesh>> out_mesh_list;
 
-    std::unordered_map<JuncId, geom::Mesh> junction_map;
+    std::vector<const Road *> roads;
     for (auto &&pair : _data.GetRoads()) {
-      const auto &road = pair.second;
-      if (!road.IsJunction()) {
-        std::vector<std::unique_ptr<geom::Mesh>> road_mesh_list =
-            mesh_factory.GenerateAllWithMaxLen(road);
-
-        out_mesh_list.insert(
-            out_mesh_list.end(),
-            std::make_move_iterator(road_mesh_list.begin()),
-            std::make_move_iterator(road_mesh_list.end()));
+      if (!pair.second.IsJunction()) {
+        roads.emplace_back(&pair.second);
       }
     }
-
-    // Generate roads within junctions and smooth them
+    std::vector<const Junction *> junctions;
     for (const auto &junc_pair : _data.GetJunctions()) {
-      const auto &junction = junc_pair.second;
+      junctions.emplace_back(&junc_pair.second);
+    }
+
+    // Generate each road outside junctions and each junction as an
+    // independent task, then gather them in order.
+    std::vector<std::vector<std::unique_ptr<geom::Mesh>>> task_meshes(
+        roads.size() + junctions.size());
+    ParallelFor(task_meshes.size(), params.max_mesh_generation_threads, [&](const size_t index) {
+      if (index < roads.size()) {
+        task_meshes[index] = mesh_factory.GenerateAllWithMaxLen(*roads[index]);
+        return;
+      }
+      // Generate roads within junctions and smooth them
+      const auto &junction = *junctions[index - roads.size()];
       std::vector<std::unique_ptr<geom::Mesh>> lane_meshes;
       std::vector<std::unique_ptr<geom::Mesh>> sidewalk_lane_meshes;
       for(const auto &connection_pair : junction.GetConnections()) {
@@ -1093,7 +1273,7 @@ namespace road {
         for(auto& lane : sidewalk_lane_meshes) {
           *merged_mesh += *lane;
         }
-        out_mesh_list.push_back(std::move(merged_mesh));
+        task_meshes[index].push_back(std::move(merged_mesh));
       } else {
         std::unique_ptr<geom::Mesh> junction_mesh = std::make_unique<geom::Mesh>();
         for(auto& lane : lane_meshes) {
@@ -1102,8 +1282,21 @@ namespace road {
         for(auto& lane : sidewalk_lane_meshes) {
           *junction_mesh += *lane;
         }
-        out_mesh_list.push_back(std::move(junction_mesh));
+        task_meshes[index].push_back(std::move(junction_mesh));
       }
+    });
+
+    // Empty meshes have no vertex to place them in a chunk.
+    std::vector<std::unique_ptr<geom::Mesh>> out_mesh_list;
+    for (auto &meshes : task_meshes) {
+      for (auto &mesh : meshes) {
+        if (!mesh->GetVertices().empty()) {
+          out_mesh_list.emplace_back(std::move(mesh));
+        }
+      }
+    }
+    if (out_mesh_list.empty()) {
+      return out_mesh_list;
     }
 
     auto min_pos = geom::Vector2D(
@@ -1141,65 +1334,39 @@ namespace road {
   {
 
     geom::MeshFactory mesh_factory(params);
-    std::map<road::Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>> road_out_mesh_list;
-    std::map<road::Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>> junction_out_mesh_list;
-
-    std::thread juntction_thread( &Map::GenerateJunctions, this, mesh_factory, params,
-      minpos, maxpos, &junction_out_mesh_list);
+    using MeshesByLaneType = std::map<road::Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>>;
 
     const std::vector<RoadId> RoadsIDToGenerate = FilterRoadsByPosition(minpos, maxpos);
-
-    size_t num_roads = RoadsIDToGenerate.size();
-    size_t num_roads_per_thread = 30;
-    size_t num_threads = (num_roads / num_roads_per_thread) + 1;
-    num_threads = num_threads > 1 ? num_threads : 1;
-    std::vector<std::thread> workers;
-    std::mutex write_mutex;
-    std::cout << "Generating " << std::to_string(num_roads) << " roads" << std::endl;
-
-    for ( size_t i = 0; i < num_threads; ++i ) {
-      std::thread neworker(
-        [this, &write_mutex, &mesh_factory, &RoadsIDToGenerate, &road_out_mesh_list, i, num_roads_per_thread]() {
-        std::map<road::Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>> Current =
-          std::move(GenerateRoadsMultithreaded(mesh_factory, RoadsIDToGenerate,i, num_roads_per_thread ));
-        std::lock_guard<std::mutex> guard(write_mutex);
-        for ( auto&& pair : Current ) {
-          if (road_out_mesh_list.find(pair.first) != road_out_mesh_list.end()) {
-            road_out_mesh_list[pair.first].insert(road_out_mesh_list[pair.first].end(),
-              std::make_move_iterator(pair.second.begin()),
-              std::make_move_iterator(pair.second.end()));
-          } else {
-            road_out_mesh_list[pair.first] = std::move(pair.second);
-          }
+    const std::vector<JuncId> JunctionsToGenerate = FilterJunctionsByPosition(minpos, maxpos);
+
+    const size_t num_roads = RoadsIDToGenerate.size();
+    const size_t num_junctions = JunctionsToGenerate.size();
+    std::cout << "Generating " << std::to_string(num_roads) << " roads and "
+              << std::to_string(num_junctions) << " junctions" << std::endl;
+
+    // Each road and each junction is an independent task, the results are
+    // merged in order afterwards, roads first.
+    std::vector<MeshesByLaneType> task_meshes(num_roads + num_junctions);
+    ParallelFor(task_meshes.size(), params.max_mesh_generation_threads, [&](const size_t index) {
+      if (index < num_roads) {
+        const auto& road = _data.GetRoads().at(RoadsIDToGenerate[index]);
+        if (!road.IsJunction()) {
+          mesh_factory.GenerateAllOrderedWithMaxLen(road, task_meshes[index]);
         }
-      });
-      workers.push_back(std::move(neworker));
-    }
-
-    for (size_t i = 0; i < workers.size(); ++i) {
-      workers[i].join();
-    }
-    workers.clear();
-    for (size_t i = 0; i < workers.size(); ++i) {
-      if (workers[i].joinable()) {
-        workers[i].join();
+      } else {
+        GenerateSingleJunction(
+            mesh_factory,
+            JunctionsToGenerate[index - num_roads],
+            &task_meshes[index]);
       }
-    }
+    });
 
-    juntction_thread.join();
-    for (auto&& pair : junction_out_mesh_list) {
-      if (road_out_mesh_list.find(pair.first) != road_out_mesh_list.end())
-      {
-        road_out_mesh_list[pair.first].insert(road_out_mesh_list[pair.first].end(),
-          std::make_move_iterator(pair.second.begin()),
-          std::make_move_iterator(pair.second.end()));
-      }
-      else
-      {
-        road_out_mesh_list[pair.first] = std::move(pair.second);
-      }
+    MeshesByLaneType road_out_mesh_list;
+    for (auto &meshes : task_meshes) {
+      MoveMeshesByLaneType(meshes, road_out_mesh_list);
     }
-    std::cout << "Generated " << std::to_string(num_roads) << " roads" << std::endl;
+    std::cout << "Generated " << std::to_string(num_roads) << " roads and "
+              << std::to_string(num_junctions) << " junctions" << std::endl;
 
     return road_out_mesh_list;
   }
@@ -1328,90 +1495,6 @@ namespace road {
       geom::deformation::GetBumpDeformation(posx,posy);
   }
 
-  std::map<road::Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>>
-      Map::GenerateRoadsMultithreaded( const carla::geom::MeshFactory& mesh_factory,
-                                        const std::vector<RoadId>& RoadsId,
-                                        const size_t index, const size_t number_of_roads_per_thread) const
-  {
-    std::map<road::Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>> out;
-
-    size_t start = index * number_of_roads_per_thread;
-    size_t endoffset = (index+1) * number_of_roads_per_thread;
-    size_t end = RoadsId.size();
-
-    for (int i = start; i < endoffset && i < end; ++i) {
-      const auto& road = _data.GetRoads().at(RoadsId[i]);
-      if (!road.IsJunction()) {
-        mesh_factory.GenerateAllOrderedWithMaxLen(road, out);
-      }
-    }
-    std::cout << "Generated roads from " + std::to_string(index * number_of_roads_per_thread) + " to " + std::to_string((index+1) * number_of_roads_per_thread ) << std::endl;
-    return out;
-  }
-
-  void Map::GenerateJunctions(const carla::geom::MeshFactory& mesh_factory,
-    const rpc::OpendriveGenerationParameters& params,
-    const geom::Vector3D& minpos,
-    const geom::Vector3D& maxpos,
-    std::map<road::Lane::LaneType,
-    std::vector<std::unique_ptr<geom::Mesh>>>* junction_out_mesh_list) const {
-
-    std::vector<JuncId> JunctionsToGenerate = FilterJunctionsByPosition(minpos, maxpos);
-    size_t num_junctions = JunctionsToGenerate.size();
-    std::cout << "Generating " << std::to_string(num_junctions) << " junctions" << std::endl;
-    size_t junctionindex = 0;
-    size_t num_junctions_per_thread = 5;
-    size_t num_threads = (num_junctions / num_junctions_per_thread) + 1;
-    num_threads = num_threads > 1 ? num_threads : 1;
-    std::vector<std::thread> workers;
-    std::mutex write_mutex;
-
-    for ( size_t i = 0; i < num_threads; ++i ) {
-      std::thread neworker(
-        [this, &write_mutex, &mesh_factory, &junction_out_mesh_list, JunctionsToGenerate, i, num_junctions_per_thread, num_junctions]() {
-        std::map<road::Lane::LaneType,
-          std::vector<std::unique_ptr<geom::Mesh>>> junctionsofthisthread;
-
-        size_t minimum = 0;
-        if( (i + 1) * num_junctions_per_thread < num_junctions ){
-          minimum = (i + 1) * num_junctions_per_thread;
-        }else{
-          minimum = num_junctions;
-        }
-        std::cout << "Generating Junctions between  " << std::to_string(i * num_junctions_per_thread) << " and " << std::to_string(minimum) << std::endl;
-
-        for ( size_t junctionindex = i * num_junctions_per_thread;
-                        junctionindex < minimum;
-                        ++junctionindex )
-        {
-          GenerateSingleJunction(mesh_factory, JunctionsToGenerate[junctionindex], &junctionsofthisthread);
-        }
-        std::cout << "Generated Junctions between  " << std::to_string(i * num_junctions_per_thread) << " and " << std::to_string(minimum) << std::endl;
-        std::lock_guard<std::mutex> guard(write_mutex);
-        for ( auto&& pair : junctionsofthisthread ) {
-          if ((*junction_out_mesh_list).find(pair.first) != (*junction_out_mesh_list).end()) {
-            (*junction_out_mesh_list)[pair.first].insert((*junction_out_mesh_list)[pair.first].end(),
-              std::make_move_iterator(pair.second.begin()),
-              std::make_move_iterator(pair.second.end()));
-          } else {
-            (*junction_out_mesh_list)[pair.first] = std::move(pair.second);
-          }
-        }
-      });
-      workers.push_back(std::move(neworker));
-    }
-
-    for (size_t i = 0; i < workers.size(); ++i) {
-      workers[i].join();
-    }
-    workers.clear();
-    for (size_t i = 0; i < workers.size(); ++i) {
-      if (workers[i].joinable()) {
-        workers[i].join();
-      }
-    }
-  }
-
   std::vector<JuncId> Map::FilterJunctionsByPosition( const geom::Vector3D& minpos,
     const geom::Vector3D& maxpos ) const {
 
@@ -21,6 +21,7 @@
 
 #include <boost/optional.hpp>
 
+#include <unordered_map>
 #include <vector>
 
 namespace carla {
@@ -36,6 +37,7 @@ namespace road {
     /// ========================================================================
 
     Map(MapData m) : _data(std::move(m)) {
+      CreateLaneLinks();
       CreateRtree();
     }
 
@@ -59,6 +61,18 @@ namespace road {
         const geom::Location &location,
         int32_t lane_type = static_cast<int32_t>(Lane::LaneType::Driving)) const;
 
+    /// Compute GetClosestWaypointOnRoad, or GetWaypoint if not @a
+    /// project_to_road, for each of @a locations. @a result is resized to the
+    /// number of locations, empty where there is no waypoint. Large batches
+    /// are split among at most @a max_threads threads, zero uses the hardware
+    /// concurrency.
+    void GetWaypoints(
+        const std::vector<geom::Location> &locations,
+        std::vector<boost::optional<element::Waypoint>> &result,
+        bool project_to_road = true,
+        int32_t lane_type = static_cast<int32_t>(Lane::LaneType::Driving),
+        size_t max_threads = 0u) const;
+
     boost::optional<element::Waypoint> GetWaypoint(
         RoadId road_id,
         LaneId lane_id,
@@ -123,6 +137,34 @@ namespace road {
     /// that a vehicle at @a waypoint could drive to.
     std::vector<Waypoint> GetPrevious(Waypoint waypoint, double distance) const;
 
+    /// Same as GetNext, but appends the waypoints to @a result. Walks the
+    /// precomputed lane successor table, so nothing is allocated other than
+    /// the growth of @a result.
+    void GetNext(Waypoint waypoint, double distance, std::vector<Waypoint> &result) const;
+    /// Same as GetPrevious, but appends the waypoints to @a result.
+    void GetPrevious(Waypoint waypoint, double distance, std::vector<Waypoint> &result) const;
+
+    /// Flat result of a batched waypoint query. The results of the i-th query
+    /// are waypoints[offsets[i]] to waypoints[offsets[i + 1]] (not included).
+    struct WaypointBatch {
+      std::vector<Waypoint> waypoints;
+      std::vector<size_t> offsets;
+    };
+
+    /// Compute GetNext for each of @a waypoints at the distance with the same
+    /// index in @a distances. @a result is cleared first, so it can be reused
+    /// between calls without allocating.
+    void GetNext(
+        const std::vector<Waypoint> &waypoints,
+        const std::vector<double> &distances,
+        WaypointBatch &result) const;
+    /// Compute GetPrevious for each of @a waypoints at the distance with the
+    /// same index in @a distances.
+    void GetPrevious(
+        const std::vector<Waypoint> &waypoints,
+        const std::vector<double> &distances,
+        WaypointBatch &result) const;
+
     /// Return a waypoint at the lane of @a waypoint's right lane.
     boost::optional<Waypoint> GetRight(Waypoint waypoint) const;
 
@@ -152,12 +194,18 @@ namespace road {
     std::unordered_map<road::RoadId, std::unordered_set<road::RoadId>>
         ComputeJunctionConflicts(JuncId id) const;
 
-    /// Buids a mesh based on the OpenDRIVE
+    /// Buids a mesh based on the OpenDRIVE. The roads and junctions are
+    /// generated in parallel on up to @a max_threads threads (zero uses the
+    /// hardware concurrency), the result doesn't depend on the number of
+    /// threads.
     geom::Mesh GenerateMesh(
         const double distance,
         const float extra_width = 0.6f,
-        const  bool smooth_junctions = true) const;
+        const  bool smooth_junctions = true,
+        const size_t max_threads = 0u) const;
 
+    /// Same as GenerateMesh, but split in chunks. The number of threads is
+    /// given by @a params.max_mesh_generation_threads.
     std::vector<std::unique_ptr<geom::Mesh>> GenerateChunkedMesh(
         const rpc::OpendriveGenerationParameters& params) const;
 
@@ -204,11 +252,70 @@ namespace road {
 private:
 
     friend MapBuilder;
+    friend MapSerializer;
     MapData _data;
 
     using Rtree = geom::SegmentCloudRtree<Waypoint>;
     Rtree _rtree;
 
+    /// Used by MapSerializer to restore a map, the R-tree is filled with the
+    /// given elements instead of computed from the roads.
+    Map(MapData m, const std::vector<Rtree::TreeElement> &rtree_elements)
+      : _data(std::move(m)) {
+      CreateLaneLinks();
+      _rtree.BulkLoad(rtree_elements);
+    }
+
+    /// Connectivity of a lane, precomputed so the road network can be walked
+    /// without looking up each lane in the map data.
+    struct LaneLinks {
+      RoadId road_id;
+      SectionId section_id;
+      LaneId lane_id;
+      /// s at the start of the lane and its length.
+      double distance;
+      double length;
+      /// s of the waypoint placed at the entrance of the lane when arriving
+      /// from a predecessor (start_s) or from a successor (end_s).
+      double start_s;
+      double end_s;
+      /// Ranges in _lane_link_targets.
+      uint32_t successors_begin;
+      uint32_t successors_end;
+      uint32_t predecessors_begin;
+      uint32_t predecessors_end;
+    };
+
+    std::vector<LaneLinks> _lane_links;
+
+    /// Indices in _lane_links of the successors and predecessors of each lane.
+    std::vector<uint32_t> _lane_link_targets;
+
+    std::unordered_map<const Lane *, uint32_t> _lane_link_indices;
+
+    void CreateLaneLinks();
+
+    uint32_t GetLaneLinksIndex(Waypoint waypoint) const;
+
+    void WalkLanes(
+        Waypoint waypoint,
+        double distance,
+        bool next,
+        std::vector<Waypoint> &result) const;
+
+    void WalkLanesFrom(
+        uint32_t lane_index,
+        double s,
+        double distance,
+        bool next,
+        std::vector<Waypoint> &result) const;
+
+    void WalkLanes(
+        const std::vector<Waypoint> &waypoints,
+        const std::vector<double> &distances,
+        bool next,
+        WaypointBatch &result) const;
+
     void CreateRtree();
 
     /// Helper Functions for constructing the rtree element list
@@ -228,19 +335,6 @@ private:
 public:
     inline float GetZPosInDeformation(float posx, float posy) const;
 
-    std::map<road::Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>>
-      GenerateRoadsMultithreaded( const carla::geom::MeshFactory& mesh_factory,
-        const std::vector<RoadId>& RoadsID,
-        const size_t index,
-        const size_t number_of_roads_per_thread) const;
-
-    void GenerateJunctions(const carla::geom::MeshFactory& mesh_factory,
-      const rpc::OpendriveGenerationParameters& params,
-      const geom::Vector3D& minpos,
-      const geom::Vector3D& maxpos,
-      std::map<road::Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>>*
-      juntion_out_mesh_list) const;
-
     void GenerateSingleJunction(const carla::geom::MeshFactory& mesh_factory,
       const JuncId Id,
       std::map<road::Lane::LaneType, std::vector<std::unique_ptr<geom::Mesh>>>*
@@ -488,6 +488,12 @@ namespace road {
         location,
         curvStart,
         curvEnd);
+    const auto &settings = _geometry_lookup_table_settings;
+    if (settings.enabled && (length > 0.0) && (_geometry_lookup_table_bytes < settings.max_bytes)) {
+      _geometry_lookup_table_bytes += spiral_geometry->BuildLookupTable(
+          settings.max_error,
+          settings.max_bytes - _geometry_lookup_table_bytes);
+    }
 
       _temp_road_info_container[road].emplace_back(std::unique_ptr<RoadInfo>(new RoadInfoGeometry(s,
         std::move(spiral_geometry))));
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/road/Map.h"
+#include "carla/road/element/Geometry.h"
 #include "carla/road/element/RoadInfoCrosswalk.h"
 #include "carla/road/element/RoadInfoSignal.h"
 
@@ -362,10 +363,21 @@ namespace road {
       _map_data._geo_reference = geo_reference;
     }
 
+    /// Set how the geometries added from now on precompute their lookup
+    /// tables.
+    void SetGeometryLookupTableSettings(const element::GeometryLookupTableSettings &settings) {
+      _geometry_lookup_table_settings = settings;
+    }
+
   private:
 
     MapData _map_data;
 
+    element::GeometryLookupTableSettings _geometry_lookup_table_settings;
+
+    /// Memory used by the lookup tables of the geometries added so far.
+    size_t _geometry_lookup_table_bytes = 0u;
+
     /// Create the pointers between RoadSegments based on the ids.
     void CreatePointersBetweenRoadSegments();
 
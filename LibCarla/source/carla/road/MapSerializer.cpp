@@ -0,0 +1,1142 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/MapSerializer.h"
+
+#include "carla/Debug.h"
+#include "carla/road/element/RoadInfoCrosswalk.h"
+#include "carla/road/element/RoadInfoElevation.h"
+#include "carla/road/element/RoadInfoGeometry.h"
+#include "carla/road/element/RoadInfoLaneAccess.h"
+#include "carla/road/element/RoadInfoLaneBorder.h"
+#include "carla/road/element/RoadInfoLaneHeight.h"
+#include "carla/road/element/RoadInfoLaneMaterial.h"
+#include "carla/road/element/RoadInfoLaneOffset.h"
+#include "carla/road/element/RoadInfoLaneRule.h"
+#include "carla/road/element/RoadInfoLaneVisibility.h"
+#include "carla/road/element/RoadInfoLaneWidth.h"
+#include "carla/road/element/RoadInfoMarkRecord.h"
+#include "carla/road/element/RoadInfoMarkTypeLine.h"
+#include "carla/road/element/RoadInfoSignal.h"
+#include "carla/road/element/RoadInfoSpeed.h"
+#include "carla/road/element/RoadInfoVisitor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+using namespace carla::road::element;
+
+namespace carla {
+namespace road {
+
+  /// "CMAP" in little-endian.
+  static constexpr uint32_t MAGIC = 0x50414d43u;
+
+  /// Increase every time the layout of the data changes.
+  static constexpr uint32_t FORMAT_VERSION = 1u;
+
+  /// Rejects data written on a host with a different byte order.
+  static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+  enum class RoadInfoType : uint8_t {
+    Elevation,
+    Geometry,
+    LaneAccess,
+    LaneBorder,
+    LaneHeight,
+    LaneMaterial,
+    LaneOffset,
+    LaneRule,
+    LaneVisibility,
+    LaneWidth,
+    MarkRecord,
+    MarkTypeLine,
+    Speed,
+    Crosswalk,
+    Signal,
+    Unknown
+  };
+
+  /// Finds the type of a RoadInfo.
+  class RoadInfoTypeVisitor final : public RoadInfoVisitor {
+  public:
+
+    RoadInfoType type = RoadInfoType::Unknown;
+
+    void Visit(RoadInfoElevation &) final { type = RoadInfoType::Elevation; }
+    void Visit(RoadInfoGeometry &) final { type = RoadInfoType::Geometry; }
+    void Visit(RoadInfoLaneAccess &) final { type = RoadInfoType::LaneAccess; }
+    void Visit(RoadInfoLaneBorder &) final { type = RoadInfoType::LaneBorder; }
+    void Visit(RoadInfoLaneHeight &) final { type = RoadInfoType::LaneHeight; }
+    void Visit(RoadInfoLaneMaterial &) final { type = RoadInfoType::LaneMaterial; }
+    void Visit(RoadInfoLaneOffset &) final { type = RoadInfoType::LaneOffset; }
+    void Visit(RoadInfoLaneRule &) final { type = RoadInfoType::LaneRule; }
+    void Visit(RoadInfoLaneVisibility &) final { type = RoadInfoType::LaneVisibility; }
+    void Visit(RoadInfoLaneWidth &) final { type = RoadInfoType::LaneWidth; }
+    void Visit(RoadInfoMarkRecord &) final { type = RoadInfoType::MarkRecord; }
+    void Visit(RoadInfoMarkTypeLine &) final { type = RoadInfoType::MarkTypeLine; }
+    void Visit(RoadInfoSpeed &) final { type = RoadInfoType::Speed; }
+    void Visit(RoadInfoCrosswalk &) final { type = RoadInfoType::Crosswalk; }
+    void Visit(RoadInfoSignal &) final { type = RoadInfoType::Signal; }
+  };
+
+  // ===========================================================================
+  // -- Writer and Reader ------------------------------------------------------
+  // ===========================================================================
+
+  class MapSerializer::Writer {
+  public:
+
+    template <typename T>
+    void WriteValue(const T &value) {
+      static_assert(std::is_trivially_copyable<T>::value, "Type cannot be copied as raw bytes");
+      const auto *begin = reinterpret_cast<const uint8_t *>(&value);
+      _data.insert(_data.end(), begin, begin + sizeof(T));
+    }
+
+    void WriteBool(const bool value) {
+      WriteValue<uint8_t>(value ? 1u : 0u);
+    }
+
+    void WriteSize(const size_t size) {
+      DEBUG_ASSERT(size <= std::numeric_limits<uint32_t>::max());
+      WriteValue(static_cast<uint32_t>(size));
+    }
+
+    void WriteString(const std::string &str) {
+      WriteSize(str.size());
+      _data.insert(_data.end(), str.begin(), str.end());
+    }
+
+    template <typename T>
+    void WriteArray(const std::vector<T> &vec) {
+      static_assert(std::is_trivially_copyable<T>::value, "Type cannot be copied as raw bytes");
+      WriteSize(vec.size());
+      const auto *begin = reinterpret_cast<const uint8_t *>(vec.data());
+      _data.insert(_data.end(), begin, begin + sizeof(T) * vec.size());
+    }
+
+    void WriteWaypoint(const Waypoint &waypoint) {
+      WriteValue(waypoint.road_id);
+      WriteValue(waypoint.section_id);
+      WriteValue(waypoint.lane_id);
+      WriteValue(waypoint.s);
+    }
+
+    /// Mark the map as not serializable.
+    void Fail() {
+      _failed = true;
+    }
+
+    bool Failed() const {
+      return _failed;
+    }
+
+    std::vector<uint8_t> &GetData() {
+      return _data;
+    }
+
+  private:
+
+    std::vector<uint8_t> _data;
+
+    bool _failed = false;
+  };
+
+  class MapSerializer::Reader {
+  public:
+
+    Reader(const uint8_t *data, size_t size)
+      : _it(data),
+        _end(data + size) {}
+
+    template <typename T>
+    T ReadValue() {
+      static_assert(std::is_trivially_copyable<T>::value, "Type cannot be copied as raw bytes");
+      T value{};
+      const uint8_t *bytes = Consume(sizeof(T));
+      if (bytes != nullptr) {
+        std::memcpy(&value, bytes, sizeof(T));
+      }
+      return value;
+    }
+
+    bool ReadBool() {
+      return ReadValue<uint8_t>() != 0u;
+    }
+
+    /// Read the number of elements of a list, @a min_element_size is used to
+    /// reject sizes that don't fit in the remaining data before allocating
+    /// anything.
+    size_t ReadSize(const size_t min_element_size) {
+      const size_t size = ReadValue<uint32_t>();
+      if (size * std::max<size_t>(min_element_size, 1u) > Remaining()) {
+        Fail();
+        return 0u;
+      }
+      return size;
+    }
+
+    std::string ReadString() {
+      const size_t size = ReadSize(1u);
+      const uint8_t *bytes = Consume(size);
+      return bytes != nullptr ?
+          std::string(reinterpret_cast<const char *>(bytes), size) :
+          std::string();
+    }
+
+    template <typename T>
+    void ReadArray(std::vector<T> &vec) {
+      static_assert(std::is_trivially_copyable<T>::value, "Type cannot be copied as raw bytes");
+      const size_t size = ReadSize(sizeof(T));
+      const uint8_t *bytes = Consume(sizeof(T) * size);
+      vec.resize(bytes != nullptr ? size : 0u);
+      if (!vec.empty()) {
+        std::memcpy(vec.data(), bytes, sizeof(T) * size);
+      }
+    }
+
+    Waypoint ReadWaypoint() {
+      Waypoint waypoint;
+      waypoint.road_id = ReadValue<RoadId>();
+      waypoint.section_id = ReadValue<SectionId>();
+      waypoint.lane_id = ReadValue<LaneId>();
+      waypoint.s = ReadValue<double>();
+      return waypoint;
+    }
+
+    void Fail() {
+      _failed = true;
+      _it = _end;
+    }
+
+    bool Failed() const {
+      return _failed;
+    }
+
+    bool AtEnd() const {
+      return _it == _end;
+    }
+
+    /// Links between lanes and roads, resolved once all the roads are read.
+    struct LaneReference {
+      Lane *lane;
+      bool next;
+      RoadId road_id;
+      SectionId section_id;
+      LaneId lane_id;
+    };
+
+    struct RoadReference {
+      Road *road;
+      bool next;
+      RoadId road_id;
+    };
+
+    std::vector<LaneReference> lane_references;
+
+    std::vector<RoadReference> road_references;
+
+  private:
+
+    size_t Remaining() const {
+      return static_cast<size_t>(_end - _it);
+    }
+
+    const uint8_t *Consume(const size_t size) {
+      if (size > Remaining()) {
+        Fail();
+        return nullptr;
+      }
+      const uint8_t *result = _it;
+      _it += size;
+      return result;
+    }
+
+    const uint8_t *_it;
+
+    const uint8_t *_end;
+
+    bool _failed = false;
+  };
+
+  // ===========================================================================
+  // -- Helpers ----------------------------------------------------------------
+  // ===========================================================================
+
+  /// Pointers to the values of @a map sorted by key, so the same map always
+  /// serializes to the same bytes.
+  template <typename MapT>
+  static auto SortedByKey(const MapT &map) {
+    std::vector<const typename MapT::value_type *> result;
+    result.reserve(map.size());
+    for (const auto &pair : map) {
+      result.emplace_back(&pair);
+    }
+    std::sort(result.begin(), result.end(), [](const auto *lhs, const auto *rhs) {
+      return lhs->first < rhs->first;
+    });
+    return result;
+  }
+
+  // ===========================================================================
+  // -- MapSerializer ----------------------------------------------------------
+  // ===========================================================================
+
+  uint64_t MapSerializer::HashOpenDrive(const std::string &opendrive) {
+    // 64-bit FNV-1a.
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : opendrive) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  std::vector<uint8_t> MapSerializer::Serialize(const Map &map, const uint64_t opendrive_hash) {
+    Writer out;
+    out.WriteValue(MAGIC);
+    out.WriteValue(FORMAT_VERSION);
+    out.WriteValue(BYTE_ORDER_MARK);
+    out.WriteValue(opendrive_hash);
+
+    const MapData &data = map._data;
+    out.WriteValue(data._geo_reference);
+
+    // Signals go first, the road infos referencing them are linked on load.
+    out.WriteSize(data._signals.size());
+    for (const auto *pair : SortedByKey(data._signals)) {
+      WriteSignal(out, *pair->second);
+    }
+    out.WriteSize(data._controllers.size());
+    for (const auto *pair : SortedByKey(data._controllers)) {
+      WriteController(out, *pair->second);
+    }
+    out.WriteSize(data._roads.size());
+    for (const auto *pair : SortedByKey(data._roads)) {
+      WriteRoad(out, pair->second);
+    }
+    out.WriteSize(data._junctions.size());
+    for (const auto *pair : SortedByKey(data._junctions)) {
+      WriteJunction(out, pair->second);
+    }
+
+    const auto rtree_elements = map._rtree.GetElements();
+    out.WriteSize(rtree_elements.size());
+    for (const auto &element : rtree_elements) {
+      const auto &segment = element.first;
+      out.WriteValue(segment.first.get<0>());
+      out.WriteValue(segment.first.get<1>());
+      out.WriteValue(segment.first.get<2>());
+      out.WriteValue(segment.second.get<0>());
+      out.WriteValue(segment.second.get<1>());
+      out.WriteValue(segment.second.get<2>());
+      out.WriteWaypoint(element.second.first);
+      out.WriteWaypoint(element.second.second);
+    }
+
+    if (out.Failed()) {
+      return {};
+    }
+    return std::move(out.GetData());
+  }
+
+  boost::optional<Map> MapSerializer::Deserialize(
+      const uint8_t *data,
+      const size_t size,
+      const uint64_t opendrive_hash) {
+    Reader in(data, size);
+    if ((in.ReadValue<uint32_t>() != MAGIC) ||
+        (in.ReadValue<uint32_t>() != FORMAT_VERSION) ||
+        (in.ReadValue<uint32_t>() != BYTE_ORDER_MARK) ||
+        (in.ReadValue<uint64_t>() != opendrive_hash)) {
+      return boost::none;
+    }
+
+    MapData map_data;
+    map_data._geo_reference = in.ReadValue<geom::GeoLocation>();
+
+    const size_t number_of_signals = in.ReadSize(1u);
+    for (size_t i = 0u; (i < number_of_signals) && !in.Failed(); ++i) {
+      if (!ReadSignal(in, map_data)) {
+        return boost::none;
+      }
+    }
+    const size_t number_of_controllers = in.ReadSize(1u);
+    for (size_t i = 0u; (i < number_of_controllers) && !in.Failed(); ++i) {
+      if (!ReadController(in, map_data)) {
+        return boost::none;
+      }
+    }
+    const size_t number_of_roads = in.ReadSize(1u);
+    for (size_t i = 0u; (i < number_of_roads) && !in.Failed(); ++i) {
+      if (!ReadRoad(in, map_data)) {
+        return boost::none;
+      }
+    }
+    if (!ResolveRoadLinks(in, map_data)) {
+      return boost::none;
+    }
+    const size_t number_of_junctions = in.ReadSize(1u);
+    for (size_t i = 0u; (i < number_of_junctions) && !in.Failed(); ++i) {
+      if (!ReadJunction(in, map_data)) {
+        return boost::none;
+      }
+    }
+
+    constexpr size_t rtree_element_size = 6u * sizeof(float) + 2u * 20u;
+    std::vector<Map::Rtree::TreeElement> rtree_elements(in.ReadSize(rtree_element_size));
+    for (auto &element : rtree_elements) {
+      const float x0 = in.ReadValue<float>();
+      const float y0 = in.ReadValue<float>();
+      const float z0 = in.ReadValue<float>();
+      const float x1 = in.ReadValue<float>();
+      const float y1 = in.ReadValue<float>();
+      const float z1 = in.ReadValue<float>();
+      element.first = Map::Rtree::BSegment(
+          Map::Rtree::BPoint(x0, y0, z0),
+          Map::Rtree::BPoint(x1, y1, z1));
+      element.second.first = in.ReadWaypoint();
+      element.second.second = in.ReadWaypoint();
+    }
+
+    if (in.Failed() || !in.AtEnd()) {
+      return boost::none;
+    }
+    return Map(std::move(map_data), rtree_elements);
+  }
+
+  // ===========================================================================
+  // -- Roads ------------------------------------------------------------------
+  // ===========================================================================
+
+  void MapSerializer::WriteRoad(Writer &out, const Road &road) {
+    auto write_lanes = [&](const std::vector<Lane *> &lanes) {
+      out.WriteSize(lanes.size());
+      for (const auto *lane : lanes) {
+        DEBUG_ASSERT(lane != nullptr);
+        out.WriteValue(lane->GetRoad()->GetId());
+        out.WriteValue(lane->GetLaneSection()->GetId());
+        out.WriteValue(lane->GetId());
+      }
+    };
+    auto write_roads = [&](const std::vector<Road *> &roads) {
+      out.WriteSize(roads.size());
+      for (const auto *other : roads) {
+        DEBUG_ASSERT(other != nullptr);
+        out.WriteValue(other->GetId());
+      }
+    };
+
+    out.WriteValue(road._id);
+    out.WriteString(road._name);
+    out.WriteValue(road._length);
+    out.WriteBool(road._is_junction);
+    out.WriteValue(road._junction_id);
+    out.WriteValue(road._successor);
+    out.WriteValue(road._predecessor);
+    WriteInformationSet(out, road._info);
+
+    out.WriteSize(static_cast<size_t>(
+        std::distance(road._lane_sections.begin(), road._lane_sections.end())));
+    for (const auto &section_pair : road._lane_sections) {
+      const LaneSection &section = section_pair.second;
+      out.WriteValue(section._id);
+      out.WriteValue(section._s);
+      out.WriteValue(section._lane_offset);
+      out.WriteSize(section._lanes.size());
+      for (const auto &lane_pair : section._lanes) {
+        const Lane &lane = lane_pair.second;
+        out.WriteValue(lane._id);
+        out.WriteValue(static_cast<int32_t>(lane._type));
+        out.WriteBool(lane._level);
+        out.WriteValue(lane._successor);
+        out.WriteValue(lane._predecessor);
+        WriteInformationSet(out, lane._info);
+        write_lanes(lane._next_lanes);
+        write_lanes(lane._prev_lanes);
+      }
+    }
+
+    write_roads(road._nexts);
+    write_roads(road._prevs);
+  }
+
+  bool MapSerializer::ReadRoad(Reader &in, MapData &data) {
+    auto read_lanes = [&](Lane &lane, const bool next) {
+      const size_t count = in.ReadSize(sizeof(RoadId) + sizeof(SectionId) + sizeof(LaneId));
+      for (size_t i = 0u; i < count; ++i) {
+        const auto road_id = in.ReadValue<RoadId>();
+        const auto section_id = in.ReadValue<SectionId>();
+        const auto lane_id = in.ReadValue<LaneId>();
+        in.lane_references.push_back({&lane, next, road_id, section_id, lane_id});
+      }
+    };
+    auto read_roads = [&](Road &road, const bool next) {
+      const size_t count = in.ReadSize(sizeof(RoadId));
+      for (size_t i = 0u; i < count; ++i) {
+        in.road_references.push_back({&road, next, in.ReadValue<RoadId>()});
+      }
+    };
+
+    const auto id = in.ReadValue<RoadId>();
+    auto result = data._roads.emplace(id, Road());
+    if (!result.second) {
+      return false;
+    }
+    Road &road = result.first->second;
+    road._id = id;
+    road._name = in.ReadString();
+    road._length = in.ReadValue<double>();
+    road._is_junction = in.ReadBool();
+    road._junction_id = in.ReadValue<JuncId>();
+    road._successor = in.ReadValue<RoadId>();
+    road._predecessor = in.ReadValue<RoadId>();
+    road._info = InformationSet(ReadInformationSet(in, data));
+
+    const size_t number_of_sections = in.ReadSize(sizeof(SectionId) + sizeof(double));
+    for (size_t i = 0u; (i < number_of_sections) && !in.Failed(); ++i) {
+      const auto section_id = in.ReadValue<SectionId>();
+      const auto s = in.ReadValue<double>();
+      LaneSection &section = road._lane_sections.Emplace(section_id, s);
+      section._road = &road;
+      section._lane_offset = in.ReadValue<geom::CubicPolynomial>();
+      const size_t number_of_lanes = in.ReadSize(sizeof(LaneId));
+      for (size_t j = 0u; (j < number_of_lanes) && !in.Failed(); ++j) {
+        const auto lane_id = in.ReadValue<LaneId>();
+        const auto type = in.ReadValue<int32_t>();
+        const bool level = in.ReadBool();
+        const auto successor = in.ReadValue<LaneId>();
+        const auto predecessor = in.ReadValue<LaneId>();
+        auto lane_result = section._lanes.emplace(
+            lane_id,
+            Lane(&section, lane_id, ReadInformationSet(in, data)));
+        if (!lane_result.second) {
+          return false;
+        }
+        Lane &lane = lane_result.first->second;
+        lane._type = static_cast<Lane::LaneType>(type);
+        lane._level = level;
+        lane._successor = successor;
+        lane._predecessor = predecessor;
+        read_lanes(lane, true);
+        read_lanes(lane, false);
+      }
+    }
+
+    read_roads(road, true);
+    read_roads(road, false);
+    return !in.Failed();
+  }
+
+  bool MapSerializer::ResolveRoadLinks(Reader &in, MapData &data) {
+    auto find_road = [&](const RoadId id) -> Road * {
+      auto it = data._roads.find(id);
+      return it != data._roads.end() ? &it->second : nullptr;
+    };
+    for (const auto &reference : in.road_references) {
+      Road *road = find_road(reference.road_id);
+      if (road == nullptr) {
+        return false;
+      }
+      (reference.next ? reference.road->_nexts : reference.road->_prevs).emplace_back(road);
+    }
+    for (const auto &reference : in.lane_references) {
+      Road *road = find_road(reference.road_id);
+      if (road == nullptr) {
+        return false;
+      }
+      Lane *lane = nullptr;
+      for (auto &section_pair : road->_lane_sections) {
+        if (section_pair.second.GetId() == reference.section_id) {
+          lane = section_pair.second.GetLane(reference.lane_id);
+          break;
+        }
+      }
+      if (lane == nullptr) {
+        return false;
+      }
+      auto &lanes = reference.next ? reference.lane->_next_lanes : reference.lane->_prev_lanes;
+      lanes.emplace_back(lane);
+    }
+    in.road_references.clear();
+    in.lane_references.clear();
+    return true;
+  }
+
+  // ===========================================================================
+  // -- Road infos -------------------------------------------------------------
+  // ===========================================================================
+
+  void MapSerializer::WriteInformationSet(Writer &out, const InformationSet &info) {
+    const auto &infos = info._road_set.GetAll();
+    out.WriteSize(infos.size());
+    for (const auto &element : infos) {
+      WriteRoadInfo(out, *element);
+    }
+  }
+
+  std::vector<std::unique_ptr<RoadInfo>> MapSerializer::ReadInformationSet(
+      Reader &in,
+      MapData &data) {
+    std::vector<std::unique_ptr<RoadInfo>> result(in.ReadSize(1u + sizeof(double)));
+    for (auto &info : result) {
+      info = ReadRoadInfo(in, data);
+      if (info == nullptr) {
+        in.Fail();
+        return {};
+      }
+    }
+    return result;
+  }
+
+  template <typename WriterT>
+  static void WriteMarkTypeLine(WriterT &out, const RoadInfoMarkTypeLine &line);
+
+  void MapSerializer::WriteRoadInfo(Writer &out, RoadInfo &info) {
+    RoadInfoTypeVisitor visitor;
+    info.AcceptVisitor(visitor);
+    out.WriteValue(visitor.type);
+    out.WriteValue(info.GetDistance());
+    switch (visitor.type) {
+      case RoadInfoType::Elevation:
+        out.WriteValue(static_cast<RoadInfoElevation &>(info).GetPolynomial());
+        break;
+      case RoadInfoType::Geometry:
+        WriteGeometry(out, static_cast<RoadInfoGeometry &>(info).GetGeometry());
+        break;
+      case RoadInfoType::LaneAccess:
+        out.WriteString(static_cast<RoadInfoLaneAccess &>(info).GetRestriction());
+        break;
+      case RoadInfoType::LaneBorder:
+        out.WriteValue(static_cast<RoadInfoLaneBorder &>(info).GetPolynomial());
+        break;
+      case RoadInfoType::LaneHeight: {
+        const auto &height = static_cast<RoadInfoLaneHeight &>(info);
+        out.WriteValue(height.GetInner());
+        out.WriteValue(height.GetOuter());
+        break;
+      }
+      case RoadInfoType::LaneMaterial: {
+        const auto &material = static_cast<RoadInfoLaneMaterial &>(info);
+        out.WriteString(material.GetSurface());
+        out.WriteValue(material.GetFriction());
+        out.WriteValue(material.GetRoughness());
+        break;
+      }
+      case RoadInfoType::LaneOffset:
+        out.WriteValue(static_cast<RoadInfoLaneOffset &>(info).GetPolynomial());
+        break;
+      case RoadInfoType::LaneRule:
+        out.WriteString(static_cast<RoadInfoLaneRule &>(info).GetValue());
+        break;
+      case RoadInfoType::LaneVisibility: {
+        const auto &visibility = static_cast<RoadInfoLaneVisibility &>(info);
+        out.WriteValue(visibility.GetForward());
+        out.WriteValue(visibility.GetBack());
+        out.WriteValue(visibility.GetLeft());
+        out.WriteValue(visibility.GetRight());
+        break;
+      }
+      case RoadInfoType::LaneWidth:
+        out.WriteValue(static_cast<RoadInfoLaneWidth &>(info).GetPolynomial());
+        break;
+      case RoadInfoType::MarkRecord: {
+        auto &mark = static_cast<RoadInfoMarkRecord &>(info);
+        out.WriteValue(mark.GetRoadMarkId());
+        out.WriteString(mark.GetType());
+        out.WriteString(mark.GetWeight());
+        out.WriteString(mark.GetColor());
+        out.WriteString(mark.GetMaterial());
+        out.WriteValue(mark.GetWidth());
+        out.WriteValue(mark.GetLaneChange());
+        out.WriteValue(mark.GetHeight());
+        out.WriteString(mark.GetTypeName());
+        out.WriteValue(mark.GetTypeWidth());
+        out.WriteSize(mark.GetLines().size());
+        for (const auto &line : mark.GetLines()) {
+          out.WriteValue(line->GetDistance());
+          WriteMarkTypeLine(out, *line);
+        }
+        break;
+      }
+      case RoadInfoType::MarkTypeLine:
+        WriteMarkTypeLine(out, static_cast<RoadInfoMarkTypeLine &>(info));
+        break;
+      case RoadInfoType::Speed: {
+        const auto &speed = static_cast<RoadInfoSpeed &>(info);
+        out.WriteValue(speed.GetSpeed());
+        out.WriteString(speed.GetType());
+        break;
+      }
+      case RoadInfoType::Crosswalk: {
+        const auto &crosswalk = static_cast<RoadInfoCrosswalk &>(info);
+        out.WriteString(crosswalk.GetName());
+        out.WriteValue(crosswalk.GetT());
+        out.WriteValue(crosswalk.GetZOffset());
+        out.WriteValue(crosswalk.GetHeading());
+        out.WriteValue(crosswalk.GetPitch());
+        out.WriteValue(crosswalk.GetRoll());
+        out.WriteString(crosswalk.GetOrientation());
+        out.WriteValue(crosswalk.GetWidth());
+        out.WriteValue(crosswalk.GetLength());
+        out.WriteSize(crosswalk.GetPoints().size());
+        for (const auto &point : crosswalk.GetPoints()) {
+          out.WriteValue(point.u);
+          out.WriteValue(point.v);
+          out.WriteValue(point.z);
+        }
+        break;
+      }
+      case RoadInfoType::Signal: {
+        const auto &signal = static_cast<RoadInfoSignal &>(info);
+        out.WriteString(signal._signal_id);
+        out.WriteValue(signal._road_id);
+        out.WriteValue(signal._s);
+        out.WriteValue(signal._t);
+        out.WriteString(signal._orientation);
+        out.WriteSize(signal._validities.size());
+        for (const auto &validity : signal._validities) {
+          out.WriteValue(validity._from_lane);
+          out.WriteValue(validity._to_lane);
+        }
+        break;
+      }
+      case RoadInfoType::Unknown:
+        out.Fail();
+        break;
+    }
+  }
+
+  template <typename WriterT>
+  static void WriteMarkTypeLine(WriterT &out, const RoadInfoMarkTypeLine &line) {
+    out.WriteValue(line.GetRoadMarkId());
+    out.WriteValue(line.GetLength());
+    out.WriteValue(line.GetSpace());
+    out.WriteValue(line.GetTOffset());
+    out.WriteString(line.GetRule());
+    out.WriteValue(line.GetWidth());
+  }
+
+  template <typename ReaderT>
+  static std::unique_ptr<RoadInfoMarkTypeLine> ReadMarkTypeLine(
+      ReaderT &in,
+      const double s) {
+    const auto road_mark_id = in.template ReadValue<int>();
+    const auto length = in.template ReadValue<double>();
+    const auto space = in.template ReadValue<double>();
+    const auto t_offset = in.template ReadValue<double>();
+    auto rule = in.ReadString();
+    const auto width = in.template ReadValue<double>();
+    return std::make_unique<RoadInfoMarkTypeLine>(
+        s, road_mark_id, length, space, t_offset, std::move(rule), width);
+  }
+
+  std::unique_ptr<RoadInfo> MapSerializer::ReadRoadInfo(Reader &in, MapData &data) {
+    const auto type = in.ReadValue<RoadInfoType>();
+    const auto s = in.ReadValue<double>();
+    if (in.Failed()) {
+      return nullptr;
+    }
+    switch (type) {
+      case RoadInfoType::Elevation:
+        return std::make_unique<RoadInfoElevation>(s, in.ReadValue<geom::CubicPolynomial>());
+      case RoadInfoType::Geometry: {
+        auto geometry = ReadGeometry(in);
+        if (geometry == nullptr) {
+          return nullptr;
+        }
+        return std::make_unique<RoadInfoGeometry>(s, std::move(geometry));
+      }
+      case RoadInfoType::LaneAccess:
+        return std::make_unique<RoadInfoLaneAccess>(s, in.ReadString());
+      case RoadInfoType::LaneBorder:
+        return std::make_unique<RoadInfoLaneBorder>(s, in.ReadValue<geom::CubicPolynomial>());
+      case RoadInfoType::LaneHeight: {
+        const auto inner = in.ReadValue<double>();
+        const auto outer = in.ReadValue<double>();
+        return std::make_unique<RoadInfoLaneHeight>(s, inner, outer);
+      }
+      case RoadInfoType::LaneMaterial: {
+        auto surface = in.ReadString();
+        const auto friction = in.ReadValue<double>();
+        const auto roughness = in.ReadValue<double>();
+        return std::make_unique<RoadInfoLaneMaterial>(s, std::move(surface), friction, roughness);
+      }
+      case RoadInfoType::LaneOffset:
+        return std::make_unique<RoadInfoLaneOffset>(s, in.ReadValue<geom::CubicPolynomial>());
+      case RoadInfoType::LaneRule:
+        return std::make_unique<RoadInfoLaneRule>(s, in.ReadString());
+      case RoadInfoType::LaneVisibility: {
+        const auto forward = in.ReadValue<double>();
+        const auto back = in.ReadValue<double>();
+        const auto left = in.ReadValue<double>();
+        const auto right = in.ReadValue<double>();
+        return std::make_unique<RoadInfoLaneVisibility>(s, forward, back, left, right);
+      }
+      case RoadInfoType::LaneWidth:
+        return std::make_unique<RoadInfoLaneWidth>(s, in.ReadValue<geom::CubicPolynomial>());
+      case RoadInfoType::MarkRecord: {
+        const auto road_mark_id = in.ReadValue<int>();
+        auto mark_type = in.ReadString();
+        auto weight = in.ReadString();
+        auto color = in.ReadString();
+        auto material = in.ReadString();
+        const auto width = in.ReadValue<double>();
+        const auto lane_change = in.ReadValue<RoadInfoMarkRecord::LaneChange>();
+        const auto height = in.ReadValue<double>();
+        auto type_name = in.ReadString();
+        const auto type_width = in.ReadValue<double>();
+        auto mark = std::make_unique<RoadInfoMarkRecord>(
+            s, road_mark_id, std::move(mark_type), std::move(weight), std::move(color),
+            std::move(material), width, lane_change, height, std::move(type_name), type_width);
+        const size_t number_of_lines = in.ReadSize(sizeof(double));
+        for (size_t i = 0u; i < number_of_lines; ++i) {
+          const auto line_s = in.ReadValue<double>();
+          mark->GetLines().emplace_back(ReadMarkTypeLine(in, line_s));
+        }
+        return mark;
+      }
+      case RoadInfoType::MarkTypeLine:
+        return ReadMarkTypeLine(in, s);
+      case RoadInfoType::Speed: {
+        const auto speed = in.ReadValue<double>();
+        auto speed_type = in.ReadString();
+        return std::make_unique<RoadInfoSpeed>(s, speed, speed_type);
+      }
+      case RoadInfoType::Crosswalk: {
+        auto name = in.ReadString();
+        const auto t = in.ReadValue<double>();
+        const auto z_offset = in.ReadValue<double>();
+        const auto heading = in.ReadValue<double>();
+        const auto pitch = in.ReadValue<double>();
+        const auto roll = in.ReadValue<double>();
+        auto orientation = in.ReadString();
+        const auto width = in.ReadValue<double>();
+        const auto length = in.ReadValue<double>();
+        std::vector<CrosswalkPoint> points;
+        const size_t number_of_points = in.ReadSize(3u * sizeof(double));
+        points.reserve(number_of_points);
+        for (size_t i = 0u; i < number_of_points; ++i) {
+          const auto u = in.ReadValue<double>();
+          const auto v = in.ReadValue<double>();
+          const auto z = in.ReadValue<double>();
+          points.emplace_back(u, v, z);
+        }
+        return std::make_unique<RoadInfoCrosswalk>(
+            s, std::move(name), t, z_offset, heading, pitch, roll,
+            std::move(orientation), width, length, std::move(points));
+      }
+      case RoadInfoType::Signal: {
+        auto signal_id = in.ReadString();
+        const auto road_id = in.ReadValue<RoadId>();
+        const auto signal_s = in.ReadValue<double>();
+        const auto t = in.ReadValue<double>();
+        auto orientation = in.ReadString();
+        auto it = data._signals.find(signal_id);
+        Signal *signal = it != data._signals.end() ? it->second.get() : nullptr;
+        auto info = std::make_unique<RoadInfoSignal>(
+            signal_id, signal, road_id, signal_s, t, std::move(orientation));
+        const size_t number_of_validities = in.ReadSize(2u * sizeof(LaneId));
+        for (size_t i = 0u; i < number_of_validities; ++i) {
+          const auto from_lane = in.ReadValue<LaneId>();
+          const auto to_lane = in.ReadValue<LaneId>();
+          info->_validities.emplace_back(from_lane, to_lane);
+        }
+        return info;
+      }
+      case RoadInfoType::Unknown:
+        break;
+    }
+    return nullptr;
+  }
+
+  // ===========================================================================
+  // -- Geometries -------------------------------------------------------------
+  // ===========================================================================
+
+  void MapSerializer::WriteGeometry(Writer &out, const Geometry &geometry) {
+    out.WriteValue(geometry.GetType());
+    out.WriteValue(geometry.GetStartOffset());
+    out.WriteValue(geometry.GetLength());
+    out.WriteValue(geometry.GetHeading());
+    out.WriteValue(geometry.GetStartPosition());
+    switch (geometry.GetType()) {
+      case GeometryType::LINE:
+        break;
+      case GeometryType::ARC:
+        out.WriteValue(static_cast<const GeometryArc &>(geometry).GetCurvature());
+        break;
+      case GeometryType::SPIRAL: {
+        const auto &spiral = static_cast<const GeometrySpiral &>(geometry);
+        out.WriteValue(spiral._curve_start);
+        out.WriteValue(spiral._curve_end);
+        out.WriteValue(spiral._table_step);
+        out.WriteArray(spiral._table);
+        break;
+      }
+      case GeometryType::POLY3: {
+        const auto &poly = static_cast<const GeometryPoly3 &>(geometry);
+        out.WriteValue(poly.Geta());
+        out.WriteValue(poly.Getb());
+        out.WriteValue(poly.Getc());
+        out.WriteValue(poly.Getd());
+        break;
+      }
+      case GeometryType::POLY3PARAM: {
+        const auto &poly = static_cast<const GeometryParamPoly3 &>(geometry);
+        out.WriteValue(poly.GetaU());
+        out.WriteValue(poly.GetbU());
+        out.WriteValue(poly.GetcU());
+        out.WriteValue(poly.GetdU());
+        out.WriteValue(poly.GetaV());
+        out.WriteValue(poly.GetbV());
+        out.WriteValue(poly.GetcV());
+        out.WriteValue(poly.GetdV());
+        out.WriteBool(poly.IsArcLength());
+        break;
+      }
+      default:
+        out.Fail();
+        break;
+    }
+  }
+
+  std::unique_ptr<Geometry> MapSerializer::ReadGeometry(Reader &in) {
+    const auto type = in.ReadValue<GeometryType>();
+    const auto start_offset = in.ReadValue<double>();
+    const auto length = in.ReadValue<double>();
+    const auto heading = in.ReadValue<double>();
+    const auto start_position = in.ReadValue<geom::Location>();
+    if (in.Failed()) {
+      return nullptr;
+    }
+    switch (type) {
+      case GeometryType::LINE:
+        return std::make_unique<GeometryLine>(start_offset, length, heading, start_position);
+      case GeometryType::ARC: {
+        const auto curvature = in.ReadValue<double>();
+        return std::make_unique<GeometryArc>(
+            start_offset, length, heading, start_position, curvature);
+      }
+      case GeometryType::SPIRAL: {
+        const auto curve_start = in.ReadValue<double>();
+        const auto curve_end = in.ReadValue<double>();
+        auto spiral = std::make_unique<GeometrySpiral>(
+            start_offset, length, heading, start_position, curve_start, curve_end);
+        spiral->_table_step = in.ReadValue<double>();
+        in.ReadArray(spiral->_table);
+        return spiral;
+      }
+      case GeometryType::POLY3: {
+        const auto a = in.ReadValue<double>();
+        const auto b = in.ReadValue<double>();
+        const auto c = in.ReadValue<double>();
+        const auto d = in.ReadValue<double>();
+        return std::make_unique<GeometryPoly3>(
+            start_offset, length, heading, start_position, a, b, c, d);
+      }
+      case GeometryType::POLY3PARAM: {
+        const auto aU = in.ReadValue<double>();
+        const auto bU = in.ReadValue<double>();
+        const auto cU = in.ReadValue<double>();
+        const auto dU = in.ReadValue<double>();
+        const auto aV = in.ReadValue<double>();
+        const auto bV = in.ReadValue<double>();
+        const auto cV = in.ReadValue<double>();
+        const auto dV = in.ReadValue<double>();
+        const bool arc_length = in.ReadBool();
+        return std::make_unique<GeometryParamPoly3>(
+            start_offset, length, heading, start_position,
+            aU, bU, cU, dU, aV, bV, cV, dV, arc_length);
+      }
+      default:
+        return nullptr;
+    }
+  }
+
+  // ===========================================================================
+  // -- Junctions, signals and controllers -------------------------------------
+  // ===========================================================================
+
+  template <typename WriterT, typename T>
+  static void WriteSet(WriterT &out, const std::set<T> &set) {
+    out.WriteSize(set.size());
+    for (const auto &value : set) {
+      out.WriteValue(value);
+    }
+  }
+
+  template <typename WriterT>
+  static void WriteSet(WriterT &out, const std::set<std::string> &set) {
+    out.WriteSize(set.size());
+    for (const auto &value : set) {
+      out.WriteString(value);
+    }
+  }
+
+  template <typename T, typename ReaderT>
+  static std::set<T> ReadSet(ReaderT &in) {
+    std::set<T> result;
+    const size_t size = in.ReadSize(sizeof(T));
+    for (size_t i = 0u; i < size; ++i) {
+      result.emplace(in.template ReadValue<T>());
+    }
+    return result;
+  }
+
+  template <typename ReaderT>
+  static std::set<std::string> ReadStringSet(ReaderT &in) {
+    std::set<std::string> result;
+    const size_t size = in.ReadSize(sizeof(uint32_t));
+    for (size_t i = 0u; i < size; ++i) {
+      result.emplace(in.ReadString());
+    }
+    return result;
+  }
+
+  void MapSerializer::WriteJunction(Writer &out, const Junction &junction) {
+    out.WriteValue(junction._id);
+    out.WriteString(junction._name);
+    out.WriteSize(junction._connections.size());
+    for (const auto *pair : SortedByKey(junction._connections)) {
+      const auto &connection = pair->second;
+      out.WriteValue(connection.id);
+      out.WriteValue(connection.incoming_road);
+      out.WriteValue(connection.connecting_road);
+      out.WriteSize(connection.lane_links.size());
+      for (const auto &link : connection.lane_links) {
+        out.WriteValue(link.from);
+        out.WriteValue(link.to);
+      }
+    }
+    WriteSet(out, junction._controllers);
+    out.WriteSize(junction._road_conflicts.size());
+    for (const auto *pair : SortedByKey(junction._road_conflicts)) {
+      out.WriteValue(pair->first);
+      WriteSet(out, std::set<RoadId>(pair->second.begin(), pair->second.end()));
+    }
+    out.WriteValue(junction._bounding_box);
+  }
+
+  bool MapSerializer::ReadJunction(Reader &in, MapData &data) {
+    const auto id = in.ReadValue<JuncId>();
+    Junction junction(id, in.ReadString());
+    const size_t number_of_connections = in.ReadSize(3u * sizeof(uint32_t));
+    for (size_t i = 0u; i < number_of_connections; ++i) {
+      const auto connection_id = in.ReadValue<ConId>();
+      const auto incoming_road = in.ReadValue<RoadId>();
+      const auto connecting_road = in.ReadValue<RoadId>();
+      auto &connection = junction._connections.emplace(
+          connection_id,
+          Junction::Connection(connection_id, incoming_road, connecting_road)).first->second;
+      const size_t number_of_links = in.ReadSize(2u * sizeof(LaneId));
+      for (size_t j = 0u; j < number_of_links; ++j) {
+        const auto from = in.ReadValue<LaneId>();
+        const auto to = in.ReadValue<LaneId>();
+        connection.AddLaneLink(from, to);
+      }
+    }
+    junction._controllers = ReadStringSet(in);
+    const size_t number_of_conflicts = in.ReadSize(sizeof(RoadId));
+    for (size_t i = 0u; i < number_of_conflicts; ++i) {
+      const auto road_id = in.ReadValue<RoadId>();
+      const auto conflicts = ReadSet<RoadId>(in);
+      junction._road_conflicts[road_id].insert(conflicts.begin(), conflicts.end());
+    }
+    junction._bounding_box = in.ReadValue<geom::BoundingBox>();
+    return !in.Failed() && data._junctions.emplace(id, std::move(junction)).second;
+  }
+
+  void MapSerializer::WriteSignal(Writer &out, const Signal &signal) {
+    out.WriteValue(signal._road_id);
+    out.WriteString(signal._signal_id);
+    out.WriteValue(signal._s);
+    out.WriteValue(signal._t);
+    out.WriteString(signal._name);
+    out.WriteString(signal._dynamic);
+    out.WriteString(signal._orientation);
+    out.WriteValue(signal._zOffset);
+    out.WriteString(signal._country);
+    out.WriteString(signal._type);
+    out.WriteString(signal._subtype);
+    out.WriteValue(signal._value);
+    out.WriteString(signal._unit);
+    out.WriteValue(signal._height);
+    out.WriteValue(signal._width);
+    out.WriteString(signal._text);
+    out.WriteValue(signal._hOffset);
+    out.WriteValue(signal._pitch);
+    out.WriteValue(signal._roll);
+    out.WriteSize(signal._dependencies.size());
+    for (const auto &dependency : signal._dependencies) {
+      out.WriteString(dependency._dependency_id);
+      out.WriteString(dependency._type);
+    }
+    out.WriteValue(signal._transform);
+    WriteSet(out, signal._controllers);
+    out.WriteBool(signal._using_inertial_position);
+  }
+
+  bool MapSerializer::ReadSignal(Reader &in, MapData &data) {
+    const auto road_id = in.ReadValue<RoadId>();
+    auto signal_id = in.ReadString();
+    const auto s = in.ReadValue<double>();
+    const auto t = in.ReadValue<double>();
+    auto name = in.ReadString();
+    auto dynamic = in.ReadString();
+    auto orientation = in.ReadString();
+    const auto z_offset = in.ReadValue<double>();
+    auto country = in.ReadString();
+    auto type = in.ReadString();
+    auto subtype = in.ReadString();
+    const auto value = in.ReadValue<double>();
+    auto unit = in.ReadString();
+    const auto height = in.ReadValue<double>();
+    const auto width = in.ReadValue<double>();
+    auto text = in.ReadString();
+    const auto h_offset = in.ReadValue<double>();
+    const auto pitch = in.ReadValue<double>();
+    const auto roll = in.ReadValue<double>();
+    auto signal = std::make_unique<Signal>(
+        road_id, signal_id, s, t, std::move(name), std::move(dynamic),
+        std::move(orientation), z_offset, std::move(country), std::move(type),
+        std::move(subtype), value, std::move(unit), height, width, std::move(text),
+        h_offset, pitch, roll);
+    const size_t number_of_dependencies = in.ReadSize(2u * sizeof(uint32_t));
+    for (size_t i = 0u; i < number_of_dependencies; ++i) {
+      auto dependency_id = in.ReadString();
+      auto dependency_type = in.ReadString();
+      signal->_dependencies.emplace_back(std::move(dependency_id), std::move(dependency_type));
+    }
+    signal->_transform = in.ReadValue<geom::Transform>();
+    signal->_controllers = ReadStringSet(in);
+    signal->_using_inertial_position = in.ReadBool();
+    return !in.Failed() && data._signals.emplace(std::move(signal_id), std::move(signal)).second;
+  }
+
+  void MapSerializer::WriteController(Writer &out, const Controller &controller) {
+    out.WriteString(controller._id);
+    out.WriteString(controller._name);
+    out.WriteValue(controller._sequence);
+    WriteSet(out, controller._junctions);
+    WriteSet(out, controller._signals);
+  }
+
+  bool MapSerializer::ReadController(Reader &in, MapData &data) {
+    auto id = in.ReadString();
+    auto name = in.ReadString();
+    const auto sequence = in.ReadValue<uint32_t>();
+    auto controller = std::make_unique<Controller>(id, std::move(name), sequence);
+    controller->_junctions = ReadSet<JuncId>(in);
+    controller->_signals = ReadStringSet(in);
+    return !in.Failed() && data._controllers.emplace(std::move(id), std::move(controller)).second;
+  }
+
+} // namespace road
+} // namespace carla
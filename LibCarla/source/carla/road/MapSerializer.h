@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/road/Map.h"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  /// Versioned binary format of a fully built Map, the map data and the
+  /// R-tree, used to cache maps and skip parsing their OpenDRIVE file.
+  ///
+  /// Values are stored in the byte order of the host and read in place, so a
+  /// map can be restored directly from a memory-mapped file.
+  class MapSerializer {
+  public:
+
+    /// Hash of the OpenDRIVE contents, identifies the serialized maps.
+    static uint64_t HashOpenDrive(const std::string &opendrive);
+
+    /// Serialize @a map, built from the OpenDRIVE file with hash
+    /// @a opendrive_hash.
+    static std::vector<uint8_t> Serialize(const Map &map, uint64_t opendrive_hash);
+
+    /// Restore a map serialized with Serialize. Returns an empty optional if
+    /// the data is truncated or corrupt, was written with another version of
+    /// the format, or belongs to another OpenDRIVE file.
+    static boost::optional<Map> Deserialize(
+        const uint8_t *data,
+        size_t size,
+        uint64_t opendrive_hash);
+
+  private:
+
+    class Writer;
+
+    class Reader;
+
+    static void WriteRoad(Writer &out, const Road &road);
+
+    static void WriteInformationSet(Writer &out, const InformationSet &info);
+
+    static void WriteRoadInfo(Writer &out, element::RoadInfo &info);
+
+    static void WriteGeometry(Writer &out, const element::Geometry &geometry);
+
+    static void WriteJunction(Writer &out, const Junction &junction);
+
+    static void WriteSignal(Writer &out, const Signal &signal);
+
+    static void WriteController(Writer &out, const Controller &controller);
+
+    static bool ReadRoad(Reader &in, MapData &data);
+
+    static bool ResolveRoadLinks(Reader &in, MapData &data);
+
+    static std::vector<std::unique_ptr<element::RoadInfo>> ReadInformationSet(
+        Reader &in,
+        MapData &data);
+
+    static std::unique_ptr<element::RoadInfo> ReadRoadInfo(Reader &in, MapData &data);
+
+    static std::unique_ptr<element::Geometry> ReadGeometry(Reader &in);
+
+    static bool ReadJunction(Reader &in, MapData &data);
+
+    static bool ReadSignal(Reader &in, MapData &data);
+
+    static bool ReadController(Reader &in, MapData &data);
+  };
+
+} // namespace road
+} // namespace carla
@@ -18,6 +18,9 @@
 namespace carla {
 namespace road {
 
+  class MapBuilder;
+  class MapSerializer;
+
   enum SignalOrientation {
     Positive,
     Negative,
@@ -179,6 +182,7 @@ namespace road {
 
   private:
     friend MapBuilder;
+    friend MapSerializer;
 
     RoadId _road_id;
 
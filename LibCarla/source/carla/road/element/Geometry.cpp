@@ -19,6 +19,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <limits>
 #include <stdexcept>
 
 namespace carla {
@@ -66,32 +68,62 @@ namespace element {
     static_cast<float>(y * cos_a + x * sin_a));
   }
 
-  DirectedPoint GeometrySpiral::PosFromDist(double dist) const {
+  // Nearest point to @a location of the polyline defined by the @a count
+  // samples returned by @a get_sample, as a pair of distance along the
+  // polyline and distance to the polyline.
+  template <typename SampleFuncT>
+  static std::pair<float, float> DistanceToPolyline(
+      const geom::Location &location,
+      const size_t count,
+      SampleFuncT &&get_sample) {
+    DEBUG_ASSERT(count >= 2u);
+    std::pair<float, float> result{0.0f, std::numeric_limits<float>::max()};
+    auto last = get_sample(0u);
+    for (auto i = 1u; i < count; ++i) {
+      auto current = get_sample(i);
+      auto distance = geom::Math::DistanceSegmentToPoint(location, last.second, current.second);
+      if (distance.second < result.second) {
+        result = {static_cast<float>(last.first) + distance.first, distance.second};
+      }
+      last = current;
+    }
+    return result;
+  }
+
+  GeometrySpiral::GeometrySpiral(
+      const double start_offset,
+      const double length,
+      const double heading,
+      const geom::Location &start_pos,
+      const double curv_s,
+      const double curv_e)
+    : Geometry(GeometryType::SPIRAL, start_offset, length, heading, start_pos),
+      _curve_start(curv_s),
+      _curve_end(curv_e),
+      _curve_dot((curv_e - curv_s) / length),
+      _s_o(curv_s / _curve_dot) {
+    odrSpiral(_s_o, _curve_dot, &_x_o, &_y_o, &_t_o);
+  }
+
+  double GeometrySpiral::TangentFromDist(const double dist) const {
+    return _curve_start * dist + 0.5 * _curve_dot * dist * dist;
+  }
+
+  DirectedPoint GeometrySpiral::PosFromDistExact(double dist) const {
     dist = geom::Math::Clamp(dist, 0.0, _length);
     DEBUG_ASSERT(_length > 0.0);
     DirectedPoint p(_start_position, _heading);
 
-    const double curve_end = (_curve_end);
-    const double curve_start = (_curve_start);
-    const double curve_dot = (curve_end - curve_start) / (_length);
-    const double s_o = curve_start / curve_dot;
-    double s = s_o + dist;
-
     double x;
     double y;
     double t;
-    odrSpiral(s, curve_dot, &x, &y, &t);
-
-    double x_o;
-    double y_o;
-    double t_o;
-    odrSpiral(s_o, curve_dot, &x_o, &y_o, &t_o);
+    odrSpiral(_s_o + dist, _curve_dot, &x, &y, &t);
 
-    x = x - x_o;
-    y = y - y_o;
-    t = t - t_o;
+    x = x - _x_o;
+    y = y - _y_o;
+    t = t - _t_o;
 
-    geom::Vector2D pos = RotatebyAngle(_heading - t_o, x, y);
+    geom::Vector2D pos = RotatebyAngle(_heading - _t_o, x, y);
     p.location.x += pos.x;
     p.location.y += pos.y;
     p.tangent = _heading + t;
@@ -99,19 +131,143 @@ namespace element {
     return p;
   }
 
-  /// @todo
+  DirectedPoint GeometrySpiral::PosFromDist(double dist) const {
+    if (_table.empty()) {
+      return PosFromDistExact(dist);
+    }
+    dist = geom::Math::Clamp(dist, 0.0, _length);
+    // Cubic Hermite interpolation between the two closest samples, using the
+    // exact tangents as derivatives.
+    const size_t index = std::min(
+        static_cast<size_t>(dist / _table_step),
+        _table.size() - 2u);
+    const double s0 = static_cast<double>(index) * _table_step;
+    const double tau = (dist - s0) / _table_step;
+    const double tau2 = tau * tau;
+    const double tau3 = tau2 * tau;
+    const double h00 = 2.0 * tau3 - 3.0 * tau2 + 1.0;
+    const double h10 = (tau3 - 2.0 * tau2 + tau) * _table_step;
+    const double h01 = -2.0 * tau3 + 3.0 * tau2;
+    const double h11 = (tau3 - tau2) * _table_step;
+    const auto &p0 = _table[index];
+    const auto &p1 = _table[index + 1u];
+    const double x = h00 * p0.x + h10 * p0.cos_t + h01 * p1.x + h11 * p1.cos_t;
+    const double y = h00 * p0.y + h10 * p0.sin_t + h01 * p1.y + h11 * p1.sin_t;
+
+    DirectedPoint p(_start_position, _heading + TangentFromDist(dist));
+    p.location.x += static_cast<float>(x);
+    p.location.y += static_cast<float>(y);
+    return p;
+  }
+
+  size_t GeometrySpiral::BuildLookupTable(const double max_error, const size_t max_bytes) {
+    DEBUG_ASSERT(_length > 0.0);
+    DEBUG_ASSERT(max_error > 0.0);
+    _table.clear();
+    _table_step = 0.0;
+    // The error of the cubic Hermite interpolation is bounded by
+    // step^4 / 384 * max|p(4)|. For a curve parametrized by arc length with
+    // linear curvature k, |p(4)| = sqrt(9 k^2 k'^2 + k^6), maximum where |k|
+    // is maximum, i.e., at one of the ends.
+    const double max_curvature = std::max(std::abs(_curve_start), std::abs(_curve_end));
+    const double k2 = max_curvature * max_curvature;
+    const double fourth_derivative = std::sqrt(
+        9.0 * k2 * _curve_dot * _curve_dot + k2 * k2 * k2);
+    double max_step = _length;
+    if (fourth_derivative > 0.0) {
+      max_step = std::min(max_step, std::pow(384.0 * max_error / fourth_derivative, 0.25));
+    }
+    if (!std::isfinite(max_step) || (max_step <= 0.0)) {
+      return 0u;
+    }
+    const double number_of_intervals = std::ceil(_length / max_step);
+    const double bytes = (number_of_intervals + 1.0) * static_cast<double>(sizeof(TableSample));
+    if (bytes > static_cast<double>(max_bytes)) {
+      return 0u;
+    }
+    const size_t size = static_cast<size_t>(number_of_intervals) + 1u;
+    const double step = _length / number_of_intervals;
+    std::vector<TableSample> table;
+    table.reserve(size);
+    const double cos_a = std::cos(_heading - _t_o);
+    const double sin_a = std::sin(_heading - _t_o);
+    for (auto i = 0u; i < size; ++i) {
+      const double dist = std::min(static_cast<double>(i) * step, _length);
+      double x;
+      double y;
+      double t;
+      odrSpiral(_s_o + dist, _curve_dot, &x, &y, &t);
+      x -= _x_o;
+      y -= _y_o;
+      const double tangent = _heading + TangentFromDist(dist);
+      table.emplace_back(TableSample{
+          x * cos_a - y * sin_a,
+          y * cos_a + x * sin_a,
+          std::cos(tangent),
+          std::sin(tangent)});
+    }
+    _table = std::move(table);
+    _table_step = step;
+    return _table.size() * sizeof(TableSample);
+  }
+
   std::pair<float, float> GeometrySpiral::DistanceTo(const geom::Location &location) const {
-    // Not analytic, discretize and find nearest point
-    // throw_exception(std::runtime_error("not implemented"));
-    return {location.x - _start_position.x, location.y - _start_position.y};
+    // Not analytic, find the nearest point of the polyline through the samples
+    // of the table, or through samples every meter if there is no table.
+    std::pair<float, float> nearest;
+    double step;
+    if (!_table.empty()) {
+      step = _table_step;
+      nearest = DistanceToPolyline(location, _table.size(), [this](size_t i) {
+        geom::Location sample = _start_position;
+        sample.x += static_cast<float>(_table[i].x);
+        sample.y += static_cast<float>(_table[i].y);
+        return std::make_pair(static_cast<double>(i) * _table_step, sample);
+      });
+    } else {
+      const size_t count = static_cast<size_t>(std::ceil(_length)) + 1u;
+      step = _length / static_cast<double>(count - 1u);
+      nearest = DistanceToPolyline(location, count, [this, step](size_t i) {
+        const double dist = static_cast<double>(i) * step;
+        return std::make_pair(dist, PosFromDistExact(dist).location);
+      });
+    }
+    // Refine the nearest point on the spiral around the nearest point of the
+    // polyline.
+    auto distance_at = [&](double dist) {
+      return geom::Math::Distance2D(PosFromDist(dist).location, location);
+    };
+    double lower = std::max(0.0, static_cast<double>(nearest.first) - step);
+    double upper = std::min(_length, static_cast<double>(nearest.first) + step);
+    for (auto i = 0u; i < 32u; ++i) {
+      const double third = (upper - lower) / 3.0;
+      if (distance_at(lower + third) < distance_at(upper - third)) {
+        upper -= third;
+      } else {
+        lower += third;
+      }
+    }
+    const double dist = 0.5 * (lower + upper);
+    return {static_cast<float>(dist), distance_at(dist)};
   }
 
-  DirectedPoint GeometryPoly3::PosFromDist(double dist) const {
-    auto result = _rtree.GetNearestNeighbours(
-        Rtree::BPoint(static_cast<float>(dist))).front();
+  // Index of the first sample of the segment of @a samples containing @a dist,
+  // the first or last segment if @a dist is out of range.
+  template <typename SampleT>
+  static size_t FindSplineSegment(const std::vector<SampleT> &samples, const double dist) {
+    DEBUG_ASSERT(samples.size() >= 2u);
+    auto it = std::upper_bound(
+        samples.begin() + 1,
+        samples.end() - 1,
+        dist,
+        [](double value, const SampleT &sample) { return value < sample.s; });
+    return static_cast<size_t>(std::distance(samples.begin(), it)) - 1u;
+  }
 
-    auto &val1 = result.second.first;
-    auto &val2 = result.second.second;
+  DirectedPoint GeometryPoly3::PosFromDist(double dist) const {
+    const size_t index = FindSplineSegment(_samples, dist);
+    auto &val1 = _samples[index];
+    auto &val2 = _samples[index + 1u];
 
     double rate = (val2.s - dist) / (val2.s - val1.s);
     double u = rate * val1.u + (1.0 - rate) * val2.u;
@@ -125,10 +281,16 @@ namespace element {
     return p;
   }
 
-  std::pair<float, float> GeometryPoly3::DistanceTo(const geom::Location & /*p*/) const {
-    // No analytical expression (Newton-Raphson?/point search)
-    // throw_exception(std::runtime_error("not implemented"));
-    return {_start_position.x, _start_position.y};
+  std::pair<float, float> GeometryPoly3::DistanceTo(const geom::Location &location) const {
+    // No analytical expression, find the nearest point of the polyline through
+    // the samples.
+    return DistanceToPolyline(location, _samples.size(), [this](size_t i) {
+      const auto &sample = _samples[i];
+      const geom::Vector2D pos = RotatebyAngle(_heading, sample.u, sample.v);
+      return std::make_pair(
+          sample.s,
+          geom::Location(_start_position.x + pos.x, _start_position.y + pos.y, 0.0f));
+    });
   }
 
   void GeometryPoly3::PreComputeSpline() {
@@ -139,8 +301,8 @@ namespace element {
     double current_u = 0;
     double last_u = 0;
     double last_v = _poly.Evaluate(current_u);
-    double last_s = 0;
-    RtreeValue last_val{last_u, last_v, last_s, _poly.Tangent(current_u)};
+    _samples.clear();
+    _samples.emplace_back(SplineSample{last_u, last_v, current_s, _poly.Tangent(current_u)});
     while (current_s < _length + delta_u) {
       current_u += delta_u;
       double current_v = _poly.Evaluate(current_u);
@@ -149,26 +311,18 @@ namespace element {
       double ds = sqrt(du * du + dv * dv);
       current_s += ds;
       double current_t = _poly.Tangent(current_u);
-      RtreeValue current_val{current_u, current_v, current_s, current_t};
-
-      Rtree::BPoint p1(static_cast<float>(last_s));
-      Rtree::BPoint p2(static_cast<float>(current_s));
-      _rtree.InsertElement(Rtree::BSegment(p1, p2), last_val, current_val);
+      _samples.emplace_back(SplineSample{current_u, current_v, current_s, current_t});
 
       last_u = current_u;
       last_v = current_v;
-      last_s = current_s;
-      last_val = current_val;
-
     }
   }
 
   DirectedPoint GeometryParamPoly3::PosFromDist(double dist) const {
-    auto result = _rtree.GetNearestNeighbours(
-        Rtree::BPoint(static_cast<float>(dist))).front();
+    const size_t index = FindSplineSegment(_samples, dist);
+    auto &val1 = _samples[index];
+    auto &val2 = _samples[index + 1u];
 
-    auto &val1 = result.second.first;
-    auto &val2 = result.second.second;
     double rate = (val2.s - dist) / (val2.s - val1.s);
     double u = rate * val1.u + (1.0 - rate) * val2.u;
     double v = rate * val1.v + (1.0 - rate) * val2.v;
@@ -182,10 +336,17 @@ namespace element {
     p.location.y += pos.y;
     return p;
   }
-  std::pair<float, float> GeometryParamPoly3::DistanceTo(const geom::Location &) const {
-    // No analytical expression (Newton-Raphson?/point search)
-    // throw_exception(std::runtime_error("not implemented"));
-    return {_start_position.x, _start_position.y};
+
+  std::pair<float, float> GeometryParamPoly3::DistanceTo(const geom::Location &location) const {
+    // No analytical expression, find the nearest point of the polyline through
+    // the samples.
+    return DistanceToPolyline(location, _samples.size(), [this](size_t i) {
+      const auto &sample = _samples[i];
+      const geom::Vector2D pos = RotatebyAngle(_heading, sample.u, sample.v);
+      return std::make_pair(
+          sample.s,
+          geom::Location(_start_position.x + pos.x, _start_position.y + pos.y, 0.0f));
+    });
   }
 
   void GeometryParamPoly3::PreComputeSpline() {
@@ -201,13 +362,14 @@ namespace element {
     double current_s = 0;
     double last_u = _polyU.Evaluate(param_p);
     double last_v = _polyV.Evaluate(param_p);
-    double last_s = 0;
-    RtreeValue last_val{
+    _samples.clear();
+    _samples.reserve(number_intervals + 1u);
+    _samples.emplace_back(SplineSample{
         last_u,
         last_v,
-        last_s,
+        current_s,
         _polyU.Tangent(param_p),
-        _polyV.Tangent(param_p) };
+        _polyV.Tangent(param_p) });
     for(size_t i = 0; i < number_intervals; ++i) {
       param_p += delta_p;
       double current_u = _polyU.Evaluate(param_p);
@@ -216,23 +378,15 @@ namespace element {
       double dv = current_v - last_v;
       double ds = sqrt(du * du + dv * dv);
       current_s += ds;
-      double current_t_u = _polyU.Tangent(param_p);
-      double current_t_v = _polyV.Tangent(param_p);
-      RtreeValue current_val{
+      _samples.emplace_back(SplineSample{
           current_u,
           current_v,
           current_s,
-          current_t_u,
-          current_t_v };
-
-      Rtree::BPoint p1(static_cast<float>(last_s));
-      Rtree::BPoint p2(static_cast<float>(current_s));
-      _rtree.InsertElement(Rtree::BSegment(p1, p2), last_val, current_val);
+          _polyU.Tangent(param_p),
+          _polyV.Tangent(param_p) });
 
       last_u = current_u;
       last_v = current_v;
-      last_s = current_s;
-      last_val = current_val;
 
       if(current_s > _length){
         break;
@@ -9,10 +9,14 @@
 #include "carla/geom/Location.h"
 #include "carla/geom/Math.h"
 #include "carla/geom/CubicPolynomial.h"
-#include "carla/geom/Rtree.h"
+
+#include <vector>
 
 namespace carla {
 namespace road {
+
+  class MapSerializer;
+
 namespace element {
 
   enum class GeometryType : unsigned int {
@@ -23,6 +27,20 @@ namespace element {
     POLY3PARAM
   };
 
+  /// Settings of the arc-length lookup tables precomputed at map load for
+  /// the geometries without a closed-form expression.
+  struct GeometryLookupTableSettings {
+    /// Whether spirals precompute a lookup table, they are evaluated exactly
+    /// on every query otherwise.
+    bool enabled = true;
+    /// Maximum distance between an interpolated point and the exact one
+    /// [meters].
+    double max_error = 1e-4;
+    /// Maximum memory used by the lookup tables of all the spirals of a map,
+    /// spirals that don't fit are evaluated exactly.
+    size_t max_bytes = 64u * 1024u * 1024u;
+  };
+
   struct DirectedPoint {
 
     DirectedPoint()
@@ -62,7 +80,7 @@ namespace element {
       return _heading;
     }
 
-    const geom::Location &GetStartPosition() {
+    const geom::Location &GetStartPosition() const {
       return _start_position;
     }
 
@@ -170,16 +188,13 @@ namespace element {
         double heading,
         const geom::Location &start_pos,
         double curv_s,
-        double curv_e)
-      : Geometry(GeometryType::SPIRAL, start_offset, length, heading, start_pos),
-        _curve_start(curv_s),
-        _curve_end(curv_e) {}
+        double curv_e);
 
-    double GetCurveStart() {
+    double GetCurveStart() const {
       return _curve_start;
     }
 
-    double GetCurveEnd() {
+    double GetCurveEnd() const {
       return _curve_end;
     }
 
@@ -187,10 +202,50 @@ namespace element {
 
     std::pair<float, float> DistanceTo(const geom::Location &) const override;
 
+    /// Precompute the positions of the spiral at regular intervals of s, close
+    /// enough to interpolate between them with an error below @a max_error.
+    /// The table is not built if it needs more than @a max_bytes. Returns the
+    /// memory used by the table.
+    size_t BuildLookupTable(double max_error, size_t max_bytes);
+
+    bool HasLookupTable() const {
+      return !_table.empty();
+    }
+
   private:
 
+    friend MapSerializer;
+
+    /// Evaluates the Fresnel integrals of the spiral.
+    DirectedPoint PosFromDistExact(double dist) const;
+
+    /// Tangent at @a dist relative to the heading, the curvature changes
+    /// linearly so it has a closed-form expression.
+    double TangentFromDist(double dist) const;
+
+    struct TableSample {
+      double x;
+      double y;
+      /// Direction of the tangent.
+      double cos_t;
+      double sin_t;
+    };
+
     double _curve_start;
     double _curve_end;
+
+    /// Derivative of the curvature and the values of the standard spiral at
+    /// the start of this one.
+    double _curve_dot;
+    double _s_o;
+    double _x_o;
+    double _y_o;
+    double _t_o;
+
+    /// Offset from the start position of the samples of the table, separated
+    /// by _table_step meters.
+    std::vector<TableSample> _table;
+    double _table_step = 0.0;
   };
 
   class GeometryPoly3 final : public Geometry {
@@ -240,15 +295,15 @@ namespace element {
     double _c;
     double _d;
 
-    struct RtreeValue {
+    struct SplineSample {
       double u = 0;
       double v = 0;
       double s = 0;
       double t = 0;
     };
-    using Rtree = geom::SegmentCloudRtree<RtreeValue, 1>;
-    using TreeElement = Rtree::TreeElement;
-    Rtree _rtree;
+
+    /// Samples of the polynomial sorted by s.
+    std::vector<SplineSample> _samples;
     void PreComputeSpline();
   };
 
@@ -308,6 +363,9 @@ namespace element {
     double GetdV() const {
       return _dV;
     }
+    bool IsArcLength() const {
+      return _arcLength;
+    }
 
     DirectedPoint PosFromDist(double dist) const override;
 
@@ -327,16 +385,16 @@ namespace element {
     double _dV;
     bool _arcLength;
 
-    struct RtreeValue {
+    struct SplineSample {
       double u = 0;
       double v = 0;
       double s = 0;
       double t_u = 0;
       double t_v = 0;
     };
-    using Rtree = geom::SegmentCloudRtree<RtreeValue, 1>;
-    using TreeElement = Rtree::TreeElement;
-    Rtree _rtree;
+
+    /// Samples of the polynomials sorted by s.
+    std::vector<SplineSample> _samples;
     void PreComputeSpline();
   };
 
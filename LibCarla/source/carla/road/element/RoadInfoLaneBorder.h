@@ -32,6 +32,10 @@ namespace element {
       : RoadInfo(s),
         _border(a, b, c, d, s) {}
 
+    RoadInfoLaneBorder(double s, const geom::CubicPolynomial &border)
+      : RoadInfo(s),
+        _border(border) {}
+
     void AcceptVisitor(RoadInfoVisitor &v) final {
       v.Visit(*this);
     }
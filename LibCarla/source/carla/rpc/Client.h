@@ -33,6 +33,14 @@ namespace rpc {
       return _client.call(function, Metadata::MakeSync(), std::forward<Args>(args)...);
     }
 
+    /// Call @a function without waiting for the response, the returned future
+    /// holds the response once it arrives. Use it to have several calls in
+    /// flight at once.
+    template <typename... Args>
+    auto async_call_with_response(const std::string &function, Args &&... args) {
+      return _client.async_call(function, Metadata::MakeSync(), std::forward<Args>(args)...);
+    }
+
     template <typename... Args>
     void async_call(const std::string &function, Args &&... args) {
       _client.async_call(function, Metadata::MakeAsync(), std::forward<Args>(args)...);
@@ -0,0 +1,377 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/rpc/CommandBatch.h"
+
+#include "carla/Debug.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+namespace carla {
+namespace rpc {
+
+  using Column = CommandBatch::Column;
+  using Type = CommandBatch::Type;
+
+  // ===========================================================================
+  // -- Layouts ----------------------------------------------------------------
+  // ===========================================================================
+
+  static_assert(sizeof(ActorId) == 4u, "Unexpected actor id size");
+  static_assert(sizeof(VehicleLightState::flag_type) == 4u, "Unexpected light state size");
+
+  static constexpr Column ACTOR{"actor", 'I', 4u, 1u};
+
+  static const Column VEHICLE_CONTROL_COLUMNS[] = {
+    ACTOR,
+    {"throttle", 'f', 4u, 1u},
+    {"steer", 'f', 4u, 1u},
+    {"brake", 'f', 4u, 1u},
+    {"gear", 'i', 4u, 1u},
+    {"hand_brake", '?', 1u, 1u},
+    {"reverse", '?', 1u, 1u},
+    {"manual_gear_shift", '?', 1u, 1u}};
+
+  static const Column WALKER_CONTROL_COLUMNS[] = {
+    ACTOR,
+    {"direction", 'f', 4u, 3u},
+    {"speed", 'f', 4u, 1u},
+    {"jump", '?', 1u, 1u}};
+
+  static const Column TRANSFORM_COLUMNS[] = {
+    ACTOR,
+    {"location", 'f', 4u, 3u},
+    {"rotation", 'f', 4u, 3u}};
+
+  static const Column WALKER_STATE_COLUMNS[] = {
+    ACTOR,
+    {"location", 'f', 4u, 3u},
+    {"rotation", 'f', 4u, 3u},
+    {"speed", 'f', 4u, 1u}};
+
+  static const Column TARGET_VELOCITY_COLUMNS[] = {
+    ACTOR,
+    {"velocity", 'f', 4u, 3u}};
+
+  static const Column LIGHT_STATE_COLUMNS[] = {
+    ACTOR,
+    {"light_state", 'I', 4u, 1u}};
+
+  struct Layout {
+    const Column *columns;
+    size_t number_of_columns;
+    /// Bytes per command.
+    size_t stride;
+  };
+
+  template <size_t N>
+  static Layout MakeLayout(const Column (&columns)[N]) {
+    size_t stride = 0u;
+    for (const auto &column : columns) {
+      stride += column.GetStride();
+    }
+    return {columns, N, stride};
+  }
+
+  static const Layout &GetLayout(const Type type) {
+    static const std::array<Layout, static_cast<size_t>(Type::SIZE)> LAYOUTS = {{
+      MakeLayout(VEHICLE_CONTROL_COLUMNS),
+      MakeLayout(WALKER_CONTROL_COLUMNS),
+      MakeLayout(TRANSFORM_COLUMNS),
+      MakeLayout(WALKER_STATE_COLUMNS),
+      MakeLayout(TARGET_VELOCITY_COLUMNS),
+      MakeLayout(LIGHT_STATE_COLUMNS)}};
+    DEBUG_ASSERT(type < Type::SIZE);
+    return LAYOUTS[static_cast<size_t>(type)];
+  }
+
+  // ===========================================================================
+  // -- CommandBatch -----------------------------------------------------------
+  // ===========================================================================
+
+  CommandBatch::CommandBatch(const Type type, const size_t size)
+    : _type(static_cast<uint8_t>(type)),
+      _size(static_cast<uint32_t>(size)),
+      _data(GetLayout(type).stride * size, 0u) {
+    DEBUG_ASSERT(size <= std::numeric_limits<uint32_t>::max());
+  }
+
+  bool CommandBatch::IsValid() const {
+    return (GetType() < Type::SIZE) &&
+           (_data.size() == GetLayout(GetType()).stride * _size);
+  }
+
+  size_t CommandBatch::GetNumberOfColumns(const Type type) {
+    return GetLayout(type).number_of_columns;
+  }
+
+  const Column &CommandBatch::GetColumn(const Type type, const size_t column) {
+    const Layout &layout = GetLayout(type);
+    DEBUG_ASSERT(column < layout.number_of_columns);
+    return layout.columns[column];
+  }
+
+  size_t CommandBatch::GetColumnOffset(const size_t column) const {
+    const Layout &layout = GetLayout(GetType());
+    size_t offset = 0u;
+    for (size_t i = 0u; i < column; ++i) {
+      offset += layout.columns[i].GetStride() * _size;
+    }
+    return offset;
+  }
+
+  unsigned char *CommandBatch::GetColumnData(const size_t column) {
+    return _data.data() + GetColumnOffset(column);
+  }
+
+  const unsigned char *CommandBatch::GetColumnData(const size_t column) const {
+    return _data.data() + GetColumnOffset(column);
+  }
+
+  template <typename T>
+  void CommandBatch::Write(const size_t column, const size_t index, const T *values) {
+    const Column &layout = GetColumn(column);
+    DEBUG_ASSERT(layout.value_size == sizeof(T));
+    DEBUG_ASSERT(index < _size);
+    std::memcpy(GetColumnData(column) + index * layout.GetStride(), values, layout.GetStride());
+  }
+
+  template <typename T>
+  void CommandBatch::Read(const size_t column, const size_t index, T *values) const {
+    const Column &layout = GetColumn(column);
+    DEBUG_ASSERT(layout.value_size == sizeof(T));
+    DEBUG_ASSERT(index < _size);
+    std::memcpy(values, GetColumnData(column) + index * layout.GetStride(), layout.GetStride());
+  }
+
+  // Booleans are stored as a byte, 0 or 1.
+  static uint8_t ToByte(const bool value) {
+    return value ? 1u : 0u;
+  }
+
+  static void ToArray(const geom::Vector3D &vector, float (&values)[3]) {
+    values[0] = vector.x;
+    values[1] = vector.y;
+    values[2] = vector.z;
+  }
+
+  static void ToArray(const geom::Rotation &rotation, float (&values)[3]) {
+    values[0] = rotation.pitch;
+    values[1] = rotation.yaw;
+    values[2] = rotation.roll;
+  }
+
+  void CommandBatch::Set(const size_t index, const Command::ApplyVehicleControl &command) {
+    DEBUG_ASSERT(GetType() == Type::ApplyVehicleControl);
+    const auto &control = command.control;
+    const uint8_t flags[] = {
+        ToByte(control.hand_brake),
+        ToByte(control.reverse),
+        ToByte(control.manual_gear_shift)};
+    Write(0u, index, &command.actor);
+    Write(1u, index, &control.throttle);
+    Write(2u, index, &control.steer);
+    Write(3u, index, &control.brake);
+    Write(4u, index, &control.gear);
+    Write(5u, index, &flags[0u]);
+    Write(6u, index, &flags[1u]);
+    Write(7u, index, &flags[2u]);
+  }
+
+  void CommandBatch::Set(const size_t index, const Command::ApplyWalkerControl &command) {
+    DEBUG_ASSERT(GetType() == Type::ApplyWalkerControl);
+    float direction[3];
+    ToArray(command.control.direction, direction);
+    const uint8_t jump = ToByte(command.control.jump);
+    Write(0u, index, &command.actor);
+    Write(1u, index, direction);
+    Write(2u, index, &command.control.speed);
+    Write(3u, index, &jump);
+  }
+
+  void CommandBatch::Set(const size_t index, const Command::ApplyTransform &command) {
+    DEBUG_ASSERT(GetType() == Type::ApplyTransform);
+    float location[3];
+    float rotation[3];
+    ToArray(command.transform.location, location);
+    ToArray(command.transform.rotation, rotation);
+    Write(0u, index, &command.actor);
+    Write(1u, index, location);
+    Write(2u, index, rotation);
+  }
+
+  void CommandBatch::Set(const size_t index, const Command::ApplyWalkerState &command) {
+    DEBUG_ASSERT(GetType() == Type::ApplyWalkerState);
+    float location[3];
+    float rotation[3];
+    ToArray(command.transform.location, location);
+    ToArray(command.transform.rotation, rotation);
+    Write(0u, index, &command.actor);
+    Write(1u, index, location);
+    Write(2u, index, rotation);
+    Write(3u, index, &command.speed);
+  }
+
+  void CommandBatch::Set(const size_t index, const Command::ApplyTargetVelocity &command) {
+    DEBUG_ASSERT(GetType() == Type::ApplyTargetVelocity);
+    float velocity[3];
+    ToArray(command.velocity, velocity);
+    Write(0u, index, &command.actor);
+    Write(1u, index, velocity);
+  }
+
+  void CommandBatch::Set(const size_t index, const Command::SetVehicleLightState &command) {
+    DEBUG_ASSERT(GetType() == Type::SetVehicleLightState);
+    Write(0u, index, &command.actor);
+    Write(1u, index, &command.light_state);
+  }
+
+  void CommandBatch::Get(const size_t index, Command::ApplyVehicleControl &command) const {
+    DEBUG_ASSERT(GetType() == Type::ApplyVehicleControl);
+    auto &control = command.control;
+    uint8_t flags[3];
+    Read(0u, index, &command.actor);
+    Read(1u, index, &control.throttle);
+    Read(2u, index, &control.steer);
+    Read(3u, index, &control.brake);
+    Read(4u, index, &control.gear);
+    Read(5u, index, &flags[0u]);
+    Read(6u, index, &flags[1u]);
+    Read(7u, index, &flags[2u]);
+    control.hand_brake = flags[0u] != 0u;
+    control.reverse = flags[1u] != 0u;
+    control.manual_gear_shift = flags[2u] != 0u;
+  }
+
+  void CommandBatch::Get(const size_t index, Command::ApplyWalkerControl &command) const {
+    DEBUG_ASSERT(GetType() == Type::ApplyWalkerControl);
+    float direction[3];
+    uint8_t jump;
+    Read(0u, index, &command.actor);
+    Read(1u, index, direction);
+    Read(2u, index, &command.control.speed);
+    Read(3u, index, &jump);
+    command.control.direction = {direction[0], direction[1], direction[2]};
+    command.control.jump = jump != 0u;
+  }
+
+  void CommandBatch::Get(const size_t index, Command::ApplyTransform &command) const {
+    DEBUG_ASSERT(GetType() == Type::ApplyTransform);
+    float location[3];
+    float rotation[3];
+    Read(0u, index, &command.actor);
+    Read(1u, index, location);
+    Read(2u, index, rotation);
+    command.transform.location = {location[0], location[1], location[2]};
+    command.transform.rotation = {rotation[0], rotation[1], rotation[2]};
+  }
+
+  void CommandBatch::Get(const size_t index, Command::ApplyWalkerState &command) const {
+    DEBUG_ASSERT(GetType() == Type::ApplyWalkerState);
+    float location[3];
+    float rotation[3];
+    Read(0u, index, &command.actor);
+    Read(1u, index, location);
+    Read(2u, index, rotation);
+    Read(3u, index, &command.speed);
+    command.transform.location = {location[0], location[1], location[2]};
+    command.transform.rotation = {rotation[0], rotation[1], rotation[2]};
+  }
+
+  void CommandBatch::Get(const size_t index, Command::ApplyTargetVelocity &command) const {
+    DEBUG_ASSERT(GetType() == Type::ApplyTargetVelocity);
+    float velocity[3];
+    Read(0u, index, &command.actor);
+    Read(1u, index, velocity);
+    command.velocity = {velocity[0], velocity[1], velocity[2]};
+  }
+
+  void CommandBatch::Get(const size_t index, Command::SetVehicleLightState &command) const {
+    DEBUG_ASSERT(GetType() == Type::SetVehicleLightState);
+    Read(0u, index, &command.actor);
+    Read(1u, index, &command.light_state);
+  }
+
+  // ===========================================================================
+  // -- MakeBatches ------------------------------------------------------------
+  // ===========================================================================
+
+  /// Type of the batch of each command, SIZE if it has none.
+  struct BatchTypeVisitor {
+    Type operator()(const Command::ApplyVehicleControl &) const { return Type::ApplyVehicleControl; }
+    Type operator()(const Command::ApplyWalkerControl &) const { return Type::ApplyWalkerControl; }
+    Type operator()(const Command::ApplyTransform &) const { return Type::ApplyTransform; }
+    Type operator()(const Command::ApplyWalkerState &) const { return Type::ApplyWalkerState; }
+    Type operator()(const Command::ApplyTargetVelocity &) const { return Type::ApplyTargetVelocity; }
+    Type operator()(const Command::SetVehicleLightState &) const { return Type::SetVehicleLightState; }
+    template <typename T>
+    Type operator()(const T &) const { return Type::SIZE; }
+  };
+
+  // Overload resolution picks the first one only for the commands with a
+  // batched form.
+  template <typename T>
+  static auto SetCommand(CommandBatch &batch, size_t index, const T &command, int)
+      -> decltype(batch.Set(index, command)) {
+    batch.Set(index, command);
+  }
+
+  template <typename T>
+  static void SetCommand(CommandBatch &, size_t, const T &, long) {
+    DEBUG_ERROR;
+  }
+
+  std::vector<CommandBatch> CommandBatch::MakeBatches(
+      const std::vector<Command> &commands,
+      std::vector<Command> &others) {
+    constexpr size_t NumberOfTypes = static_cast<size_t>(Type::SIZE);
+
+    // Count the commands of each type to allocate the batches only once.
+    std::vector<Type> types;
+    types.reserve(commands.size());
+    std::array<size_t, NumberOfTypes> counts{};
+    for (const auto &command : commands) {
+      const Type type = boost::variant2::visit(BatchTypeVisitor{}, command.command);
+      types.emplace_back(type);
+      if (type != Type::SIZE) {
+        ++counts[static_cast<size_t>(type)];
+      }
+    }
+
+    std::array<CommandBatch, NumberOfTypes> batches;
+    for (size_t i = 0u; i < NumberOfTypes; ++i) {
+      if (counts[i] > 0u) {
+        batches[i] = CommandBatch(static_cast<Type>(i), counts[i]);
+      }
+    }
+
+    std::array<size_t, NumberOfTypes> next{};
+    for (size_t i = 0u; i < commands.size(); ++i) {
+      if (types[i] == Type::SIZE) {
+        others.emplace_back(commands[i]);
+        continue;
+      }
+      const size_t type_index = static_cast<size_t>(types[i]);
+      CommandBatch &batch = batches[type_index];
+      const size_t index = next[type_index]++;
+      boost::variant2::visit([&](const auto &command) {
+        SetCommand(batch, index, command, 0);
+      }, commands[i].command);
+    }
+
+    std::vector<CommandBatch> result;
+    for (auto &batch : batches) {
+      if (!batch.empty()) {
+        result.emplace_back(std::move(batch));
+      }
+    }
+    return result;
+  }
+
+} // namespace rpc
+} // namespace carla
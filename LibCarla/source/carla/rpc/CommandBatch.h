@@ -0,0 +1,164 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/rpc/ActorId.h"
+#include "carla/rpc/Command.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// A batch of commands of the same type stored as columns: the actor ids
+  /// followed by one packed array per field of the command, all in a single
+  /// binary blob. Sending a batch copies the blob instead of encoding every
+  /// command with its own header and type tag.
+  ///
+  /// Columns of each type, in order:
+  ///
+  ///   - ApplyVehicleControl: actor, throttle, steer, brake, gear,
+  ///     hand_brake, reverse, manual_gear_shift.
+  ///   - ApplyWalkerControl: actor, direction (x, y, z), speed, jump.
+  ///   - ApplyTransform: actor, location (x, y, z), rotation (pitch, yaw,
+  ///     roll).
+  ///   - ApplyWalkerState: actor, location, rotation, speed.
+  ///   - ApplyTargetVelocity: actor, velocity (x, y, z).
+  ///   - SetVehicleLightState: actor, light_state.
+  ///
+  /// Values are stored in the byte order of the host, little-endian on every
+  /// supported platform.
+  class CommandBatch {
+  public:
+
+    enum class Type : uint8_t {
+      ApplyVehicleControl,
+      ApplyWalkerControl,
+      ApplyTransform,
+      ApplyWalkerState,
+      ApplyTargetVelocity,
+      SetVehicleLightState,
+      SIZE
+    };
+
+    /// Layout of a column.
+    struct Column {
+      const char *name;
+      /// Format of the values as in Python's struct module.
+      char format;
+      /// Size in bytes of each value.
+      uint8_t value_size;
+      /// Number of values per command.
+      uint8_t components;
+
+      size_t GetStride() const {
+        return value_size * components;
+      }
+    };
+
+    CommandBatch() = default;
+
+    /// Create a batch of @a size commands of @a type, zero-initialized.
+    CommandBatch(Type type, size_t size);
+
+    Type GetType() const {
+      return static_cast<Type>(_type);
+    }
+
+    size_t size() const {
+      return _size;
+    }
+
+    bool empty() const {
+      return _size == 0u;
+    }
+
+    /// Whether the type is known and the blob has the size expected for the
+    /// number of commands. Check it before reading a batch received from the
+    /// network.
+    bool IsValid() const;
+
+    // =========================================================================
+    /// @name Columns
+    // =========================================================================
+    /// @{
+
+    static size_t GetNumberOfColumns(Type type);
+
+    static const Column &GetColumn(Type type, size_t column);
+
+    size_t GetNumberOfColumns() const {
+      return GetNumberOfColumns(GetType());
+    }
+
+    const Column &GetColumn(size_t column) const {
+      return GetColumn(GetType(), column);
+    }
+
+    /// Data of @a column, GetColumn(column).GetStride() * size() bytes.
+    unsigned char *GetColumnData(size_t column);
+
+    const unsigned char *GetColumnData(size_t column) const;
+
+    /// @}
+    // =========================================================================
+    /// @name Commands
+    // =========================================================================
+    /// @{
+
+    /// Write the command at @a index. The type of the batch must match the
+    /// type of the command.
+    void Set(size_t index, const Command::ApplyVehicleControl &command);
+    void Set(size_t index, const Command::ApplyWalkerControl &command);
+    void Set(size_t index, const Command::ApplyTransform &command);
+    void Set(size_t index, const Command::ApplyWalkerState &command);
+    void Set(size_t index, const Command::ApplyTargetVelocity &command);
+    void Set(size_t index, const Command::SetVehicleLightState &command);
+
+    /// Read the command at @a index. The type of the batch must match the
+    /// type of the command.
+    void Get(size_t index, Command::ApplyVehicleControl &command) const;
+    void Get(size_t index, Command::ApplyWalkerControl &command) const;
+    void Get(size_t index, Command::ApplyTransform &command) const;
+    void Get(size_t index, Command::ApplyWalkerState &command) const;
+    void Get(size_t index, Command::ApplyTargetVelocity &command) const;
+    void Get(size_t index, Command::SetVehicleLightState &command) const;
+
+    /// Group @a commands into one batch per type, keeping the order of the
+    /// commands of each type. Commands without a batched form are appended to
+    /// @a others.
+    static std::vector<CommandBatch> MakeBatches(
+        const std::vector<Command> &commands,
+        std::vector<Command> &others);
+
+    /// @}
+
+  private:
+
+    size_t GetColumnOffset(size_t column) const;
+
+    template <typename T>
+    void Write(size_t column, size_t index, const T *values);
+
+    template <typename T>
+    void Read(size_t column, size_t index, T *values) const;
+
+    uint8_t _type = static_cast<uint8_t>(Type::SIZE);
+
+    uint32_t _size = 0u;
+
+    std::vector<unsigned char> _data;
+
+  public:
+
+    MSGPACK_DEFINE_ARRAY(_type, _size, _data);
+  };
+
+} // namespace rpc
+} // namespace carla
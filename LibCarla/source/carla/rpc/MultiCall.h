@@ -0,0 +1,96 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/rpc/Response.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// A call to an RPC function, packed to be sent together with other calls
+  /// in a single multi-call request. The server runs all the calls of a
+  /// multi-call in a single slot of the game thread, and returns a CallResult
+  /// for each of them.
+  class CallRequest {
+  public:
+
+    /// Name of the function bound by the server to run multi-calls.
+    static constexpr const char *GetMultiCallFunctionName() {
+      return "call_multiple";
+    }
+
+    CallRequest() = default;
+
+    template <typename... Args>
+    explicit CallRequest(std::string function, Args &&... args)
+      : _function(std::move(function)) {
+      // Same layout rpclib uses for the arguments of a call.
+      ::clmdep_msgpack::sbuffer sbuf;
+      ::clmdep_msgpack::pack(sbuf, std::make_tuple(std::forward<Args>(args)...));
+      _arguments.assign(sbuf.data(), sbuf.data() + sbuf.size());
+    }
+
+    const std::string &GetFunction() const {
+      return _function;
+    }
+
+    /// The arguments of the call, packed as a MsgPack array.
+    const std::vector<char> &GetArguments() const {
+      return _arguments;
+    }
+
+    MSGPACK_DEFINE_ARRAY(_function, _arguments)
+
+  private:
+
+    std::string _function;
+
+    std::vector<char> _arguments;
+  };
+
+  /// Result of a CallRequest. Holds the packed value returned by the function,
+  /// or an error if the function could not be called.
+  class CallResult {
+  public:
+
+    CallResult() = default;
+
+    explicit CallResult(ResponseError error)
+      : _result(std::move(error)) {}
+
+    explicit CallResult(std::vector<char> value)
+      : _result(std::move(value)) {}
+
+    bool HasError() const {
+      return _result.HasError();
+    }
+
+    const ResponseError &GetError() const {
+      return _result.GetError();
+    }
+
+    /// Unpack the value returned by the function as @a T.
+    template <typename T>
+    T As() const {
+      const auto &value = _result.Get();
+      return ::clmdep_msgpack::unpack(value.data(), value.size()).template as<T>();
+    }
+
+    MSGPACK_DEFINE_ARRAY(_result)
+
+  private:
+
+    Response<std::vector<char>> _result;
+  };
+
+} // namespace rpc
+} // namespace carla
@@ -8,6 +8,8 @@
 
 #include "carla/MsgPack.h"
 
+#include <cstdint>
+
 namespace carla {
 namespace rpc {
 
@@ -40,6 +42,9 @@ namespace rpc {
     bool smooth_junctions = true;
     bool enable_mesh_visibility = true;
     bool enable_pedestrian_navigation = true;
+    /// Maximum number of threads generating the meshes, zero uses the
+    /// hardware concurrency.
+    uint32_t max_mesh_generation_threads = 0u;
 
     MSGPACK_DEFINE_ARRAY(
         vertex_distance,
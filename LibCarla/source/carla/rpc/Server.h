@@ -9,6 +9,7 @@
 #include "carla/MoveHandler.h"
 #include "carla/Time.h"
 #include "carla/rpc/Metadata.h"
+#include "carla/rpc/MultiCall.h"
 #include "carla/rpc/Response.h"
 
 #include <boost/asio/io_context.hpp>
@@ -16,7 +17,12 @@
 
 #include <rpc/server.h>
 
+#include <functional>
 #include <future>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 namespace carla {
 namespace rpc {
@@ -34,6 +40,10 @@ namespace rpc {
   /// Functions that are bind using `BindAsync` will run asynchronously in the
   /// worker threads. Functions that are bind using `BindSync` will run within
   /// `SyncRunFor` function.
+  ///
+  /// Every function bound can also be called as part of a multi-call, see
+  /// CallRequest. All the calls of a multi-call run within a single slot of
+  /// `SyncRunFor`.
   class Server {
   public:
 
@@ -67,9 +77,16 @@ namespace rpc {
 
   private:
 
+    using PackedFunction = std::function<std::vector<char>(const ::clmdep_msgpack::object &)>;
+
+    std::vector<CallResult> CallMultiple(const std::vector<CallRequest> &calls) const;
+
     boost::asio::io_context _sync_io_context;
 
     ::rpc::server _server;
+
+    /// Functions bound, callable with packed arguments by multi-calls.
+    std::unordered_map<std::string, PackedFunction> _packed_functions;
   };
 
   // ===========================================================================
@@ -138,6 +155,44 @@ namespace detail {
         }
       };
     }
+
+    /// Wraps @a functor into a function that unpacks its arguments from a
+    /// MsgPack array, and returns the value returned by @a functor packed.
+    /// Used to dispatch the calls of a multi-call.
+    template <typename FuncT>
+    static auto WrapPackedCall(FuncT &&functor) {
+      return [functor=std::forward<FuncT>(functor)](const ::clmdep_msgpack::object &packed_args) {
+        std::tuple<std::decay_t<Args>...> args;
+        packed_args.convert(args);
+        ::clmdep_msgpack::sbuffer sbuf;
+        CallAndPack(sbuf, functor, args, std::is_void<R>(), std::index_sequence_for<Args...>());
+        return std::vector<char>(sbuf.data(), sbuf.data() + sbuf.size());
+      };
+    }
+
+  private:
+
+    template <typename FuncT, typename TupleT, size_t... Is>
+    static void CallAndPack(
+        ::clmdep_msgpack::sbuffer &sbuf,
+        const FuncT &functor,
+        TupleT &args,
+        std::false_type,
+        std::index_sequence<Is...>) {
+      ::clmdep_msgpack::pack(sbuf, functor(std::get<Is>(args)...));
+    }
+
+    template <typename FuncT, typename TupleT, size_t... Is>
+    static void CallAndPack(
+        ::clmdep_msgpack::sbuffer &sbuf,
+        const FuncT &functor,
+        TupleT &args,
+        std::true_type,
+        std::index_sequence<Is...>) {
+      functor(std::get<Is>(args)...);
+      // Functions returning void return an empty array.
+      ::clmdep_msgpack::pack(sbuf, std::make_tuple());
+    }
   };
 
 } // namespace detail
@@ -146,11 +201,35 @@ namespace detail {
   inline Server::Server(Args && ... args)
     : _server(std::forward<Args>(args) ...) {
     _server.suppress_exceptions(true);
+    BindSync(CallRequest::GetMultiCallFunctionName(), [this](std::vector<CallRequest> calls) {
+      return CallMultiple(calls);
+    });
+  }
+
+  inline std::vector<CallResult> Server::CallMultiple(const std::vector<CallRequest> &calls) const {
+    std::vector<CallResult> results;
+    results.reserve(calls.size());
+    for (const auto &call : calls) {
+      auto it = _packed_functions.find(call.GetFunction());
+      if (it == _packed_functions.end()) {
+        results.emplace_back(ResponseError("function not found: " + call.GetFunction()));
+        continue;
+      }
+      try {
+        const auto &arguments = call.GetArguments();
+        auto packed_args = ::clmdep_msgpack::unpack(arguments.data(), arguments.size());
+        results.emplace_back(it->second(packed_args.get()));
+      } catch (const std::exception &e) {
+        results.emplace_back(ResponseError(call.GetFunction() + ": " + e.what()));
+      }
+    }
+    return results;
   }
 
   template <typename FunctorT>
   inline void Server::BindSync(const std::string &name, FunctorT &&functor) {
     using Wrapper = detail::FunctionWrapper<FunctorT>;
+    _packed_functions[name] = Wrapper::WrapPackedCall(functor);
     _server.bind(
         name,
         Wrapper::WrapSyncCall(_sync_io_context, std::forward<FunctorT>(functor)));
@@ -159,6 +238,7 @@ namespace detail {
   template <typename FunctorT>
   inline void Server::BindAsync(const std::string &name, FunctorT &&functor) {
     using Wrapper = detail::FunctionWrapper<FunctorT>;
+    _packed_functions[name] = Wrapper::WrapPackedCall(functor);
     _server.bind(
         name,
         Wrapper::WrapAsyncCall(std::forward<FunctorT>(functor)));
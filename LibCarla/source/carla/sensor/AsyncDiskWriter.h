@@ -0,0 +1,200 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+#include "carla/NonCopyable.h"
+#include "carla/ThreadGroup.h"
+#include "carla/Time.h"
+#include "carla/image/ImageIOConfig.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+
+namespace carla {
+namespace sensor {
+
+  /// Writes sensor data to disk in a pool of background threads, so saving a
+  /// measurement does not block the thread that received it.
+  ///
+  /// The queue of pending writes is bounded. When it is full, Write either
+  /// blocks until a write finishes or drops the new one, as set in the
+  /// options. Each write must keep alive the data it saves, usually holding a
+  /// shared pointer to the sensor data.
+  class AsyncDiskWriter : private NonCopyable {
+  public:
+
+    struct Options {
+      size_t worker_threads = 2u;
+
+      /// Maximum number of writes waiting for a thread.
+      size_t max_queue_size = 64u;
+
+      /// Drop the writes that find the queue full, instead of waiting.
+      bool drop_when_full = false;
+
+      /// Encoder settings of the images.
+      image::io::write_options image;
+    };
+
+    AsyncDiskWriter() : AsyncDiskWriter(Options()) {}
+
+    explicit AsyncDiskWriter(Options options)
+      : _options(std::move(options)) {
+      if ((_options.worker_threads == 0u) || (_options.max_queue_size == 0u)) {
+        throw_exception(std::invalid_argument(
+            "AsyncDiskWriter needs at least one worker thread and one queue slot"));
+      }
+      _workers.CreateThreads(_options.worker_threads, [this]() { Run(); });
+    }
+
+    /// Finishes the pending writes and joins the threads.
+    ~AsyncDiskWriter() {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+      }
+      _job_available.notify_all();
+      _workers.JoinAll();
+    }
+
+    const Options &GetOptions() const {
+      return _options;
+    }
+
+    /// Enqueue @a job, a function that writes to disk. Exceptions thrown by
+    /// the job are logged and counted as failed writes.
+    ///
+    /// @return false if the queue was full and the job has been dropped.
+    bool Write(std::function<void()> job) {
+      DEBUG_ASSERT(job != nullptr);
+      std::unique_lock<std::mutex> lock(_mutex);
+      if (_queue.size() >= _options.max_queue_size) {
+        if (_options.drop_when_full) {
+          ++_dropped_count;
+          return false;
+        }
+        _slot_available.wait(lock, [this]() {
+          return _queue.size() < _options.max_queue_size;
+        });
+      }
+      _queue.emplace_back(std::move(job));
+      lock.unlock();
+      _job_available.notify_one();
+      return true;
+    }
+
+    /// Block until every write enqueued so far has finished.
+    void Flush() {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _idle.wait(lock, [this]() { return IsIdle(); });
+    }
+
+    /// Like Flush, but waits at most @a timeout.
+    ///
+    /// @return false if there were writes left when the time ran out.
+    bool WaitFor(time_duration timeout) {
+      std::unique_lock<std::mutex> lock(_mutex);
+      return _idle.wait_for(lock, timeout.to_chrono(), [this]() { return IsIdle(); });
+    }
+
+    /// Number of writes waiting for a thread.
+    size_t GetQueueSize() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _queue.size();
+    }
+
+    /// Number of writes finished successfully.
+    size_t GetWrittenCount() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _written_count;
+    }
+
+    /// Number of writes that threw an exception.
+    size_t GetFailedCount() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _failed_count;
+    }
+
+    /// Number of writes dropped because the queue was full.
+    size_t GetDroppedCount() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _dropped_count;
+    }
+
+  private:
+
+    bool IsIdle() const {
+      return _queue.empty() && (_running_count == 0u);
+    }
+
+    void Run() {
+      for (;;) {
+        std::function<void()> job;
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          _job_available.wait(lock, [this]() { return _stop || !_queue.empty(); });
+          if (_queue.empty()) {
+            return;
+          }
+          job = std::move(_queue.front());
+          _queue.pop_front();
+          ++_running_count;
+        }
+        _slot_available.notify_one();
+        bool succeeded = false;
+        try {
+          job();
+          succeeded = true;
+        } catch (const std::exception &e) {
+          log_error("AsyncDiskWriter: failed to write:", e.what());
+        } catch (...) {
+          log_error("AsyncDiskWriter: failed to write: unknown error");
+        }
+        // Release the data before reporting the write as finished.
+        job = nullptr;
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          --_running_count;
+          ++(succeeded ? _written_count : _failed_count);
+        }
+        _idle.notify_all();
+      }
+    }
+
+    const Options _options;
+
+    mutable std::mutex _mutex;
+
+    std::condition_variable _job_available;
+
+    std::condition_variable _slot_available;
+
+    std::condition_variable _idle;
+
+    std::deque<std::function<void()>> _queue;
+
+    size_t _running_count = 0u;
+
+    size_t _written_count = 0u;
+
+    size_t _failed_count = 0u;
+
+    size_t _dropped_count = 0u;
+
+    bool _stop = false;
+
+    ThreadGroup _workers;
+  };
+
+} // namespace sensor
+} // namespace carla
@@ -9,6 +9,7 @@
 #include "carla/Debug.h"
 #include "carla/sensor/data/Array.h"
 #include "carla/sensor/data/DVSEvent.h"
+#include "carla/sensor/data/DVSEventKernels.h"
 #include "carla/sensor/data/Color.h"
 #include "carla/sensor/s11n/DVSEventArraySerializer.h"
 
@@ -56,22 +57,14 @@ namespace data {
     ///  Get an event "frame" image for visualization
     std::vector<Color> ToImage() const {
       std::vector<Color> img(GetHeight() * GetWidth());
-      for (const auto &event : *this) {
-        size_t index = (GetWidth() * event.y) + event.x;
-        if (event.pol == true) {
-          // Blue is positive
-          img[index].b = 255u;
-        } else {
-          // Red is negative
-          img[index].r = 255u;
-        }
-      }
+      DVSEventKernels::ToImage(data(), size(), GetWidth(), GetHeight(), img.data());
       return img;
     }
 
     /// Get the array of events in pure vector format
     std::vector<std::vector<std::int64_t>> ToArray() const {
       std::vector<std::vector<std::int64_t>> array;
+      array.reserve(size());
       for (const auto &event : *this) {
         array.push_back({static_cast<std::int64_t>(event.x), static_cast<std::int64_t>(event.y), static_cast<std::int64_t>(event.t), (2*static_cast<std::int64_t>(event.pol)) - 1});
       }
@@ -80,40 +73,63 @@ namespace data {
 
     /// Get all events' x coordinate for convenience
     std::vector<std::uint16_t> ToArrayX() const {
-      std::vector<std::uint16_t> array;
-      for (const auto &event : *this) {
-        array.push_back(event.x);
-      }
+      std::vector<std::uint16_t> array(size());
+      DVSEventKernels::Decode(data(), size(), array.data(), nullptr, nullptr, nullptr);
       return array;
     }
 
     /// Get all events' y coordinate for convenience
     std::vector<std::uint16_t> ToArrayY() const {
-      std::vector<std::uint16_t> array;
-      for (const auto &event : *this) {
-        array.push_back(event.y);
-      }
+      std::vector<std::uint16_t> array(size());
+      DVSEventKernels::Decode(data(), size(), nullptr, array.data(), nullptr, nullptr);
       return array;
     }
 
     /// Get all events' timestamp for convenience
     std::vector<std::int64_t> ToArrayT() const {
-      std::vector<std::int64_t> array;
-      for (const auto &event : *this) {
-        array.push_back(event.t);
-      }
+      std::vector<std::int64_t> array(size());
+      DVSEventKernels::Decode(data(), size(), nullptr, nullptr, array.data(), nullptr);
       return array;
     }
 
     /// Get all events' polarity for convenience
     std::vector<short> ToArrayPol() const {
-      std::vector<short> array;
-      for (const auto &event : *this) {
-        array.push_back(2*static_cast<short>(event.pol) - 1);
-      }
+      std::vector<short> array(size());
+      DVSEventKernels::Decode(data(), size(), nullptr, nullptr, nullptr, array.data());
       return array;
     }
 
+    /// Get the time window [begin, end) holding all the events, in
+    /// nanoseconds.
+    DVSEventKernels::TimeWindow GetTimeRange() const {
+      return DVSEventKernels::GetTimeRange(data(), size());
+    }
+
+    /// Get the sum of the polarities of the events in [t_begin, t_end) at
+    /// each pixel, HxW. If split_polarity, the count of positive and negative
+    /// events at each pixel, 2xHxW.
+    std::vector<float> ToEventFrame(
+        std::int64_t t_begin,
+        std::int64_t t_end,
+        bool split_polarity = false) const {
+      std::vector<float> frame((split_polarity ? 2u : 1u) * GetHeight() * GetWidth(), 0.0f);
+      DVSEventKernels::AccumulateFrame(
+          data(), size(), GetWidth(), GetHeight(), {t_begin, t_end}, split_polarity, frame.data());
+      return frame;
+    }
+
+    /// Get a voxel grid of the events in [t_begin, t_end) with the given
+    /// number of temporal bins, bins x H x W.
+    std::vector<float> ToVoxelGrid(
+        size_t bins,
+        std::int64_t t_begin,
+        std::int64_t t_end) const {
+      std::vector<float> grid(bins * GetHeight() * GetWidth(), 0.0f);
+      DVSEventKernels::AccumulateVoxelGrid(
+          data(), size(), GetWidth(), GetHeight(), bins, {t_begin, t_end}, grid.data());
+      return grid;
+    }
+
   };
 
 } // namespace data
@@ -0,0 +1,166 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/sensor/data/DVSEventKernels.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace carla {
+namespace sensor {
+namespace data {
+
+  // DVSEvent is packed, read its fields by value to avoid unaligned
+  // references.
+  static inline bool IsInside(const DVSEvent &event, size_t width, size_t height) {
+    const size_t x = event.x;
+    const size_t y = event.y;
+    return (x < width) & (y < height);
+  }
+
+  static inline bool IsInWindow(const DVSEvent &event, DVSEventKernels::TimeWindow window) {
+    const std::int64_t t = event.t;
+    return (t >= window.begin) & (t < window.end);
+  }
+
+  DVSEventKernels::TimeWindow DVSEventKernels::GetTimeRange(
+      const DVSEvent *events,
+      const size_t count) {
+    if (count == 0u) {
+      return {0, 0};
+    }
+    std::int64_t min = std::numeric_limits<std::int64_t>::max();
+    std::int64_t max = std::numeric_limits<std::int64_t>::min();
+    for (size_t i = 0u; i < count; ++i) {
+      const std::int64_t t = events[i].t;
+      min = std::min(min, t);
+      max = std::max(max, t);
+    }
+    return {min, max + 1};
+  }
+
+  void DVSEventKernels::Decode(
+      const DVSEvent *events,
+      const size_t count,
+      std::uint16_t *x,
+      std::uint16_t *y,
+      std::int64_t *t,
+      std::int16_t *pol) {
+    if ((x != nullptr) && (y != nullptr) && (t != nullptr) && (pol != nullptr)) {
+      for (size_t i = 0u; i < count; ++i) {
+        const DVSEvent &event = events[i];
+        x[i] = event.x;
+        y[i] = event.y;
+        t[i] = event.t;
+        pol[i] = static_cast<std::int16_t>(2 * static_cast<int>(event.pol) - 1);
+      }
+      return;
+    }
+    // Only some of the columns, one pass each.
+    if (x != nullptr) {
+      for (size_t i = 0u; i < count; ++i) {
+        x[i] = events[i].x;
+      }
+    }
+    if (y != nullptr) {
+      for (size_t i = 0u; i < count; ++i) {
+        y[i] = events[i].y;
+      }
+    }
+    if (t != nullptr) {
+      for (size_t i = 0u; i < count; ++i) {
+        t[i] = events[i].t;
+      }
+    }
+    if (pol != nullptr) {
+      for (size_t i = 0u; i < count; ++i) {
+        pol[i] = static_cast<std::int16_t>(2 * static_cast<int>(events[i].pol) - 1);
+      }
+    }
+  }
+
+  void DVSEventKernels::ToImage(
+      const DVSEvent *events,
+      const size_t count,
+      const size_t width,
+      const size_t height,
+      Color *image) {
+    for (size_t i = 0u; i < count; ++i) {
+      const DVSEvent &event = events[i];
+      if (!IsInside(event, width, height)) {
+        continue;
+      }
+      Color &pixel = image[width * event.y + event.x];
+      // Blue is positive, red is negative.
+      const std::uint8_t positive = event.pol ? 255u : 0u;
+      pixel.b |= positive;
+      pixel.r |= static_cast<std::uint8_t>(~positive);
+    }
+  }
+
+  void DVSEventKernels::AccumulateFrame(
+      const DVSEvent *events,
+      const size_t count,
+      const size_t width,
+      const size_t height,
+      const TimeWindow window,
+      const bool split_polarity,
+      float *frame) {
+    const size_t channel_size = width * height;
+    for (size_t i = 0u; i < count; ++i) {
+      const DVSEvent &event = events[i];
+      if (!(IsInside(event, width, height) & IsInWindow(event, window))) {
+        continue;
+      }
+      const size_t pixel = width * event.y + event.x;
+      const bool positive = event.pol;
+      if (split_polarity) {
+        frame[(positive ? 0u : channel_size) + pixel] += 1.0f;
+      } else {
+        frame[pixel] += positive ? 1.0f : -1.0f;
+      }
+    }
+  }
+
+  void DVSEventKernels::AccumulateVoxelGrid(
+      const DVSEvent *events,
+      const size_t count,
+      const size_t width,
+      const size_t height,
+      const size_t bins,
+      const TimeWindow window,
+      float *grid) {
+    if ((bins == 0u) || (window.end <= window.begin)) {
+      return;
+    }
+    const size_t channel_size = width * height;
+    // Map the window to [0, bins - 1], the last bin holds the events at the
+    // end of the window.
+    const std::int64_t span = window.end - 1 - window.begin;
+    const double scale = (span > 0) ?
+        static_cast<double>(bins - 1u) / static_cast<double>(span) :
+        0.0;
+    for (size_t i = 0u; i < count; ++i) {
+      const DVSEvent &event = events[i];
+      if (!(IsInside(event, width, height) & IsInWindow(event, window))) {
+        continue;
+      }
+      const std::int64_t t = event.t;
+      const double position = static_cast<double>(t - window.begin) * scale;
+      const size_t lower = std::min(static_cast<size_t>(position), bins - 1u);
+      const float weight = static_cast<float>(position - static_cast<double>(lower));
+      const float polarity = event.pol ? 1.0f : -1.0f;
+      const size_t pixel = width * event.y + event.x;
+      grid[lower * channel_size + pixel] += polarity * (1.0f - weight);
+      if (lower + 1u < bins) {
+        grid[(lower + 1u) * channel_size + pixel] += polarity * weight;
+      }
+    }
+  }
+
+} // namespace data
+} // namespace sensor
+} // namespace carla
@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/sensor/data/Color.h"
+#include "carla/sensor/data/DVSEvent.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace carla {
+namespace sensor {
+namespace data {
+
+  /// Single-pass conversions of DVS events into columns, images, event frames
+  /// and voxel grids, written into arrays allocated by the caller.
+  ///
+  /// Polarities are +1 for positive events and -1 for negative ones. Events
+  /// outside the image are ignored. The loops are branch-free over the
+  /// events so the compiler can vectorize them.
+  class DVSEventKernels {
+  public:
+
+    /// Time window [begin, end) of the events to accumulate, in nanoseconds.
+    struct TimeWindow {
+      std::int64_t begin;
+      std::int64_t end;
+    };
+
+    /// Smallest window holding all the events, empty if there are none.
+    static TimeWindow GetTimeRange(const DVSEvent *events, size_t count);
+
+    /// Decode the events into separate columns. Any output can be null to
+    /// skip it, the others are filled in a single pass.
+    static void Decode(
+        const DVSEvent *events,
+        size_t count,
+        std::uint16_t *x,
+        std::uint16_t *y,
+        std::int64_t *t,
+        std::int16_t *pol);
+
+    /// Draw the events in a zero-initialized image of @a width x @a height,
+    /// blue for positive events and red for negative ones.
+    static void ToImage(
+        const DVSEvent *events,
+        size_t count,
+        size_t width,
+        size_t height,
+        Color *image);
+
+    /// Add the polarity of the events in @a window to a @a width x
+    /// @a height frame. If @a split_polarity, the frame has two channels of
+    /// @a width x @a height that count the positive and the negative events.
+    static void AccumulateFrame(
+        const DVSEvent *events,
+        size_t count,
+        size_t width,
+        size_t height,
+        TimeWindow window,
+        bool split_polarity,
+        float *frame);
+
+    /// Add the polarity of the events in @a window to a voxel grid of
+    /// @a bins x @a height x @a width. Each event is split between its two
+    /// closest temporal bins, weighted by distance.
+    static void AccumulateVoxelGrid(
+        const DVSEvent *events,
+        size_t count,
+        size_t width,
+        size_t height,
+        size_t bins,
+        TimeWindow window,
+        float *grid);
+  };
+
+} // namespace data
+} // namespace sensor
+} // namespace carla
@@ -73,6 +73,10 @@ namespace data {
       }
   };
 
+  // PointCloudIO writes binary PLY files straight from memory, following the
+  // properties of WritePlyHeaderInfo.
+  static_assert(sizeof(LidarDetection) == 4u * sizeof(float), "Invalid LidarDetection size");
+
   class LidarData : public SemanticLidarData{
 
   public:
@@ -25,7 +25,9 @@ namespace data {
     friend Serializer;
 
     explicit RawEpisodeState(RawData &&data)
-      : Super(Serializer::header_offset, std::move(data)) {}
+      : Super(std::move(data), [](const RawData &message) {
+          return Serializer::GetActorsOffset(message);
+        }) {}
 
   private:
 
@@ -66,6 +68,19 @@ namespace data {
       return GetHeader().simulation_state;
     }
 
+    /// Whether this frame holds only the actors added or changed since a
+    /// keyframe, in which case it needs to be applied to the keyframe with
+    /// EpisodeStateSerializer::ApplyDelta.
+    bool IsDeltaFrame() const {
+      return Serializer::IsDeltaFrame(Super::GetRawData());
+    }
+
+    /// Frame of the keyframe a delta frame applies to.
+    uint64_t GetKeyframe() const {
+      DEBUG_ASSERT(IsDeltaFrame());
+      return Serializer::DeserializeDeltaHeader(Super::GetRawData()).keyframe;
+    }
+
   };
 
 } // namespace data
@@ -83,6 +83,9 @@ namespace data {
   };
   #pragma pack(pop)
 
+  // Binary PLY files are copied from this layout, one field per property.
+  static_assert(sizeof(SemanticLidarDetection) == 24u, "Invalid SemanticLidarDetection size");
+
   class SemanticLidarData {
     static_assert(sizeof(float) == sizeof(uint32_t), "Invalid float size");
 
@@ -0,0 +1,158 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/sensor/s11n/EpisodeStateDeltaEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace carla {
+namespace sensor {
+namespace s11n {
+
+  using Header = EpisodeStateSerializer::Header;
+  using DeltaHeader = EpisodeStateSerializer::DeltaHeader;
+  using SimulationState = EpisodeStateSerializer::SimulationState;
+
+  static bool Exceeds(const geom::Vector3D lhs, const geom::Vector3D rhs, const float epsilon) {
+    return (std::abs(lhs.x - rhs.x) > epsilon) ||
+           (std::abs(lhs.y - rhs.y) > epsilon) ||
+           (std::abs(lhs.z - rhs.z) > epsilon);
+  }
+
+  void EpisodeStateDeltaEncoder::SetSettings(const EpisodeStateDeltaSettings &settings) {
+    _settings = settings;
+    // Start over with a keyframe.
+    _has_keyframe = false;
+  }
+
+  Buffer EpisodeStateDeltaEncoder::Encode(const uint64_t frame, Buffer &&buffer) {
+    if (_settings.keyframe_interval < 2u) {
+      _has_keyframe = false;
+      return std::move(buffer);
+    }
+    DEBUG_ASSERT(buffer.size() >= sizeof(Header));
+    DEBUG_ASSERT((buffer.size() - sizeof(Header)) % sizeof(ActorDynamicState) == 0u);
+    Header header;
+    std::memcpy(&header, buffer.data(), sizeof(Header));
+    const size_t count = (buffer.size() - sizeof(Header)) / sizeof(ActorDynamicState);
+    const auto *actors = reinterpret_cast<const ActorDynamicState *>(buffer.data() + sizeof(Header));
+
+    const bool needs_keyframe =
+        !_has_keyframe ||
+        (header.episode_id != _keyframe_episode_id) ||
+        ((header.simulation_state & SimulationState::MapChange) != 0) ||
+        (_frames_since_keyframe + 1u >= _settings.keyframe_interval);
+    if (needs_keyframe) {
+      SetKeyframe(frame, header.episode_id, actors, count);
+      return std::move(buffer);
+    }
+
+    // Actors changed or added since the keyframe.
+    _seen.assign(_keyframe_actors.size(), false);
+    std::vector<const ActorDynamicState *> changed;
+    for (size_t i = 0u; i < count; ++i) {
+      const auto &actor = actors[i];
+      auto it = _keyframe_index.find(actor.id);
+      if (it == _keyframe_index.end()) {
+        changed.emplace_back(&actor);
+      } else {
+        _seen[it->second] = true;
+        if (HasChanged(_keyframe_actors[it->second], actor)) {
+          changed.emplace_back(&actor);
+        }
+      }
+    }
+    const auto number_of_removed = static_cast<uint32_t>(
+        std::count(_seen.begin(), _seen.end(), false));
+
+    const size_t delta_size = sizeof(Header) + sizeof(DeltaHeader) +
+        sizeof(ActorId) * number_of_removed +
+        sizeof(ActorDynamicState) * changed.size();
+    if (delta_size >= buffer.size()) {
+      // Nothing to gain, send a new keyframe instead.
+      SetKeyframe(frame, header.episode_id, actors, count);
+      return std::move(buffer);
+    }
+
+    _delta.resize(delta_size);
+    auto *it = _delta.data();
+    auto write = [&it](const void *data, size_t size) {
+      std::memcpy(it, data, size);
+      it += size;
+    };
+    header.simulation_state = static_cast<SimulationState>(
+        header.simulation_state | SimulationState::DeltaFrame);
+    write(&header, sizeof(Header));
+    const DeltaHeader delta_header{_keyframe, number_of_removed};
+    write(&delta_header, sizeof(DeltaHeader));
+    for (size_t i = 0u; i < _seen.size(); ++i) {
+      if (!_seen[i]) {
+        const ActorId id = _keyframe_actors[i].id;
+        write(&id, sizeof(ActorId));
+      }
+    }
+    for (const auto *actor : changed) {
+      write(actor, sizeof(ActorDynamicState));
+    }
+    DEBUG_ASSERT(it == _delta.data() + _delta.size());
+
+    ++_frames_since_keyframe;
+    // Reuse the memory of the given buffer, it is always bigger.
+    buffer.copy_from(_delta);
+    return std::move(buffer);
+  }
+
+  bool EpisodeStateDeltaEncoder::HasChanged(
+      const ActorDynamicState &keyframe,
+      const ActorDynamicState &current) const {
+    if (std::memcmp(&keyframe, &current, sizeof(ActorDynamicState)) == 0) {
+      return false;
+    }
+    const bool lossless =
+        (_settings.location_epsilon <= 0.0f) &&
+        (_settings.rotation_epsilon <= 0.0f) &&
+        (_settings.velocity_epsilon <= 0.0f);
+    if (lossless ||
+        (keyframe.actor_state != current.actor_state) ||
+        (std::memcmp(&keyframe.state, &current.state, sizeof(keyframe.state)) != 0)) {
+      return true;
+    }
+    const geom::Transform keyframe_transform = keyframe.transform;
+    const geom::Transform current_transform = current.transform;
+    const geom::Rotation &lhs = keyframe_transform.rotation;
+    const geom::Rotation &rhs = current_transform.rotation;
+    return
+        Exceeds(keyframe_transform.location, current_transform.location, _settings.location_epsilon) ||
+        (std::abs(lhs.pitch - rhs.pitch) > _settings.rotation_epsilon) ||
+        (std::abs(lhs.yaw - rhs.yaw) > _settings.rotation_epsilon) ||
+        (std::abs(lhs.roll - rhs.roll) > _settings.rotation_epsilon) ||
+        Exceeds(keyframe.velocity, current.velocity, _settings.velocity_epsilon) ||
+        Exceeds(keyframe.angular_velocity, current.angular_velocity, _settings.velocity_epsilon) ||
+        Exceeds(keyframe.acceleration, current.acceleration, _settings.velocity_epsilon);
+  }
+
+  void EpisodeStateDeltaEncoder::SetKeyframe(
+      const uint64_t frame,
+      const uint64_t episode_id,
+      const ActorDynamicState *actors,
+      const size_t count) {
+    _has_keyframe = true;
+    _keyframe = frame;
+    _keyframe_episode_id = episode_id;
+    _frames_since_keyframe = 0u;
+    _keyframe_actors.assign(actors, actors + count);
+    _keyframe_index.clear();
+    _keyframe_index.reserve(count);
+    for (size_t i = 0u; i < count; ++i) {
+      _keyframe_index.emplace(_keyframe_actors[i].id, static_cast<uint32_t>(i));
+    }
+  }
+
+} // namespace s11n
+} // namespace sensor
+} // namespace carla
@@ -0,0 +1,94 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/sensor/data/ActorDynamicState.h"
+#include "carla/sensor/s11n/EpisodeStateSerializer.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace sensor {
+namespace s11n {
+
+  struct EpisodeStateDeltaSettings {
+
+    /// Number of frames between keyframes, delta frames are disabled if lower
+    /// than two.
+    uint32_t keyframe_interval = 0u;
+
+    /// An actor is sent in a delta frame if any of its location components
+    /// changed more than this since the keyframe, in meters. Actors are
+    /// compared bit by bit if all the epsilons are zero.
+    float location_epsilon = 0.0f;
+
+    /// Same for rotation components, in degrees.
+    float rotation_epsilon = 0.0f;
+
+    /// Same for velocity, angular velocity and acceleration components.
+    float velocity_epsilon = 0.0f;
+  };
+
+  /// Encodes the episode state stream as a keyframe every
+  /// EpisodeStateDeltaSettings::keyframe_interval frames, and in between
+  /// delta frames holding only the actors added, removed or changed since the
+  /// last keyframe. Deltas refer to the keyframe and not to the previous
+  /// frame, so clients that miss a frame can still decode the next one.
+  class EpisodeStateDeltaEncoder : private NonCopyable {
+  public:
+
+    void SetSettings(const EpisodeStateDeltaSettings &settings);
+
+    const EpisodeStateDeltaSettings &GetSettings() const {
+      return _settings;
+    }
+
+    /// Encode the full frame @a buffer, as written by the server with the
+    /// header and every actor, that is going to be sent with @a frame.
+    /// Returns either @a buffer unchanged as a keyframe, or a delta frame
+    /// written in the same buffer.
+    Buffer Encode(uint64_t frame, Buffer &&buffer);
+
+  private:
+
+    using ActorDynamicState = data::ActorDynamicState;
+
+    bool HasChanged(const ActorDynamicState &keyframe, const ActorDynamicState &current) const;
+
+    void SetKeyframe(
+        uint64_t frame,
+        uint64_t episode_id,
+        const ActorDynamicState *actors,
+        size_t count);
+
+    EpisodeStateDeltaSettings _settings;
+
+    bool _has_keyframe = false;
+
+    uint64_t _keyframe = 0u;
+
+    uint64_t _keyframe_episode_id = 0u;
+
+    uint32_t _frames_since_keyframe = 0u;
+
+    std::vector<ActorDynamicState> _keyframe_actors;
+
+    std::unordered_map<ActorId, uint32_t> _keyframe_index;
+
+    /// Scratch space reused between frames.
+    std::vector<unsigned char> _delta;
+
+    std::vector<bool> _seen;
+  };
+
+} // namespace s11n
+} // namespace sensor
+} // namespace carla
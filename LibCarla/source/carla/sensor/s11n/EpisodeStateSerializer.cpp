@@ -7,6 +7,10 @@
 #include "carla/sensor/s11n/EpisodeStateSerializer.h"
 
 #include "carla/sensor/data/RawEpisodeState.h"
+#include "carla/sensor/s11n/SensorHeaderSerializer.h"
+
+#include <unordered_map>
+#include <unordered_set>
 
 namespace carla {
 namespace sensor {
@@ -16,6 +20,72 @@ namespace s11n {
     return SharedPtr<data::RawEpisodeState>(new data::RawEpisodeState{std::move(data)});
   }
 
+  Buffer EpisodeStateSerializer::ApplyDelta(
+      const data::RawEpisodeState &keyframe,
+      const data::RawEpisodeState &delta) {
+    using ActorDynamicState = data::ActorDynamicState;
+    DEBUG_ASSERT(delta.IsDeltaFrame());
+    if (keyframe.IsDeltaFrame() ||
+        (keyframe.GetEpisodeId() != delta.GetEpisodeId()) ||
+        (keyframe.GetFrame() != delta.GetKeyframe())) {
+      return {};
+    }
+
+    const RawData &message = delta.GetRawData();
+    const auto delta_header = DeserializeDeltaHeader(message);
+    std::unordered_set<ActorId> removed;
+    removed.reserve(delta_header.number_of_removed_actors);
+    const auto *removed_ids = message.begin() + header_offset + sizeof(DeltaHeader);
+    for (auto i = 0u; i < delta_header.number_of_removed_actors; ++i) {
+      ActorId id;
+      std::memcpy(&id, removed_ids + i * sizeof(ActorId), sizeof(ActorId));
+      removed.emplace(id);
+    }
+    std::unordered_map<ActorId, const ActorDynamicState *> changed;
+    changed.reserve(delta.size());
+    for (const auto &actor : delta) {
+      changed.emplace(actor.id, &actor);
+    }
+
+    // The sensor header of the delta frame is kept as is, it comes right
+    // before its data.
+    constexpr auto sensor_header_size = SensorHeaderSerializer::header_offset;
+    const auto max_size = sensor_header_size + header_offset +
+        sizeof(ActorDynamicState) * (keyframe.size() + delta.size());
+    Buffer result(static_cast<uint64_t>(max_size));
+    auto *it = result.data();
+    auto write = [&it](const void *data, size_t size) {
+      std::memcpy(it, data, size);
+      it += size;
+    };
+    write(message.begin() - sensor_header_size, sensor_header_size);
+    Header header = DeserializeHeader(message);
+    header.simulation_state = static_cast<SimulationState>(
+        header.simulation_state & ~SimulationState::DeltaFrame);
+    write(&header, sizeof(Header));
+
+    // Actors of the keyframe in the same order, then the added ones.
+    for (const auto &actor : keyframe) {
+      if (removed.find(actor.id) != removed.end()) {
+        continue;
+      }
+      auto found = changed.find(actor.id);
+      if (found != changed.end()) {
+        write(found->second, sizeof(ActorDynamicState));
+        changed.erase(found);
+      } else {
+        write(&actor, sizeof(ActorDynamicState));
+      }
+    }
+    for (const auto &actor : delta) {
+      if (changed.find(actor.id) != changed.end()) {
+        write(&actor, sizeof(ActorDynamicState));
+      }
+    }
+    result.resize(static_cast<uint64_t>(it - result.data()));
+    return result;
+  }
+
 } // namespace s11n
 } // namespace sensor
 } // namespace carla
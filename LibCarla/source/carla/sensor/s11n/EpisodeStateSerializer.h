@@ -15,12 +15,19 @@
 #include "carla/sensor/data/ActorDynamicState.h"
 
 #include <cstdint>
+#include <cstring>
 
 namespace carla {
 namespace sensor {
 
   class SensorData;
 
+namespace data {
+
+  class RawEpisodeState;
+
+} // namespace data
+
 namespace s11n {
 
   /// Serializes the current state of the whole episode.
@@ -30,7 +37,10 @@ namespace s11n {
     enum SimulationState {
       None               = (0x0 << 0),
       MapChange          = (0x1 << 0),
-      PendingLightUpdate = (0x1 << 1)
+      PendingLightUpdate = (0x1 << 1),
+      /// The frame holds only the actors changed since a keyframe, see
+      /// DeltaHeader.
+      DeltaFrame         = (0x1 << 2)
     };
 
 #pragma pack(push, 1)
@@ -41,6 +51,14 @@ namespace s11n {
       geom::Vector3DInt map_origin;
       SimulationState simulation_state = SimulationState::None;
     };
+
+    /// Follows the header in delta frames. After it come the ids of the
+    /// actors removed since the keyframe, and then the actors added or changed
+    /// since the keyframe.
+    struct DeltaHeader {
+      uint64_t keyframe;
+      uint32_t number_of_removed_actors;
+    };
 #pragma pack(pop)
 
     constexpr static auto header_offset = sizeof(Header);
@@ -49,6 +67,34 @@ namespace s11n {
       return *reinterpret_cast<const Header *>(message.begin());
     }
 
+    static DeltaHeader DeserializeDeltaHeader(const RawData &message) {
+      DEBUG_ASSERT(message.size() >= header_offset + sizeof(DeltaHeader));
+      DeltaHeader header;
+      std::memcpy(&header, message.begin() + header_offset, sizeof(DeltaHeader));
+      return header;
+    }
+
+    static bool IsDeltaFrame(const RawData &message) {
+      return (DeserializeHeader(message).simulation_state & SimulationState::DeltaFrame) != 0;
+    }
+
+    /// Offset of the array of actors in @a message.
+    static size_t GetActorsOffset(const RawData &message) {
+      if (!IsDeltaFrame(message)) {
+        return header_offset;
+      }
+      const auto delta_header = DeserializeDeltaHeader(message);
+      return header_offset + sizeof(DeltaHeader) +
+          sizeof(ActorId) * delta_header.number_of_removed_actors;
+    }
+
+    /// Rebuild the full message of the frame of @a delta by applying it to
+    /// @a keyframe. Returns an empty buffer if @a delta does not apply to
+    /// @a keyframe.
+    static Buffer ApplyDelta(
+        const data::RawEpisodeState &keyframe,
+        const data::RawEpisodeState &delta);
+
     template <typename SensorT>
     static Buffer Serialize(const SensorT &, Buffer &&buffer) {
       return std::move(buffer);
@@ -8,20 +8,31 @@
 
 #include "carla/Logging.h"
 #include "carla/ThreadPool.h"
+#include "carla/streaming/DeliveryPolicy.h"
 #include "carla/streaming/Token.h"
-#include "carla/streaming/detail/tcp/Client.h"
+#include "carla/streaming/detail/DeliveryQueue.h"
+#include "carla/streaming/detail/shm/Client.h"
 #include "carla/streaming/low_level/Client.h"
 
 #include <boost/asio/io_context.hpp>
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 namespace carla {
 namespace streaming {
 
   using stream_token = detail::token_type;
 
-  /// A client able to subscribe to multiple streams.
+  /// A client able to subscribe to multiple streams. Streams published
+  /// through shared memory on this host are read from it, the rest over TCP.
+  ///
+  /// Callbacks run on their own threads, so a slow callback never holds back
+  /// the reads of any stream. What happens to the messages that arrive while
+  /// a callback is busy is set per subscription with DeliveryOptions.
   class Client {
-    using underlying_client = low_level::Client<detail::tcp::Client>;
+    using underlying_client = low_level::Client<detail::shm::Client>;
   public:
 
     Client() = default;
@@ -31,34 +42,78 @@ namespace streaming {
 
     ~Client() {
       _service.Stop();
+      _callback_service.Stop();
     }
 
     /// @warning cannot subscribe twice to the same stream (even if it's a
     /// MultiStream).
     template <typename Functor>
-    void Subscribe(const Token &token, Functor &&callback) {
-      _client.Subscribe(_service.io_context(), token, std::forward<Functor>(callback));
+    void Subscribe(
+        const Token &token,
+        Functor &&callback,
+        DeliveryOptions options = DeliveryOptions{}) {
+      auto queue = std::make_shared<detail::DeliveryQueue>(
+          _callback_service.io_context(),
+          options,
+          std::forward<Functor>(callback));
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queues[detail::token_type(token).get_stream_id()] = queue;
+      }
+      _client.Subscribe(_service.io_context(), token, [queue](Buffer message) {
+        queue->Push(std::move(message));
+      }, options.priority);
+    }
+
+    /// Read the streams subscribed from now on through a single connection
+    /// per server, see low_level::Client::SetMultiplexing.
+    void SetMultiplexing(bool enabled) {
+      _client.SetMultiplexing(enabled);
     }
 
     void UnSubscribe(const Token &token) {
       _client.UnSubscribe(token);
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto it = _queues.find(detail::token_type(token).get_stream_id());
+      if (it != _queues.end()) {
+        it->second->Stop();
+        _queues.erase(it);
+      }
+    }
+
+    /// Delivery counters of the stream of @a token, all zero if not
+    /// subscribed.
+    DeliveryStats GetDeliveryStats(const Token &token) const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto it = _queues.find(detail::token_type(token).get_stream_id());
+      return it != _queues.end() ? it->second->GetStats() : DeliveryStats{};
     }
 
     void Run() {
+      _callback_service.AsyncRun(1u);
       _service.Run();
     }
 
+    /// Launch @a worker_threads threads to read the streams, and as many to
+    /// run the callbacks.
     void AsyncRun(size_t worker_threads) {
+      _callback_service.AsyncRun(worker_threads);
       _service.AsyncRun(worker_threads);
     }
 
   private:
 
-    // The order of these two arguments is very important.
+    // The order of these arguments is very important.
+
+    ThreadPool _callback_service;
 
     ThreadPool _service;
 
     underlying_client _client;
+
+    mutable std::mutex _mutex;
+
+    std::unordered_map<detail::stream_id_type, std::shared_ptr<detail::DeliveryQueue>> _queues;
   };
 
 } // namespace streaming
@@ -0,0 +1,63 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace carla {
+namespace streaming {
+
+  /// What to do with the messages of a stream that arrive while its callback
+  /// is still busy with a previous one.
+  enum class DeliveryPolicy : uint8_t {
+    /// Deliver every message in order. The queue grows while the callback is
+    /// slower than the stream.
+    KeepAll,
+    /// Keep only the newest DeliveryOptions::queue_size messages, dropping
+    /// the oldest ones.
+    KeepLatest,
+    /// Keep only the newest message.
+    Coalesce
+  };
+
+  struct DeliveryOptions {
+    DeliveryPolicy policy = DeliveryPolicy::KeepAll;
+
+    /// Maximum number of queued messages with DeliveryPolicy::KeepLatest.
+    size_t queue_size = 1u;
+
+    /// When several streams share a multiplexed connection, the messages of
+    /// the streams with higher priority are sent first.
+    uint8_t priority = 0u;
+  };
+
+  /// Counters of the messages delivered to the callback of a stream.
+  struct DeliveryStats {
+    /// Messages read from the stream.
+    uint64_t received = 0u;
+
+    /// Messages passed to the callback.
+    uint64_t delivered = 0u;
+
+    /// Messages dropped by the delivery policy.
+    uint64_t skipped = 0u;
+
+    /// Messages waiting for the callback.
+    size_t queue_depth = 0u;
+
+    size_t max_queue_depth = 0u;
+
+    /// Time from reading a message to calling the callback with it, in
+    /// microseconds.
+    uint64_t mean_latency = 0u;
+
+    uint64_t max_latency = 0u;
+  };
+
+} // namespace streaming
+} // namespace carla
@@ -71,6 +71,18 @@ namespace streaming {
       _server.SetSynchronousMode(is_synchro);
     }
 
+    void SetSendQueueSettings(const detail::tcp::SendQueueSettings &settings) {
+      _server.SetSendQueueSettings(settings);
+    }
+
+    /// Publish the streams created from now on also through shared memory,
+    /// clients on the same host read them without going through TCP.
+    void SetSharedMemoryTransport(
+        bool enabled,
+        size_t ring_capacity = detail::shm::DEFAULT_RING_CAPACITY) {
+      _server.SetSharedMemoryTransport(enabled, ring_capacity);
+    }
+
     token_type GetToken(stream_id sensor_id) {
       return _server.GetToken(sensor_id);
     }
@@ -0,0 +1,105 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/DeliveryQueue.h"
+
+#include "carla/Debug.h"
+
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  DeliveryQueue::DeliveryQueue(
+      boost::asio::io_context &io_context,
+      DeliveryOptions options,
+      callback_function_type callback)
+    : _options(options),
+      _callback(std::move(callback)),
+      _strand(io_context) {
+    DEBUG_ASSERT(_callback != nullptr);
+  }
+
+  void DeliveryQueue::Push(Buffer message) {
+    bool schedule = false;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_done) {
+        return;
+      }
+      ++_stats.received;
+      size_t capacity = 0u;
+      switch (_options.policy) {
+        case DeliveryPolicy::KeepLatest:
+          capacity = std::max<size_t>(_options.queue_size, 1u);
+          break;
+        case DeliveryPolicy::Coalesce:
+          capacity = 1u;
+          break;
+        default:
+          break;
+      }
+      if (capacity > 0u) {
+        while (_queue.size() >= capacity) {
+          _queue.pop_front();
+          ++_stats.skipped;
+        }
+      }
+      _queue.push_back(QueuedMessage{std::move(message), clock::now()});
+      _stats.max_queue_depth = std::max(_stats.max_queue_depth, _queue.size());
+      schedule = !_is_delivering;
+      _is_delivering = true;
+    }
+    if (schedule) {
+      auto self = shared_from_this();
+      boost::asio::post(_strand, [self]() { self->Deliver(); });
+    }
+  }
+
+  void DeliveryQueue::Stop() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _done = true;
+    _queue.clear();
+  }
+
+  DeliveryStats DeliveryQueue::GetStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    DeliveryStats stats = _stats;
+    stats.queue_depth = _queue.size();
+    stats.mean_latency = _stats.delivered > 0u ? _total_latency / _stats.delivered : 0u;
+    return stats;
+  }
+
+  void DeliveryQueue::Deliver() {
+    QueuedMessage queued;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_queue.empty() || _done) {
+        _is_delivering = false;
+        return;
+      }
+      queued = std::move(_queue.front());
+      _queue.pop_front();
+      const auto latency = static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              clock::now() - queued.received).count());
+      ++_stats.delivered;
+      _total_latency += latency;
+      _stats.max_latency = std::max(_stats.max_latency, latency);
+    }
+    _callback(std::move(queued.message));
+    // Deliver the next message in a new handler, so the streams sharing the
+    // threads of the io_context take turns.
+    auto self = shared_from_this();
+    boost::asio::post(_strand, [self]() { self->Deliver(); });
+  }
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/streaming/DeliveryPolicy.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  /// Queue between the socket of a stream and its callback. Messages are
+  /// pushed from the thread reading the socket, which never waits for the
+  /// callback, and delivered one at a time, in order, on the @a io_context
+  /// given, usually served by threads other than the ones reading sockets.
+  class DeliveryQueue
+    : public std::enable_shared_from_this<DeliveryQueue>,
+      private NonCopyable {
+  public:
+
+    using callback_function_type = std::function<void (Buffer)>;
+
+    DeliveryQueue(
+        boost::asio::io_context &io_context,
+        DeliveryOptions options,
+        callback_function_type callback);
+
+    /// Queue @a message according to the delivery policy. Does not block.
+    void Push(Buffer message);
+
+    /// Drop the queued messages and ignore any further one. A callback
+    /// already running is not interrupted.
+    void Stop();
+
+    DeliveryStats GetStats() const;
+
+  private:
+
+    using clock = std::chrono::steady_clock;
+
+    void Deliver();
+
+    struct QueuedMessage {
+      Buffer message;
+      clock::time_point received;
+    };
+
+    const DeliveryOptions _options;
+
+    callback_function_type _callback;
+
+    boost::asio::io_context::strand _strand;
+
+    mutable std::mutex _mutex;
+
+    std::deque<QueuedMessage> _queue;
+
+    bool _is_delivering = false;
+
+    bool _done = false;
+
+    DeliveryStats _stats;
+
+    uint64_t _total_latency = 0u;
+  };
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
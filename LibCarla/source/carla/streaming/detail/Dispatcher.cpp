@@ -42,7 +42,7 @@ namespace detail {
     auto search = _stream_map.find(_cached_token.get_stream_id());
     if (search == _stream_map.end()) {
       // creating new stream
-      ptr = std::make_shared<MultiStreamState>(_cached_token);
+      ptr = MakeStreamState(_cached_token);
       auto result = _stream_map.emplace(std::make_pair(_cached_token.get_stream_id(), ptr));
       if (!result.second) {
         throw_exception(std::runtime_error("failed to create stream!"));
@@ -117,7 +117,7 @@ namespace detail {
       log_debug("Not Found sensor id, creating sensor stream: ", sensor_id);
       token_type temp_token(_cached_token);
       temp_token.set_stream_id(sensor_id);
-      auto ptr = std::make_shared<MultiStreamState>(temp_token);
+      auto ptr = MakeStreamState(temp_token);
       auto result = _stream_map.emplace(std::make_pair(temp_token.get_stream_id(), ptr));
       ptr->ForceActive();
       if (!result.second) {
@@ -129,6 +129,24 @@ namespace detail {
     return token_type();
   }
 
+  void Dispatcher::SetSharedMemoryTransport(bool enabled, size_t ring_capacity) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cached_token.set_shared_memory(enabled && shm::IsSupported());
+    _shared_memory_ring_capacity = ring_capacity;
+  }
+
+  std::shared_ptr<MultiStreamState> Dispatcher::MakeStreamState(const token_type &token) {
+    auto ptr = std::make_shared<MultiStreamState>(token);
+    if (token.has_shared_memory() && !ptr->OpenSharedMemoryRing(_shared_memory_ring_capacity)) {
+      // Don't advertise a ring that doesn't exist.
+      log_warning("stream", token.get_stream_id(), ": shared memory not available, using TCP only");
+      token_type tcp_token(token);
+      tcp_token.set_shared_memory(false);
+      ptr = std::make_shared<MultiStreamState>(tcp_token);
+    }
+    return ptr;
+  }
+
 } // namespace detail
 } // namespace streaming
 } // namespace carla
@@ -43,6 +43,12 @@ namespace detail {
 
     token_type GetToken(stream_id_type sensor_id);
 
+    /// Publish the streams created from now on also through shared memory
+    /// rings of @a ring_capacity bytes, so clients on this host can skip TCP.
+    /// Their tokens advertise the ring, clients fall back to TCP if they
+    /// can't open it.
+    void SetSharedMemoryTransport(bool enabled, size_t ring_capacity);
+
     void EnableForROS(stream_id_type sensor_id) {
       auto search = _stream_map.find(sensor_id);
       if (search != _stream_map.end()) {
@@ -67,12 +73,16 @@ namespace detail {
 
   private:
 
+    std::shared_ptr<MultiStreamState> MakeStreamState(const token_type &token);
+
     // We use a mutex here, but we assume that sessions and streams won't be
     // created too often.
     std::mutex _mutex;
 
     token_type _cached_token;
 
+    size_t _shared_memory_ring_capacity = 0u;
+
     StreamMap _stream_map;
   };
 
@@ -9,8 +9,10 @@
 #include "carla/AtomicSharedPtr.h"
 #include "carla/Logging.h"
 #include "carla/streaming/detail/StreamStateBase.h"
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
 #include "carla/streaming/detail/tcp/Message.h"
 
+#include <array>
 #include <mutex>
 #include <vector>
 #include <atomic>
@@ -21,7 +23,10 @@ namespace detail {
 
   /// A stream state that can hold any number of sessions.
   ///
-  /// @todo Lacking some optimization.
+  /// The buffers written are wrapped in a single message shared by all the
+  /// sessions, each session only queues a reference to it. The sessions are
+  /// written outside the lock, so a session blocked by a slow client doesn't
+  /// prevent other sessions from connecting or disconnecting.
   class MultiStreamState final : public StreamStateBase {
   public:
 
@@ -34,6 +39,13 @@ namespace detail {
 
     template <typename... Buffers>
     void Write(Buffers... buffers) {
+      // write to the readers on this host
+      if ((_shared_memory_ring != nullptr) && _shared_memory_ring->HasReaders()) {
+        const std::array<boost::asio::const_buffer, sizeof...(Buffers)> views{{buffers->cbuffer()...}};
+        std::lock_guard<std::mutex> lock(_shared_memory_mutex);
+        _shared_memory_ring->Write(views);
+      }
+
       // try write single stream
       auto session = _session.load();
       if (session != nullptr) {
@@ -46,10 +58,14 @@ namespace detail {
       }
 
       // try write multiple stream
-      std::lock_guard<std::mutex> lock(_mutex);
-      if (_sessions.size() > 0) {
+      std::vector<std::shared_ptr<Session>> sessions;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        sessions = _sessions;
+      }
+      if (sessions.size() > 0) {
         auto message = Session::MakeMessage(buffers...);
-        for (auto &s : _sessions) {
+        for (auto &s : sessions) {
           if (s != nullptr) {
             s->Write(message);
             log_debug("sensor ", s->get_stream_id()," data sent ");
@@ -58,6 +74,32 @@ namespace detail {
       }
     }
 
+    /// Statistics of the send queue of every session connected.
+    std::vector<tcp::SessionStatistics> GetSessionStatistics() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::vector<tcp::SessionStatistics> result;
+      result.reserve(_sessions.size());
+      for (auto &s : _sessions) {
+        if (s != nullptr) {
+          result.emplace_back(s->GetStatistics());
+        }
+      }
+      return result;
+    }
+
+    /// Publish the stream also through a shared memory ring, so clients on
+    /// this host can read it without going through TCP. Must be called before
+    /// writing to the stream. Returns false if the ring couldn't be created.
+    bool OpenSharedMemoryRing(size_t capacity) {
+      DEBUG_ASSERT(token().has_shared_memory());
+      _shared_memory_ring = shm::RingWriter::Create(
+          shm::GetRingName(token().get_port(), token().get_stream_id()),
+          token().get_port(),
+          token().get_stream_id(),
+          capacity);
+      return _shared_memory_ring != nullptr;
+    }
+
     void ForceActive() {
       _force_active = true;
     }
@@ -75,7 +117,8 @@ namespace detail {
     }
 
     bool AreClientsListening() {
-      return (_sessions.size() > 0 || _force_active || _enabled_for_ros);
+      return (_sessions.size() > 0 || _force_active || _enabled_for_ros ||
+          ((_shared_memory_ring != nullptr) && _shared_memory_ring->HasReaders()));
     }
 
     void ConnectSession(std::shared_ptr<Session> session) final {
@@ -137,6 +180,9 @@ namespace detail {
     AtomicSharedPtr<Session> _session;
     // if there are more than one session, we use vector of sessions with mutex
     std::vector<std::shared_ptr<Session>> _sessions;
+    std::unique_ptr<shm::RingWriter> _shared_memory_ring;
+    // serializes writers of the ring
+    std::mutex _shared_memory_mutex;
     bool _force_active {false};
     bool _enabled_for_ros {false};
   };
@@ -6,13 +6,45 @@
 
 #pragma once
 
-#include "carla/streaming/detail/tcp/ServerSession.h"
+#include "carla/TypeTraits.h"
+#include "carla/streaming/detail/Types.h"
+#include "carla/streaming/detail/tcp/Message.h"
+#include "carla/streaming/detail/tcp/SendQueue.h"
+
+#include <memory>
 
 namespace carla {
 namespace streaming {
 namespace detail {
 
-  using Session = tcp::ServerSession;
+  /// Where the messages of a stream are written for one client: either a
+  /// connection of its own (tcp::ServerSession) or a channel of a connection
+  /// shared by several streams (tcp::MultiplexedSession).
+  class Session {
+  public:
+
+    virtual ~Session() = default;
+
+    virtual stream_id_type get_stream_id() const = 0;
+
+    template <typename... Buffers>
+    static auto MakeMessage(Buffers... buffers) {
+      static_assert(
+          are_same<SharedBufferView, Buffers...>::value,
+          "This function only accepts arguments of type BufferView.");
+      return std::make_shared<const tcp::Message>(buffers...);
+    }
+
+    /// Queues a message to be written. The message is shared, not copied, so
+    /// the same message can be written to several sessions.
+    virtual void Write(std::shared_ptr<const tcp::Message> message) = 0;
+
+    /// Post a job to close the session.
+    virtual void Close() = 0;
+
+    /// Counters of the messages written to this session.
+    virtual tcp::SessionStatistics GetStatistics() const = 0;
+  };
 
 } // namespace detail
 } // namespace streaming
@@ -29,7 +29,9 @@ namespace detail {
     enum class protocol : uint8_t {
       not_set,
       tcp,
-      udp
+      udp,
+      /// TCP, and a shared memory ring for clients on the same host.
+      tcp_shared_memory
     } protocol = protocol::not_set;
 
     enum class address : uint8_t {
@@ -74,10 +76,18 @@ namespace detail {
     template <typename P>
     boost::asio::ip::basic_endpoint<P> get_endpoint() const {
       DEBUG_ASSERT(is_valid());
-      DEBUG_ASSERT(get_protocol<P>() == _token.protocol);
+      DEBUG_ASSERT(get_protocol<P>() == get_endpoint_protocol());
       return {get_address(), _token.port};
     }
 
+    /// Protocol of the endpoint, a shared memory token is reached over TCP
+    /// when the ring is not available.
+    auto get_endpoint_protocol() const {
+      return _token.protocol == token_data::protocol::tcp_shared_memory ?
+          token_data::protocol::tcp :
+          _token.protocol;
+    }
+
   public:
   
     template <typename Protocol>
@@ -152,12 +162,26 @@ namespace detail {
     }
 
     bool protocol_is_tcp() const {
-      return _token.protocol == token_data::protocol::tcp;
+      return get_endpoint_protocol() == token_data::protocol::tcp;
+    }
+
+    /// Whether the stream is also published through a shared memory ring,
+    /// only TCP streams can be.
+    bool has_shared_memory() const {
+      return _token.protocol == token_data::protocol::tcp_shared_memory;
+    }
+
+    void set_shared_memory(bool enabled) {
+      if (protocol_is_tcp()) {
+        _token.protocol = enabled ?
+            token_data::protocol::tcp_shared_memory :
+            token_data::protocol::tcp;
+      }
     }
 
     template <typename Protocol>
     bool has_same_protocol(const boost::asio::ip::basic_endpoint<Protocol> &) const {
-      return _token.protocol == get_protocol<Protocol>();
+      return get_endpoint_protocol() == get_protocol<Protocol>();
     }
 
     boost::asio::ip::udp::endpoint to_udp_endpoint() const {
@@ -0,0 +1,113 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/shm/Client.h"
+
+#include "carla/BufferPool.h"
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
+
+#include <boost/asio/post.hpp>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  /// Time the reader thread waits for a message before checking whether the
+  /// client was stopped or the writer went away.
+  static const time_duration RING_POLL_TIMEOUT = time_duration::milliseconds(100u);
+
+  Client::Client(
+      boost::asio::io_context &io_context,
+      const token_type &token,
+      callback_function_type callback)
+    : LIBCARLA_INITIALIZE_LIFETIME_PROFILER(
+          std::string("shm client ") + std::to_string(token.get_stream_id())),
+      _io_context(io_context),
+      _token(token),
+      _callback(std::move(callback)),
+      _strand(io_context),
+      _buffer_pool(std::make_shared<BufferPool>()) {}
+
+  Client::~Client() {
+    if (_reader_thread.joinable()) {
+      _reader_thread.detach();
+    }
+  }
+
+  void Client::Connect() {
+    std::unique_ptr<RingReader> reader;
+    if (_token.has_shared_memory() && IsSupported() && IsLocalAddress(_token.get_address())) {
+      reader = RingReader::Open(
+          GetRingName(_token.get_port(), _token.get_stream_id()),
+          _token.get_port(),
+          _token.get_stream_id());
+    }
+    if (reader == nullptr) {
+      ConnectTcp();
+      return;
+    }
+    log_debug("streaming client: reading stream", _token.get_stream_id(), "from shared memory");
+    _is_using_shared_memory = true;
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto self = shared_from_this();
+    auto *reader_ptr = reader.release();
+    _reader_thread = std::thread([self, reader_ptr]() {
+      self->ReadRing(std::unique_ptr<RingReader>(reader_ptr));
+    });
+  }
+
+  void Client::Stop() {
+    _done = true;
+    std::thread reader_thread;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_tcp_client != nullptr) {
+        _tcp_client->Stop();
+      }
+      reader_thread = std::move(_reader_thread);
+    }
+    if (reader_thread.joinable()) {
+      if (reader_thread.get_id() == std::this_thread::get_id()) {
+        reader_thread.detach();
+      } else {
+        reader_thread.join();
+      }
+    }
+  }
+
+  void Client::ReadRing(std::unique_ptr<RingReader> reader) {
+    while (!_done) {
+      auto buffer = _buffer_pool->Pop();
+      if (reader->Read(buffer, RING_POLL_TIMEOUT)) {
+        auto message = std::make_shared<Buffer>(std::move(buffer));
+        boost::asio::post(_strand, [self=shared_from_this(), message]() {
+          self->_callback(std::move(*message));
+        });
+      } else if (!reader->IsWriterAlive()) {
+        log_info("streaming client: shared memory ring of stream", _token.get_stream_id(), "closed, falling back to TCP");
+        _is_using_shared_memory = false;
+        ConnectTcp();
+        return;
+      }
+    }
+  }
+
+  void Client::ConnectTcp() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_done || (_tcp_client != nullptr)) {
+      return;
+    }
+    _tcp_client = std::make_shared<tcp::Client>(_io_context, _token, _callback);
+    _tcp_client->Connect();
+  }
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
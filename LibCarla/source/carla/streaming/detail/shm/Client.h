@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/profiler/LifetimeProfiled.h"
+#include "carla/streaming/detail/Token.h"
+#include "carla/streaming/detail/Types.h"
+#include "carla/streaming/detail/tcp/Client.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace carla {
+
+  class BufferPool;
+
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  class RingReader;
+
+  /// A client that connects to a single stream. If the token advertises a
+  /// shared memory ring and the stream is published on this host, the
+  /// messages are read from the ring; otherwise, or if the ring goes away,
+  /// it falls back to a tcp::Client.
+  ///
+  /// @warning This client should be stopped before releasing the shared pointer
+  /// or won't be destroyed.
+  class Client
+    : public std::enable_shared_from_this<Client>,
+      private profiler::LifetimeProfiled,
+      private NonCopyable {
+  public:
+
+    using endpoint = tcp::Client::endpoint;
+    using protocol_type = tcp::Client::protocol_type;
+    using callback_function_type = tcp::Client::callback_function_type;
+
+    Client(
+        boost::asio::io_context &io_context,
+        const token_type &token,
+        callback_function_type callback);
+
+    ~Client();
+
+    void Connect();
+
+    stream_id_type GetStreamId() const {
+      return _token.get_stream_id();
+    }
+
+    /// Whether the messages are being read from a shared memory ring.
+    bool IsUsingSharedMemory() const {
+      return _is_using_shared_memory;
+    }
+
+    void Stop();
+
+  private:
+
+    void ReadRing(std::unique_ptr<RingReader> reader);
+
+    void ConnectTcp();
+
+    boost::asio::io_context &_io_context;
+
+    const token_type _token;
+
+    callback_function_type _callback;
+
+    boost::asio::io_context::strand _strand;
+
+    std::shared_ptr<BufferPool> _buffer_pool;
+
+    std::mutex _mutex;
+
+    std::shared_ptr<tcp::Client> _tcp_client;
+
+    std::thread _reader_thread;
+
+    std::atomic_bool _is_using_shared_memory{false};
+
+    std::atomic_bool _done{false};
+  };
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
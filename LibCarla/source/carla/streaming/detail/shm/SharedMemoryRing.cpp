@@ -0,0 +1,401 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
+
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#  include <climits>
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <ifaddrs.h>
+#  include <netinet/in.h>
+#  include <linux/futex.h>
+#  include <signal.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/syscall.h>
+#  include <time.h>
+#  include <unistd.h>
+#endif // __linux__
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  static constexpr uint32_t RING_MAGIC = 0x43524e47u; // "CRNG"
+
+  static constexpr uint32_t RING_VERSION = 1u;
+
+  /// Messages are stored as an 8 bytes size followed by the payload, padded
+  /// to 8 bytes so the size never wraps around the end of the ring.
+  static constexpr uint64_t RECORD_ALIGNMENT = 8u;
+
+  static_assert(
+      sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+      "futex word must be a plain 32-bit integer");
+
+  /// Layout of the beginning of the segment. Positions are absolute byte
+  /// counts since the ring was created, the offset in the ring is the
+  /// position modulo the capacity.
+  struct alignas(64) RingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    int64_t writer_pid;
+    stream_id_type stream_id;
+    uint16_t port;
+    std::atomic<uint32_t> is_ready;
+    std::atomic<uint32_t> is_closed;
+    std::atomic<uint32_t> reader_count;
+    /// Incremented on every message, readers wait on it.
+    std::atomic<uint32_t> notification;
+    /// End of the last message written.
+    std::atomic<uint64_t> write_position;
+    /// Beginning of the last message written.
+    std::atomic<uint64_t> last_message_position;
+    /// Data before this position may have been overwritten.
+    std::atomic<uint64_t> tail_position;
+  };
+
+  static constexpr size_t DATA_OFFSET = sizeof(RingHeader);
+
+  static uint64_t GetRecordSize(uint64_t size) {
+    const uint64_t padded = (size + RECORD_ALIGNMENT - 1u) & ~(RECORD_ALIGNMENT - 1u);
+    return sizeof(uint64_t) + padded;
+  }
+
+  std::string GetRingName(uint16_t port, stream_id_type stream_id) {
+    return "/carla-stream-" + std::to_string(port) + "-" + std::to_string(stream_id);
+  }
+
+  unsigned char *SharedMemory::data() const {
+    return reinterpret_cast<unsigned char *>(_data) + DATA_OFFSET;
+  }
+
+#if defined(__linux__)
+
+  // ===========================================================================
+  // -- Platform helpers -------------------------------------------------------
+  // ===========================================================================
+
+  bool IsSupported() {
+    return true;
+  }
+
+  bool IsLocalAddress(const boost::asio::ip::address &address) {
+    if (address.is_loopback()) {
+      return true;
+    }
+    ifaddrs *interfaces = nullptr;
+    if (getifaddrs(&interfaces) != 0) {
+      return false;
+    }
+    bool found = false;
+    for (auto *it = interfaces; (it != nullptr) && !found; it = it->ifa_next) {
+      if (it->ifa_addr == nullptr) {
+        continue;
+      }
+      if ((it->ifa_addr->sa_family == AF_INET) && address.is_v4()) {
+        const auto *ip = reinterpret_cast<const sockaddr_in *>(it->ifa_addr);
+        found = (ntohl(ip->sin_addr.s_addr) == address.to_v4().to_uint());
+      } else if ((it->ifa_addr->sa_family == AF_INET6) && address.is_v6()) {
+        const auto *ip = reinterpret_cast<const sockaddr_in6 *>(it->ifa_addr);
+        const auto bytes = address.to_v6().to_bytes();
+        found = (std::memcmp(&ip->sin6_addr, bytes.data(), bytes.size()) == 0);
+      }
+    }
+    freeifaddrs(interfaces);
+    return found;
+  }
+
+  static void FutexWait(std::atomic<uint32_t> &word, uint32_t expected, time_duration timeout) {
+    const auto milliseconds = timeout.milliseconds();
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(milliseconds / 1000u);
+    ts.tv_nsec = static_cast<long>((milliseconds % 1000u) * 1000000u);
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+  }
+
+  static void FutexWakeAll(std::atomic<uint32_t> &word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+  }
+
+  static std::unique_ptr<SharedMemory> Map(int fd, size_t size) {
+    void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      return nullptr;
+    }
+    return std::make_unique<SharedMemory>(data, size);
+  }
+
+  SharedMemory::~SharedMemory() {
+    munmap(_data, _size);
+  }
+
+  // ===========================================================================
+  // -- RingWriter -------------------------------------------------------------
+  // ===========================================================================
+
+  std::unique_ptr<RingWriter> RingWriter::Create(
+      const std::string &name,
+      const uint16_t port,
+      const stream_id_type stream_id,
+      size_t capacity) {
+    capacity = static_cast<size_t>(GetRecordSize(capacity) - sizeof(uint64_t));
+    // Remove any segment left behind by a process that didn't exit cleanly.
+    shm_unlink(name.c_str());
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      log_warning("shared memory ring", name, ": failed to create segment:", std::strerror(errno));
+      return nullptr;
+    }
+    const size_t size = DATA_OFFSET + capacity;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      log_warning("shared memory ring", name, ": failed to allocate segment:", std::strerror(errno));
+      close(fd);
+      shm_unlink(name.c_str());
+      return nullptr;
+    }
+    auto memory = Map(fd, size);
+    if (memory == nullptr) {
+      log_warning("shared memory ring", name, ": failed to map segment");
+      shm_unlink(name.c_str());
+      return nullptr;
+    }
+    auto &header = *new (&memory->header()) RingHeader{};
+    header.magic = RING_MAGIC;
+    header.version = RING_VERSION;
+    header.capacity = capacity;
+    header.writer_pid = getpid();
+    header.stream_id = stream_id;
+    header.port = port;
+    header.is_ready.store(1u, std::memory_order_release);
+    log_debug("shared memory ring", name, "created");
+    return std::unique_ptr<RingWriter>(new RingWriter(name, std::move(memory)));
+  }
+
+  RingWriter::RingWriter(std::string name, std::unique_ptr<SharedMemory> memory)
+    : _name(std::move(name)),
+      _memory(std::move(memory)) {}
+
+  RingWriter::~RingWriter() {
+    auto &header = _memory->header();
+    header.is_closed.store(1u, std::memory_order_release);
+    header.notification.fetch_add(1u, std::memory_order_release);
+    FutexWakeAll(header.notification);
+    shm_unlink(_name.c_str());
+  }
+
+  bool RingWriter::HasReaders() const {
+    return _memory->header().reader_count.load(std::memory_order_relaxed) > 0u;
+  }
+
+  uint64_t RingWriter::BeginWrite(const size_t size) {
+    auto &header = _memory->header();
+    const uint64_t record_size = GetRecordSize(size);
+    if (record_size > header.capacity) {
+      log_warning("shared memory ring", _name, ": message of", size, "bytes discarded, ring too small");
+      return INVALID_POSITION;
+    }
+    const uint64_t position = header.write_position.load(std::memory_order_relaxed);
+    const uint64_t end = position + record_size;
+    if (end > header.capacity) {
+      // Invalidate the region we are about to overwrite before touching it.
+      header.tail_position.store(end - header.capacity, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+    const uint64_t size_field = size;
+    CopyIn(position, &size_field, sizeof(size_field));
+    return position + sizeof(size_field);
+  }
+
+  void RingWriter::CopyIn(const uint64_t position, const void *source, const size_t size) {
+    const uint64_t capacity = _memory->header().capacity;
+    const size_t offset = static_cast<size_t>(position % capacity);
+    const size_t first = std::min(size, static_cast<size_t>(capacity) - offset);
+    auto *bytes = reinterpret_cast<const unsigned char *>(source);
+    std::memcpy(_memory->data() + offset, bytes, first);
+    std::memcpy(_memory->data(), bytes + first, size - first);
+  }
+
+  void RingWriter::EndWrite(const uint64_t position, const size_t size) {
+    auto &header = _memory->header();
+    const uint64_t begin = position - sizeof(uint64_t);
+    header.last_message_position.store(begin, std::memory_order_release);
+    header.write_position.store(begin + GetRecordSize(size), std::memory_order_release);
+    header.notification.fetch_add(1u, std::memory_order_release);
+    FutexWakeAll(header.notification);
+  }
+
+  // ===========================================================================
+  // -- RingReader -------------------------------------------------------------
+  // ===========================================================================
+
+  static bool IsProcessAlive(const int64_t pid) {
+    return (pid > 0) &&
+        ((kill(static_cast<pid_t>(pid), 0) == 0) || (errno == EPERM));
+  }
+
+  std::unique_ptr<RingReader> RingReader::Open(
+      const std::string &name,
+      const uint16_t port,
+      const stream_id_type stream_id) {
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+      return nullptr;
+    }
+    struct stat status;
+    if ((fstat(fd, &status) != 0) || (static_cast<size_t>(status.st_size) < DATA_OFFSET)) {
+      close(fd);
+      return nullptr;
+    }
+    auto memory = Map(fd, static_cast<size_t>(status.st_size));
+    if (memory == nullptr) {
+      return nullptr;
+    }
+    auto &header = memory->header();
+    const bool is_valid =
+        (header.is_ready.load(std::memory_order_acquire) != 0u) &&
+        (header.magic == RING_MAGIC) &&
+        (header.version == RING_VERSION) &&
+        (header.port == port) &&
+        (header.stream_id == stream_id) &&
+        (DATA_OFFSET + header.capacity <= static_cast<size_t>(status.st_size)) &&
+        (header.is_closed.load(std::memory_order_acquire) == 0u) &&
+        IsProcessAlive(header.writer_pid);
+    if (!is_valid) {
+      log_debug("shared memory ring", name, "is not valid, ignoring it");
+      return nullptr;
+    }
+    header.reader_count.fetch_add(1u, std::memory_order_relaxed);
+    return std::unique_ptr<RingReader>(new RingReader(std::move(memory)));
+  }
+
+  RingReader::RingReader(std::unique_ptr<SharedMemory> memory)
+    : _memory(std::move(memory)),
+      _read_position(_memory->header().write_position.load(std::memory_order_acquire)) {}
+
+  RingReader::~RingReader() {
+    _memory->header().reader_count.fetch_sub(1u, std::memory_order_relaxed);
+  }
+
+  bool RingReader::IsWriterAlive() const {
+    const auto &header = _memory->header();
+    return (header.is_closed.load(std::memory_order_acquire) == 0u) &&
+        IsProcessAlive(header.writer_pid);
+  }
+
+  void RingReader::CopyOut(const uint64_t position, void *destination, const size_t size) const {
+    const uint64_t capacity = _memory->header().capacity;
+    const size_t offset = static_cast<size_t>(position % capacity);
+    const size_t first = std::min(size, static_cast<size_t>(capacity) - offset);
+    auto *bytes = reinterpret_cast<unsigned char *>(destination);
+    std::memcpy(bytes, _memory->data() + offset, first);
+    std::memcpy(bytes + first, _memory->data(), size - first);
+  }
+
+  bool RingReader::Read(Buffer &buffer, const time_duration timeout) {
+    auto &header = _memory->header();
+    bool has_waited = false;
+    for (;;) {
+      const uint64_t write_position = header.write_position.load(std::memory_order_acquire);
+      if (_read_position == write_position) {
+        if (has_waited) {
+          return false;
+        }
+        const uint32_t notification = header.notification.load(std::memory_order_acquire);
+        if (header.write_position.load(std::memory_order_acquire) == write_position) {
+          FutexWait(header.notification, notification, timeout);
+        }
+        has_waited = true;
+        continue;
+      }
+      if ((_read_position > write_position) ||
+          (_read_position < header.tail_position.load(std::memory_order_acquire))) {
+        // We fell behind and the writer overwrote our message, skip to the
+        // latest one.
+        _read_position = header.last_message_position.load(std::memory_order_acquire);
+        continue;
+      }
+      uint64_t size = 0u;
+      CopyOut(_read_position, &size, sizeof(size));
+      if (GetRecordSize(size) <= header.capacity) {
+        buffer.reset(size);
+        CopyOut(_read_position + sizeof(size), buffer.data(), size);
+      }
+      // Check that the writer didn't overwrite the message while copying it.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (_read_position < header.tail_position.load(std::memory_order_relaxed)) {
+        continue;
+      }
+      DEBUG_ASSERT(GetRecordSize(size) <= header.capacity);
+      _read_position += GetRecordSize(size);
+      return true;
+    }
+  }
+
+#else
+
+  bool IsSupported() {
+    return false;
+  }
+
+  bool IsLocalAddress(const boost::asio::ip::address &address) {
+    return address.is_loopback();
+  }
+
+  SharedMemory::~SharedMemory() = default;
+
+  std::unique_ptr<RingWriter> RingWriter::Create(
+      const std::string &, uint16_t, stream_id_type, size_t) {
+    return nullptr;
+  }
+
+  RingWriter::~RingWriter() = default;
+
+  bool RingWriter::HasReaders() const {
+    return false;
+  }
+
+  uint64_t RingWriter::BeginWrite(size_t) {
+    return INVALID_POSITION;
+  }
+
+  void RingWriter::CopyIn(uint64_t, const void *, size_t) {}
+
+  void RingWriter::EndWrite(uint64_t, size_t) {}
+
+  std::unique_ptr<RingReader> RingReader::Open(
+      const std::string &, uint16_t, stream_id_type) {
+    return nullptr;
+  }
+
+  RingReader::~RingReader() = default;
+
+  bool RingReader::Read(Buffer &, time_duration) {
+    return false;
+  }
+
+  bool RingReader::IsWriterAlive() const {
+    return false;
+  }
+
+#endif // __linux__
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
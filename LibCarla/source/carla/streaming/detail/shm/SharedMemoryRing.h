@@ -0,0 +1,159 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+#include "carla/streaming/detail/Types.h"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/ip/address.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  struct RingHeader;
+
+  /// Default size of the ring of each stream, enough for a few 4K images.
+  static constexpr size_t DEFAULT_RING_CAPACITY = 128u * 1024u * 1024u;
+
+  /// Whether shared memory rings are supported on this platform.
+  bool IsSupported();
+
+  /// Whether @a address belongs to this host, only streams published on this
+  /// host can be read from shared memory.
+  bool IsLocalAddress(const boost::asio::ip::address &address);
+
+  /// Name of the shared memory segment of a stream, derived from the port of
+  /// the streaming server and the stream id so clients can find it from the
+  /// token.
+  std::string GetRingName(uint16_t port, stream_id_type stream_id);
+
+  /// Mapping of a shared memory segment, unmapped on destruction.
+  class SharedMemory : private NonCopyable {
+  public:
+
+    SharedMemory(void *data, size_t size) : _data(data), _size(size) {}
+
+    ~SharedMemory();
+
+    RingHeader &header() const {
+      return *reinterpret_cast<RingHeader *>(_data);
+    }
+
+    unsigned char *data() const;
+
+  private:
+
+    void *_data;
+
+    size_t _size;
+  };
+
+  /// Writing end of a shared memory ring. The ring holds the most recent
+  /// messages of a stream in a single segment; each message is copied once
+  /// into the ring and readers on the same host copy it out, without going
+  /// through the network stack.
+  ///
+  /// The writer never waits for the readers. A reader that falls behind by
+  /// more than the capacity of the ring skips to the latest message, the same
+  /// as a slow TCP session in asynchronous mode.
+  class RingWriter : private NonCopyable {
+  public:
+
+    /// Creates the segment @a name, replacing any stale segment with the same
+    /// name. Returns nullptr on failure.
+    static std::unique_ptr<RingWriter> Create(
+        const std::string &name,
+        uint16_t port,
+        stream_id_type stream_id,
+        size_t capacity);
+
+    ~RingWriter();
+
+    /// Whether any reader is attached to the ring.
+    bool HasReaders() const;
+
+    /// Copies @a buffers as a single message into the ring and wakes up the
+    /// readers. Messages bigger than the ring are discarded.
+    template <typename ConstBufferSequence>
+    void Write(const ConstBufferSequence &buffers) {
+      const size_t size = boost::asio::buffer_size(buffers);
+      const uint64_t position = BeginWrite(size);
+      if (position == INVALID_POSITION) {
+        return;
+      }
+      uint64_t offset = position;
+      for (auto it = boost::asio::buffer_sequence_begin(buffers);
+           it != boost::asio::buffer_sequence_end(buffers);
+           ++it) {
+        CopyIn(offset, it->data(), it->size());
+        offset += it->size();
+      }
+      EndWrite(position, size);
+    }
+
+  private:
+
+    static constexpr uint64_t INVALID_POSITION = ~uint64_t(0u);
+
+    RingWriter(std::string name, std::unique_ptr<SharedMemory> memory);
+
+    uint64_t BeginWrite(size_t size);
+
+    void CopyIn(uint64_t position, const void *source, size_t size);
+
+    void EndWrite(uint64_t position, size_t size);
+
+    const std::string _name;
+
+    const std::unique_ptr<SharedMemory> _memory;
+  };
+
+  /// Reading end of a shared memory ring. Only one thread may read from a
+  /// reader.
+  class RingReader : private NonCopyable {
+  public:
+
+    /// Opens the ring of the stream, returns nullptr if there is no ring
+    /// published by a live process for it on this host.
+    static std::unique_ptr<RingReader> Open(
+        const std::string &name,
+        uint16_t port,
+        stream_id_type stream_id);
+
+    ~RingReader();
+
+    /// Waits up to @a timeout for the next message and copies it into
+    /// @a buffer. Returns false if there was no new message.
+    bool Read(Buffer &buffer, time_duration timeout);
+
+    /// Whether the process that published the ring is still running.
+    bool IsWriterAlive() const;
+
+  private:
+
+    explicit RingReader(std::unique_ptr<SharedMemory> memory);
+
+    void CopyOut(uint64_t position, void *destination, size_t size) const;
+
+    const std::unique_ptr<SharedMemory> _memory;
+
+    uint64_t _read_position;
+  };
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -30,19 +30,17 @@ namespace tcp {
   // ===========================================================================
 
   /// Helper for reading incoming TCP messages. Allocates the whole message in
-  /// a single buffer.
+  /// a single buffer, taken from the pool once the size is known.
   class IncomingMessage {
   public:
 
-    explicit IncomingMessage(Buffer &&buffer) : _message(std::move(buffer)) {}
-
     boost::asio::mutable_buffer size_as_buffer() {
       return boost::asio::buffer(&_size, sizeof(_size));
     }
 
-    boost::asio::mutable_buffer buffer() {
+    boost::asio::mutable_buffer buffer(BufferPool &pool) {
       DEBUG_ASSERT(_size > 0u);
-      _message.reset(_size);
+      _message = pool.Pop(_size);
       return _message.buffer();
     }
 
@@ -172,7 +170,7 @@ namespace tcp {
 
       // log_debug("streaming client: Client::ReadData");
 
-      auto message = std::make_shared<IncomingMessage>(_buffer_pool->Pop());
+      auto message = std::make_shared<IncomingMessage>();
 
       auto handle_read_data = [this, self, message](boost::system::error_code ec, size_t DEBUG_ONLY(bytes)) {
         DEBUG_ONLY(log_debug("streaming client: Client::ReadData.handle_read_data", bytes, "bytes"));
@@ -180,9 +178,10 @@ namespace tcp {
           DEBUG_ASSERT_EQ(bytes, message->size());
           DEBUG_ASSERT_NE(bytes, 0u);
           // Move the buffer to the callback function and start reading the next
-          // piece of data.
+          // piece of data. The callback only queues the message for delivery
+          // (see DeliveryQueue), so it is called here instead of posted.
           // log_debug("streaming client: success reading data, calling the callback");
-          boost::asio::post(_strand, [self, message]() { self->_callback(message->pop()); });
+          _callback(message->pop());
           ReadData();
         } else {
           // As usual, if anything fails start over from the very top.
@@ -204,7 +203,7 @@ namespace tcp {
           // buffer and start putting data into it.
           boost::asio::async_read(
               _socket,
-              message->buffer(),
+              message->buffer(*_buffer_pool),
               boost::asio::bind_executor(_strand, handle_read_data));
         } else if (!_done) {
           log_debug("streaming client: failed to read header:", ec.message());
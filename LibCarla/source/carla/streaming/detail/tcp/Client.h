@@ -31,6 +31,10 @@ namespace tcp {
 
   /// A client that connects to a single stream.
   ///
+  /// The callback is called from the strand that reads the socket, so the next
+  /// message is not read until it returns. streaming::Client passes a callback
+  /// that only queues the message.
+  ///
   /// @warning This client should be stopped before releasing the shared pointer
   /// or won't be destroyed.
   class Client
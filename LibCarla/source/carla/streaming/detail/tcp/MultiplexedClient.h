@@ -0,0 +1,144 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/profiler/LifetimeProfiled.h"
+#include "carla/streaming/detail/Token.h"
+#include "carla/streaming/detail/Types.h"
+#include "carla/streaming/detail/tcp/Client.h"
+#include "carla/streaming/detail/tcp/MultiplexedProtocol.h"
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace carla {
+
+  class BufferPool;
+
+namespace streaming {
+namespace detail {
+namespace tcp {
+
+  /// A client that reads any number of streams of a server through a single
+  /// connection, a MultiplexedSession on the server side.
+  ///
+  /// Connects on the first subscription and subscribes again to every stream
+  /// after reconnecting. If the server refuses the multiplexed session, each
+  /// stream falls back to a Client of its own.
+  ///
+  /// As with Client, the callbacks are called from the strand that reads the
+  /// socket, so they should only queue the messages.
+  ///
+  /// @warning This client should be stopped before releasing the shared pointer
+  /// or won't be destroyed.
+  class MultiplexedClient
+    : public std::enable_shared_from_this<MultiplexedClient>,
+      private profiler::LifetimeProfiled,
+      private NonCopyable {
+  public:
+
+    using endpoint = boost::asio::ip::tcp::endpoint;
+    using protocol_type = endpoint::protocol_type;
+    using callback_function_type = std::function<void (Buffer)>;
+
+    MultiplexedClient(boost::asio::io_context &io_context, endpoint ep);
+
+    ~MultiplexedClient();
+
+    /// Subscribe to the stream of @a token, which must be served at the
+    /// endpoint of this client. The messages of streams with higher @a
+    /// priority are sent first.
+    void Subscribe(
+        const token_type &token,
+        uint8_t priority,
+        callback_function_type callback);
+
+    void UnSubscribe(stream_id_type stream_id);
+
+    /// Whether the server refused the multiplexed session, and each stream is
+    /// read through a connection of its own.
+    bool IsFallingBack() const {
+      return _is_falling_back;
+    }
+
+    void Stop();
+
+  private:
+
+    struct Subscription {
+      token_type token;
+      uint8_t priority;
+      callback_function_type callback;
+      std::shared_ptr<Client> fallback_client;
+    };
+
+    /// The methods below must be called within the strand.
+
+    void Connect();
+
+    void Reconnect();
+
+    void FallBack();
+
+    void StartFallbackClient(Subscription &subscription);
+
+    void SendRequest(
+        MultiplexedRequest::Type type,
+        stream_id_type stream_id,
+        uint8_t priority = 0u);
+
+    void WriteNextRequest();
+
+    void ReadData(size_t connection);
+
+    boost::asio::io_context &_io_context;
+
+    const endpoint _endpoint;
+
+    boost::asio::ip::tcp::socket _socket;
+
+    boost::asio::io_context::strand _strand;
+
+    boost::asio::deadline_timer _connection_timer;
+
+    std::shared_ptr<BufferPool> _buffer_pool;
+
+    std::unordered_map<stream_id_type, Subscription> _subscriptions;
+
+    std::deque<MultiplexedRequest> _requests;
+
+    uint32_t _acknowledgement = 0u;
+
+    /// Incremented on every connection attempt, handlers of previous
+    /// connections are ignored.
+    size_t _connection = 0u;
+
+    bool _is_active = false;
+
+    bool _is_connected = false;
+
+    bool _is_writing = false;
+
+    std::atomic_bool _is_falling_back{false};
+
+    std::atomic_bool _done{false};
+  };
+
+} // namespace tcp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,63 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/streaming/detail/Types.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace tcp {
+
+  /// Stream id sent by a client, instead of the id of a stream, to open a
+  /// multiplexed session: a single connection carrying any number of streams.
+  constexpr stream_id_type MULTIPLEXED_STREAM_ID =
+      std::numeric_limits<stream_id_type>::max();
+
+  /// Sent back by a server that accepts the multiplexed session. Servers that
+  /// don't support it close the connection instead.
+  constexpr uint32_t MULTIPLEXED_PROTOCOL_VERSION = 1u;
+
+#pragma pack(push, 1)
+
+  /// Request sent by the client of a multiplexed session.
+  struct MultiplexedRequest {
+    enum class Type : uint8_t {
+      Subscribe = 1u,
+      UnSubscribe = 2u
+    };
+
+    Type type = Type::Subscribe;
+
+    /// Messages of streams with higher priority are sent first.
+    uint8_t priority = 0u;
+
+    uint16_t reserved = 0u;
+
+    stream_id_type stream_id = 0u;
+  };
+
+  /// Header of every message sent through a multiplexed session. The payload
+  /// follows, exactly as a single stream session would send it.
+  struct MultiplexedHeader {
+    stream_id_type stream_id = 0u;
+
+    message_size_type size = 0u;
+  };
+
+#pragma pack(pop)
+
+  static_assert(sizeof(MultiplexedRequest) == 8u, "Invalid request size");
+  static_assert(sizeof(MultiplexedHeader) == 8u, "Invalid header size");
+
+} // namespace tcp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
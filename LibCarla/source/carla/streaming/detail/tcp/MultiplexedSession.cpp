@@ -0,0 +1,409 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/tcp/MultiplexedSession.h"
+#include "carla/streaming/detail/tcp/Server.h"
+
+#include "carla/Debug.h"
+#include "carla/ListView.h"
+#include "carla/Logging.h"
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace tcp {
+
+  static std::atomic_size_t MULTIPLEXED_SESSION_COUNTER{0u};
+
+  static uint64_t GetWireSize(const Message &message) {
+    return sizeof(MultiplexedHeader) + message.size();
+  }
+
+  // ===========================================================================
+  // -- OutgoingMessage --------------------------------------------------------
+  // ===========================================================================
+
+  /// A message of a channel together with its multiplexed header, kept alive
+  /// until the write completes.
+  class OutgoingMessage {
+  public:
+
+    OutgoingMessage(stream_id_type stream_id, std::shared_ptr<const Message> message)
+      : _message(std::move(message)) {
+      _header.stream_id = stream_id;
+      _header.size = _message->size();
+      _buffer_views[0u] = boost::asio::buffer(&_header, sizeof(_header));
+      // Skip the size header of the message, it is part of ours.
+      auto sequence = _message->GetBufferSequence();
+      for (auto it = std::next(sequence.begin()); it != sequence.end(); ++it) {
+        _buffer_views[_number_of_buffers++] = *it;
+      }
+    }
+
+    auto GetBufferSequence() const {
+      auto begin = _buffer_views.begin();
+      return MakeListView(begin, begin + _number_of_buffers);
+    }
+
+  private:
+
+    MultiplexedHeader _header;
+
+    std::shared_ptr<const Message> _message;
+
+    std::array<boost::asio::const_buffer, Message::max_size() + 1u> _buffer_views;
+
+    size_t _number_of_buffers = 1u;
+  };
+
+  // ===========================================================================
+  // -- MultiplexedChannel -----------------------------------------------------
+  // ===========================================================================
+
+  void MultiplexedChannel::Write(std::shared_ptr<const Message> message) {
+    _session->Write(*this, std::move(message));
+  }
+
+  void MultiplexedChannel::Close() {
+    boost::asio::post(_session->_strand, [self=shared_from_this()]() {
+      self->_session->CloseChannel(self);
+    });
+  }
+
+  SessionStatistics MultiplexedChannel::GetStatistics() const {
+    return _session->GetStatistics(*this);
+  }
+
+  // ===========================================================================
+  // -- MultiplexedSession -----------------------------------------------------
+  // ===========================================================================
+
+  MultiplexedSession::MultiplexedSession(
+      boost::asio::io_context &io_context,
+      socket_type socket,
+      const time_duration timeout,
+      const SendQueueSettings send_queue_settings,
+      Server &server)
+    : LIBCARLA_INITIALIZE_LIFETIME_PROFILER(
+          std::string("tcp multiplexed session ") + std::to_string(MULTIPLEXED_SESSION_COUNTER)),
+      _server(server),
+      _session_id(MULTIPLEXED_SESSION_COUNTER++),
+      _socket(std::move(socket)),
+      _timeout(timeout),
+      _deadline(io_context),
+      _strand(io_context),
+      _send_queue_settings(send_queue_settings) {
+    DEBUG_ASSERT(_send_queue_settings.max_queued_messages > 0u);
+  }
+
+  void MultiplexedSession::Open(
+      callback_function_type on_channel_opened,
+      callback_function_type on_channel_closed) {
+    DEBUG_ASSERT(on_channel_opened && on_channel_closed);
+    _on_channel_opened = std::move(on_channel_opened);
+    _on_channel_closed = std::move(on_channel_closed);
+
+    _deadline.expires_from_now(_timeout);
+    StartTimer();
+    auto self = shared_from_this();
+    boost::asio::post(_strand, [this, self]() {
+      static constexpr uint32_t version = MULTIPLEXED_PROTOCOL_VERSION;
+      auto handle_sent = [this, self](const boost::system::error_code &ec, size_t) {
+        if (!ec) {
+          log_debug("multiplexed session", _session_id, "started");
+          ReadRequest();
+        } else {
+          log_error("multiplexed session", _session_id, ": error sending acknowledgement :", ec.message());
+          CloseNow(ec);
+        }
+      };
+      boost::asio::async_write(
+          _socket,
+          boost::asio::buffer(&version, sizeof(version)),
+          boost::asio::bind_executor(_strand, handle_sent));
+    });
+  }
+
+  void MultiplexedSession::Close() {
+    boost::asio::post(_strand, [self=shared_from_this()]() { self->CloseNow(); });
+  }
+
+  void MultiplexedSession::Write(
+      MultiplexedChannel &channel,
+      std::shared_ptr<const Message> message) {
+    DEBUG_ASSERT(message != nullptr);
+    DEBUG_ASSERT(!message->empty());
+    const uint64_t message_bytes = GetWireSize(*message);
+    const size_t max_queued_messages = std::max<size_t>(_send_queue_settings.max_queued_messages, 1u);
+    // In synchronous mode every message must arrive, the writer waits for the
+    // channel to catch up.
+    const SendQueuePolicy policy = _server.IsSynchronousMode() ?
+        SendQueuePolicy::Block :
+        _send_queue_settings.policy;
+
+    auto &queue = channel._send_queue;
+    auto &statistics = channel._statistics;
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_is_closed || channel._is_closed) {
+      return;
+    }
+    bool discard_message = false;
+    if (queue.size() >= max_queued_messages) {
+      switch (policy) {
+        case SendQueuePolicy::DropOldest: {
+          const uint64_t dropped_bytes = GetWireSize(*queue.front());
+          queue.pop_front();
+          ++statistics.dropped_messages;
+          statistics.dropped_bytes += dropped_bytes;
+          statistics.queued_bytes -= dropped_bytes;
+          break;
+        }
+        case SendQueuePolicy::Block:
+          _queue_not_full.wait_for(
+              lock,
+              _send_queue_settings.block_timeout.to_chrono(),
+              [&]() {
+                return _is_closed || channel._is_closed || (queue.size() < max_queued_messages);
+              });
+          if (_is_closed || channel._is_closed) {
+            return;
+          }
+          discard_message = (queue.size() >= max_queued_messages);
+          break;
+        case SendQueuePolicy::DropNewest:
+          discard_message = true;
+          break;
+      }
+    }
+    if (discard_message) {
+      ++statistics.dropped_messages;
+      statistics.dropped_bytes += message_bytes;
+      log_debug("multiplexed session", _session_id, ": stream", channel._stream_id, "too slow: message discarded");
+      return;
+    }
+    queue.emplace_back(std::move(message));
+    statistics.queued_messages = queue.size();
+    statistics.queued_bytes += message_bytes;
+    if (_is_writing) {
+      // The message is picked up when the one in flight has been sent.
+      return;
+    }
+    _is_writing = true;
+    lock.unlock();
+
+    boost::asio::post(_strand, [self=shared_from_this()]() { self->WriteNextMessage(); });
+  }
+
+  SessionStatistics MultiplexedSession::GetStatistics(const MultiplexedChannel &channel) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return channel._statistics;
+  }
+
+  void MultiplexedSession::ReadRequest() {
+    auto handle_request = [this, self=shared_from_this()](
+        const boost::system::error_code &ec,
+        size_t DEBUG_ONLY(bytes_received)) {
+      if (ec) {
+        log_debug("multiplexed session", _session_id, ": error reading request :", ec.message());
+        CloseNow(ec);
+        return;
+      }
+      DEBUG_ASSERT_EQ(bytes_received, sizeof(_request));
+      _deadline.expires_from_now(_timeout);
+      switch (_request.type) {
+        case MultiplexedRequest::Type::Subscribe:
+          OpenChannel(_request.stream_id, _request.priority);
+          break;
+        case MultiplexedRequest::Type::UnSubscribe: {
+          auto channel = FindChannel(_request.stream_id);
+          if (channel != nullptr) {
+            CloseChannel(std::move(channel));
+          }
+          break;
+        }
+        default:
+          log_error("multiplexed session", _session_id, ": invalid request, closing session");
+          CloseNow();
+          return;
+      }
+      ReadRequest();
+    };
+
+    boost::asio::async_read(
+        _socket,
+        boost::asio::buffer(&_request, sizeof(_request)),
+        boost::asio::bind_executor(_strand, handle_request));
+  }
+
+  std::shared_ptr<MultiplexedChannel> MultiplexedSession::FindChannel(stream_id_type stream_id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = std::find_if(_channels.begin(), _channels.end(), [=](const auto &channel) {
+      return channel->_stream_id == stream_id;
+    });
+    return it != _channels.end() ? *it : nullptr;
+  }
+
+  void MultiplexedSession::OpenChannel(stream_id_type stream_id, uint8_t priority) {
+    if (FindChannel(stream_id) != nullptr) {
+      log_warning("multiplexed session", _session_id, ": already subscribed to stream", stream_id);
+      return;
+    }
+    auto channel = std::make_shared<MultiplexedChannel>(shared_from_this(), stream_id, priority);
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_is_closed) {
+        return;
+      }
+      _channels.emplace_back(channel);
+    }
+    log_debug("multiplexed session", _session_id, ": stream", stream_id, "subscribed");
+    // Called within the strand, so a channel is always opened before it is
+    // closed.
+    _on_channel_opened(std::move(channel));
+  }
+
+  void MultiplexedSession::CloseChannel(std::shared_ptr<MultiplexedChannel> channel) {
+    DEBUG_ASSERT(channel != nullptr);
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto it = std::find(_channels.begin(), _channels.end(), channel);
+      if (it == _channels.end()) {
+        // Already closed.
+        return;
+      }
+      _channels.erase(it);
+      channel->_is_closed = true;
+      channel->_send_queue.clear();
+      channel->_statistics.queued_messages = 0u;
+      channel->_statistics.queued_bytes = 0u;
+    }
+    _queue_not_full.notify_all();
+    log_debug("multiplexed session", _session_id, ": stream", channel->_stream_id, "unsubscribed");
+    _on_channel_closed(std::move(channel));
+  }
+
+  void MultiplexedSession::WriteNextMessage() {
+    std::shared_ptr<MultiplexedChannel> channel;
+    std::shared_ptr<const Message> message;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!_socket.is_open() || _is_closed) {
+        _is_writing = false;
+        return;
+      }
+      // Pick the channel with the highest priority, starting after the last
+      // one sent so channels with the same priority take turns.
+      const size_t count = _channels.size();
+      size_t selected = 0u;
+      for (size_t i = 0u; i < count; ++i) {
+        const size_t index = (_next_channel + i) % count;
+        const auto &candidate = _channels[index];
+        if (!candidate->_send_queue.empty() &&
+            ((channel == nullptr) || (candidate->_priority > channel->_priority))) {
+          channel = candidate;
+          selected = index;
+        }
+      }
+      if (channel == nullptr) {
+        _is_writing = false;
+        return;
+      }
+      _next_channel = selected + 1u;
+      message = std::move(channel->_send_queue.front());
+      channel->_send_queue.pop_front();
+      channel->_statistics.queued_messages = channel->_send_queue.size();
+      channel->_statistics.queued_bytes -= GetWireSize(*message);
+    }
+    _queue_not_full.notify_all();
+
+    const uint64_t message_bytes = GetWireSize(*message);
+    auto outgoing = std::make_shared<OutgoingMessage>(channel->_stream_id, std::move(message));
+
+    auto handle_sent = [this, self=shared_from_this(), channel, outgoing, message_bytes](
+        const boost::system::error_code &ec,
+        size_t DEBUG_ONLY(bytes)) {
+      if (ec) {
+        log_info("multiplexed session", _session_id, ": error sending data :", ec.message());
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _is_writing = false;
+        }
+        CloseNow(ec);
+      } else {
+        DEBUG_ASSERT_EQ(bytes, message_bytes);
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          ++channel->_statistics.sent_messages;
+          channel->_statistics.sent_bytes += message_bytes;
+        }
+        WriteNextMessage();
+      }
+    };
+
+    _deadline.expires_from_now(_timeout);
+    boost::asio::async_write(
+        _socket,
+        outgoing->GetBufferSequence(),
+        boost::asio::bind_executor(_strand, handle_sent));
+  }
+
+  void MultiplexedSession::StartTimer() {
+    if (_deadline.expires_at() <= boost::asio::deadline_timer::traits_type::now()) {
+      log_debug("multiplexed session", _session_id, "timed out");
+      Close();
+    } else {
+      _deadline.async_wait([this, self=shared_from_this()](boost::system::error_code ec) {
+        if (!ec) {
+          StartTimer();
+        }
+      });
+    }
+  }
+
+  void MultiplexedSession::CloseNow(boost::system::error_code) {
+    std::vector<std::shared_ptr<MultiplexedChannel>> channels;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_is_closed) {
+        return;
+      }
+      _is_closed = true;
+      channels.swap(_channels);
+      for (auto &channel : channels) {
+        channel->_is_closed = true;
+        channel->_send_queue.clear();
+        channel->_statistics.queued_messages = 0u;
+        channel->_statistics.queued_bytes = 0u;
+      }
+    }
+    _queue_not_full.notify_all();
+    _deadline.cancel();
+    if (_socket.is_open()) {
+      boost::system::error_code ec2;
+      _socket.shutdown(boost::asio::socket_base::shutdown_both, ec2);
+      _socket.close(ec2);
+    }
+    // The channels, and with them their references to this session, are
+    // released by the callback.
+    for (auto &channel : channels) {
+      _on_channel_closed(channel);
+    }
+    log_debug("multiplexed session", _session_id, "closed");
+  }
+
+} // namespace tcp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
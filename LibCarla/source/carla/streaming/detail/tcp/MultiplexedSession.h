@@ -0,0 +1,200 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+#include "carla/profiler/LifetimeProfiled.h"
+#include "carla/streaming/detail/Session.h"
+#include "carla/streaming/detail/Types.h"
+#include "carla/streaming/detail/tcp/Message.h"
+#include "carla/streaming/detail/tcp/MultiplexedProtocol.h"
+#include "carla/streaming/detail/tcp/SendQueue.h"
+
+#if defined(__clang__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wshadow"
+#endif
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/strand.hpp>
+#if defined(__clang__)
+#  pragma clang diagnostic pop
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace tcp {
+
+  class MultiplexedSession;
+  class Server;
+
+  /// A stream sent through a MultiplexedSession. Each channel has its own
+  /// bounded send queue and statistics, so a stream that can't keep up only
+  /// discards its own messages, as a ServerSession would.
+  class MultiplexedChannel final
+    : public Session,
+      public std::enable_shared_from_this<MultiplexedChannel>,
+      private NonCopyable {
+  public:
+
+    MultiplexedChannel(
+        std::shared_ptr<MultiplexedSession> session,
+        stream_id_type stream_id,
+        uint8_t priority)
+      : _session(std::move(session)),
+        _stream_id(stream_id),
+        _priority(priority) {}
+
+    stream_id_type get_stream_id() const override {
+      return _stream_id;
+    }
+
+    uint8_t get_priority() const {
+      return _priority;
+    }
+
+    void Write(std::shared_ptr<const Message> message) override;
+
+    /// Post a job to close the channel, the rest of the session is not
+    /// affected.
+    void Close() override;
+
+    SessionStatistics GetStatistics() const override;
+
+  private:
+
+    friend class MultiplexedSession;
+
+    const std::shared_ptr<MultiplexedSession> _session;
+
+    const stream_id_type _stream_id;
+
+    const uint8_t _priority;
+
+    /// The members below are guarded by the mutex of the session.
+
+    std::deque<std::shared_ptr<const Message>> _send_queue;
+
+    SessionStatistics _statistics;
+
+    bool _is_closed = false;
+  };
+
+  /// A TCP server session carrying any number of streams. Opened by a
+  /// ServerSession that reads MULTIPLEXED_STREAM_ID instead of a stream id.
+  ///
+  /// The client subscribes and unsubscribes streams with MultiplexedRequest
+  /// messages, each subscription opens a MultiplexedChannel that is passed to
+  /// the callbacks as any other session. Every message is sent preceded by a
+  /// MultiplexedHeader. When several channels have messages queued, the one
+  /// with the highest priority is sent first, channels with the same priority
+  /// take turns.
+  class MultiplexedSession
+    : public std::enable_shared_from_this<MultiplexedSession>,
+      private profiler::LifetimeProfiled,
+      private NonCopyable {
+  public:
+
+    using socket_type = boost::asio::ip::tcp::socket;
+    using callback_function_type = std::function<void(std::shared_ptr<Session>)>;
+
+    MultiplexedSession(
+        boost::asio::io_context &io_context,
+        socket_type socket,
+        time_duration timeout,
+        SendQueueSettings send_queue_settings,
+        Server &server);
+
+    /// Acknowledges the session and starts reading requests. Calls @a
+    /// on_channel_opened for each stream subscribed, and @a on_channel_closed
+    /// once its channel is closed.
+    void Open(
+        callback_function_type on_channel_opened,
+        callback_function_type on_channel_closed);
+
+    /// Post a job to close the session and all its channels.
+    void Close();
+
+  private:
+
+    friend class MultiplexedChannel;
+
+    void Write(MultiplexedChannel &channel, std::shared_ptr<const Message> message);
+
+    SessionStatistics GetStatistics(const MultiplexedChannel &channel) const;
+
+    void ReadRequest();
+
+    /// The channel of @a stream_id, if any. Must be called within the
+    /// strand.
+    std::shared_ptr<MultiplexedChannel> FindChannel(stream_id_type stream_id) const;
+
+    /// Must be called within the strand.
+    void OpenChannel(stream_id_type stream_id, uint8_t priority);
+
+    /// Must be called within the strand.
+    void CloseChannel(std::shared_ptr<MultiplexedChannel> channel);
+
+    /// Sends the next message of the channel with the highest priority, must
+    /// be called within the strand.
+    void WriteNextMessage();
+
+    void StartTimer();
+
+    void CloseNow(boost::system::error_code ec = boost::system::error_code());
+
+    Server &_server;
+
+    const size_t _session_id;
+
+    socket_type _socket;
+
+    time_duration _timeout;
+
+    boost::asio::deadline_timer _deadline;
+
+    boost::asio::io_context::strand _strand;
+
+    callback_function_type _on_channel_opened;
+
+    callback_function_type _on_channel_closed;
+
+    const SendQueueSettings _send_queue_settings;
+
+    MultiplexedRequest _request;
+
+    /// Guards the channels and their send queues, shared between the writers
+    /// and the strand.
+    mutable std::mutex _mutex;
+
+    std::condition_variable _queue_not_full;
+
+    std::vector<std::shared_ptr<MultiplexedChannel>> _channels;
+
+    /// Where to start looking for the next channel to send, so channels with
+    /// the same priority take turns.
+    size_t _next_channel = 0u;
+
+    bool _is_writing = false;
+
+    bool _is_closed = false;
+  };
+
+} // namespace tcp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
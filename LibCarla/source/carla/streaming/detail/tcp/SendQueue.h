@@ -0,0 +1,55 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Time.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace tcp {
+
+  /// What a session does when a message is written while its send queue is
+  /// full.
+  enum class SendQueuePolicy : uint8_t {
+    /// Discard the oldest queued message to make room for the new one.
+    DropOldest,
+    /// Discard the new message.
+    DropNewest,
+    /// Wait until there is room in the queue, or discard the new message if
+    /// there is still none after the block timeout.
+    Block
+  };
+
+  struct SendQueueSettings {
+    SendQueuePolicy policy = SendQueuePolicy::DropOldest;
+    /// Maximum number of messages waiting to be sent, not counting the one
+    /// being sent. At least one.
+    size_t max_queued_messages = 1u;
+    /// Maximum time a write waits for room in the queue under the Block
+    /// policy.
+    time_duration block_timeout = time_duration::seconds(1u);
+  };
+
+  /// Byte and message counters of a session. Bytes include the message
+  /// headers.
+  struct SessionStatistics {
+    size_t queued_messages = 0u;
+    uint64_t queued_bytes = 0u;
+    uint64_t sent_messages = 0u;
+    uint64_t sent_bytes = 0u;
+    uint64_t dropped_messages = 0u;
+    uint64_t dropped_bytes = 0u;
+  };
+
+} // namespace tcp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -29,7 +29,11 @@ namespace tcp {
       ServerSession::callback_function_type on_closed) {
     using boost::system::error_code;
 
-    auto session = std::make_shared<ServerSession>(_io_context, timeout, *this);
+    auto session = std::make_shared<ServerSession>(
+        _io_context,
+        timeout,
+        GetSendQueueSettings(),
+        *this);
 
     auto handle_query = [on_opened, on_closed, session](const error_code &ec) {
       if (!ec) {
@@ -46,6 +50,23 @@ namespace tcp {
     });
   }
 
+  void Server::OpenMultiplexedSession(ServerSession::socket_type socket) {
+    if (_on_channel_opened == nullptr) {
+      log_info("tcp server: multiplexed sessions not enabled, closing connection");
+      boost::system::error_code ec;
+      socket.shutdown(boost::asio::socket_base::shutdown_both, ec);
+      socket.close(ec);
+      return;
+    }
+    auto session = std::make_shared<MultiplexedSession>(
+        _io_context,
+        std::move(socket),
+        _timeout,
+        GetSendQueueSettings(),
+        *this);
+    session->Open(_on_channel_opened, _on_channel_closed);
+  }
+
 } // namespace tcp
 } // namespace detail
 } // namespace streaming
@@ -8,6 +8,7 @@
 
 #include "carla/NonCopyable.h"
 #include "carla/Time.h"
+#include "carla/streaming/detail/tcp/MultiplexedSession.h"
 #include "carla/streaming/detail/tcp/ServerSession.h"
 
 #include <boost/asio/io_context.hpp>
@@ -15,6 +16,7 @@
 #include <boost/asio/post.hpp>
 
 #include <atomic>
+#include <mutex>
 
 namespace carla {
 namespace streaming {
@@ -41,6 +43,29 @@ namespace tcp {
       _timeout = timeout;
     }
 
+    /// Set the send queue settings. Applies only to newly created sessions.
+    void SetSendQueueSettings(const SendQueueSettings &settings) {
+      std::lock_guard<std::mutex> lock(_send_queue_settings_mutex);
+      _send_queue_settings = settings;
+    }
+
+    SendQueueSettings GetSendQueueSettings() const {
+      std::lock_guard<std::mutex> lock(_send_queue_settings_mutex);
+      return _send_queue_settings;
+    }
+
+    /// Accept multiplexed sessions too. @a on_channel_opened is called for
+    /// each stream subscribed through one of them, and @a on_channel_closed
+    /// when its channel is closed. Otherwise multiplexed sessions are refused,
+    /// and the clients fall back to a session per stream. Must be called
+    /// before Listen.
+    void EnableMultiplexing(
+        MultiplexedSession::callback_function_type on_channel_opened,
+        MultiplexedSession::callback_function_type on_channel_closed) {
+      _on_channel_opened = std::move(on_channel_opened);
+      _on_channel_closed = std::move(on_channel_closed);
+    }
+
     /// Start listening for connections. On each new connection, @a
     /// on_session_opened is called, and @a on_session_closed when the session
     /// is closed.
@@ -64,17 +89,30 @@ namespace tcp {
 
   private:
 
+    friend class ServerSession;
+
     void OpenSession(
         time_duration timeout,
         ServerSession::callback_function_type on_session_opened,
         ServerSession::callback_function_type on_session_closed);
 
+    /// Takes over the connection of a session that requested multiplexing.
+    void OpenMultiplexedSession(ServerSession::socket_type socket);
+
     boost::asio::io_context &_io_context;
 
     boost::asio::ip::tcp::acceptor _acceptor;
 
     std::atomic<time_duration> _timeout;
 
+    mutable std::mutex _send_queue_settings_mutex;
+
+    SendQueueSettings _send_queue_settings;
+
+    MultiplexedSession::callback_function_type _on_channel_opened;
+
+    MultiplexedSession::callback_function_type _on_channel_closed;
+
     bool _synchronous;
   };
 
@@ -15,8 +15,8 @@
 #include <boost/asio/bind_executor.hpp>
 #include <boost/asio/post.hpp>
 
+#include <algorithm>
 #include <atomic>
-#include <thread>
 
 namespace carla {
 namespace streaming {
@@ -28,6 +28,7 @@ namespace tcp {
   ServerSession::ServerSession(
       boost::asio::io_context &io_context,
       const time_duration timeout,
+      const SendQueueSettings send_queue_settings,
       Server &server)
     : LIBCARLA_INITIALIZE_LIFETIME_PROFILER(
           std::string("tcp server session ") + std::to_string(SESSION_COUNTER)),
@@ -36,7 +37,10 @@ namespace tcp {
       _socket(io_context),
       _timeout(timeout),
       _deadline(io_context),
-      _strand(io_context) {}
+      _strand(io_context),
+      _send_queue_settings(send_queue_settings) {
+    DEBUG_ASSERT(_send_queue_settings.max_queued_messages > 0u);
+  }
 
   void ServerSession::Open(
       callback_function_type on_opened,
@@ -58,6 +62,13 @@ namespace tcp {
           size_t DEBUG_ONLY(bytes_received)) {
         if (!ec) {
           DEBUG_ASSERT_EQ(bytes_received, sizeof(_stream_id));
+          if (_stream_id == MULTIPLEXED_STREAM_ID) {
+            // The socket is handed over, this session is never opened.
+            log_debug("session", _session_id, ": multiplexed session requested");
+            _deadline.cancel();
+            _server.OpenMultiplexedSession(std::move(_socket));
+            return;
+          }
           log_debug("session", _session_id, "for stream", _stream_id, " started");
           boost::asio::post(_strand.context(), [=]() { callback(self); });
         } else {
@@ -75,53 +86,129 @@ namespace tcp {
     });
   }
 
+  static uint64_t GetWireSize(const Message &message) {
+    return sizeof(message_size_type) + message.size();
+  }
+
   void ServerSession::Write(std::shared_ptr<const Message> message) {
     DEBUG_ASSERT(message != nullptr);
     DEBUG_ASSERT(!message->empty());
-    auto self = shared_from_this();
-    boost::asio::post(_strand, [=]() {
-      if (!_socket.is_open()) {
-        return;
-      }
-      if (_is_writing) {
-        if (_server.IsSynchronousMode()) {
-          // wait until previous message has been sent
-          while (_is_writing) {
-            std::this_thread::yield();
-          }
-        } else {
-          // ignore this message
-          log_debug("session", _session_id, ": connection too slow: message discarded");
-          return;
+    const uint64_t message_bytes = GetWireSize(*message);
+    const size_t max_queued_messages = std::max<size_t>(_send_queue_settings.max_queued_messages, 1u);
+    // In synchronous mode every message must arrive, the writer waits for the
+    // session to catch up.
+    const SendQueuePolicy policy = _server.IsSynchronousMode() ?
+        SendQueuePolicy::Block :
+        _send_queue_settings.policy;
+
+    std::unique_lock<std::mutex> lock(_queue_mutex);
+    if (_is_closed) {
+      return;
+    }
+    bool discard_message = false;
+    if (_send_queue.size() >= max_queued_messages) {
+      switch (policy) {
+        case SendQueuePolicy::DropOldest: {
+          const uint64_t dropped_bytes = GetWireSize(*_send_queue.front());
+          _send_queue.pop_front();
+          ++_statistics.dropped_messages;
+          _statistics.dropped_bytes += dropped_bytes;
+          _statistics.queued_bytes -= dropped_bytes;
+          log_debug("session", _session_id, ": connection too slow: oldest message discarded");
+          break;
         }
+        case SendQueuePolicy::Block:
+          _queue_not_full.wait_for(
+              lock,
+              _send_queue_settings.block_timeout.to_chrono(),
+              [this, max_queued_messages]() {
+                return _is_closed || (_send_queue.size() < max_queued_messages);
+              });
+          if (_is_closed) {
+            return;
+          }
+          // Discard this message if the session didn't catch up in time.
+          discard_message = (_send_queue.size() >= max_queued_messages);
+          break;
+        case SendQueuePolicy::DropNewest:
+          discard_message = true;
+          break;
       }
-      _is_writing = true;
+    }
+    if (discard_message) {
+      ++_statistics.dropped_messages;
+      _statistics.dropped_bytes += message_bytes;
+      log_debug("session", _session_id, ": connection too slow: message discarded");
+      return;
+    }
+    _send_queue.emplace_back(std::move(message));
+    _statistics.queued_messages = _send_queue.size();
+    _statistics.queued_bytes += message_bytes;
+    if (_is_writing) {
+      // The message is picked up when the one in flight has been sent.
+      return;
+    }
+    _is_writing = true;
+    lock.unlock();
+
+    boost::asio::post(_strand, [self=shared_from_this()]() { self->WriteNextMessage(); });
+  }
 
-      auto handle_sent = [this, self, message](const boost::system::error_code &ec, size_t DEBUG_ONLY(bytes)) {
+  void ServerSession::WriteNextMessage() {
+    std::shared_ptr<const Message> message;
+    {
+      std::lock_guard<std::mutex> lock(_queue_mutex);
+      if (_send_queue.empty() || !_socket.is_open()) {
         _is_writing = false;
-        if (ec) {
-          log_info("session", _session_id, ": error sending data :", ec.message());
-          CloseNow(ec);
-        } else {
-          DEBUG_ONLY(log_debug("session", _session_id, ": successfully sent", bytes, "bytes"));
-          DEBUG_ASSERT_EQ(bytes, sizeof(message_size_type) + message->size());
+        return;
+      }
+      message = std::move(_send_queue.front());
+      _send_queue.pop_front();
+      _statistics.queued_messages = _send_queue.size();
+      _statistics.queued_bytes -= GetWireSize(*message);
+    }
+    _queue_not_full.notify_one();
+
+    auto handle_sent = [this, self=shared_from_this(), message](
+        const boost::system::error_code &ec,
+        size_t DEBUG_ONLY(bytes)) {
+      if (ec) {
+        log_info("session", _session_id, ": error sending data :", ec.message());
+        {
+          std::lock_guard<std::mutex> lock(_queue_mutex);
+          _is_writing = false;
         }
-      };
+        CloseNow(ec);
+      } else {
+        DEBUG_ONLY(log_debug("session", _session_id, ": successfully sent", bytes, "bytes"));
+        DEBUG_ASSERT_EQ(bytes, GetWireSize(*message));
+        {
+          std::lock_guard<std::mutex> lock(_queue_mutex);
+          ++_statistics.sent_messages;
+          _statistics.sent_bytes += GetWireSize(*message);
+        }
+        WriteNextMessage();
+      }
+    };
 
-      log_debug("session", _session_id, ": sending message of", message->size(), "bytes");
+    log_debug("session", _session_id, ": sending message of", message->size(), "bytes");
 
-      _deadline.expires_from_now(_timeout);
-      boost::asio::async_write(
-          _socket,
-          message->GetBufferSequence(),
-          handle_sent);
-    });
+    _deadline.expires_from_now(_timeout);
+    boost::asio::async_write(
+        _socket,
+        message->GetBufferSequence(),
+        boost::asio::bind_executor(_strand, handle_sent));
   }
 
   void ServerSession::Close() {
     boost::asio::post(_strand, [self=shared_from_this()]() { self->CloseNow(); });
   }
 
+  SessionStatistics ServerSession::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(_queue_mutex);
+    return _statistics;
+  }
+
   void ServerSession::StartTimer() {
     if (_deadline.expires_at() <= boost::asio::deadline_timer::traits_type::now()) {
       log_debug("session", _session_id, "timed out");
@@ -138,6 +225,14 @@ namespace tcp {
   }
 
   void ServerSession::CloseNow(boost::system::error_code ec) {
+    {
+      std::lock_guard<std::mutex> lock(_queue_mutex);
+      _is_closed = true;
+      _send_queue.clear();
+      _statistics.queued_messages = 0u;
+      _statistics.queued_bytes = 0u;
+    }
+    _queue_not_full.notify_all();
     _deadline.cancel();
     if (!ec)
     {
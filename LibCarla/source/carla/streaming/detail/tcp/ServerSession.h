@@ -8,10 +8,12 @@
 
 #include "carla/NonCopyable.h"
 #include "carla/Time.h"
-#include "carla/TypeTraits.h"
 #include "carla/profiler/LifetimeProfiled.h"
+#include "carla/streaming/detail/Session.h"
 #include "carla/streaming/detail/Types.h"
 #include "carla/streaming/detail/tcp/Message.h"
+#include "carla/streaming/detail/tcp/MultiplexedProtocol.h"
+#include "carla/streaming/detail/tcp/SendQueue.h"
 
 #if defined(__clang__)
 #  pragma clang diagnostic push
@@ -25,8 +27,11 @@
 #  pragma clang diagnostic pop
 #endif
 
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 
 namespace carla {
 namespace streaming {
@@ -38,8 +43,18 @@ namespace tcp {
   /// A TCP server session. When a session opens, it reads from the socket a
   /// stream id object and passes itself to the callback functor. The session
   /// closes itself after @a timeout of inactivity is met.
+  ///
+  /// Messages are sent in order through a bounded queue, so a slow client
+  /// only affects its own session. When the queue is full the
+  /// SendQueueSettings of the session decide which message is discarded; in
+  /// synchronous mode writes always block until there is room or the block
+  /// timeout expires.
+  ///
+  /// A client that sends MULTIPLEXED_STREAM_ID instead of a stream id is
+  /// handed over to a MultiplexedSession, and this session is dropped.
   class ServerSession
-    : public std::enable_shared_from_this<ServerSession>,
+    : public Session,
+      public std::enable_shared_from_this<ServerSession>,
       private profiler::LifetimeProfiled,
       private NonCopyable {
   public:
@@ -50,6 +65,7 @@ namespace tcp {
     explicit ServerSession(
         boost::asio::io_context &io_context,
         time_duration timeout,
+        SendQueueSettings send_queue_settings,
         Server &server);
 
     /// Starts the session and calls @a on_opened after successfully reading the
@@ -60,20 +76,13 @@ namespace tcp {
 
     /// @warning This function should only be called after the session is
     /// opened. It is safe to call this function from within the @a callback.
-    stream_id_type get_stream_id() const {
+    stream_id_type get_stream_id() const override {
       return _stream_id;
     }
 
-    template <typename... Buffers>
-    static auto MakeMessage(Buffers... buffers) {
-      static_assert(
-          are_same<SharedBufferView, Buffers...>::value,
-          "This function only accepts arguments of type BufferView.");
-      return std::make_shared<const Message>(buffers...);
-    }
-
-    /// Writes some data to the socket.
-    void Write(std::shared_ptr<const Message> message);
+    /// Queues a message to be written to the socket. The message is shared,
+    /// not copied, so the same message can be written to several sessions.
+    void Write(std::shared_ptr<const Message> message) override;
 
     /// Writes some data to the socket.
     template <typename... Buffers>
@@ -82,10 +91,16 @@ namespace tcp {
     }
 
     /// Post a job to close the session.
-    void Close();
+    void Close() override;
+
+    /// Counters of the messages written to this session.
+    SessionStatistics GetStatistics() const override;
 
   private:
 
+    /// Sends the next message in the queue, must be called within the strand.
+    void WriteNextMessage();
+
     void StartTimer();
 
     void CloseNow(boost::system::error_code ec = boost::system::error_code());
@@ -108,7 +123,21 @@ namespace tcp {
 
     callback_function_type _on_closed;
 
+    const SendQueueSettings _send_queue_settings;
+
+    /// Guards the send queue, the statistics and the flags below, which are
+    /// shared between the writers and the strand.
+    mutable std::mutex _queue_mutex;
+
+    std::condition_variable _queue_not_full;
+
+    std::deque<std::shared_ptr<const Message>> _send_queue;
+
+    SessionStatistics _statistics;
+
     bool _is_writing = false;
+
+    bool _is_closed = false;
   };
 
 } // namespace tcp
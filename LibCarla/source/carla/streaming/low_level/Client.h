@@ -8,9 +8,12 @@
 
 #include "carla/streaming/detail/Token.h"
 #include "carla/streaming/detail/tcp/Client.h"
+#include "carla/streaming/detail/tcp/MultiplexedClient.h"
 
 #include <boost/asio/io_context.hpp>
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <unordered_map>
 
@@ -44,19 +47,45 @@ namespace low_level {
       for (auto &pair : _clients) {
         pair.second->Stop();
       }
+      for (auto &pair : _multiplexed_clients) {
+        pair.second->Stop();
+      }
+    }
+
+    /// Read the TCP streams subscribed from now on through a single
+    /// multiplexed connection per server, instead of a connection per stream.
+    /// Servers that don't support it are still read with a connection per
+    /// stream. Streams advertised through shared memory are not affected.
+    void SetMultiplexing(bool enabled) {
+      _multiplexing = enabled;
     }
 
     /// @warning cannot subscribe twice to the same stream (even if it's a
     /// MultiStream).
+    ///
+    /// Over a multiplexed connection, the messages of streams with higher @a
+    /// priority are sent first; otherwise @a priority is ignored.
     template <typename Functor>
     void Subscribe(
         boost::asio::io_context &io_context,
         token_type token,
-        Functor &&callback) {
+        Functor &&callback,
+        uint8_t priority = 0u) {
       DEBUG_ASSERT_EQ(_clients.find(token.get_stream_id()), _clients.end());
+      DEBUG_ASSERT_EQ(_multiplexed_streams.find(token.get_stream_id()), _multiplexed_streams.end());
       if (!token.has_address()) {
         token.set_address(_fallback_address);
       }
+      if (_multiplexing && token.protocol_is_tcp() && !token.has_shared_memory()) {
+        const auto ep = token.to_tcp_endpoint();
+        auto &client = _multiplexed_clients[ep];
+        if (client == nullptr) {
+          client = std::make_shared<detail::tcp::MultiplexedClient>(io_context, ep);
+        }
+        client->Subscribe(token, priority, std::forward<Functor>(callback));
+        _multiplexed_streams.emplace(token.get_stream_id(), ep);
+        return;
+      }
       auto client = std::make_shared<underlying_client>(
           io_context,
           token,
@@ -67,6 +96,24 @@ namespace low_level {
 
     void UnSubscribe(token_type token) {
       log_debug("calling sensor UnSubscribe()");
+      auto stream = _multiplexed_streams.find(token.get_stream_id());
+      if (stream != _multiplexed_streams.end()) {
+        const auto ep = stream->second;
+        _multiplexed_streams.erase(stream);
+        auto client = _multiplexed_clients.find(ep);
+        DEBUG_ASSERT(client != _multiplexed_clients.end());
+        client->second->UnSubscribe(token.get_stream_id());
+        // Drop the connection with its last stream.
+        const bool is_used = std::any_of(
+            _multiplexed_streams.begin(),
+            _multiplexed_streams.end(),
+            [&](const auto &pair) { return pair.second == ep; });
+        if (!is_used) {
+          client->second->Stop();
+          _multiplexed_clients.erase(client);
+        }
+        return;
+      }
       auto it = _clients.find(token.get_stream_id());
       if (it != _clients.end()) {
         it->second->Stop();
@@ -81,6 +128,16 @@ namespace low_level {
     std::unordered_map<
         detail::stream_id_type,
         std::shared_ptr<underlying_client>> _clients;
+
+    bool _multiplexing = false;
+
+    std::map<
+        detail::tcp::MultiplexedClient::endpoint,
+        std::shared_ptr<detail::tcp::MultiplexedClient>> _multiplexed_clients;
+
+    std::unordered_map<
+        detail::stream_id_type,
+        detail::tcp::MultiplexedClient::endpoint> _multiplexed_streams;
   };
 
 } // namespace low_level
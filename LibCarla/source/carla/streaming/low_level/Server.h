@@ -8,6 +8,7 @@
 
 #include "carla/streaming/detail/Dispatcher.h"
 #include "carla/streaming/detail/Types.h"
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
 #include "carla/streaming/Stream.h"
 
 #include <boost/asio/io_context.hpp>
@@ -77,6 +78,18 @@ namespace low_level {
       _server.SetSynchronousMode(is_synchro);
     }
 
+    void SetSendQueueSettings(const detail::tcp::SendQueueSettings &settings) {
+      _server.SetSendQueueSettings(settings);
+    }
+
+    /// Publish the streams created from now on also through shared memory,
+    /// clients on the same host read them without going through TCP.
+    void SetSharedMemoryTransport(
+        bool enabled,
+        size_t ring_capacity = detail::shm::DEFAULT_RING_CAPACITY) {
+      _dispatcher.SetSharedMemoryTransport(enabled, ring_capacity);
+    }
+
     token_type GetToken(stream_id sensor_id) {
       return _dispatcher.GetToken(sensor_id);
     }
@@ -105,6 +118,9 @@ namespace low_level {
         log_debug("on_session_closed called");
         _dispatcher.DeregisterSession(session);
       };
+      // The streams subscribed through a multiplexed session are registered
+      // the same way.
+      _server.EnableMultiplexing(on_session_opened, on_session_closed);
       _server.Listen(on_session_opened, on_session_closed);
     }
 
@@ -53,6 +53,31 @@ namespace traffic_manager {
       map.erase(key);
     }
 
+    /// Call @a functor(key, value) for every entry, holding the lock once.
+    template <typename Functor>
+    void ForEach(Functor &&functor) const {
+
+      std::lock_guard<std::mutex> lock(map_mutex);
+      for (const auto &entry : map) {
+        functor(entry.first, entry.second);
+      }
+    }
+
+    /// Remove the entries for which @a predicate(key, value) returns true,
+    /// holding the lock once.
+    template <typename Predicate>
+    void RemoveIf(Predicate &&predicate) {
+
+      std::lock_guard<std::mutex> lock(map_mutex);
+      for (auto it = map.begin(); it != map.end();) {
+        if (predicate(it->first, it->second)) {
+          it = map.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+
   };
 
 } // namespace traffic_manager
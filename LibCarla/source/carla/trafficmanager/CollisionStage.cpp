@@ -43,10 +43,14 @@ void CollisionStage::Update(const unsigned long index) {
     const unsigned long look_ahead_index = GetTargetWaypoint(ego_buffer, JUNCTION_LOOK_AHEAD).second;
     const float velocity = simulation_state.GetVelocity(ego_actor_id).Length();
 
-    ActorIdSet overlapping_actors = track_traffic.GetOverlappingVehicles(ego_actor_id);
+    CollisionLockEntry ego_lock = GetCollisionLock(ego_actor_id);
+
+    const ParametersSnapshot &snapshot = parameters.GetSnapshot();
+    const VehicleParameters &ego_parameters = snapshot.GetVehicle(index);
+
     std::vector<ActorId> collision_candidate_ids;
-    // Run through vehicles with overlapping paths and filter them;
-    const float distance_to_leading = parameters.GetDistanceToLeadingVehicle(ego_actor_id);
+    // Run through the actors around the vehicle and keep those with overlapping paths.
+    const float distance_to_leading = ego_parameters.distance_to_leading_vehicle;
     float collision_radius_square = SQUARE(COLLISION_RADIUS_RATE * velocity + COLLISION_RADIUS_MIN);
     if (velocity < 2.0f) {
       const float length = simulation_state.GetDimensions(ego_actor_id).x;
@@ -57,13 +61,14 @@ void CollisionStage::Update(const unsigned long index) {
         collision_radius_square = SQUARE(distance_to_leading);
     }
 
-    for (ActorId overlapping_actor_id : overlapping_actors) {
+    for (ActorId nearby_actor_id : GetActorsInRadius(ego_location, std::sqrt(collision_radius_square))) {
       // If actor is within maximum collision avoidance and vertical overlap range.
-      const cg::Location &overlapping_actor_location = simulation_state.GetLocation(overlapping_actor_id);
-      if (overlapping_actor_id != ego_actor_id
-          && cg::Math::DistanceSquared(overlapping_actor_location, ego_location) < collision_radius_square
-          && std::abs(ego_location.z - overlapping_actor_location.z) < VERTICAL_OVERLAP_THRESHOLD) {
-        collision_candidate_ids.push_back(overlapping_actor_id);
+      const cg::Location nearby_actor_location = simulation_state.GetLocation(nearby_actor_id);
+      if (nearby_actor_id != ego_actor_id
+          && cg::Math::DistanceSquared(nearby_actor_location, ego_location) < collision_radius_square
+          && std::abs(ego_location.z - nearby_actor_location.z) < VERTICAL_OVERLAP_THRESHOLD
+          && track_traffic.IsOverlapping(ego_actor_id, nearby_actor_id)) {
+        collision_candidate_ids.push_back(nearby_actor_id);
       }
     }
 
@@ -71,9 +76,9 @@ void CollisionStage::Update(const unsigned long index) {
     std::sort(collision_candidate_ids.begin(), collision_candidate_ids.end(),
               [this, &ego_location](const ActorId &a_id_1, const ActorId &a_id_2) {
                 const cg::Location &e_loc = ego_location;
-                const cg::Location &loc_1 = simulation_state.GetLocation(a_id_1);
-                const cg::Location &loc_2 = simulation_state.GetLocation(a_id_2);
-                return (cg::Math::DistanceSquared(e_loc, loc_1) < cg::Math::DistanceSquared(e_loc, loc_2));
+                const float distance_1 = cg::Math::DistanceSquared(e_loc, simulation_state.GetLocation(a_id_1));
+                const float distance_2 = cg::Math::DistanceSquared(e_loc, simulation_state.GetLocation(a_id_2));
+                return distance_1 < distance_2 || (distance_1 == distance_2 && a_id_1 < a_id_2);
               });
 
     // Check every actor in the vicinity if it poses a collision hazard.
@@ -83,17 +88,18 @@ void CollisionStage::Update(const unsigned long index) {
       const ActorId other_actor_id = *iter;
       const ActorType other_actor_type = simulation_state.GetType(other_actor_id);
 
-      if (parameters.GetCollisionDetection(ego_actor_id, other_actor_id)
+      if (snapshot.GetCollisionDetection(ego_parameters, other_actor_id)
           && buffer_map.find(ego_actor_id) != buffer_map.end()
           && simulation_state.ContainsActor(other_actor_id)) {
         std::pair<bool, float> negotiation_result = NegotiateCollision(ego_actor_id,
                                                                        other_actor_id,
-                                                                       look_ahead_index);
+                                                                       look_ahead_index,
+                                                                       ego_lock);
         if (negotiation_result.first) {
           if ((other_actor_type == ActorType::Vehicle
-               && parameters.GetPercentageIgnoreVehicles(ego_actor_id) <= random_device.next())
+               && ego_parameters.perc_ignore_vehicles <= GetRandomSample(index))
               || (other_actor_type == ActorType::Pedestrian
-                  && parameters.GetPercentageIgnoreWalkers(ego_actor_id) <= random_device.next())) {
+                  && ego_parameters.perc_ignore_walkers <= GetRandomSample(index))) {
             collision_hazard = true;
             obstacle_id = other_actor_id;
             available_distance_margin = negotiation_result.second;
@@ -101,6 +107,12 @@ void CollisionStage::Update(const unsigned long index) {
         }
       }
     }
+
+    if (parallel_cycle) {
+      staged_collision_locks.at(index) = ego_lock;
+    } else {
+      CommitCollisionLock(ego_actor_id, ego_lock);
+    }
   }
 
   CollisionHazardData &output_element = output_array.at(index);
@@ -117,7 +129,96 @@ void CollisionStage::Reset() {
   collision_locks.clear();
 }
 
-float CollisionStage::GetBoundingBoxExtention(const ActorId actor_id) {
+void CollisionStage::PrepareCycle() {
+  // Entries for the registered vehicles are filled by UpdateBoundaries, so
+  // they can be computed concurrently without modifying the map.
+  for (const ActorId actor_id : vehicle_id_list) {
+    if (simulation_state.ContainsActor(actor_id)) {
+      actor_geometry_map.insert({actor_id, ActorGeometry()});
+    }
+  }
+
+  for (const ActorId actor_id : simulation_state.GetActorSet()) {
+    const cg::Location location = simulation_state.GetLocation(actor_id);
+    const uint64_t cell_key = GetGridCellKey(GetGridCoordinate(location.x), GetGridCoordinate(location.y));
+    collision_grid[cell_key].push_back(actor_id);
+
+    if (actor_geometry_map.find(actor_id) == actor_geometry_map.end()) {
+      actor_geometry_map.insert({actor_id, GetActorGeometry(actor_id, GetCollisionLock(actor_id))});
+    }
+  }
+}
+
+void CollisionStage::PrepareParallelCycle() {
+  parallel_cycle = true;
+
+  const unsigned long number_of_vehicles = vehicle_id_list.size();
+  staged_collision_locks.resize(number_of_vehicles);
+  cycle_random_samples.resize(number_of_vehicles);
+  for (unsigned long index = 0u; index < number_of_vehicles; ++index) {
+    staged_collision_locks.at(index) = GetCollisionLock(vehicle_id_list.at(index));
+    cycle_random_samples.at(index) = random_device.next();
+  }
+}
+
+void CollisionStage::UpdateBoundaries(const unsigned long index) {
+  const ActorId actor_id = vehicle_id_list.at(index);
+  if (simulation_state.ContainsActor(actor_id)) {
+    actor_geometry_map.at(actor_id) = GetActorGeometry(actor_id, GetCollisionLock(actor_id));
+  }
+}
+
+int32_t CollisionStage::GetGridCoordinate(const float value) const {
+  return static_cast<int32_t>(std::floor(value * INV_BROADPHASE_CELL_SIZE));
+}
+
+uint64_t CollisionStage::GetGridCellKey(const int32_t x, const int32_t y) const {
+  uint64_t cell_key = static_cast<uint32_t>(x);
+  cell_key <<= 32;
+  cell_key |= static_cast<uint32_t>(y);
+  return cell_key;
+}
+
+std::vector<ActorId> CollisionStage::GetActorsInRadius(const cg::Location &location, const float radius) const {
+  std::vector<ActorId> actor_ids;
+  const int32_t min_x = GetGridCoordinate(location.x - radius);
+  const int32_t max_x = GetGridCoordinate(location.x + radius);
+  const int32_t min_y = GetGridCoordinate(location.y - radius);
+  const int32_t max_y = GetGridCoordinate(location.y + radius);
+  for (int32_t x = min_x; x <= max_x; ++x) {
+    for (int32_t y = min_y; y <= max_y; ++y) {
+      const auto cell_it = collision_grid.find(GetGridCellKey(x, y));
+      if (cell_it != collision_grid.end()) {
+        actor_ids.insert(actor_ids.end(), cell_it->second.begin(), cell_it->second.end());
+      }
+    }
+  }
+  return actor_ids;
+}
+
+CollisionLockEntry CollisionStage::GetCollisionLock(const ActorId actor_id) const {
+  CollisionLockEntry lock_entry{false, {0.0, 0.0, 0u}};
+  const auto lock_it = collision_locks.find(actor_id);
+  if (lock_it != collision_locks.end()) {
+    lock_entry.is_locked = true;
+    lock_entry.lock = lock_it->second;
+  }
+  return lock_entry;
+}
+
+void CollisionStage::CommitCollisionLock(const ActorId actor_id, const CollisionLockEntry &lock_entry) {
+  if (lock_entry.is_locked) {
+    collision_locks[actor_id] = lock_entry.lock;
+  } else {
+    collision_locks.erase(actor_id);
+  }
+}
+
+double CollisionStage::GetRandomSample(const unsigned long index) {
+  return parallel_cycle ? cycle_random_samples.at(index) : random_device.next();
+}
+
+float CollisionStage::GetBoundingBoxExtention(const ActorId actor_id, const CollisionLockEntry &lock_entry) {
 
   const float velocity = cg::Math::Dot(simulation_state.GetVelocity(actor_id), simulation_state.GetHeading(actor_id));
   float bbox_extension;
@@ -125,8 +226,8 @@ float CollisionStage::GetBoundingBoxExtention(const ActorId actor_id) {
   float velocity_extension = VEL_EXT_FACTOR * velocity;
   bbox_extension = BOUNDARY_EXTENSION_MINIMUM + velocity_extension * velocity_extension;
   // If a valid collision lock present, change boundary length to maintain lock.
-  if (collision_locks.find(actor_id) != collision_locks.end()) {
-    const CollisionLock &lock = collision_locks.at(actor_id);
+  if (lock_entry.is_locked) {
+    const CollisionLock &lock = lock_entry.lock;
     float lock_boundary_length = static_cast<float>(lock.distance_to_lead_vehicle + LOCKING_DISTANCE_PADDING);
     // Only extend boundary track vehicle if the leading vehicle
     // if it is not further than velocity dependent extension by MAX_LOCKING_EXTENSION.
@@ -169,74 +270,68 @@ LocationVector CollisionStage::GetBoundary(const ActorId actor_id) {
   return bbox_boundary;
 }
 
-LocationVector CollisionStage::GetGeodesicBoundary(const ActorId actor_id) {
+LocationVector CollisionStage::GetGeodesicBoundary(const ActorId actor_id,
+                                                   const LocationVector &bbox,
+                                                   const CollisionLockEntry &lock_entry) {
   LocationVector geodesic_boundary;
 
-  if (geodesic_boundary_map.find(actor_id) != geodesic_boundary_map.end()) {
-    geodesic_boundary = geodesic_boundary_map.at(actor_id);
-  } else {
-    const LocationVector bbox = GetBoundary(actor_id);
-
-    if (buffer_map.find(actor_id) != buffer_map.end()) {
-      float bbox_extension = GetBoundingBoxExtention(actor_id);
-      const float specific_lead_distance = parameters.GetDistanceToLeadingVehicle(actor_id);
-      bbox_extension = std::max(specific_lead_distance, bbox_extension);
-      const float bbox_extension_square = SQUARE(bbox_extension);
-
-      LocationVector left_boundary;
-      LocationVector right_boundary;
-      cg::Vector3D dimensions = simulation_state.GetDimensions(actor_id);
-      const float width = dimensions.y;
-      const float length = dimensions.x;
-
-      const Buffer &waypoint_buffer = buffer_map.at(actor_id);
-      const TargetWPInfo target_wp_info = GetTargetWaypoint(waypoint_buffer, length);
-      const SimpleWaypointPtr boundary_start = target_wp_info.first;
-      const uint64_t boundary_start_index = target_wp_info.second;
-
-      // At non-signalized junctions, we extend the boundary across the junction
-      // and in all other situations, boundary length is velocity-dependent.
-      SimpleWaypointPtr boundary_end = nullptr;
-      SimpleWaypointPtr current_point = waypoint_buffer.at(boundary_start_index);
-      bool reached_distance = false;
-      for (uint64_t j = boundary_start_index; !reached_distance && (j < waypoint_buffer.size()); ++j) {
-        if (boundary_start->DistanceSquared(current_point) > bbox_extension_square || j == waypoint_buffer.size() - 1) {
-          reached_distance = true;
-        }
-        if (boundary_end == nullptr
-            || cg::Math::Dot(boundary_end->GetForwardVector(), current_point->GetForwardVector()) < COS_10_DEGREES
-            || reached_distance) {
-
-          const cg::Vector3D heading_vector = current_point->GetForwardVector();
-          const cg::Location location = current_point->GetLocation();
-          cg::Vector3D perpendicular_vector = cg::Vector3D(-heading_vector.y, heading_vector.x, 0.0f);
-          perpendicular_vector = perpendicular_vector.MakeSafeUnitVector(EPSILON);
-          // Direction determined for the left-handed system.
-          const cg::Vector3D scaled_perpendicular = perpendicular_vector * width;
-          left_boundary.push_back(location + cg::Location(scaled_perpendicular));
-          right_boundary.push_back(location + cg::Location(-1.0f * scaled_perpendicular));
-
-          boundary_end = current_point;
-        }
-
-        current_point = waypoint_buffer.at(j);
+  if (buffer_map.find(actor_id) != buffer_map.end()) {
+    float bbox_extension = GetBoundingBoxExtention(actor_id, lock_entry);
+    const float specific_lead_distance = parameters.GetSnapshot().FindVehicle(actor_id).distance_to_leading_vehicle;
+    bbox_extension = std::max(specific_lead_distance, bbox_extension);
+    const float bbox_extension_square = SQUARE(bbox_extension);
+
+    LocationVector left_boundary;
+    LocationVector right_boundary;
+    cg::Vector3D dimensions = simulation_state.GetDimensions(actor_id);
+    const float width = dimensions.y;
+    const float length = dimensions.x;
+
+    const Buffer &waypoint_buffer = buffer_map.at(actor_id);
+    const TargetWPInfo target_wp_info = GetTargetWaypoint(waypoint_buffer, length);
+    const SimpleWaypointPtr boundary_start = target_wp_info.first;
+    const uint64_t boundary_start_index = target_wp_info.second;
+
+    // At non-signalized junctions, we extend the boundary across the junction
+    // and in all other situations, boundary length is velocity-dependent.
+    SimpleWaypointPtr boundary_end = nullptr;
+    SimpleWaypointPtr current_point = waypoint_buffer.at(boundary_start_index);
+    bool reached_distance = false;
+    for (uint64_t j = boundary_start_index; !reached_distance && (j < waypoint_buffer.size()); ++j) {
+      if (boundary_start->DistanceSquared(current_point) > bbox_extension_square || j == waypoint_buffer.size() - 1) {
+        reached_distance = true;
+      }
+      if (boundary_end == nullptr
+          || cg::Math::Dot(boundary_end->GetForwardVector(), current_point->GetForwardVector()) < COS_10_DEGREES
+          || reached_distance) {
+
+        const cg::Vector3D heading_vector = current_point->GetForwardVector();
+        const cg::Location location = current_point->GetLocation();
+        cg::Vector3D perpendicular_vector = cg::Vector3D(-heading_vector.y, heading_vector.x, 0.0f);
+        perpendicular_vector = perpendicular_vector.MakeSafeUnitVector(EPSILON);
+        // Direction determined for the left-handed system.
+        const cg::Vector3D scaled_perpendicular = perpendicular_vector * width;
+        left_boundary.push_back(location + cg::Location(scaled_perpendicular));
+        right_boundary.push_back(location + cg::Location(-1.0f * scaled_perpendicular));
+
+        boundary_end = current_point;
       }
 
-      // Reversing right boundary to construct clockwise (left-hand system)
-      // boundary. This is so because both left and right boundary vectors have
-      // the closest point to the vehicle at their starting index for the right
-      // boundary,
-      // we want to begin at the farthest point to have a clockwise trace.
-      std::reverse(right_boundary.begin(), right_boundary.end());
-      geodesic_boundary.insert(geodesic_boundary.end(), right_boundary.begin(), right_boundary.end());
-      geodesic_boundary.insert(geodesic_boundary.end(), bbox.begin(), bbox.end());
-      geodesic_boundary.insert(geodesic_boundary.end(), left_boundary.begin(), left_boundary.end());
-    } else {
-
-      geodesic_boundary = bbox;
+      current_point = waypoint_buffer.at(j);
     }
 
-    geodesic_boundary_map.insert({actor_id, geodesic_boundary});
+    // Reversing right boundary to construct clockwise (left-hand system)
+    // boundary. This is so because both left and right boundary vectors have
+    // the closest point to the vehicle at their starting index for the right
+    // boundary,
+    // we want to begin at the farthest point to have a clockwise trace.
+    std::reverse(right_boundary.begin(), right_boundary.end());
+    geodesic_boundary.insert(geodesic_boundary.end(), right_boundary.begin(), right_boundary.end());
+    geodesic_boundary.insert(geodesic_boundary.end(), bbox.begin(), bbox.end());
+    geodesic_boundary.insert(geodesic_boundary.end(), left_boundary.begin(), left_boundary.end());
+  } else {
+
+    geodesic_boundary = bbox;
   }
 
   return geodesic_boundary;
@@ -253,6 +348,28 @@ Polygon CollisionStage::GetPolygon(const LocationVector &boundary) {
   return boundary_polygon;
 }
 
+ActorGeometry CollisionStage::GetActorGeometry(const ActorId actor_id, const CollisionLockEntry &lock_entry) {
+  const LocationVector bbox = GetBoundary(actor_id);
+
+  ActorGeometry actor_geometry;
+  actor_geometry.bbox_polygon = GetPolygon(bbox);
+  actor_geometry.geodesic_polygon = GetPolygon(GetGeodesicBoundary(actor_id, bbox, lock_entry));
+  bg::envelope(actor_geometry.geodesic_polygon, actor_geometry.geodesic_envelope);
+
+  return actor_geometry;
+}
+
+bool CollisionStage::GeodesicBoundariesApart(const ActorId reference_vehicle_id, const ActorId other_actor_id) const {
+  const Box &reference_envelope = actor_geometry_map.at(reference_vehicle_id).geodesic_envelope;
+  const Box &other_envelope = actor_geometry_map.at(other_actor_id).geodesic_envelope;
+
+  // The distance between the polygons is at least the gap between their envelopes.
+  return reference_envelope.max_corner().x() + OVERLAP_THRESHOLD < other_envelope.min_corner().x()
+         || other_envelope.max_corner().x() + OVERLAP_THRESHOLD < reference_envelope.min_corner().x()
+         || reference_envelope.max_corner().y() + OVERLAP_THRESHOLD < other_envelope.min_corner().y()
+         || other_envelope.max_corner().y() + OVERLAP_THRESHOLD < reference_envelope.min_corner().y();
+}
+
 GeometryComparison CollisionStage::GetGeometryBetweenActors(const ActorId reference_vehicle_id,
                                                             const ActorId other_actor_id) {
 
@@ -271,20 +388,32 @@ GeometryComparison CollisionStage::GetGeometryBetweenActors(const ActorId refere
 
   GeometryComparison comparision_result{-1.0, -1.0, -1.0, -1.0};
 
-  if (geometry_cache.find(actor_id_key) != geometry_cache.end()) {
+  bool found_in_cache = false;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    const auto comparison_it = geometry_cache.find(actor_id_key);
+    if (comparison_it != geometry_cache.end()) {
+      comparision_result = comparison_it->second;
+      found_in_cache = true;
+    }
+  }
+
+  if (found_in_cache) {
 
-    comparision_result = geometry_cache.at(actor_id_key);
     double mref_veh_other = comparision_result.reference_vehicle_to_other_geodesic;
     comparision_result.reference_vehicle_to_other_geodesic = comparision_result.other_vehicle_to_reference_geodesic;
     comparision_result.other_vehicle_to_reference_geodesic = mref_veh_other;
   } else {
 
-    const Polygon reference_polygon = GetPolygon(GetBoundary(reference_vehicle_id));
-    const Polygon other_polygon = GetPolygon(GetBoundary(other_actor_id));
+    const ActorGeometry &reference_geometry = actor_geometry_map.at(reference_vehicle_id);
+    const ActorGeometry &other_geometry = actor_geometry_map.at(other_actor_id);
+
+    const Polygon &reference_polygon = reference_geometry.bbox_polygon;
+    const Polygon &other_polygon = other_geometry.bbox_polygon;
 
-    const Polygon reference_geodesic_polygon = GetPolygon(GetGeodesicBoundary(reference_vehicle_id));
+    const Polygon &reference_geodesic_polygon = reference_geometry.geodesic_polygon;
 
-    const Polygon other_geodesic_polygon = GetPolygon(GetGeodesicBoundary(other_actor_id));
+    const Polygon &other_geodesic_polygon = other_geometry.geodesic_polygon;
 
     const double reference_vehicle_to_other_geodesic = bg::distance(reference_polygon, other_geodesic_polygon);
     const double other_vehicle_to_reference_geodesic = bg::distance(other_polygon, reference_geodesic_polygon);
@@ -296,6 +425,7 @@ GeometryComparison CollisionStage::GetGeometryBetweenActors(const ActorId refere
               inter_geodesic_distance,
               inter_bbox_distance};
 
+    std::lock_guard<std::mutex> lock(cache_mutex);
     geometry_cache.insert({actor_id_key, comparision_result});
   }
 
@@ -304,7 +434,8 @@ GeometryComparison CollisionStage::GetGeometryBetweenActors(const ActorId refere
 
 std::pair<bool, float> CollisionStage::NegotiateCollision(const ActorId reference_vehicle_id,
                                                           const ActorId other_actor_id,
-                                                          const uint64_t reference_junction_look_ahead_index) {
+                                                          const uint64_t reference_junction_look_ahead_index,
+                                                          CollisionLockEntry &reference_lock) {
   // Output variables for the method.
   bool hazard = false;
   float available_distance_margin = std::numeric_limits<float>::infinity();
@@ -328,8 +459,8 @@ std::pair<bool, float> CollisionStage::NegotiateCollision(const ActorId referenc
   float other_vehicle_length = simulation_state.GetDimensions(other_actor_id).x * SQUARE_ROOT_OF_TWO;
 
   float inter_vehicle_distance = cg::Math::DistanceSquared(reference_location, other_location);
-  float ego_bounding_box_extension = GetBoundingBoxExtention(reference_vehicle_id);
-  float other_bounding_box_extension = GetBoundingBoxExtention(other_actor_id);
+  float ego_bounding_box_extension = GetBoundingBoxExtention(reference_vehicle_id, reference_lock);
+  float other_bounding_box_extension = GetBoundingBoxExtention(other_actor_id, GetCollisionLock(other_actor_id));
   // Calculate minimum distance between vehicle to consider collision negotiation.
   float inter_vehicle_length = reference_vehicle_length + other_vehicle_length;
   float ego_detection_range = SQUARE(ego_bounding_box_extension + inter_vehicle_length);
@@ -349,10 +480,12 @@ std::pair<bool, float> CollisionStage::NegotiateCollision(const ActorId referenc
   SimpleWaypointPtr look_ahead_point = reference_vehicle_buffer.at(reference_junction_look_ahead_index);
   bool ego_at_junction_entrance = !closest_point->CheckJunction() && look_ahead_point->CheckJunction();
 
-  // Conditions to consider collision negotiation.
+  // Conditions to consider collision negotiation. Actors whose paths can't
+  // touch are discarded before comparing their polygons.
   if (!(ego_at_junction_entrance && ego_at_traffic_light && ego_stopped_by_light)
       && ((ego_inside_junction && other_vehicles_in_cross_detection_range)
-          || (!ego_inside_junction && other_vehicle_in_front && other_vehicle_in_ego_range))) {
+          || (!ego_inside_junction && other_vehicle_in_front && other_vehicle_in_ego_range))
+      && !GeodesicBoundariesApart(reference_vehicle_id, other_actor_id)) {
     GeometryComparison geometry_comparison = GetGeometryBetweenActors(reference_vehicle_id, other_actor_id);
 
     // Conditions for collision negotiation.
@@ -374,7 +507,7 @@ std::pair<bool, float> CollisionStage::NegotiateCollision(const ActorId referenc
 
       hazard = true;
 
-      const float reference_lead_distance = parameters.GetDistanceToLeadingVehicle(reference_vehicle_id);
+      const float reference_lead_distance = parameters.GetSnapshot().FindVehicle(reference_vehicle_id).distance_to_leading_vehicle;
       const float specific_distance_margin = std::max(reference_lead_distance, MIN_REFERENCE_DISTANCE);
       available_distance_margin = static_cast<float>(std::max(geometry_comparison.reference_vehicle_to_other_geodesic
                                                               - static_cast<double>(specific_distance_margin), 0.0));
@@ -385,8 +518,8 @@ std::pair<bool, float> CollisionStage::NegotiateCollision(const ActorId referenc
       // This enables us to smoothly approach the lead vehicle.
 
       // When possible collision found, check if an entry for collision lock present.
-      if (collision_locks.find(reference_vehicle_id) != collision_locks.end()) {
-        CollisionLock &lock = collision_locks.at(reference_vehicle_id);
+      if (reference_lock.is_locked) {
+        CollisionLock &lock = reference_lock.lock;
         // Check if the same vehicle is under lock.
         if (other_actor_id == lock.lead_vehicle_id) {
           // If the body of the lead vehicle is touching the reference vehicle bounding box.
@@ -403,24 +536,30 @@ std::pair<bool, float> CollisionStage::NegotiateCollision(const ActorId referenc
         }
       } else {
         // Insert and initialize lock entry if not present.
-        collision_locks.insert({reference_vehicle_id,
-                                {geometry_comparison.inter_bbox_distance,
+        reference_lock = {true, {geometry_comparison.inter_bbox_distance,
                                  geometry_comparison.inter_bbox_distance,
-                                 other_actor_id}});
+                                 other_actor_id}};
       }
     }
   }
 
   // If no collision hazard detected, then flush collision lock held by the vehicle.
-  if (!hazard && collision_locks.find(reference_vehicle_id) != collision_locks.end()) {
-    collision_locks.erase(reference_vehicle_id);
+  if (!hazard && reference_lock.is_locked) {
+    reference_lock.is_locked = false;
   }
 
   return {hazard, available_distance_margin};
 }
 
 void CollisionStage::ClearCycleCache() {
-  geodesic_boundary_map.clear();
+  if (parallel_cycle) {
+    for (unsigned long index = 0u; index < staged_collision_locks.size(); ++index) {
+      CommitCollisionLock(vehicle_id_list.at(index), staged_collision_locks.at(index));
+    }
+    parallel_cycle = false;
+  }
+  actor_geometry_map.clear();
+  collision_grid.clear();
   geometry_cache.clear();
 }
 
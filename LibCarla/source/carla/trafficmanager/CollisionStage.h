@@ -2,6 +2,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #if defined(__clang__)
 #  pragma clang diagnostic push
@@ -38,15 +39,31 @@ struct CollisionLock {
 };
 using CollisionLockMap = std::unordered_map<ActorId, CollisionLock>;
 
+/// Collision lock state of a vehicle while it is being updated.
+struct CollisionLockEntry {
+  bool is_locked;
+  CollisionLock lock;
+};
+
 namespace cc = carla::client;
 namespace bg = boost::geometry;
 
 using Buffer = std::deque<std::shared_ptr<SimpleWaypoint>>;
 using BufferMap = std::unordered_map<carla::ActorId, Buffer>;
 using LocationVector = std::vector<cg::Location>;
-using GeodesicBoundaryMap = std::unordered_map<ActorId, LocationVector>;
 using GeometryComparisonMap = std::unordered_map<uint64_t, GeometryComparison>;
 using Polygon = bg::model::polygon<bg::model::d2::point_xy<double>>;
+using Box = bg::model::box<bg::model::d2::point_xy<double>>;
+
+/// Polygons of an actor, computed once per cycle.
+struct ActorGeometry {
+  Polygon bbox_polygon;
+  Polygon geodesic_polygon;
+  Box geodesic_envelope;
+};
+using ActorGeometryMap = std::unordered_map<ActorId, ActorGeometry>;
+/// Uniform grid over actor locations, keyed by packed cell coordinates.
+using CollisionGrid = std::unordered_map<uint64_t, std::vector<ActorId>>;
 
 /// This class has functionality to detect potential collision with a nearby actor.
 class CollisionStage : Stage {
@@ -59,34 +76,74 @@ private:
   CollisionFrame &output_array;
   // Structure keeping track of blocking lead vehicles.
   CollisionLockMap collision_locks;
-  // Structures to cache geodesic boundaries of vehicle and
+  // Structures to cache polygons of actors and
   // comparision between vehicle boundaries
   // to avoid repeated computation within a cycle.
   GeometryComparisonMap geometry_cache;
-  GeodesicBoundaryMap geodesic_boundary_map;
+  ActorGeometryMap actor_geometry_map;
+  // Broadphase grid over the locations of all actors, rebuilt every cycle.
+  CollisionGrid collision_grid;
+  // Mutex guarding the geometry comparison cache, which is shared by all
+  // the vehicles when the stage is updated in parallel.
+  std::mutex cache_mutex;
+  // Whether the current cycle is being updated in parallel.
+  bool parallel_cycle {false};
+  // Collision locks modified during a parallel cycle, indexed as vehicle_id_list.
+  // They are committed when flushing the cycle cache, so every vehicle reads the
+  // locks of the others as they were at the beginning of the cycle.
+  std::vector<CollisionLockEntry> staged_collision_locks;
+  // Random samples drawn at the beginning of a parallel cycle, one per vehicle,
+  // so the outcome does not depend on the order in which vehicles are updated.
+  std::vector<double> cycle_random_samples;
   RandomGenerator &random_device;
 
   // Method to determine if a vehicle is on a collision path to another.
   std::pair<bool, float> NegotiateCollision(const ActorId reference_vehicle_id,
                                             const ActorId other_actor_id,
-                                            const uint64_t reference_junction_look_ahead_index);
+                                            const uint64_t reference_junction_look_ahead_index,
+                                            CollisionLockEntry &reference_lock);
+
+  // Method to retrieve the committed collision lock of an actor.
+  CollisionLockEntry GetCollisionLock(const ActorId actor_id) const;
+
+  // Method to store the collision lock of a vehicle.
+  void CommitCollisionLock(const ActorId actor_id, const CollisionLockEntry &lock_entry);
+
+  // Method to draw the random sample used to ignore an obstacle.
+  double GetRandomSample(const unsigned long index);
 
   // Method to calculate bounding box extention length ahead of the vehicle.
-  float GetBoundingBoxExtention(const ActorId actor_id);
+  float GetBoundingBoxExtention(const ActorId actor_id, const CollisionLockEntry &lock_entry);
 
   // Method to calculate polygon points around the vehicle's bounding box.
   LocationVector GetBoundary(const ActorId actor_id);
 
   // Method to construct polygon points around the path boundary of the vehicle.
-  LocationVector GetGeodesicBoundary(const ActorId actor_id);
+  LocationVector GetGeodesicBoundary(const ActorId actor_id,
+                                     const LocationVector &bbox,
+                                     const CollisionLockEntry &lock_entry);
 
   Polygon GetPolygon(const LocationVector &boundary);
 
+  // Method to build the bounding box and path polygons of an actor.
+  ActorGeometry GetActorGeometry(const ActorId actor_id, const CollisionLockEntry &lock_entry);
+
+  // Method to check, from their envelopes, that the path boundaries of two
+  // actors are too far apart to overlap.
+  bool GeodesicBoundariesApart(const ActorId reference_vehicle_id, const ActorId other_actor_id) const;
+
   // Method to compare path boundaries, bounding boxes of vehicles
   // and cache the results for reuse in current update cycle.
   GeometryComparison GetGeometryBetweenActors(const ActorId reference_vehicle_id,
                                               const ActorId other_actor_id);
 
+  // Methods to index the broadphase grid.
+  int32_t GetGridCoordinate(const float value) const;
+  uint64_t GetGridCellKey(const int32_t x, const int32_t y) const;
+
+  // Method to retrieve the actors around a location from the broadphase grid.
+  std::vector<ActorId> GetActorsInRadius(const cg::Location &location, const float radius) const;
+
   // Method to draw path boundary.
   void DrawBoundary(const LocationVector &boundary);
 
@@ -105,6 +162,18 @@ public:
 
   void Reset() override;
 
+  // Method to build the broadphase grid and the polygons of the actors not
+  // registered to the traffic manager. Called once at the start of a cycle.
+  void PrepareCycle();
+
+  // Method to prepare the stage for a cycle where Update is called
+  // concurrently for different vehicles.
+  void PrepareParallelCycle();
+
+  // Method to compute the polygons of a vehicle once per cycle, before
+  // calling Update. Can be called concurrently for different vehicles.
+  void UpdateBoundaries(const unsigned long index);
+
   // Method to flush cache for current update cycle.
   void ClearCycleCache();
 };
@@ -87,6 +87,8 @@ static const float EPSILON = 2.0f * std::numeric_limits<float>::epsilon();
 static const float MIN_REFERENCE_DISTANCE = 0.5f;
 static const float MIN_VELOCITY_COLL_RADIUS = 2.0f;
 static const float VEL_EXT_FACTOR = 0.36f;
+static const float BROADPHASE_CELL_SIZE = 20.0f;
+static const float INV_BROADPHASE_CELL_SIZE = 1.0f / BROADPHASE_CELL_SIZE;
 } // namespace Collision
 
 namespace FrameMemory {
@@ -160,6 +162,10 @@ static const uint64_t BUFFER_STEP_THROUGH = 5;
 static const float INV_BUFFER_STEP_THROUGH = 1.0f / static_cast<float>(BUFFER_STEP_THROUGH);
 } // namespace TrackTraffic
 
+namespace StageExecution {
+static const unsigned long MIN_VEHICLES_PER_THREAD = 16u;
+} // namespace StageExecution
+
 } // namespace constants
 } // namespace traffic_manager
 } // namespace carla
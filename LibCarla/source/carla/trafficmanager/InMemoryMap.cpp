@@ -160,6 +160,8 @@ namespace traffic_manager {
     // create spatial tree
     SetUpSpatialTree();
 
+    waypoint_graph.Build(dense_topology);
+
     return true;
   }
 
@@ -363,6 +365,8 @@ namespace traffic_manager {
 
     // Specifying a RoadOption for each SimpleWaypoint
     SetUpRoadOption();
+
+    waypoint_graph.Build(dense_topology);
   }
 
   void InMemoryMap::SetUpSpatialTree() {
@@ -509,6 +513,14 @@ namespace traffic_manager {
     return dense_topology;
   }
 
+  const WaypointGraph &InMemoryMap::GetWaypointGraph() const {
+    return waypoint_graph;
+  }
+
+  const SimpleWaypointPtr &InMemoryMap::GetWaypointByIndex(const WaypointIndex index) const {
+    return dense_topology.at(index);
+  }
+
   void InMemoryMap::FindAndLinkLaneChange(SimpleWaypointPtr reference_waypoint) {
 
     const WaypointPtr raw_waypoint = reference_waypoint->GetWaypoint();
@@ -32,6 +32,7 @@
 #include "carla/trafficmanager/RandomGenerator.h"
 #include "carla/trafficmanager/SimpleWaypoint.h"
 #include "carla/trafficmanager/CachedSimpleWaypoint.h"
+#include "carla/trafficmanager/WaypointGraph.h"
 
 namespace carla {
 namespace traffic_manager {
@@ -71,6 +72,8 @@ namespace bgi = boost::geometry::index;
     NodeList dense_topology;
     /// Spatial quadratic R-tree for indexing and querying waypoints.
     Rtree rtree;
+    /// Flat copy of dense_topology used while updating the vehicles.
+    WaypointGraph waypoint_graph;
 
   public:
 
@@ -94,6 +97,12 @@ namespace bgi = boost::geometry::index;
     /// This method returns the full list of discrete samples of the map in the local cache.
     NodeList GetDenseTopology() const;
 
+    /// This method returns the flat graph of the waypoints in the local cache.
+    const WaypointGraph &GetWaypointGraph() const;
+
+    /// This method returns the waypoint at a given position of the waypoint graph.
+    const SimpleWaypointPtr &GetWaypointByIndex(const WaypointIndex index) const;
+
     std::string GetMapName();
 
     const cc::Map& GetMap() const;
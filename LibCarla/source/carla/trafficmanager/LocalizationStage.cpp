@@ -38,6 +38,7 @@ void LocalizationStage::Update(const unsigned long index) {
   const ActorId actor_id = vehicle_id_list.at(index);
   const cg::Location vehicle_location = simulation_state.GetLocation(actor_id);
   const cg::Vector3D heading_vector = simulation_state.GetHeading(actor_id);
+  const WaypointGraph &waypoint_graph = local_map->GetWaypointGraph();
   const cg::Vector3D vehicle_velocity_vector = simulation_state.GetVelocity(actor_id);
   const float vehicle_speed = vehicle_velocity_vector.Length();
 
@@ -55,8 +56,8 @@ void LocalizationStage::Update(const unsigned long index) {
 
   // Clear buffer if vehicle is too far from the first waypoint in the buffer.
   if (!waypoint_buffer.empty() &&
-      cg::Math::DistanceSquared(waypoint_buffer.front()->GetLocation(),
-                                vehicle_location) > SQUARE(MAX_START_DISTANCE)) {
+      waypoint_graph.DistanceSquared(waypoint_buffer.front()->GetIndex(),
+                                     vehicle_location) > SQUARE(MAX_START_DISTANCE)) {
 
     auto number_of_pops = waypoint_buffer.size();
     for (uint64_t j = 0u; j < number_of_pops; ++j) {
@@ -67,24 +68,26 @@ void LocalizationStage::Update(const unsigned long index) {
   bool is_at_junction_entrance = false;
   if (!waypoint_buffer.empty()) {
     // Purge passed waypoints.
-    float dot_product = DeviationDotProduct(vehicle_location, heading_vector, waypoint_buffer.front()->GetLocation());
+    float dot_product = DeviationDotProduct(vehicle_location, heading_vector,
+                                            waypoint_graph.GetLocation(waypoint_buffer.front()->GetIndex()));
     while (dot_product <= 0.0f && !waypoint_buffer.empty()) {
       PopWaypoint(actor_id, track_traffic, waypoint_buffer);
       if (!waypoint_buffer.empty()) {
-        dot_product = DeviationDotProduct(vehicle_location, heading_vector, waypoint_buffer.front()->GetLocation());
+        dot_product = DeviationDotProduct(vehicle_location, heading_vector,
+                                          waypoint_graph.GetLocation(waypoint_buffer.front()->GetIndex()));
       }
     }
 
     if (!waypoint_buffer.empty()) {
       // Determine if the vehicle is at the entrance of a junction.
-      SimpleWaypointPtr look_ahead_point = GetTargetWaypoint(waypoint_buffer, JUNCTION_LOOK_AHEAD).first;
-      SimpleWaypointPtr front_waypoint = waypoint_buffer.front();
-      bool front_waypoint_junction = front_waypoint->CheckJunction();
-      is_at_junction_entrance = !front_waypoint_junction && look_ahead_point->CheckJunction();
+      const WaypointIndex look_ahead_index = GetTargetWaypoint(waypoint_buffer, JUNCTION_LOOK_AHEAD).first->GetIndex();
+      const WaypointIndex front_index = waypoint_buffer.front()->GetIndex();
+      bool front_waypoint_junction = waypoint_graph.IsJunction(front_index);
+      is_at_junction_entrance = !front_waypoint_junction && waypoint_graph.IsJunction(look_ahead_index);
       if (!is_at_junction_entrance) {
-        std::vector<SimpleWaypointPtr> last_passed_waypoints = front_waypoint->GetPreviousWaypoint();
+        const WaypointIndexRange last_passed_waypoints = waypoint_graph.GetPrevious(front_index);
         if (last_passed_waypoints.size() == 1) {
-          is_at_junction_entrance = !last_passed_waypoints.front()->CheckJunction() && front_waypoint_junction;
+          is_at_junction_entrance = !waypoint_graph.IsJunction(last_passed_waypoints.front()) && front_waypoint_junction;
         }
       }
       if (is_at_junction_entrance
@@ -98,8 +101,9 @@ void LocalizationStage::Update(const unsigned long index) {
     // Purge waypoints too far from the front of the buffer, but not if it has reached a junction.
     while (!is_at_junction_entrance
            && !waypoint_buffer.empty()
-           && waypoint_buffer.back()->DistanceSquared(waypoint_buffer.front()) > horizon_square + horizon_square
-           && !waypoint_buffer.back()->CheckJunction()) {
+           && waypoint_graph.DistanceSquared(waypoint_buffer.back()->GetIndex(),
+                                             waypoint_buffer.front()->GetIndex()) > horizon_square + horizon_square
+           && !waypoint_graph.IsJunction(waypoint_buffer.back()->GetIndex())) {
       PopWaypoint(actor_id, track_traffic, waypoint_buffer, false);
     }
   }
@@ -110,16 +114,18 @@ void LocalizationStage::Update(const unsigned long index) {
     PushWaypoint(actor_id, track_traffic, waypoint_buffer, closest_waypoint);
   }
 
+  const VehicleParameters &vehicle_parameters = parameters.GetSnapshot().GetVehicle(index);
+
   // Assign a lane change.
-  const ChangeLaneInfo lane_change_info = parameters.GetForceLaneChange(actor_id);
+  const ChangeLaneInfo lane_change_info = vehicle_parameters.force_lane_change;
   bool force_lane_change = lane_change_info.change_lane;
   bool lane_change_direction = lane_change_info.direction;
 
   // Apply parameters for keep right rule and random lane changes.
   if (!force_lane_change && vehicle_speed > MIN_LANE_CHANGE_SPEED){
-    const float perc_keep_right = parameters.GetKeepRightPercentage(actor_id);
-    const float perc_random_leftlanechange = parameters.GetRandomLeftLaneChangePercentage(actor_id);
-    const float perc_random_rightlanechange = parameters.GetRandomRightLaneChangePercentage(actor_id);
+    const float perc_keep_right = vehicle_parameters.perc_keep_right;
+    const float perc_random_leftlanechange = vehicle_parameters.perc_random_left;
+    const float perc_random_rightlanechange = vehicle_parameters.perc_random_right;
     const bool is_keep_right = perc_keep_right > random_device.next();
     const bool is_random_left_change = perc_random_leftlanechange >= random_device.next();
     const bool is_random_right_change = perc_random_rightlanechange >= random_device.next();
@@ -150,7 +156,7 @@ void LocalizationStage::Update(const unsigned long index) {
     done_with_previous_lane_change = distance_frm_previous > lane_change_distance;
     if (done_with_previous_lane_change) last_lane_change_swpt.erase(actor_id);
   }
-  bool auto_or_force_lane_change = parameters.GetAutoLaneChange(actor_id) || force_lane_change;
+  bool auto_or_force_lane_change = vehicle_parameters.auto_lane_change || force_lane_change;
   bool front_waypoint_not_junction = !front_waypoint->CheckJunction();
 
   if (auto_or_force_lane_change
@@ -174,8 +180,15 @@ void LocalizationStage::Update(const unsigned long index) {
     }
   }
 
-  Path imported_path = parameters.GetCustomPath(actor_id);
-  Route imported_actions = parameters.GetImportedRoute(actor_id);
+  // Only look up the paths and routes of the vehicles that may have one.
+  Path imported_path;
+  Route imported_actions;
+  if (vehicle_parameters.has_custom_path) {
+    imported_path = parameters.GetCustomPath(actor_id);
+  }
+  if (imported_path.empty() && vehicle_parameters.has_imported_route) {
+    imported_actions = parameters.GetImportedRoute(actor_id);
+  }
   // We are effectively importing a path.
   if (!imported_path.empty()) {
 
@@ -189,24 +202,25 @@ void LocalizationStage::Update(const unsigned long index) {
 
   // Populating the buffer through randomly chosen waypoints.
   else {
-    while (waypoint_buffer.back()->DistanceSquared(waypoint_buffer.front()) <= horizon_square) {
-      SimpleWaypointPtr furthest_waypoint = waypoint_buffer.back();
-      std::vector<SimpleWaypointPtr> next_waypoints = furthest_waypoint->GetNextWaypoint();
+    const WaypointIndex front_index = waypoint_buffer.front()->GetIndex();
+    WaypointIndex furthest_index = waypoint_buffer.back()->GetIndex();
+    while (waypoint_graph.DistanceSquared(furthest_index, front_index) <= horizon_square) {
+      const WaypointIndexRange next_waypoints = waypoint_graph.GetNext(furthest_index);
       uint64_t selection_index = 0u;
       // Pseudo-randomized path selection if found more than one choice.
       if (next_waypoints.size() > 1) {
         double r_sample = random_device.next();
         selection_index = static_cast<uint64_t>(r_sample*next_waypoints.size()*0.01);
       } else if (next_waypoints.size() == 0) {
-        if (!parameters.GetOSMMode()) {
+        if (!parameters.GetSnapshot().osm_mode) {
           std::cout << "This map has dead-end roads, please change the set_open_street_map parameter to true" << std::endl;
         }
         marked_for_removal.push_back(actor_id);
         break;
       }
-      SimpleWaypointPtr next_wp_selection = next_waypoints.at(selection_index);
-      PushWaypoint(actor_id, track_traffic, waypoint_buffer, next_wp_selection);
-      if (next_wp_selection->GetId() == waypoint_buffer.front()->GetId()){
+      furthest_index = next_waypoints[selection_index];
+      PushWaypoint(actor_id, track_traffic, waypoint_buffer, local_map->GetWaypointByIndex(furthest_index));
+      if (waypoint_graph.GetId(furthest_index) == waypoint_graph.GetId(front_index)){
         // Found a loop, stop. Don't use zero distance as there can be two waypoints at the same location
         break;
       }
@@ -228,40 +242,40 @@ void LocalizationStage::Update(const unsigned long index) {
   }
 
   // Updating geodesic grid position for actor.
-  track_traffic.UpdateGridPosition(actor_id, waypoint_buffer);
+  track_traffic.UpdateGridPosition(actor_id, waypoint_buffer, waypoint_graph);
 }
 
 void LocalizationStage::ExtendAndFindSafeSpace(const ActorId actor_id,
                                                const bool is_at_junction_entrance,
                                                Buffer &waypoint_buffer) {
 
-  SimpleWaypointPtr junction_end_point = nullptr;
-  SimpleWaypointPtr safe_point_after_junction = nullptr;
-
   if (is_at_junction_entrance
       && vehicles_at_junction_entrance.find(actor_id) == vehicles_at_junction_entrance.end()) {
 
+    const WaypointGraph &waypoint_graph = local_map->GetWaypointGraph();
     bool entered_junction = false;
     bool past_junction = false;
     bool safe_point_found = false;
-    SimpleWaypointPtr current_waypoint = nullptr;
-    SimpleWaypointPtr junction_begin_point = nullptr;
+    WaypointIndex current_index = INVALID_WAYPOINT_INDEX;
+    WaypointIndex junction_begin_index = INVALID_WAYPOINT_INDEX;
+    WaypointIndex junction_end_index = INVALID_WAYPOINT_INDEX;
+    WaypointIndex safe_point_index = INVALID_WAYPOINT_INDEX;
     float safe_distance_squared = SQUARE(SAFE_DISTANCE_AFTER_JUNCTION);
 
     // Scanning existing buffer points.
     for (unsigned long i = 0u; i < waypoint_buffer.size() && !safe_point_found; ++i) {
-      current_waypoint = waypoint_buffer.at(i);
-      if (!entered_junction && current_waypoint->CheckJunction()) {
+      current_index = waypoint_buffer.at(i)->GetIndex();
+      if (!entered_junction && waypoint_graph.IsJunction(current_index)) {
         entered_junction = true;
-        junction_begin_point = current_waypoint;
+        junction_begin_index = current_index;
       }
-      if (entered_junction && !past_junction && !current_waypoint->CheckJunction()) {
+      if (entered_junction && !past_junction && !waypoint_graph.IsJunction(current_index)) {
         past_junction = true;
-        junction_end_point = current_waypoint;
+        junction_end_index = current_index;
       }
-      if (past_junction && junction_end_point->DistanceSquared(current_waypoint) > safe_distance_squared) {
+      if (past_junction && waypoint_graph.DistanceSquared(junction_end_index, current_index) > safe_distance_squared) {
         safe_point_found = true;
-        safe_point_after_junction = current_waypoint;
+        safe_point_index = current_index;
       }
     }
 
@@ -270,13 +284,13 @@ void LocalizationStage::ExtendAndFindSafeSpace(const ActorId actor_id,
       bool abort = false;
 
       while (!past_junction && !abort) {
-        NodeList next_waypoints = current_waypoint->GetNextWaypoint();
+        const WaypointIndexRange next_waypoints = waypoint_graph.GetNext(current_index);
         if (!next_waypoints.empty()) {
-          current_waypoint = next_waypoints.front();
-          PushWaypoint(actor_id, track_traffic, waypoint_buffer, current_waypoint);
-          if (!current_waypoint->CheckJunction()) {
+          current_index = next_waypoints.front();
+          PushWaypoint(actor_id, track_traffic, waypoint_buffer, local_map->GetWaypointByIndex(current_index));
+          if (!waypoint_graph.IsJunction(current_index)) {
             past_junction = true;
-            junction_end_point = current_waypoint;
+            junction_end_index = current_index;
           }
         } else {
           abort = true;
@@ -284,17 +298,17 @@ void LocalizationStage::ExtendAndFindSafeSpace(const ActorId actor_id,
       }
 
       while (!safe_point_found && !abort) {
-        std::vector<SimpleWaypointPtr> next_waypoints = current_waypoint->GetNextWaypoint();
-        if ((junction_end_point->DistanceSquared(current_waypoint) > safe_distance_squared)
+        const WaypointIndexRange next_waypoints = waypoint_graph.GetNext(current_index);
+        if ((waypoint_graph.DistanceSquared(junction_end_index, current_index) > safe_distance_squared)
             || next_waypoints.size() > 1
-            || current_waypoint->CheckJunction()) {
+            || waypoint_graph.IsJunction(current_index)) {
 
           safe_point_found = true;
-          safe_point_after_junction = current_waypoint;
+          safe_point_index = current_index;
         } else {
           if (!next_waypoints.empty()) {
-            current_waypoint = next_waypoints.front();
-            PushWaypoint(actor_id, track_traffic, waypoint_buffer, current_waypoint);
+            current_index = next_waypoints.front();
+            PushWaypoint(actor_id, track_traffic, waypoint_buffer, local_map->GetWaypointByIndex(current_index));
           } else {
             abort = true;
           }
@@ -302,12 +316,22 @@ void LocalizationStage::ExtendAndFindSafeSpace(const ActorId actor_id,
       }
     }
 
-    if (junction_end_point != nullptr &&
-        safe_point_after_junction != nullptr &&
-        junction_begin_point->DistanceSquared(junction_end_point) < SQUARE(MIN_JUNCTION_LENGTH)) {
+    if (junction_end_index != INVALID_WAYPOINT_INDEX &&
+        safe_point_index != INVALID_WAYPOINT_INDEX &&
+        junction_begin_index != INVALID_WAYPOINT_INDEX &&
+        waypoint_graph.DistanceSquared(junction_begin_index, junction_end_index) < SQUARE(MIN_JUNCTION_LENGTH)) {
+
+      junction_end_index = INVALID_WAYPOINT_INDEX;
+      safe_point_index = INVALID_WAYPOINT_INDEX;
+    }
 
-      junction_end_point = nullptr;
-      safe_point_after_junction = nullptr;
+    SimpleWaypointPtr junction_end_point = nullptr;
+    if (junction_end_index != INVALID_WAYPOINT_INDEX) {
+      junction_end_point = local_map->GetWaypointByIndex(junction_end_index);
+    }
+    SimpleWaypointPtr safe_point_after_junction = nullptr;
+    if (safe_point_index != INVALID_WAYPOINT_INDEX) {
+      safe_point_after_junction = local_map->GetWaypointByIndex(safe_point_index);
     }
 
     vehicles_at_junction_entrance.insert({actor_id, {junction_end_point, safe_point_after_junction}});
@@ -501,7 +525,7 @@ void LocalizationStage::ImportPath(Path &imported_path, Buffer &waypoint_buffer,
           }
         }
       } else if (next_waypoints.size() == 0) {
-        if (!parameters.GetOSMMode()) {
+        if (!parameters.GetSnapshot().osm_mode) {
           std::cout << "This map has dead-end roads, please change the set_open_street_map parameter to true" << std::endl;
         }
         marked_for_removal.push_back(actor_id);
@@ -564,7 +588,7 @@ void LocalizationStage::ImportRoute(Route &imported_actions, Buffer &waypoint_bu
           }
         }
       } else if (next_waypoints.size() == 0) {
-        if (!parameters.GetOSMMode()) {
+        if (!parameters.GetSnapshot().osm_mode) {
           std::cout << "This map has dead-end roads, please change the set_open_street_map parameter to true" << std::endl;
         }
         marked_for_removal.push_back(actor_id);
@@ -36,7 +36,7 @@ float DeviationDotProduct(const cg::Location &reference_location,
 }
 
 void PushWaypoint(ActorId actor_id, TrackTraffic &track_traffic,
-                  Buffer &buffer, SimpleWaypointPtr &waypoint) {
+                  Buffer &buffer, const SimpleWaypointPtr &waypoint) {
 
   const uint64_t waypoint_id = waypoint->GetId();
   buffer.push_back(waypoint);
@@ -46,8 +46,7 @@ void PushWaypoint(ActorId actor_id, TrackTraffic &track_traffic,
 void PopWaypoint(ActorId actor_id, TrackTraffic &track_traffic,
                  Buffer &buffer, bool front_or_back) {
 
-  SimpleWaypointPtr removed_waypoint = front_or_back ? buffer.front() : buffer.back();
-  const uint64_t removed_waypoint_id = removed_waypoint->GetId();
+  const uint64_t removed_waypoint_id = front_or_back ? buffer.front()->GetId() : buffer.back()->GetId();
   if (front_or_back) {
     buffer.pop_front();
   } else {
@@ -58,39 +57,42 @@ void PopWaypoint(ActorId actor_id, TrackTraffic &track_traffic,
 
 TargetWPInfo GetTargetWaypoint(const Buffer &waypoint_buffer, const float &target_point_distance) {
 
-  SimpleWaypointPtr target_waypoint = waypoint_buffer.front();
-  const SimpleWaypointPtr &buffer_front = waypoint_buffer.front();
+  // The scan keeps track of positions in the buffer instead of copying the
+  // waypoint pointers, which would update their reference counts.
+  const cg::Location buffer_front_location = waypoint_buffer.front()->GetLocation();
   uint64_t startPosn = static_cast<uint64_t>(std::fabs(target_point_distance * INV_MAP_RESOLUTION));
   uint64_t index = startPosn;
+  uint64_t target_index = 0u;
   /// Condition to determine forward or backward scanning of waypoint buffer.
 
   if (startPosn < waypoint_buffer.size()) {
     bool mScanForward = false;
     const float target_point_dist_power = target_point_distance * target_point_distance;
-    if (buffer_front->DistanceSquared(target_waypoint) < target_point_dist_power) {
+    if (waypoint_buffer.at(target_index)->DistanceSquared(buffer_front_location) < target_point_dist_power) {
       mScanForward = true;
     }
 
     if (mScanForward) {
       for (uint64_t i = startPosn;
-           (i < waypoint_buffer.size()) && (buffer_front->DistanceSquared(target_waypoint) < target_point_dist_power);
+           (i < waypoint_buffer.size())
+           && (waypoint_buffer.at(target_index)->DistanceSquared(buffer_front_location) < target_point_dist_power);
            ++i) {
-        target_waypoint = waypoint_buffer.at(i);
+        target_index = i;
         index = i;
       }
     } else {
       for (uint64_t i = startPosn;
-           (buffer_front->DistanceSquared(target_waypoint) > target_point_dist_power);
+           (waypoint_buffer.at(target_index)->DistanceSquared(buffer_front_location) > target_point_dist_power);
            --i) {
-        target_waypoint = waypoint_buffer.at(i);
+        target_index = i;
         index = i;
       }
     }
   } else {
-    target_waypoint = waypoint_buffer.back();
+    target_index = waypoint_buffer.size() - 1;
     index = waypoint_buffer.size() - 1;
   }
-  return std::make_pair(target_waypoint, index);
+  return std::make_pair(waypoint_buffer.at(target_index), index);
 }
 
 } // namespace traffic_manager
@@ -73,7 +73,9 @@ void MotionPlanStage::Update(const unsigned long index) {
   const LocalizationData &localization = localization_frame.at(index);
   const CollisionHazardData &collision_hazard = collision_frame.at(index);
   const bool &tl_hazard = tl_frame.at(index);
-  current_timestamp = world.GetSnapshot().GetTimestamp();
+  const cc::Timestamp current_timestamp = world.GetSnapshot().GetTimestamp();
+  const ParametersSnapshot &snapshot = parameters.GetSnapshot();
+  const VehicleParameters &vehicle_parameters = snapshot.GetVehicle(index);
   StateEntry current_state;
 
   // Instanciating teleportation transform as current vehicle transform.
@@ -81,33 +83,28 @@ void MotionPlanStage::Update(const unsigned long index) {
 
   // Get information about the hero location from the actor_id state.
   cg::Location hero_location = track_traffic.GetHeroLocation();
-  bool is_hero_alive = hero_location != cg::Location(0, 0, 0);
 
-  if (simulation_state.IsDormant(actor_id) && parameters.GetRespawnDormantVehicles() && is_hero_alive) {
+  if (RequiresSequentialUpdate(index)) {
     // Flushing controller state for vehicle.
     current_state = {current_timestamp,
                     0.0f, 0.0f,
                     0.0f};
 
-    // Add entry to teleportation duration clock table if not present.
-    if (teleportation_instance.find(actor_id) == teleportation_instance.end()) {
-      teleportation_instance.insert({actor_id, current_timestamp});
-    }
-
     // Get lower and upper bound for teleporting vehicle.
-    float lower_bound = parameters.GetLowerBoundaryRespawnDormantVehicles();
-    float upper_bound = parameters.GetUpperBoundaryRespawnDormantVehicles();
+    float lower_bound = snapshot.respawn_lower_bound;
+    float upper_bound = snapshot.respawn_upper_bound;
     float dilate_factor = (upper_bound-lower_bound)/100.0f;
 
     // Measuring time elapsed since last teleportation for the vehicle.
-    double elapsed_time = current_timestamp.elapsed_seconds - teleportation_instance.at(actor_id).elapsed_seconds;
+    double elapsed_time = GetElapsedTimeSinceTeleportation(actor_id, current_timestamp);
 
-    if (parameters.GetSynchronousMode() || elapsed_time > HYBRID_MODE_DT) {
+    if (snapshot.synchronous_mode || elapsed_time > HYBRID_MODE_DT) {
       float random_sample = (static_cast<float>(random_device.next())*dilate_factor) + lower_bound;
       NodeList teleport_waypoint_list = local_map->GetWaypointsInDelta(hero_location, ATTEMPTS_TO_TELEPORT, random_sample);
       if (!teleport_waypoint_list.empty()) {
+        const WaypointGraph &waypoint_graph = local_map->GetWaypointGraph();
         for (auto &teleport_waypoint : teleport_waypoint_list) {
-          GeoGridId geogrid_id = teleport_waypoint->GetGeodesicGridId();
+          GeoGridId geogrid_id = waypoint_graph.GetGeodesicGridId(teleport_waypoint->GetIndex());
           if (track_traffic.IsGeoGridFree(geogrid_id)) {
             teleportation_transform = teleport_waypoint->GetTransform();
             teleportation_transform.location.z += 0.5f;
@@ -131,7 +128,7 @@ void MotionPlanStage::Update(const unsigned long index) {
   else {
 
     // Target velocity for vehicle.
-    float max_target_velocity = parameters.GetVehicleTargetVelocity(actor_id, vehicle_speed_limit) / 3.6f;
+    float max_target_velocity = vehicle_parameters.GetTargetVelocity(vehicle_speed_limit) / 3.6f;
 
     // Algorithm to reduce speed near landmarks
     float max_landmark_target_velocity = GetLandmarkTargetVelocity(*(waypoint_buffer.at(0)), vehicle_location, actor_id, max_target_velocity);
@@ -160,7 +157,7 @@ void MotionPlanStage::Update(const unsigned long index) {
       const SimpleWaypointPtr &target_waypoint = GetTargetWaypoint(waypoint_buffer, target_point_distance).first;
       cg::Location target_location = target_waypoint->GetLocation();
 
-      float offset = parameters.GetLaneOffset(actor_id);
+      float offset = vehicle_parameters.lane_offset;
       auto right_vector = target_waypoint->GetTransform().GetRightVector();
       auto offset_location = cg::Location(cg::Vector3D(offset*right_vector.x, offset*right_vector.y, 0.0f));
       target_location = target_location + offset_location;
@@ -173,15 +170,8 @@ void MotionPlanStage::Update(const unsigned long index) {
       }
       const float angular_deviation = dot_product;
       const float velocity_deviation = (dynamic_target_velocity - vehicle_speed) / dynamic_target_velocity;
-      // If previous state for vehicle not found, initialize state entry.
-      if (pid_state_map.find(actor_id) == pid_state_map.end()) {
-        const auto initial_state = StateEntry{current_timestamp, 0.0f, 0.0f, 0.0f};
-        pid_state_map.insert({actor_id, initial_state});
-      }
-
       // Retrieving the previous state.
-      traffic_manager::StateEntry previous_state;
-      previous_state = pid_state_map.at(actor_id);
+      traffic_manager::StateEntry previous_state = GetPreviousState(actor_id, current_timestamp);
 
       // Select PID parameters.
       std::vector<float> longitudinal_parameters;
@@ -218,8 +208,7 @@ void MotionPlanStage::Update(const unsigned long index) {
 
       // Updating PID state.
       current_state.steer = actuation_signal.steer;
-      StateEntry &state = pid_state_map.at(actor_id);
-      state = current_state;
+      SetState(actor_id, current_state);
     }
     // For physics-less vehicles, determine position and orientation for teleportation.
     else {
@@ -228,16 +217,11 @@ void MotionPlanStage::Update(const unsigned long index) {
                       0.0f, 0.0f,
                       0.0f};
 
-      // Add entry to teleportation duration clock table if not present.
-      if (teleportation_instance.find(actor_id) == teleportation_instance.end()) {
-        teleportation_instance.insert({actor_id, current_timestamp});
-      }
-
       // Measuring time elapsed since last teleportation for the vehicle.
-      double elapsed_time = current_timestamp.elapsed_seconds - teleportation_instance.at(actor_id).elapsed_seconds;
+      double elapsed_time = GetElapsedTimeSinceTeleportation(actor_id, current_timestamp);
 
       // Find a location ahead of the vehicle for teleportation to achieve intended velocity.
-      if (!emergency_stop && (parameters.GetSynchronousMode() || elapsed_time > HYBRID_MODE_DT)) {
+      if (!emergency_stop && (snapshot.synchronous_mode || elapsed_time > HYBRID_MODE_DT)) {
 
         // Target displacement magnitude to achieve target velocity.
         const float target_displacement = dynamic_target_velocity * HYBRID_MODE_DT_FL;
@@ -267,6 +251,39 @@ void MotionPlanStage::Update(const unsigned long index) {
   }
 }
 
+bool MotionPlanStage::RequiresSequentialUpdate(const unsigned long index) const {
+  const ActorId actor_id = vehicle_id_list.at(index);
+  const bool is_hero_alive = track_traffic.GetHeroLocation() != cg::Location(0, 0, 0);
+  // Respawning a dormant vehicle draws random samples and takes geodesic grids
+  // shared by all vehicles.
+  return simulation_state.IsDormant(actor_id) && parameters.GetSnapshot().respawn_dormant_vehicles && is_hero_alive;
+}
+
+StateEntry MotionPlanStage::GetPreviousState(const ActorId actor_id, const cc::Timestamp &timestamp) {
+  std::lock_guard<std::mutex> lock(state_mutex);
+  // If previous state for vehicle not found, initialize state entry.
+  auto state_it = pid_state_map.find(actor_id);
+  if (state_it == pid_state_map.end()) {
+    state_it = pid_state_map.insert({actor_id, StateEntry{timestamp, 0.0f, 0.0f, 0.0f}}).first;
+  }
+  return state_it->second;
+}
+
+void MotionPlanStage::SetState(const ActorId actor_id, const StateEntry &state) {
+  std::lock_guard<std::mutex> lock(state_mutex);
+  pid_state_map[actor_id] = state;
+}
+
+double MotionPlanStage::GetElapsedTimeSinceTeleportation(const ActorId actor_id, const cc::Timestamp &timestamp) {
+  std::lock_guard<std::mutex> lock(state_mutex);
+  // Add entry to teleportation duration clock table if not present.
+  auto teleportation_it = teleportation_instance.find(actor_id);
+  if (teleportation_it == teleportation_instance.end()) {
+    teleportation_it = teleportation_instance.insert({actor_id, timestamp}).first;
+  }
+  return timestamp.elapsed_seconds - teleportation_it->second.elapsed_seconds;
+}
+
 bool MotionPlanStage::SafeAfterJunction(const LocalizationData &localization,
                                         const bool tl_hazard,
                                         const bool collision_emergency_stop) {
@@ -388,7 +405,7 @@ float MotionPlanStage::GetLandmarkTargetVelocity(const SimpleWaypoint& waypoint,
         minimum_velocity = YIELD_TARGET_VELOCITY;
       } else if (landmark_type == "274") {  // Speed limit
         float value = static_cast<float>(landmark->GetValue()) / 3.6f;
-        value = parameters.GetVehicleTargetVelocity(actor_id, value);
+        value = parameters.GetSnapshot().FindVehicle(actor_id).GetTargetVelocity(value);
         minimum_velocity = (value < max_target_velocity) ? value : max_target_velocity;
       } else {
         continue;
@@ -408,9 +425,9 @@ float MotionPlanStage::GetTurnTargetVelocity(const Buffer &waypoint_buffer,
     return max_target_velocity;
   }
   else {
-    const SimpleWaypointPtr first_waypoint = waypoint_buffer.front();
-    const SimpleWaypointPtr last_waypoint = waypoint_buffer.back();
-    const SimpleWaypointPtr middle_waypoint = waypoint_buffer.at(static_cast<uint16_t>(waypoint_buffer.size() / 2));
+    const SimpleWaypointPtr &first_waypoint = waypoint_buffer.front();
+    const SimpleWaypointPtr &last_waypoint = waypoint_buffer.back();
+    const SimpleWaypointPtr &middle_waypoint = waypoint_buffer.at(static_cast<uint16_t>(waypoint_buffer.size() / 2));
 
     float radius = GetThreePointCircleRadius(first_waypoint->GetLocation(),
                                              middle_waypoint->GetLocation(),
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "carla/trafficmanager/DataStructures.h"
 #include "carla/trafficmanager/InMemoryMap.h"
 #include "carla/trafficmanager/LocalizationUtils.h"
@@ -40,8 +42,10 @@ private:
   // Structure to keep track of duration between teleportation
   // in hybrid physics mode.
   std::unordered_map<ActorId, cc::Timestamp> teleportation_instance;
+  // Mutex guarding the controller state and teleportation clocks, so
+  // different vehicles can be updated concurrently.
+  std::mutex state_mutex;
   ControlFrame &output_array;
-  cc::Timestamp current_timestamp;
   RandomGenerator &random_device;
   const LocalMapPtr &local_map;
 
@@ -51,6 +55,13 @@ private:
                                            const cg::Vector3D ego_heading,
                                            const float max_target_velocity);
 
+  // Methods to query and store the controller state of a vehicle.
+  StateEntry GetPreviousState(const ActorId actor_id, const cc::Timestamp &timestamp);
+  void SetState(const ActorId actor_id, const StateEntry &state);
+
+  // Method to measure the time elapsed since the vehicle was first teleported.
+  double GetElapsedTimeSinceTeleportation(const ActorId actor_id, const cc::Timestamp &timestamp);
+
   bool SafeAfterJunction(const LocalizationData &localization,
                          const bool tl_hazard,
                          const bool collision_emergency_stop);
@@ -87,6 +98,10 @@ public:
 
   void Update(const unsigned long index);
 
+  // Method to check whether the vehicle modifies state shared with other
+  // vehicles, in which case it can't be updated concurrently with them.
+  bool RequiresSequentialUpdate(const unsigned long index) const;
+
   void RemoveActor(const ActorId actor_id);
 
   void Reset();
@@ -4,6 +4,8 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <algorithm>
+
 #include "carla/trafficmanager/Parameters.h"
 #include "carla/trafficmanager/Constants.h"
 
@@ -14,6 +16,8 @@ Parameters::Parameters() {
 
   /// Set default synchronous mode time out.
   synchronous_time_out = std::chrono::duration<int, std::milli>(10);
+
+  snapshot = std::make_shared<ParametersSnapshot>();
 }
 
 Parameters::~Parameters() {}
@@ -28,6 +32,7 @@ void Parameters::SetHybridPhysicsMode(const bool mode_switch) {
 void Parameters::SetRespawnDormantVehicles(const bool mode_switch) {
 
   respawn_dormant_vehicles.store(mode_switch);
+  ++version;
 }
 
 void Parameters::SetMaxBoundaries(const float lower, const float upper) {
@@ -38,6 +43,7 @@ void Parameters::SetMaxBoundaries(const float lower, const float upper) {
 void Parameters::SetBoundariesRespawnDormantVehicles(const float lower_bound, const float upper_bound) {
   respawn_lower_bound = min_lower_bound > lower_bound ? min_lower_bound : lower_bound;
   respawn_upper_bound = max_upper_bound < upper_bound ? max_upper_bound : upper_bound;
+  ++version;
 }
 
 void Parameters::SetPercentageSpeedDifference(const ActorPtr &actor, const float percentage) {
@@ -47,11 +53,13 @@ void Parameters::SetPercentageSpeedDifference(const ActorPtr &actor, const float
   if (exact_desired_speed.Contains(actor->GetId())) {
     exact_desired_speed.RemoveEntry(actor->GetId());
   }
+  ++version;
 }
 
 void Parameters::SetLaneOffset(const ActorPtr &actor, const float offset) {
   const auto entry = std::make_pair(actor->GetId(), offset);
   lane_offset.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetDesiredSpeed(const ActorPtr &actor, const float value) {
@@ -61,15 +69,18 @@ void Parameters::SetDesiredSpeed(const ActorPtr &actor, const float value) {
   if (percentage_difference_from_speed_limit.Contains(actor->GetId())) {
     percentage_difference_from_speed_limit.RemoveEntry(actor->GetId());
   }
+  ++version;
 }
 
 void Parameters::SetGlobalPercentageSpeedDifference(const float percentage) {
   float new_percentage = std::min(100.0f, percentage);
   global_percentage_difference_from_limit = new_percentage;
+  ++version;
 }
 
 void Parameters::SetGlobalLaneOffset(const float offset) {
   global_lane_offset = offset;
+  ++version;
 }
 
 void Parameters::SetCollisionDetection(const ActorPtr &reference_actor, const ActorPtr &other_actor, const bool detect_collision) {
@@ -96,6 +107,7 @@ void Parameters::SetCollisionDetection(const ActorPtr &reference_actor, const Ac
       ignore_collision.AddEntry(entry);
     }
   }
+  ++version;
 }
 
 void Parameters::SetForceLaneChange(const ActorPtr &actor, const bool direction) {
@@ -103,37 +115,42 @@ void Parameters::SetForceLaneChange(const ActorPtr &actor, const bool direction)
   const ChangeLaneInfo lane_change_info = {true, direction};
   const auto entry = std::make_pair(actor->GetId(), lane_change_info);
   force_lane_change.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetKeepRightPercentage(const ActorPtr &actor, const float percentage) {
 
   const auto entry = std::make_pair(actor->GetId(), percentage);
   perc_keep_right.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetRandomLeftLaneChangePercentage(const ActorPtr &actor, const float percentage) {
 
   const auto entry = std::make_pair(actor->GetId(), percentage);
   perc_random_left.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetRandomRightLaneChangePercentage(const ActorPtr &actor, const float percentage) {
 
   const auto entry = std::make_pair(actor->GetId(), percentage);
   perc_random_right.AddEntry(entry);
-
+  ++version;
 }
 
 void Parameters::SetUpdateVehicleLights(const ActorPtr &actor, const bool do_update) {
 
   const auto entry = std::make_pair(actor->GetId(), do_update);
   auto_update_vehicle_lights.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetAutoLaneChange(const ActorPtr &actor, const bool enable) {
 
   const auto entry = std::make_pair(actor->GetId(), enable);
   auto_lane_change.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetDistanceToLeadingVehicle(const ActorPtr &actor, const float distance) {
@@ -141,10 +158,12 @@ void Parameters::SetDistanceToLeadingVehicle(const ActorPtr &actor, const float
   float new_distance = std::max(0.0f, distance);
   const auto entry = std::make_pair(actor->GetId(), new_distance);
   distance_to_leading_vehicle.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetSynchronousMode(const bool mode_switch) {
   synchronous_mode.store(mode_switch);
+  ++version;
 }
 
 void Parameters::SetSynchronousModeTimeOutInMiliSecond(const double time) {
@@ -154,6 +173,7 @@ void Parameters::SetSynchronousModeTimeOutInMiliSecond(const double time) {
 void Parameters::SetGlobalDistanceToLeadingVehicle(const float dist) {
 
   distance_margin.store(dist);
+  ++version;
 }
 
 void Parameters::SetPercentageRunningLight(const ActorPtr &actor, const float perc) {
@@ -161,6 +181,7 @@ void Parameters::SetPercentageRunningLight(const ActorPtr &actor, const float pe
   float new_perc = cg::Math::Clamp(perc, 0.0f, 100.0f);
   const auto entry = std::make_pair(actor->GetId(), new_perc);
   perc_run_traffic_light.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetPercentageRunningSign(const ActorPtr &actor, const float perc) {
@@ -168,6 +189,7 @@ void Parameters::SetPercentageRunningSign(const ActorPtr &actor, const float per
   float new_perc = cg::Math::Clamp(perc, 0.0f, 100.0f);
   const auto entry = std::make_pair(actor->GetId(), new_perc);
   perc_run_traffic_sign.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetPercentageIgnoreVehicles(const ActorPtr &actor, const float perc) {
@@ -175,6 +197,7 @@ void Parameters::SetPercentageIgnoreVehicles(const ActorPtr &actor, const float
   float new_perc = cg::Math::Clamp(perc, 0.0f, 100.0f);
   const auto entry = std::make_pair(actor->GetId(), new_perc);
   perc_ignore_vehicles.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetPercentageIgnoreWalkers(const ActorPtr &actor, const float perc) {
@@ -182,6 +205,7 @@ void Parameters::SetPercentageIgnoreWalkers(const ActorPtr &actor, const float p
   float new_perc = cg::Math::Clamp(perc,0.0f,100.0f);
   const auto entry = std::make_pair(actor->GetId(), new_perc);
   perc_ignore_walkers.AddEntry(entry);
+  ++version;
 }
 
 void Parameters::SetHybridPhysicsRadius(const float radius) {
@@ -189,8 +213,13 @@ void Parameters::SetHybridPhysicsRadius(const float radius) {
   hybrid_physics_radius.store(new_radius);
 }
 
+void Parameters::SetWorkerThreads(const size_t number_of_threads) {
+  worker_threads.store(std::max(number_of_threads, static_cast<size_t>(1u)));
+}
+
 void Parameters::SetOSMMode(const bool mode_switch) {
   osm_mode.store(mode_switch);
+  ++version;
 }
 
 void Parameters::SetCustomPath(const ActorPtr &actor, const Path path, const bool empty_buffer) {
@@ -198,6 +227,7 @@ void Parameters::SetCustomPath(const ActorPtr &actor, const Path path, const boo
   custom_path.AddEntry(entry);
   const auto entry2 = std::make_pair(actor->GetId(), empty_buffer);
   upload_path.AddEntry(entry2);
+  ++version;
 }
 
 void Parameters::RemoveUploadPath(const ActorId &actor_id, const bool remove_path) {
@@ -205,6 +235,7 @@ void Parameters::RemoveUploadPath(const ActorId &actor_id, const bool remove_pat
     upload_path.RemoveEntry(actor_id);
   } else {
     custom_path.RemoveEntry(actor_id);
+    ++version;
   }
 }
 
@@ -219,6 +250,7 @@ void Parameters::SetImportedRoute(const ActorPtr &actor, const Route route, cons
   custom_route.AddEntry(entry);
   const auto entry2 = std::make_pair(actor->GetId(), empty_buffer);
   upload_route.AddEntry(entry2);
+  ++version;
 }
 
 void Parameters::RemoveImportedRoute(const ActorId &actor_id, const bool remove_path) {
@@ -226,6 +258,7 @@ void Parameters::RemoveImportedRoute(const ActorId &actor_id, const bool remove_
     upload_route.RemoveEntry(actor_id);
   } else {
     custom_route.RemoveEntry(actor_id);
+    ++version;
   }
 }
 
@@ -242,6 +275,10 @@ float Parameters::GetHybridPhysicsRadius() const {
   return hybrid_physics_radius.load();
 }
 
+size_t Parameters::GetWorkerThreads() const {
+  return worker_threads.load();
+}
+
 bool Parameters::GetSynchronousMode() const {
   return synchronous_mode.load();
 }
@@ -480,5 +517,141 @@ Route Parameters::GetImportedRoute(const ActorId &actor_id) const {
 }
 
 
+///////////////////////////////// SNAPSHOT ////////////////////////////////////
+
+bool ParametersSnapshot::GetCollisionDetection(const VehicleParameters &reference, const ActorId other_actor_id) const {
+
+  const auto begin = ignore_collision.begin() + reference.ignore_collision_begin;
+  const auto end = ignore_collision.begin() + reference.ignore_collision_end;
+  return !std::binary_search(begin, end, other_actor_id);
+}
+
+void Parameters::PublishSnapshot(const std::vector<ActorId> &vehicle_ids) {
+
+  // Lane change commands last for a single cycle, if the previous snapshot
+  // took any the next one has to be built without them.
+  if (snapshot->version != version.load() ||
+      snapshot->has_forced_lane_changes ||
+      snapshot->vehicle_ids != vehicle_ids) {
+    snapshot = MakeSnapshot(vehicle_ids);
+  }
+}
+
+std::shared_ptr<const ParametersSnapshot> Parameters::MakeSnapshot(const std::vector<ActorId> &vehicle_ids) {
+
+  auto result = std::make_shared<ParametersSnapshot>();
+  // Read the version first, changes made while building the snapshot trigger
+  // another one in the next cycle.
+  result->version = version.load();
+
+  result->synchronous_mode = synchronous_mode.load();
+  result->respawn_dormant_vehicles = respawn_dormant_vehicles.load();
+  result->respawn_lower_bound = respawn_lower_bound.load();
+  result->respawn_upper_bound = respawn_upper_bound.load();
+  result->osm_mode = osm_mode.load();
+
+  VehicleParameters &default_vehicle = result->default_vehicle;
+  default_vehicle.speed_limit_factor = 1.0f - global_percentage_difference_from_limit / 100.0f;
+  default_vehicle.lane_offset = global_lane_offset;
+  default_vehicle.distance_to_leading_vehicle = distance_margin.load();
+
+  result->vehicle_ids = vehicle_ids;
+  result->vehicles.assign(vehicle_ids.size(), default_vehicle);
+  result->vehicle_index.reserve(vehicle_ids.size());
+  for (unsigned long index = 0u; index < vehicle_ids.size(); ++index) {
+    result->vehicle_index.emplace(vehicle_ids[index], index);
+  }
+
+  // Each map is locked once, only the entries of the registered vehicles are
+  // copied.
+  auto for_each_vehicle = [&result](const auto &map, auto &&functor) {
+    map.ForEach([&](const ActorId actor_id, const auto &value) {
+      const auto it = result->vehicle_index.find(actor_id);
+      if (it != result->vehicle_index.end()) {
+        functor(result->vehicles[it->second], value);
+      }
+    });
+  };
+
+  for_each_vehicle(exact_desired_speed, [](VehicleParameters &vehicle, const float value) {
+    vehicle.exact_speed = value;
+    vehicle.use_exact_speed = true;
+  });
+  // A percentage difference takes precedence over a desired speed.
+  for_each_vehicle(percentage_difference_from_speed_limit, [](VehicleParameters &vehicle, const float value) {
+    vehicle.speed_limit_factor = 1.0f - value / 100.0f;
+    vehicle.use_exact_speed = false;
+  });
+  for_each_vehicle(lane_offset, [](VehicleParameters &vehicle, const float value) {
+    vehicle.lane_offset = value;
+  });
+  for_each_vehicle(distance_to_leading_vehicle, [](VehicleParameters &vehicle, const float value) {
+    vehicle.distance_to_leading_vehicle = value;
+  });
+  for_each_vehicle(perc_run_traffic_light, [](VehicleParameters &vehicle, const float value) {
+    vehicle.perc_run_traffic_light = value;
+  });
+  for_each_vehicle(perc_run_traffic_sign, [](VehicleParameters &vehicle, const float value) {
+    vehicle.perc_run_traffic_sign = value;
+  });
+  for_each_vehicle(perc_ignore_walkers, [](VehicleParameters &vehicle, const float value) {
+    vehicle.perc_ignore_walkers = value;
+  });
+  for_each_vehicle(perc_ignore_vehicles, [](VehicleParameters &vehicle, const float value) {
+    vehicle.perc_ignore_vehicles = value;
+  });
+  for_each_vehicle(perc_keep_right, [](VehicleParameters &vehicle, const float value) {
+    vehicle.perc_keep_right = value;
+  });
+  for_each_vehicle(perc_random_left, [](VehicleParameters &vehicle, const float value) {
+    vehicle.perc_random_left = value;
+  });
+  for_each_vehicle(perc_random_right, [](VehicleParameters &vehicle, const float value) {
+    vehicle.perc_random_right = value;
+  });
+  for_each_vehicle(auto_lane_change, [](VehicleParameters &vehicle, const bool value) {
+    vehicle.auto_lane_change = value;
+  });
+  for_each_vehicle(auto_update_vehicle_lights, [](VehicleParameters &vehicle, const bool value) {
+    vehicle.update_vehicle_lights = value;
+  });
+  for_each_vehicle(custom_path, [](VehicleParameters &vehicle, const Path &) {
+    vehicle.has_custom_path = true;
+  });
+  for_each_vehicle(custom_route, [](VehicleParameters &vehicle, const Route &) {
+    vehicle.has_imported_route = true;
+  });
+
+  // Collect the ignored actors first, the sets have their own locks.
+  std::vector<std::pair<unsigned long, std::shared_ptr<AtomicActorSet>>> ignore_sets;
+  ignore_collision.ForEach([&](const ActorId actor_id, const std::shared_ptr<AtomicActorSet> &actor_set) {
+    const auto it = result->vehicle_index.find(actor_id);
+    if (it != result->vehicle_index.end()) {
+      ignore_sets.emplace_back(it->second, actor_set);
+    }
+  });
+  for (auto &entry : ignore_sets) {
+    VehicleParameters &vehicle = result->vehicles[entry.first];
+    const std::vector<ActorId> ignored = entry.second->GetIDList();
+    vehicle.ignore_collision_begin = static_cast<uint32_t>(result->ignore_collision.size());
+    // The ids of the set are already sorted.
+    result->ignore_collision.insert(result->ignore_collision.end(), ignored.begin(), ignored.end());
+    vehicle.ignore_collision_end = static_cast<uint32_t>(result->ignore_collision.size());
+  }
+
+  // Take the lane change commands of the registered vehicles.
+  force_lane_change.RemoveIf([&result](const ActorId actor_id, const ChangeLaneInfo &value) {
+    const auto it = result->vehicle_index.find(actor_id);
+    if (it == result->vehicle_index.end()) {
+      return false;
+    }
+    result->vehicles[it->second].force_lane_change = value;
+    result->has_forced_lane_changes = true;
+    return true;
+  });
+
+  return result;
+}
+
 } // namespace traffic_manager
 } // namespace carla
@@ -8,8 +8,10 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <random>
 #include <unordered_map>
+#include <vector>
 
 #include "carla/client/Actor.h"
 #include "carla/client/Vehicle.h"
@@ -34,6 +36,80 @@ struct ChangeLaneInfo {
   bool direction = false;
 };
 
+/// Parameters of a vehicle for one cycle, with the global settings already
+/// applied.
+struct VehicleParameters {
+  /// Fraction of the speed limit to drive at, unless using an exact speed.
+  float speed_limit_factor = 1.0f;
+  /// Desired speed, used instead of the speed limit if use_exact_speed.
+  float exact_speed = 0.0f;
+  bool use_exact_speed = false;
+  float lane_offset = 0.0f;
+  float distance_to_leading_vehicle = 2.0f;
+  float perc_run_traffic_light = 0.0f;
+  float perc_run_traffic_sign = 0.0f;
+  float perc_ignore_walkers = 0.0f;
+  float perc_ignore_vehicles = 0.0f;
+  /// Negative if not set for the vehicle.
+  float perc_keep_right = -1.0f;
+  float perc_random_left = -1.0f;
+  float perc_random_right = -1.0f;
+  bool auto_lane_change = true;
+  bool update_vehicle_lights = false;
+  /// Lane change command taken when the snapshot was published.
+  ChangeLaneInfo force_lane_change;
+  /// Whether a custom path or route may be waiting to be imported.
+  bool has_custom_path = false;
+  bool has_imported_route = false;
+  /// Range of the actors ignored by this vehicle in
+  /// ParametersSnapshot::ignore_collision.
+  uint32_t ignore_collision_begin = 0u;
+  uint32_t ignore_collision_end = 0u;
+
+  /// Target velocity for the given speed limit.
+  float GetTargetVelocity(const float speed_limit) const {
+    return use_exact_speed ? exact_speed : speed_limit * speed_limit_factor;
+  }
+};
+
+/// Immutable copy of the parameters published once per cycle, so the stages
+/// read plain memory instead of locking the parameter maps of every vehicle.
+/// The per-vehicle parameters are aligned with the vehicle id list of the
+/// cycle.
+struct ParametersSnapshot {
+  /// Version of the parameters this snapshot was built from.
+  uint64_t version = 0u;
+  /// Whether the snapshot took lane change commands, which only last for one
+  /// cycle.
+  bool has_forced_lane_changes = false;
+
+  bool synchronous_mode = false;
+  bool respawn_dormant_vehicles = false;
+  float respawn_lower_bound = 100.0f;
+  float respawn_upper_bound = 1000.0f;
+  bool osm_mode = true;
+
+  std::vector<ActorId> vehicle_ids;
+  std::vector<VehicleParameters> vehicles;
+  std::unordered_map<ActorId, unsigned long> vehicle_index;
+  /// Parameters of the actors not registered to this cycle.
+  VehicleParameters default_vehicle;
+  /// Sorted actor ids ignored by each vehicle during collision detection.
+  std::vector<ActorId> ignore_collision;
+
+  const VehicleParameters &GetVehicle(const unsigned long index) const {
+    return vehicles[index];
+  }
+
+  const VehicleParameters &FindVehicle(const ActorId actor_id) const {
+    const auto it = vehicle_index.find(actor_id);
+    return it != vehicle_index.end() ? vehicles[it->second] : default_vehicle;
+  }
+
+  /// Collision avoidance rule between a vehicle and another actor.
+  bool GetCollisionDetection(const VehicleParameters &reference, const ActorId other_actor_id) const;
+};
+
 class Parameters {
 
 private:
@@ -89,6 +165,8 @@ private:
   float max_upper_bound;
   /// Hybrid physics radius.
   std::atomic<float> hybrid_physics_radius {70.0};
+  /// Number of threads used to run the per-vehicle loops of the stages.
+  std::atomic<size_t> worker_threads {1u};
   /// Parameter specifying Open Street Map mode.
   std::atomic<bool> osm_mode {true};
   /// Parameter specifying if importing a custom path.
@@ -99,6 +177,14 @@ private:
   AtomicMap<ActorId, bool> upload_route;
   /// Structure to hold all custom routes.
   AtomicMap<ActorId, Route> custom_route;
+  /// Incremented after every change of the per-vehicle parameters.
+  std::atomic<uint64_t> version {1u};
+  /// Snapshot of the current cycle, only accessed by the traffic manager
+  /// thread.
+  std::shared_ptr<const ParametersSnapshot> snapshot;
+
+  /// Build a snapshot of the current parameters for @a vehicle_ids.
+  std::shared_ptr<const ParametersSnapshot> MakeSnapshot(const std::vector<ActorId> &vehicle_ids);
 
 public:
   Parameters();
@@ -181,6 +267,9 @@ public:
   /// Method to set hybrid physics radius.
   void SetHybridPhysicsRadius(const float radius);
 
+  /// Method to set the number of threads used to run the stages.
+  void SetWorkerThreads(const size_t number_of_threads);
+
   /// Method to set Open Street Map mode.
   void SetOSMMode(const bool mode_switch);
 
@@ -216,6 +305,9 @@ public:
   /// Method to retrieve hybrid physics radius.
   float GetHybridPhysicsRadius() const;
 
+  /// Method to retrieve the number of threads used to run the stages.
+  size_t GetWorkerThreads() const;
+
   /// Method to query target velocity for a vehicle.
   float GetVehicleTargetVelocity(const ActorId &actor_id, const float speed_limit) const;
 
@@ -291,6 +383,19 @@ public:
   /// Method to get a custom route.
   Route GetImportedRoute(const ActorId &actor_id) const;
 
+  ///////////////////////////////// SNAPSHOT ////////////////////////////////////
+
+  /// Publish the snapshot read by the stages during this cycle. A new
+  /// snapshot is built only if the parameters or the vehicles changed since
+  /// the previous one. Not thread-safe, call it from the traffic manager
+  /// thread before running the stages.
+  void PublishSnapshot(const std::vector<ActorId> &vehicle_ids);
+
+  /// Snapshot published for the current cycle.
+  const ParametersSnapshot &GetSnapshot() const {
+    return *snapshot;
+  }
+
   /// Synchronous mode time out variable.
   std::chrono::duration<double, std::milli> synchronous_time_out;
 };
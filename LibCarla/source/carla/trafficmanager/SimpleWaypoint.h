@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <limits>
 #include <memory.h>
 
 #include "carla/client/Waypoint.h"
@@ -22,6 +23,9 @@ namespace traffic_manager {
   namespace cg = carla::geom;
   using WaypointPtr = carla::SharedPtr<cc::Waypoint>;
   using GeoGridId = carla::road::JuncId;
+  /// Position of a waypoint in the WaypointGraph of the local map.
+  using WaypointIndex = uint32_t;
+  static const WaypointIndex INVALID_WAYPOINT_INDEX = std::numeric_limits<WaypointIndex>::max();
   enum class RoadOption : uint8_t {
     Void = 0,
     Left = 1,
@@ -57,6 +61,8 @@ namespace traffic_manager {
     GeoGridId geodesic_grid_id = 0;
     // Boolean to hold if the waypoint belongs to a junction
     bool _is_junction = false;
+    /// Position of the waypoint in the waypoint graph.
+    WaypointIndex index = INVALID_WAYPOINT_INDEX;
 
   public:
 
@@ -134,6 +140,10 @@ namespace traffic_manager {
     // Accessor methods for road option.
     void SetRoadOption(RoadOption _road_option);
     RoadOption GetRoadOption();
+
+    /// Accessor methods for the position of the waypoint in the waypoint graph.
+    void SetIndex(WaypointIndex _index);
+    WaypointIndex GetIndex() const;
   };
 
 } // namespace traffic_manager
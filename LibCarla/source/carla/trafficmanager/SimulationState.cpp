@@ -20,6 +20,10 @@ bool SimulationState::ContainsActor(ActorId actor_id) const {
   return actor_set.find(actor_id) != actor_set.end();
 }
 
+const std::unordered_set<ActorId> &SimulationState::GetActorSet() const {
+  return actor_set;
+}
+
 void SimulationState::RemoveActor(ActorId actor_id) {
   actor_set.erase(actor_id);
   kinematic_state_map.erase(actor_id);
@@ -64,6 +64,9 @@ public :
   // Method to verify if an actor is present currently present in the simulation state.
   bool ContainsActor(ActorId actor_id) const;
 
+  // Method to retrieve the ids of all actors in the simulation state.
+  const std::unordered_set<ActorId> &GetActorSet() const;
+
   // Method to remove an actor from simulation state.
   void RemoveActor(ActorId actor_id);
 
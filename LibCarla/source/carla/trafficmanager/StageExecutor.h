@@ -0,0 +1,120 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "carla/NonCopyable.h"
+#include "carla/ThreadPool.h"
+
+#include "carla/trafficmanager/Constants.h"
+
+namespace carla {
+namespace traffic_manager {
+
+using constants::StageExecution::MIN_VEHICLES_PER_THREAD;
+
+/// This class runs the per-vehicle loop of a stage over a pool of worker
+/// threads. The vehicle indices are split in contiguous ranges, one per
+/// thread, so every index is processed exactly once and only writes to its
+/// own slot of the output frames. The partition has no effect on the results,
+/// hence the output of a stage doesn't depend on the number of threads.
+class StageExecutor : private NonCopyable {
+
+public:
+  StageExecutor() = default;
+
+  ~StageExecutor() {
+    Stop();
+  }
+
+  /// Number of threads, including the calling one, that ParallelFor uses.
+  /// With one thread (the default) every loop runs on the calling thread.
+  void SetNumberOfThreads(const size_t threads) {
+    const size_t new_number_of_threads = std::max(threads, static_cast<size_t>(1u));
+    if (new_number_of_threads != number_of_threads) {
+      Stop();
+      number_of_threads = new_number_of_threads;
+      if (number_of_threads > 1u) {
+        pool = std::make_unique<ThreadPool>();
+        pool->AsyncRun(number_of_threads - 1u);
+      }
+    }
+  }
+
+  size_t GetNumberOfThreads() const {
+    return number_of_threads;
+  }
+
+  /// Calls @a functor once for every index in [0, @a number_of_vehicles) and
+  /// blocks until all of them have finished. Exceptions thrown by the functor
+  /// are re-thrown in the calling thread.
+  template <typename FunctorT>
+  void ParallelFor(const unsigned long number_of_vehicles, FunctorT &&functor) {
+    const unsigned long max_chunks = std::max(number_of_vehicles / MIN_VEHICLES_PER_THREAD, 1ul);
+    const unsigned long number_of_chunks = std::min(static_cast<unsigned long>(number_of_threads), max_chunks);
+    if (pool == nullptr || number_of_chunks <= 1u) {
+      for (unsigned long index = 0u; index < number_of_vehicles; ++index) {
+        functor(index);
+      }
+      return;
+    }
+
+    const unsigned long chunk_size = (number_of_vehicles + number_of_chunks - 1u) / number_of_chunks;
+    auto run_chunk = [&functor, number_of_vehicles](const unsigned long begin, const unsigned long end) {
+      for (unsigned long index = begin; index < end && index < number_of_vehicles; ++index) {
+        functor(index);
+      }
+    };
+
+    std::vector<std::future<void>> pending_chunks;
+    pending_chunks.reserve(number_of_chunks - 1u);
+    for (unsigned long chunk = 1u; chunk < number_of_chunks; ++chunk) {
+      const unsigned long begin = chunk * chunk_size;
+      pending_chunks.emplace_back(pool->Post([=]() { run_chunk(begin, begin + chunk_size); }));
+    }
+    // The calling thread takes care of the first chunk. All chunks have to
+    // finish before returning, even on error, as they reference @a functor.
+    std::exception_ptr error;
+    try {
+      run_chunk(0u, chunk_size);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    for (auto &pending_chunk : pending_chunks) {
+      try {
+        pending_chunk.get();
+      } catch (...) {
+        if (error == nullptr) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  void Stop() {
+    if (pool != nullptr) {
+      pool->Stop();
+      pool.reset();
+    }
+  }
+
+  /// Worker threads, the calling thread is not part of the pool.
+  std::unique_ptr<ThreadPool> pool;
+  size_t number_of_threads {1u};
+};
+
+} // namespace traffic_manager
+} // namespace carla
@@ -37,7 +37,7 @@ void TrackTraffic::UpdateUnregisteredGridPosition(const ActorId actor_id,
     actor_to_grids.insert({actor_id, current_grids});
 }
 
-void TrackTraffic::UpdateGridPosition(const ActorId actor_id, const Buffer &buffer) {
+void TrackTraffic::UpdateGridPosition(const ActorId actor_id, const Buffer &buffer, const WaypointGraph &waypoint_graph) {
     if (!buffer.empty()) {
 
         // Clear current actor from all grids containing itself.
@@ -55,19 +55,12 @@ void TrackTraffic::UpdateGridPosition(const ActorId actor_id, const Buffer &buff
 
         // Step through buffer and update grid list for actor and actor list for grids.
         std::unordered_set<GeoGridId> current_grids;
-        uint64_t buffer_size = buffer.size();
-        for (uint64_t i = 0u; i <= buffer_size - 1u; ++i) {
-            auto waypoint = buffer.at(i);
-            GeoGridId ggid = waypoint->GetGeodesicGridId();
-            current_grids.insert(ggid);
-            // Add grid entry if not present.
-            if (grid_to_actors.find(ggid) == grid_to_actors.end()) {
-                grid_to_actors.insert({ggid, {}});
-            }
-
-            ActorIdSet &actor_ids = grid_to_actors.at(ggid);
-            if (actor_ids.find(actor_id) == actor_ids.end()) {
-                actor_ids.insert(actor_id);
+        for (const SimpleWaypointPtr &waypoint : buffer) {
+            GeoGridId ggid = waypoint_graph.GetGeodesicGridId(waypoint->GetIndex());
+            // Consecutive waypoints mostly share the same grid.
+            if (current_grids.insert(ggid).second) {
+                // Add grid entry if not present.
+                grid_to_actors[ggid].insert(actor_id);
             }
         }
 
@@ -114,6 +107,21 @@ ActorIdSet TrackTraffic::GetOverlappingVehicles(ActorId actor_id) const {
     return actor_id_set;
 }
 
+bool TrackTraffic::IsOverlapping(const ActorId actor_id, const ActorId other_actor_id) const {
+    const auto grids_it = actor_to_grids.find(actor_id);
+    if (grids_it != actor_to_grids.end()) {
+        for (auto &grid_id : grids_it->second) {
+            const auto actors_it = grid_to_actors.find(grid_id);
+            if (actors_it != grid_to_actors.end()
+                && actors_it->second.find(other_actor_id) != actors_it->second.end()) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 void TrackTraffic::DeleteActor(ActorId actor_id) {
     if (actor_to_grids.find(actor_id) != actor_to_grids.end()) {
         std::unordered_set<GeoGridId> &grid_ids = actor_to_grids.at(actor_id);
@@ -5,6 +5,7 @@
 #include "carla/rpc/ActorId.h"
 
 #include "carla/trafficmanager/SimpleWaypoint.h"
+#include "carla/trafficmanager/WaypointGraph.h"
 
 namespace carla {
 namespace traffic_manager {
@@ -44,11 +45,12 @@ public:
     void RemovePassingVehicle(uint64_t waypoint_id, ActorId actor_id);
     ActorIdSet GetPassingVehicles(uint64_t waypoint_id) const;
 
-    void UpdateGridPosition(const ActorId actor_id, const Buffer &buffer);
+    void UpdateGridPosition(const ActorId actor_id, const Buffer &buffer, const WaypointGraph &waypoint_graph);
     void UpdateUnregisteredGridPosition(const ActorId actor_id,
                                         const std::vector<SimpleWaypointPtr> waypoints);
 
     ActorIdSet GetOverlappingVehicles(ActorId actor_id) const;
+    bool IsOverlapping(const ActorId actor_id, const ActorId other_actor_id) const;
     bool IsGeoGridFree(const GeoGridId geogrid_id) const;
     void AddTakenGrid(const GeoGridId geogrid_id, const ActorId actor_id);
 
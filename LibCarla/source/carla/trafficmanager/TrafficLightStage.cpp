@@ -33,6 +33,7 @@ void TrafficLightStage::Update(const unsigned long index) {
 
   const ActorId ego_actor_id = vehicle_id_list.at(index);
   if (!simulation_state.IsDormant(ego_actor_id)) {
+    const VehicleParameters &ego_parameters = parameters.GetSnapshot().GetVehicle(index);
 
     JunctionID current_junction_id = -1;
     if (vehicle_last_junction.find(ego_actor_id) != vehicle_last_junction.end()) {
@@ -50,7 +51,7 @@ void TrafficLightStage::Update(const unsigned long index) {
     if (is_at_traffic_light &&
         traffic_light_state != TLS::Green &&
         traffic_light_state != TLS::Off &&
-        parameters.GetPercentageRunningLight(ego_actor_id) <= random_device.next()) {
+        ego_parameters.perc_run_traffic_light <= random_device.next()) {
       // Remove actor from non-signalized junction if it is affected by a traffic light.
       if (current_junction_id != -1) {
         RemoveActor(ego_actor_id);
@@ -71,7 +72,7 @@ void TrafficLightStage::Update(const unsigned long index) {
     else if (affected_junction_id != -1 &&
             !is_at_traffic_light &&
             traffic_light_state != TLS::Green &&
-            parameters.GetPercentageRunningSign(ego_actor_id) <= random_device.next()) {
+            ego_parameters.perc_run_traffic_sign <= random_device.next()) {
 
       AddActorToNonSignalisedJunction(ego_actor_id, affected_junction_id);
       traffic_light_hazard = true;
@@ -152,6 +152,14 @@ public:
     }
   }
 
+  /// This method sets the number of threads used to update the vehicles.
+  void SetWorkerThreads(const size_t number_of_threads) {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      tm_ptr->SetWorkerThreads(number_of_threads);
+    }
+  }
+
   /// This method registers a vehicle with the traffic manager.
   void RegisterVehicles(const std::vector<ActorPtr> &actor_list) {
     TrafficManagerBase* tm_ptr = GetTM(_port);
@@ -128,6 +128,9 @@ public:
   /// Method to set hybrid physics radius.
   virtual void SetHybridPhysicsRadius(const float radius) = 0;
 
+  /// Method to set the number of threads used to run the stages.
+  virtual void SetWorkerThreads(const size_t number_of_threads) = 0;
+
   /// Method to set randomization seed.
   virtual void SetRandomDeviceSeed(const uint64_t seed) = 0;
 
@@ -225,6 +225,12 @@ public:
     _client->call("set_hybrid_physics_radius", radius);
   }
 
+  /// Method to set the number of threads used to run the stages.
+  void SetWorkerThreads(const size_t number_of_threads) {
+    DEBUG_ASSERT(_client != nullptr);
+    _client->call("set_worker_threads", number_of_threads);
+  }
+
   /// Method to set randomization seed.
   void SetRandomDeviceSeed(const uint64_t seed) {
     DEBUG_ASSERT(_client != nullptr);
@@ -44,13 +44,13 @@ TrafficManagerLocal::TrafficManagerLocal(
                                          localization_frame,
                                          random_device)),
 
-    collision_stage(CollisionStage(vehicle_id_list,
-                                   simulation_state,
-                                   buffer_map,
-                                   track_traffic,
-                                   parameters,
-                                   collision_frame,
-                                   random_device)),
+    collision_stage(vehicle_id_list,
+                    simulation_state,
+                    buffer_map,
+                    track_traffic,
+                    parameters,
+                    collision_frame,
+                    random_device),
 
     traffic_light_stage(TrafficLightStage(vehicle_id_list,
                                           simulation_state,
@@ -60,22 +60,22 @@ TrafficManagerLocal::TrafficManagerLocal(
                                           tl_frame,
                                           random_device)),
 
-    motion_plan_stage(MotionPlanStage(vehicle_id_list,
-                                      simulation_state,
-                                      parameters,
-                                      buffer_map,
-                                      track_traffic,
-                                      longitudinal_PID_parameters,
-                                      longitudinal_highway_PID_parameters,
-                                      lateral_PID_parameters,
-                                      lateral_highway_PID_parameters,
-                                      localization_frame,
-                                      collision_frame,
-                                      tl_frame,
-                                      world,
-                                      control_frame,
-                                      random_device,
-                                      local_map)),
+    motion_plan_stage(vehicle_id_list,
+                      simulation_state,
+                      parameters,
+                      buffer_map,
+                      track_traffic,
+                      longitudinal_PID_parameters,
+                      longitudinal_highway_PID_parameters,
+                      lateral_PID_parameters,
+                      lateral_highway_PID_parameters,
+                      localization_frame,
+                      collision_frame,
+                      tl_frame,
+                      world,
+                      control_frame,
+                      random_device,
+                      local_map),
 
     vehicle_light_stage(VehicleLightStage(vehicle_id_list,
                                           buffer_map,
@@ -218,36 +218,107 @@ void TrafficManagerLocal::Run() {
     // that will be inserted by the motion_plan_stage stage.
     control_frame.resize(number_of_vehicles);
 
+    // Publish the parameters read by the stages during this cycle.
+    parameters.PublishSnapshot(vehicle_id_list);
+
     // Run core operation stages.
-    for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
-      localization_stage.Update(index);
-    }
-    for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
-      collision_stage.Update(index);
-    }
-    collision_stage.ClearCycleCache();
-    vehicle_light_stage.UpdateWorldInfo();
-    for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
-      traffic_light_stage.Update(index);
-      motion_plan_stage.Update(index);
-      vehicle_light_stage.Update(index);
+    stage_executor.SetNumberOfThreads(parameters.GetWorkerThreads());
+    if (stage_executor.GetNumberOfThreads() > 1u) {
+      RunParallelStages();
+    } else {
+      for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
+        localization_stage.Update(index);
+      }
+      collision_stage.PrepareCycle();
+      for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
+        collision_stage.UpdateBoundaries(index);
+      }
+      for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
+        collision_stage.Update(index);
+      }
+      collision_stage.ClearCycleCache();
+      vehicle_light_stage.UpdateWorldInfo();
+      for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
+        traffic_light_stage.Update(index);
+        motion_plan_stage.Update(index);
+        vehicle_light_stage.Update(index);
+      }
     }
 
     registration_lock.unlock();
 
     // Sending the current cycle's batch command to the simulator.
     if (synchronous_mode) {
-      episode_proxy.Lock()->ApplyBatchSync(control_frame, false);
+      ApplyControlFrame();
       step_end.store(true);
       step_end_trigger.notify_one();
     } else {
       if (control_frame.size() > 0){
-        episode_proxy.Lock()->ApplyBatchSync(control_frame, false);
+        ApplyControlFrame();
       }
     }
   }
 }
 
+void TrafficManagerLocal::ApplyControlFrame() {
+
+  unbatched_commands.clear();
+  auto batches = carla::rpc::CommandBatch::MakeBatches(control_frame, unbatched_commands);
+  auto simulator = episode_proxy.Lock();
+  if (!unbatched_commands.empty()) {
+    simulator->ApplyBatchSync(unbatched_commands, false);
+  }
+  simulator->ApplyCommandBatchSync(std::move(batches), false);
+}
+
+void TrafficManagerLocal::RunParallelStages() {
+
+  const unsigned long number_of_vehicles = vehicle_id_list.size();
+
+  // Localization and traffic light stages update the traffic tracking and
+  // junction queues shared by all vehicles, they always run sequentially.
+  for (unsigned long index = 0u; index < number_of_vehicles; ++index) {
+    localization_stage.Update(index);
+  }
+
+  collision_stage.PrepareCycle();
+  collision_stage.PrepareParallelCycle();
+  stage_executor.ParallelFor(number_of_vehicles, [this](const unsigned long index) {
+    collision_stage.UpdateBoundaries(index);
+  });
+  stage_executor.ParallelFor(number_of_vehicles, [this](const unsigned long index) {
+    collision_stage.Update(index);
+  });
+  collision_stage.ClearCycleCache();
+
+  for (unsigned long index = 0u; index < number_of_vehicles; ++index) {
+    traffic_light_stage.Update(index);
+  }
+
+  // Respawning dormant vehicles modifies shared state, those vehicles are
+  // updated after the rest.
+  sequential_motion_plan.clear();
+  for (unsigned long index = 0u; index < number_of_vehicles; ++index) {
+    if (motion_plan_stage.RequiresSequentialUpdate(index)) {
+      sequential_motion_plan.push_back(index);
+    }
+  }
+  stage_executor.ParallelFor(number_of_vehicles, [this](const unsigned long index) {
+    if (!motion_plan_stage.RequiresSequentialUpdate(index)) {
+      motion_plan_stage.Update(index);
+    }
+  });
+  for (const unsigned long index : sequential_motion_plan) {
+    motion_plan_stage.Update(index);
+  }
+
+  // Light commands are appended to the control frame, keep them in order.
+  vehicle_light_stage.UpdateWorldInfo();
+  for (unsigned long index = 0u; index < number_of_vehicles; ++index) {
+    vehicle_light_stage.Update(index);
+  }
+}
+
 bool TrafficManagerLocal::SynchronousTick() {
   if (parameters.GetSynchronousMode()) {
     step_begin.store(true);
@@ -407,6 +478,10 @@ void TrafficManagerLocal::SetHybridPhysicsRadius(const float radius) {
   parameters.SetHybridPhysicsRadius(radius);
 }
 
+void TrafficManagerLocal::SetWorkerThreads(const size_t number_of_threads) {
+  parameters.SetWorkerThreads(number_of_threads);
+}
+
 void TrafficManagerLocal::SetOSMMode(const bool mode_switch) {
   parameters.SetOSMMode(mode_switch);
 }
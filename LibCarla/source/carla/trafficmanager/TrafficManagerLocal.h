@@ -17,12 +17,14 @@
 #include "carla/client/World.h"
 #include "carla/Memory.h"
 #include "carla/rpc/Command.h"
+#include "carla/rpc/CommandBatch.h"
 
 #include "carla/trafficmanager/AtomicActorSet.h"
 #include "carla/trafficmanager/InMemoryMap.h"
 #include "carla/trafficmanager/Parameters.h"
 #include "carla/trafficmanager/RandomGenerator.h"
 #include "carla/trafficmanager/SimulationState.h"
+#include "carla/trafficmanager/StageExecutor.h"
 #include "carla/trafficmanager/TrackTraffic.h"
 #include "carla/trafficmanager/TrafficManagerBase.h"
 #include "carla/trafficmanager/TrafficManagerServer.h"
@@ -94,6 +96,12 @@ private:
   TrafficLightStage traffic_light_stage;
   MotionPlanStage motion_plan_stage;
   VehicleLightStage vehicle_light_stage;
+  /// Worker pool running the per-vehicle loops of the stages.
+  StageExecutor stage_executor;
+  /// Vehicles whose motion plan has to be updated after the parallel loop.
+  std::vector<unsigned long> sequential_motion_plan;
+  /// Commands of the control frame without a batched form.
+  std::vector<carla::rpc::Command> unbatched_commands;
   ALSM alsm;
   /// Traffic manager server instance.
   TrafficManagerServer server;
@@ -117,6 +125,12 @@ private:
   /// Mutex to prevent vehicle registration during frame array re-allocation.
   std::mutex registration_mutex;
 
+  /// Method to run the stages of a cycle over the worker pool.
+  void RunParallelStages();
+
+  /// Method to send the control frame to the simulator as columnar batches.
+  void ApplyControlFrame();
+
   /// Method to check if all traffic lights are frozen in a group.
   bool CheckAllFrozen(TLGroup tl_to_freeze);
 
@@ -239,6 +253,9 @@ public:
   /// Method to set hybrid physics radius.
   void SetHybridPhysicsRadius(const float radius);
 
+  /// Method to set the number of threads used to run the stages.
+  void SetWorkerThreads(const size_t number_of_threads);
+
   /// Method to set randomization seed.
   void SetRandomDeviceSeed(const uint64_t _seed);
 
@@ -217,6 +217,10 @@ void TrafficManagerRemote::SetHybridPhysicsRadius(const float radius) {
   client.SetHybridPhysicsRadius(radius);
 }
 
+void TrafficManagerRemote::SetWorkerThreads(const size_t number_of_threads) {
+  client.SetWorkerThreads(number_of_threads);
+}
+
 void TrafficManagerRemote::SetOSMMode(const bool mode_switch) {
   client.SetOSMMode(mode_switch);
 }
@@ -125,6 +125,9 @@ public:
   /// Method to set hybrid physics radius.
   void SetHybridPhysicsRadius(const float radius);
 
+  /// Method to set the number of threads used to run the stages.
+  void SetWorkerThreads(const size_t number_of_threads);
+
   /// Method to set Open Street Map mode.
   void SetOSMMode(const bool mode_switch);
 
@@ -198,6 +198,11 @@ public:
         tm->SetHybridPhysicsRadius(radius);
       });
 
+      /// Method to set the number of threads used to run the stages.
+      server->bind("set_worker_threads", [=](const size_t number_of_threads) {
+        tm->SetWorkerThreads(number_of_threads);
+      });
+
       /// Method to set hybrid physics radius.
       server->bind("set_osm_mode", [=](const bool mode_switch) {
         tm->SetOSMMode(mode_switch);
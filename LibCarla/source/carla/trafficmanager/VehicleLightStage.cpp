@@ -30,7 +30,7 @@ void VehicleLightStage::UpdateWorldInfo() {
 void VehicleLightStage::Update(const unsigned long index) {
   ActorId actor_id = vehicle_id_list.at(index);
 
-  if (!parameters.GetUpdateVehicleLights(actor_id))
+  if (!parameters.GetSnapshot().GetVehicle(index).update_vehicle_lights)
     return; // this vehicle is not set to have automatic lights update
 
   rpc::VehicleLightState::flag_type light_states = uint32_t(-1);
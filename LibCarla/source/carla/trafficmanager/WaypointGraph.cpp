@@ -0,0 +1,95 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/trafficmanager/WaypointGraph.h"
+
+namespace carla {
+namespace traffic_manager {
+
+  using SimpleWaypointPtr = std::shared_ptr<SimpleWaypoint>;
+
+  template <typename T>
+  static size_t GetVectorMemoryUsage(const std::vector<T> &vector) {
+    return vector.capacity() * sizeof(T);
+  }
+
+  static WaypointIndex GetIndexOrInvalid(const SimpleWaypointPtr &waypoint) {
+    return waypoint != nullptr ? waypoint->GetIndex() : INVALID_WAYPOINT_INDEX;
+  }
+
+  void WaypointGraph::Build(const std::vector<SimpleWaypointPtr> &dense_topology) {
+    const size_t number_of_waypoints = dense_topology.size();
+
+    for (size_t i = 0u; i < number_of_waypoints; ++i) {
+      dense_topology[i]->SetIndex(static_cast<WaypointIndex>(i));
+    }
+
+    locations.clear();
+    forward_vectors.clear();
+    waypoint_ids.clear();
+    geodesic_grid_ids.clear();
+    junction_flags.clear();
+    next_offsets.clear();
+    next_indices.clear();
+    previous_offsets.clear();
+    previous_indices.clear();
+    left_indices.clear();
+    right_indices.clear();
+
+    locations.reserve(number_of_waypoints);
+    forward_vectors.reserve(number_of_waypoints);
+    waypoint_ids.reserve(number_of_waypoints);
+    geodesic_grid_ids.reserve(number_of_waypoints);
+    junction_flags.reserve(number_of_waypoints);
+    next_offsets.reserve(number_of_waypoints + 1u);
+    previous_offsets.reserve(number_of_waypoints + 1u);
+    left_indices.reserve(number_of_waypoints);
+    right_indices.reserve(number_of_waypoints);
+
+    next_offsets.push_back(0u);
+    previous_offsets.push_back(0u);
+    for (const SimpleWaypointPtr &waypoint : dense_topology) {
+      const cg::Transform transform = waypoint->GetTransform();
+      locations.push_back(transform.location);
+      forward_vectors.push_back(transform.GetForwardVector());
+      waypoint_ids.push_back(waypoint->GetId());
+      geodesic_grid_ids.push_back(waypoint->GetGeodesicGridId());
+      junction_flags.push_back(waypoint->CheckJunction() ? 1u : 0u);
+
+      for (const SimpleWaypointPtr &next_waypoint : waypoint->GetNextWaypoint()) {
+        next_indices.push_back(next_waypoint->GetIndex());
+      }
+      next_offsets.push_back(static_cast<uint32_t>(next_indices.size()));
+
+      for (const SimpleWaypointPtr &previous_waypoint : waypoint->GetPreviousWaypoint()) {
+        previous_indices.push_back(previous_waypoint->GetIndex());
+      }
+      previous_offsets.push_back(static_cast<uint32_t>(previous_indices.size()));
+
+      left_indices.push_back(GetIndexOrInvalid(waypoint->GetLeftWaypoint()));
+      right_indices.push_back(GetIndexOrInvalid(waypoint->GetRightWaypoint()));
+    }
+
+    next_indices.shrink_to_fit();
+    previous_indices.shrink_to_fit();
+  }
+
+  size_t WaypointGraph::GetMemoryUsage() const {
+    return GetVectorMemoryUsage(locations)
+        + GetVectorMemoryUsage(forward_vectors)
+        + GetVectorMemoryUsage(waypoint_ids)
+        + GetVectorMemoryUsage(geodesic_grid_ids)
+        + GetVectorMemoryUsage(junction_flags)
+        + GetVectorMemoryUsage(next_offsets)
+        + GetVectorMemoryUsage(next_indices)
+        + GetVectorMemoryUsage(previous_offsets)
+        + GetVectorMemoryUsage(previous_indices)
+        + GetVectorMemoryUsage(left_indices)
+        + GetVectorMemoryUsage(right_indices);
+  }
+
+} // namespace traffic_manager
+} // namespace carla
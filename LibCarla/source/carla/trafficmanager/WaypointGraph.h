@@ -0,0 +1,155 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "carla/geom/Location.h"
+#include "carla/geom/Math.h"
+#include "carla/geom/Vector3D.h"
+
+#include "carla/trafficmanager/SimpleWaypoint.h"
+
+namespace carla {
+namespace traffic_manager {
+
+  namespace cg = carla::geom;
+
+  /// Contiguous range of waypoint indices, used for the connections of a
+  /// waypoint in the graph.
+  class WaypointIndexRange {
+  public:
+
+    WaypointIndexRange(const WaypointIndex *begin, const WaypointIndex *end)
+      : _begin(begin),
+        _end(end) {}
+
+    const WaypointIndex *begin() const {
+      return _begin;
+    }
+
+    const WaypointIndex *end() const {
+      return _end;
+    }
+
+    size_t size() const {
+      return static_cast<size_t>(_end - _begin);
+    }
+
+    bool empty() const {
+      return _begin == _end;
+    }
+
+    WaypointIndex front() const {
+      return *_begin;
+    }
+
+    WaypointIndex operator[](const size_t i) const {
+      return _begin[i];
+    }
+
+  private:
+
+    const WaypointIndex *_begin;
+    const WaypointIndex *_end;
+  };
+
+  /// Flat representation of the waypoints of the local map. The attributes
+  /// read on every cycle are stored in contiguous arrays indexed by the
+  /// position of the waypoint in the dense topology, and the connections are
+  /// stored as index ranges, so traversing the graph doesn't touch the
+  /// reference count of the SimpleWaypoint objects.
+  class WaypointGraph {
+
+  public:
+
+    /// Builds the graph from the dense topology of the local map, and assigns
+    /// to every SimpleWaypoint its index in the graph.
+    void Build(const std::vector<std::shared_ptr<SimpleWaypoint>> &dense_topology);
+
+    /// Number of waypoints in the graph.
+    size_t Size() const {
+      return locations.size();
+    }
+
+    const cg::Location &GetLocation(const WaypointIndex index) const {
+      return locations[index];
+    }
+
+    const cg::Vector3D &GetForwardVector(const WaypointIndex index) const {
+      return forward_vectors[index];
+    }
+
+    uint64_t GetId(const WaypointIndex index) const {
+      return waypoint_ids[index];
+    }
+
+    bool IsJunction(const WaypointIndex index) const {
+      return junction_flags[index] != 0u;
+    }
+
+    /// Geodesic grid of the waypoint, the junction id for waypoints inside
+    /// junctions.
+    GeoGridId GetGeodesicGridId(const WaypointIndex index) const {
+      return geodesic_grid_ids[index];
+    }
+
+    WaypointIndexRange GetNext(const WaypointIndex index) const {
+      return GetRange(next_offsets, next_indices, index);
+    }
+
+    WaypointIndexRange GetPrevious(const WaypointIndex index) const {
+      return GetRange(previous_offsets, previous_indices, index);
+    }
+
+    /// Lane change connections, INVALID_WAYPOINT_INDEX if there is none.
+    WaypointIndex GetLeft(const WaypointIndex index) const {
+      return left_indices[index];
+    }
+
+    WaypointIndex GetRight(const WaypointIndex index) const {
+      return right_indices[index];
+    }
+
+    float DistanceSquared(const WaypointIndex index, const WaypointIndex other_index) const {
+      return cg::Math::DistanceSquared(locations[index], locations[other_index]);
+    }
+
+    float DistanceSquared(const WaypointIndex index, const cg::Location &location) const {
+      return cg::Math::DistanceSquared(locations[index], location);
+    }
+
+    /// Memory used by the graph, in bytes.
+    size_t GetMemoryUsage() const;
+
+  private:
+
+    static WaypointIndexRange GetRange(const std::vector<uint32_t> &offsets,
+                                       const std::vector<WaypointIndex> &indices,
+                                       const WaypointIndex index) {
+      const WaypointIndex *data = indices.data();
+      return WaypointIndexRange(data + offsets[index], data + offsets[index + 1u]);
+    }
+
+    std::vector<cg::Location> locations;
+    std::vector<cg::Vector3D> forward_vectors;
+    std::vector<uint64_t> waypoint_ids;
+    std::vector<GeoGridId> geodesic_grid_ids;
+    std::vector<uint8_t> junction_flags;
+    /// Connections stored in compressed rows: the successors of waypoint i
+    /// are next_indices[next_offsets[i]] to next_indices[next_offsets[i + 1]].
+    std::vector<uint32_t> next_offsets;
+    std::vector<WaypointIndex> next_indices;
+    std::vector<uint32_t> previous_offsets;
+    std::vector<WaypointIndex> previous_indices;
+    std::vector<WaypointIndex> left_indices;
+    std::vector<WaypointIndex> right_indices;
+  };
+
+} // namespace traffic_manager
+} // namespace carla
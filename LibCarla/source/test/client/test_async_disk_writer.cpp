@@ -0,0 +1,136 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/image/ImageIO.h>
+#include <carla/sensor/AsyncDiskWriter.h>
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <vector>
+
+using namespace std::chrono_literals;
+using carla::sensor::AsyncDiskWriter;
+
+namespace fs = boost::filesystem;
+
+TEST(async_disk_writer, flush) {
+  AsyncDiskWriter::Options options;
+  options.worker_threads = 4u;
+  options.max_queue_size = 3u;
+  AsyncDiskWriter writer(options);
+  std::atomic_size_t count{0u};
+  constexpr size_t number_of_writes = 100u;
+  for (auto i = 0u; i < number_of_writes; ++i) {
+    ASSERT_TRUE(writer.Write([&]() {
+      std::this_thread::sleep_for(1ms);
+      ++count;
+    }));
+  }
+  writer.Flush();
+  ASSERT_EQ(count, number_of_writes);
+  ASSERT_EQ(writer.GetWrittenCount(), number_of_writes);
+  ASSERT_EQ(writer.GetQueueSize(), 0u);
+  ASSERT_EQ(writer.GetDroppedCount(), 0u);
+  ASSERT_EQ(writer.GetFailedCount(), 0u);
+}
+
+TEST(async_disk_writer, drop_when_full) {
+  AsyncDiskWriter::Options options;
+  options.worker_threads = 1u;
+  options.max_queue_size = 2u;
+  options.drop_when_full = true;
+  AsyncDiskWriter writer(options);
+
+  // Keep the only thread busy until the queue has been filled.
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool started = false;
+  bool release = false;
+  ASSERT_TRUE(writer.Write([&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    started = true;
+    cv.notify_all();
+    cv.wait(lock, [&]() { return release; });
+  }));
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&]() { return started; });
+  }
+  ASSERT_TRUE(writer.Write([]() {}));
+  ASSERT_TRUE(writer.Write([]() { throw std::runtime_error("disk full"); }));
+  ASSERT_FALSE(writer.Write([]() {}));
+  ASSERT_FALSE(writer.Write([]() {}));
+  ASSERT_EQ(writer.GetQueueSize(), 2u);
+  ASSERT_EQ(writer.GetDroppedCount(), 2u);
+  ASSERT_FALSE(writer.WaitFor(10ms));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  cv.notify_all();
+  ASSERT_TRUE(writer.WaitFor(10s));
+  ASSERT_EQ(writer.GetWrittenCount(), 2u);
+  ASSERT_EQ(writer.GetFailedCount(), 1u);
+  ASSERT_EQ(writer.GetDroppedCount(), 2u);
+}
+
+TEST(async_disk_writer, data_kept_alive) {
+  auto data = std::make_shared<std::vector<int>>(1000u, 42);
+  std::weak_ptr<std::vector<int>> weak = data;
+  std::atomic_int sum{0};
+  {
+    AsyncDiskWriter writer;
+    writer.Write([data, &sum]() {
+      std::this_thread::sleep_for(10ms);
+      for (auto value : *data) {
+        sum += value;
+      }
+    });
+    data.reset();
+  } // Pending writes are finished on destruction.
+  ASSERT_EQ(sum, 42000);
+  ASSERT_TRUE(weak.expired());
+}
+
+#if LIBCARLA_IMAGE_WITH_PNG_SUPPORT
+
+TEST(async_disk_writer, png_compression_level) {
+  using namespace carla::image;
+  // Noisy stripes, so the compression level makes a difference.
+  std::vector<boost::gil::rgb8_pixel_t> pixels(512u * 512u);
+  std::mt19937 engine(42u);
+  std::uniform_int_distribution<int> distribution(0, 7);
+  for (auto i = 0u; i < pixels.size(); ++i) {
+    const auto value = static_cast<uint8_t>((i / 8u) % 256u + static_cast<uint32_t>(distribution(engine)));
+    pixels[i] = boost::gil::rgb8_pixel_t(value, value, value);
+  }
+  const auto view = boost::gil::interleaved_view(512u, 512u, pixels.data(), 512u * sizeof(pixels[0u]));
+
+  const auto directory = fs::temp_directory_path() / fs::unique_path("carla-%%%%-%%%%-%%%%");
+  std::vector<uintmax_t> sizes;
+  for (int level : {0, 9}) {
+    AsyncDiskWriter::Options options;
+    options.image.png_compression_level = level;
+    AsyncDiskWriter writer(options);
+    const auto path = (directory / ("level" + std::to_string(level) + ".png")).string();
+    writer.Write([=, &writer]() {
+      ImageIO::WriteView(path, view, writer.GetOptions().image);
+    });
+    writer.Flush();
+    ASSERT_EQ(writer.GetWrittenCount(), 1u);
+    sizes.emplace_back(fs::file_size(path));
+  }
+  fs::remove_all(directory);
+  ASSERT_LT(sizes[1u], sizes[0u]);
+}
+
+#endif // LIBCARLA_IMAGE_WITH_PNG_SUPPORT
@@ -0,0 +1,247 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "OpenDrive.h"
+#include "Random.h"
+
+#include <carla/StopWatch.h>
+#include <carla/geom/Math.h>
+#include <carla/geom/Mesh.h>
+#include <carla/geom/Rtree.h>
+#include <carla/opendrive/OpenDriveParser.h>
+#include <carla/road/MapSerializer.h>
+#include <carla/road/element/RoadInfoGeometry.h>
+#include <carla/rpc/OpendriveGenerationParameters.h>
+
+#include <thread>
+
+using namespace carla::road;
+using namespace carla::opendrive;
+
+static double time_compute_transforms(
+    const Map &map,
+    const std::vector<element::Waypoint> &waypoints,
+    const size_t rounds) {
+  carla::StopWatch stop_watch;
+  float checksum = 0.0f;
+  for (auto i = 0u; i < rounds; ++i) {
+    for (const auto &waypoint : waypoints) {
+      checksum += map.ComputeTransform(waypoint).location.x;
+    }
+  }
+  stop_watch.Stop();
+  // Prevent the loop from being optimized away.
+  EXPECT_TRUE(std::isfinite(checksum));
+  return 1e-3 * static_cast<double>(stop_watch.GetElapsedTime());
+}
+
+static double time_spirals(Map &map, const size_t rounds) {
+  std::vector<const element::Geometry *> spirals;
+  for (const auto &pair : map.GetMap().GetRoads()) {
+    for (const auto *info : pair.second.GetInfos<element::RoadInfoGeometry>()) {
+      if (info->GetGeometry().GetType() == element::GeometryType::SPIRAL) {
+        spirals.emplace_back(&info->GetGeometry());
+      }
+    }
+  }
+  carla::StopWatch stop_watch;
+  double checksum = 0.0;
+  for (auto i = 0u; i < rounds; ++i) {
+    for (const auto *spiral : spirals) {
+      for (double s = 0.0; s < spiral->GetLength(); s += 0.1) {
+        checksum += spiral->PosFromDist(s).tangent;
+      }
+    }
+  }
+  stop_watch.Stop();
+  EXPECT_TRUE(std::isfinite(checksum));
+  return 1e-3 * static_cast<double>(stop_watch.GetElapsedTime());
+}
+
+TEST(benchmark_opendrive, compute_transform_lookup_tables) {
+  constexpr size_t rounds = 10u;
+  element::GeometryLookupTableSettings exact_settings;
+  exact_settings.enabled = false;
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    const auto xodr = util::OpenDrive::Load(file);
+    auto exact_map = OpenDriveParser::Load(xodr, exact_settings);
+    auto map = OpenDriveParser::Load(xodr);
+    ASSERT_TRUE(exact_map.has_value());
+    ASSERT_TRUE(map.has_value());
+
+    const auto waypoints = exact_map->GenerateWaypoints(0.5);
+    double max_error = 0.0;
+    for (const auto &waypoint : waypoints) {
+      const auto expected = exact_map->ComputeTransform(waypoint);
+      const auto result = map->ComputeTransform(waypoint);
+      max_error = std::max(
+          max_error,
+          static_cast<double>(carla::geom::Math::Distance(expected.location, result.location)));
+    }
+    ASSERT_LT(max_error, 0.01);
+
+    const double exact_time = time_compute_transforms(*exact_map, waypoints, rounds);
+    const double time = time_compute_transforms(*map, waypoints, rounds);
+    carla::logging::log(
+        file, ":", waypoints.size() * rounds, "waypoint transforms in",
+        time, "seconds, without lookup tables", exact_time,
+        "seconds, max error", max_error, "meters.");
+    carla::logging::log(
+        file, ": spirals evaluated in", time_spirals(*map, rounds),
+        "seconds, without lookup tables", time_spirals(*exact_map, rounds), "seconds.");
+  }
+}
+
+static std::vector<std::unique_ptr<carla::geom::Mesh>> generate_chunked_mesh(
+    const Map &map,
+    const uint32_t max_threads,
+    double &seconds) {
+  carla::rpc::OpendriveGenerationParameters params;
+  params.max_mesh_generation_threads = max_threads;
+  carla::StopWatch stop_watch;
+  auto meshes = map.GenerateChunkedMesh(params);
+  stop_watch.Stop();
+  seconds = 1e-3 * static_cast<double>(stop_watch.GetElapsedTime());
+  return meshes;
+}
+
+TEST(benchmark_opendrive, generate_chunked_mesh_in_parallel) {
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    auto map = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(map.has_value());
+
+    double serial_time;
+    double parallel_time;
+    const auto expected = generate_chunked_mesh(*map, 1u, serial_time);
+    const auto result = generate_chunked_mesh(*map, 0u, parallel_time);
+
+    // The output must not depend on the number of threads.
+    ASSERT_EQ(result.size(), expected.size());
+    for (auto i = 0u; i < result.size(); ++i) {
+      ASSERT_EQ(result[i]->GetVertices(), expected[i]->GetVertices());
+      ASSERT_EQ(result[i]->GetIndexes(), expected[i]->GetIndexes());
+    }
+    carla::logging::log(
+        file, ":", result.size(), "mesh chunks generated in", parallel_time,
+        "seconds with", std::thread::hardware_concurrency(),
+        "threads, in", serial_time, "seconds with one thread.");
+  }
+}
+
+TEST(benchmark_opendrive, load_serialized_map) {
+  constexpr size_t rounds = 5u;
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    const auto xodr = util::OpenDrive::Load(file);
+    const auto hash = MapSerializer::HashOpenDrive(xodr);
+
+    carla::StopWatch parse_watch;
+    for (auto i = 0u; i < rounds; ++i) {
+      ASSERT_TRUE(OpenDriveParser::Load(xodr).has_value());
+    }
+    parse_watch.Stop();
+
+    auto map = OpenDriveParser::Load(xodr);
+    ASSERT_TRUE(map.has_value());
+    const auto data = MapSerializer::Serialize(*map, hash);
+    ASSERT_FALSE(data.empty());
+
+    carla::StopWatch load_watch;
+    for (auto i = 0u; i < rounds; ++i) {
+      ASSERT_TRUE(MapSerializer::Deserialize(data.data(), data.size(), hash).has_value());
+    }
+    load_watch.Stop();
+
+    const auto to_seconds = [](const carla::StopWatch &watch) {
+      return 1e-3 * static_cast<double>(watch.GetElapsedTime()) / static_cast<double>(rounds);
+    };
+    carla::logging::log(
+        file, ": map loaded from", data.size(), "serialized bytes in",
+        to_seconds(load_watch), "seconds, from", xodr.size(),
+        "OpenDRIVE bytes in", to_seconds(parse_watch), "seconds.");
+  }
+}
+
+TEST(benchmark_opendrive, nearest_waypoint_queries) {
+  using Rtree = carla::geom::SegmentCloudRtree<element::Waypoint>;
+  constexpr size_t number_of_queries = 20'000u;
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    auto map = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(map.has_value());
+
+    std::vector<carla::geom::Location> locations;
+    locations.reserve(number_of_queries);
+    for (auto i = 0u; i < number_of_queries; ++i) {
+      locations.emplace_back(util::Random::Location(-500.0f, 500.0f));
+    }
+    const auto queries_per_second = [&](const carla::StopWatch &watch) {
+      return static_cast<double>(number_of_queries) /
+          (1e-3 * static_cast<double>(std::max<size_t>(watch.GetElapsedTime(), 1u)));
+    };
+
+    carla::StopWatch single_watch;
+    for (const auto &location : locations) {
+      map->GetClosestWaypointOnRoad(location);
+    }
+    single_watch.Stop();
+
+    std::vector<boost::optional<element::Waypoint>> result;
+    carla::StopWatch serial_watch;
+    map->GetWaypoints(locations, result, true, static_cast<int32_t>(Lane::LaneType::Driving), 1u);
+    serial_watch.Stop();
+
+    carla::StopWatch parallel_watch;
+    map->GetWaypoints(locations, result, true);
+    parallel_watch.Stop();
+    ASSERT_EQ(result.size(), number_of_queries);
+
+    carla::logging::log(
+        file, ": nearest waypoint queries per second,",
+        queries_per_second(single_watch), "one at a time,",
+        queries_per_second(serial_watch), "batched in one thread,",
+        queries_per_second(parallel_watch), "batched in",
+        std::thread::hardware_concurrency(), "threads.");
+
+    // Segments between waypoints one meter apart, to compare building the
+    // tree one element at a time with bulk-loading it.
+    std::vector<Rtree::TreeElement> elements;
+    for (const auto &waypoint : map->GenerateWaypoints(1.0)) {
+      const auto start = map->ComputeTransform(waypoint).location;
+      for (const auto &next : map->GetNext(waypoint, 1.0)) {
+        const auto end = map->ComputeTransform(next).location;
+        elements.emplace_back(
+            Rtree::BSegment(Rtree::BPoint(start.x, start.y, start.z), Rtree::BPoint(end.x, end.y, end.z)),
+            std::make_pair(waypoint, next));
+      }
+    }
+    const auto time_queries = [&](const Rtree &rtree) {
+      carla::StopWatch watch;
+      for (const auto &location : locations) {
+        EXPECT_EQ(rtree.GetNearestNeighbours(Rtree::BPoint(location.x, location.y, location.z)).size(), 1u);
+      }
+      watch.Stop();
+      return watch;
+    };
+
+    Rtree inserted;
+    carla::StopWatch insert_watch;
+    inserted.InsertElements(elements);
+    insert_watch.Stop();
+
+    Rtree packed;
+    carla::StopWatch bulk_load_watch;
+    packed.BulkLoad(elements);
+    bulk_load_watch.Stop();
+    ASSERT_EQ(packed.GetTreeSize(), inserted.GetTreeSize());
+
+    carla::logging::log(
+        file, ":", elements.size(), "segments inserted in",
+        1e-3 * static_cast<double>(insert_watch.GetElapsedTime()), "seconds,",
+        queries_per_second(time_queries(inserted)), "queries per second; bulk-loaded in",
+        1e-3 * static_cast<double>(bulk_load_watch.GetElapsedTime()), "seconds,",
+        queries_per_second(time_queries(packed)), "queries per second.");
+  }
+}
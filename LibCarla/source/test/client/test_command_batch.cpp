@@ -0,0 +1,170 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/MsgPackAdaptors.h>
+#include <carla/StopWatch.h>
+#include <carla/rpc/Command.h>
+#include <carla/rpc/CommandBatch.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace carla::rpc;
+using carla::geom::Location;
+using carla::geom::Rotation;
+using carla::geom::Transform;
+
+static std::vector<Command> MakeVehicleControls(size_t count) {
+  std::mt19937_64 rng(42u);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<Command> commands;
+  commands.reserve(count);
+  for (auto i = 0u; i < count; ++i) {
+    VehicleControl control;
+    control.throttle = std::abs(dist(rng));
+    control.steer = dist(rng);
+    control.brake = std::abs(dist(rng));
+    control.hand_brake = (i % 3u) == 0u;
+    control.reverse = (i % 5u) == 0u;
+    control.manual_gear_shift = (i % 7u) == 0u;
+    control.gear = static_cast<int32_t>(i % 6u) - 1;
+    commands.emplace_back(Command::ApplyVehicleControl{i + 1u, control});
+  }
+  return commands;
+}
+
+TEST(command_batch, vehicle_control) {
+  const auto commands = MakeVehicleControls(100u);
+  CommandBatch batch{CommandBatch::Type::ApplyVehicleControl, commands.size()};
+  ASSERT_TRUE(batch.IsValid());
+  ASSERT_EQ(batch.size(), commands.size());
+  for (auto i = 0u; i < commands.size(); ++i) {
+    batch.Set(i, boost::variant2::get<Command::ApplyVehicleControl>(commands[i].command));
+  }
+  for (auto i = 0u; i < commands.size(); ++i) {
+    const auto &expected = boost::variant2::get<Command::ApplyVehicleControl>(commands[i].command);
+    Command::ApplyVehicleControl command;
+    batch.Get(i, command);
+    ASSERT_EQ(command.actor, expected.actor);
+    ASSERT_EQ(command.control, expected.control);
+  }
+  // The actor ids are the first column, packed.
+  uint32_t id;
+  std::memcpy(&id, batch.GetColumnData(0u) + 4u * sizeof(uint32_t), sizeof(id));
+  ASSERT_EQ(id, 5u);
+}
+
+TEST(command_batch, transform_and_walker_state) {
+  const Transform transform{Location{1.0f, 2.0f, 3.0f}, Rotation{10.0f, 20.0f, 30.0f}};
+  CommandBatch transforms{CommandBatch::Type::ApplyTransform, 2u};
+  transforms.Set(1u, Command::ApplyTransform{7u, transform});
+  Command::ApplyTransform result;
+  transforms.Get(1u, result);
+  ASSERT_EQ(result.actor, 7u);
+  ASSERT_EQ(result.transform, transform);
+  transforms.Get(0u, result);
+  ASSERT_EQ(result.actor, 0u);
+  ASSERT_EQ(result.transform, Transform{});
+
+  CommandBatch states{CommandBatch::Type::ApplyWalkerState, 1u};
+  states.Set(0u, Command::ApplyWalkerState{3u, transform, 1.5f});
+  Command::ApplyWalkerState state;
+  states.Get(0u, state);
+  ASSERT_EQ(state.actor, 3u);
+  ASSERT_EQ(state.transform, transform);
+  ASSERT_EQ(state.speed, 1.5f);
+}
+
+TEST(command_batch, make_batches) {
+  std::vector<Command> commands;
+  commands.emplace_back(Command::ApplyVehicleControl{1u, VehicleControl{}});
+  commands.emplace_back(Command::SetVehicleLightState{2u, 3u});
+  commands.emplace_back(Command::DestroyActor{4u});
+  commands.emplace_back(Command::ApplyVehicleControl{5u, VehicleControl{}});
+  commands.emplace_back(Command::ApplyTargetVelocity{6u, carla::geom::Vector3D{1.0f, 0.0f, 0.0f}});
+  std::vector<Command> others;
+  const auto batches = CommandBatch::MakeBatches(commands, others);
+  ASSERT_EQ(batches.size(), 3u);
+  ASSERT_EQ(others.size(), 1u);
+  size_t total = 0u;
+  for (const auto &batch : batches) {
+    ASSERT_TRUE(batch.IsValid());
+    total += batch.size();
+    if (batch.GetType() == CommandBatch::Type::ApplyVehicleControl) {
+      ASSERT_EQ(batch.size(), 2u);
+      Command::ApplyVehicleControl command;
+      batch.Get(1u, command);
+      ASSERT_EQ(command.actor, 5u);
+    }
+  }
+  ASSERT_EQ(total, 4u);
+}
+
+TEST(command_batch, msgpack) {
+  using mp = carla::MsgPack;
+  const auto commands = MakeVehicleControls(10u);
+  std::vector<Command> others;
+  const auto batches = CommandBatch::MakeBatches(commands, others);
+  ASSERT_EQ(batches.size(), 1u);
+  const auto result = mp::UnPack<std::vector<CommandBatch>>(mp::Pack(batches));
+  ASSERT_EQ(result.size(), 1u);
+  ASSERT_TRUE(result[0u].IsValid());
+  ASSERT_EQ(result[0u].size(), commands.size());
+  for (auto i = 0u; i < commands.size(); ++i) {
+    const auto &expected = boost::variant2::get<Command::ApplyVehicleControl>(commands[i].command);
+    Command::ApplyVehicleControl command;
+    result[0u].Get(i, command);
+    ASSERT_EQ(command.actor, expected.actor);
+    ASSERT_EQ(command.control, expected.control);
+  }
+}
+
+TEST(command_batch, invalid) {
+  ASSERT_FALSE(CommandBatch{}.IsValid());
+  // A blob shorter than the commands it claims to hold is rejected.
+  const auto buffer = carla::MsgPack::Pack(CommandBatch{CommandBatch::Type::ApplyTransform, 4u});
+  ASSERT_TRUE(carla::MsgPack::UnPack<CommandBatch>(buffer).IsValid());
+  std::vector<unsigned char> data(buffer.data(), buffer.data() + buffer.size());
+  // Patch the size, the second element of the array, from 4 to 5.
+  ASSERT_EQ(data[2u], 4u);
+  data[2u] = 5u;
+  ASSERT_FALSE(carla::MsgPack::UnPack<CommandBatch>(data.data(), data.size()).IsValid());
+}
+
+TEST(benchmark_command_batch, encode_decode) {
+  using mp = carla::MsgPack;
+  for (size_t count : {1000u, 5000u, 20000u}) {
+    const auto commands = MakeVehicleControls(count);
+
+    carla::StopWatch commands_watch;
+    const auto command_buffer = mp::Pack(commands);
+    const auto decoded_commands = mp::UnPack<std::vector<Command>>(command_buffer);
+    commands_watch.Stop();
+    ASSERT_EQ(decoded_commands.size(), count);
+
+    carla::StopWatch batch_watch;
+    std::vector<Command> others;
+    const auto batch_buffer = mp::Pack(CommandBatch::MakeBatches(commands, others));
+    const auto decoded_batches = mp::UnPack<std::vector<CommandBatch>>(batch_buffer);
+    Command::ApplyVehicleControl command;
+    for (auto i = 0u; i < count; ++i) {
+      decoded_batches[0u].Get(i, command);
+    }
+    batch_watch.Stop();
+    ASSERT_EQ(decoded_batches[0u].size(), count);
+
+    carla::logging::log(
+        count, "vehicle controls: apply_batch",
+        command_buffer.size(), "bytes,",
+        commands_watch.GetElapsedTime<std::chrono::microseconds>(), "us; command batch",
+        batch_buffer.size(), "bytes,",
+        batch_watch.GetElapsedTime<std::chrono::microseconds>(), "us");
+  }
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/StopWatch.h>
+#include <carla/sensor/data/DVSEventKernels.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using carla::sensor::data::Color;
+using carla::sensor::data::DVSEvent;
+using carla::sensor::data::DVSEventKernels;
+
+static std::vector<DVSEvent> MakeEvents(size_t count, size_t width, size_t height) {
+  std::mt19937_64 rng(42u);
+  std::uniform_int_distribution<uint16_t> x_dist(0u, static_cast<uint16_t>(width - 1u));
+  std::uniform_int_distribution<uint16_t> y_dist(0u, static_cast<uint16_t>(height - 1u));
+  std::uniform_int_distribution<int64_t> t_dist(1000000, 1050000000);
+  std::bernoulli_distribution pol_dist(0.5);
+  std::vector<DVSEvent> events;
+  events.reserve(count);
+  for (auto i = 0u; i < count; ++i) {
+    events.emplace_back(x_dist(rng), y_dist(rng), t_dist(rng), pol_dist(rng));
+  }
+  return events;
+}
+
+TEST(dvs, decode) {
+  const auto events = MakeEvents(1000u, 64u, 48u);
+  const auto size = events.size();
+  std::vector<uint16_t> x(size), y(size), x_only(size);
+  std::vector<int64_t> t(size);
+  std::vector<int16_t> pol(size), pol_only(size);
+  DVSEventKernels::Decode(events.data(), size, x.data(), y.data(), t.data(), pol.data());
+  DVSEventKernels::Decode(events.data(), size, x_only.data(), nullptr, nullptr, pol_only.data());
+  for (auto i = 0u; i < size; ++i) {
+    const DVSEvent event = events[i];
+    ASSERT_EQ(x[i], event.x);
+    ASSERT_EQ(y[i], event.y);
+    ASSERT_EQ(t[i], event.t);
+    ASSERT_EQ(pol[i], event.pol ? 1 : -1);
+    ASSERT_EQ(x_only[i], x[i]);
+    ASSERT_EQ(pol_only[i], pol[i]);
+  }
+  const auto range = DVSEventKernels::GetTimeRange(events.data(), size);
+  ASSERT_EQ(range.begin, *std::min_element(t.begin(), t.end()));
+  ASSERT_EQ(range.end, *std::max_element(t.begin(), t.end()) + 1);
+}
+
+TEST(dvs, image) {
+  std::vector<DVSEvent> events;
+  events.emplace_back(1u, 0u, 10, true);
+  events.emplace_back(2u, 1u, 11, false);
+  events.emplace_back(2u, 1u, 12, true);
+  events.emplace_back(9u, 9u, 13, true); // outside the image
+  std::vector<Color> image(4u * 2u);
+  DVSEventKernels::ToImage(events.data(), events.size(), 4u, 2u, image.data());
+  ASSERT_EQ(image[1].b, 255u);
+  ASSERT_EQ(image[1].r, 0u);
+  ASSERT_EQ(image[6].b, 255u);
+  ASSERT_EQ(image[6].r, 255u);
+  ASSERT_EQ(image[0].b, 0u);
+  ASSERT_EQ(image[0].r, 0u);
+}
+
+TEST(dvs, event_frame) {
+  constexpr size_t width = 64u;
+  constexpr size_t height = 48u;
+  const auto events = MakeEvents(10000u, width, height);
+  const DVSEventKernels::TimeWindow window{200000000, 800000000};
+  std::vector<float> frame(width * height, 0.0f);
+  std::vector<float> split(2u * width * height, 0.0f);
+  std::vector<float> expected(width * height, 0.0f);
+  size_t in_window = 0u;
+  for (const DVSEvent &event : events) {
+    const int64_t t = event.t;
+    if (t >= window.begin && t < window.end) {
+      expected[width * event.y + event.x] += event.pol ? 1.0f : -1.0f;
+      ++in_window;
+    }
+  }
+  DVSEventKernels::AccumulateFrame(events.data(), events.size(), width, height, window, false, frame.data());
+  DVSEventKernels::AccumulateFrame(events.data(), events.size(), width, height, window, true, split.data());
+  float total = 0.0f;
+  for (auto i = 0u; i < width * height; ++i) {
+    ASSERT_EQ(frame[i], expected[i]);
+    ASSERT_EQ(split[i] - split[width * height + i], expected[i]);
+    total += split[i] + split[width * height + i];
+  }
+  ASSERT_EQ(static_cast<size_t>(total), in_window);
+}
+
+TEST(dvs, voxel_grid) {
+  constexpr size_t width = 32u;
+  constexpr size_t height = 16u;
+  constexpr size_t bins = 5u;
+  const auto events = MakeEvents(5000u, width, height);
+  const auto window = DVSEventKernels::GetTimeRange(events.data(), events.size());
+  std::vector<float> grid(bins * width * height, 0.0f);
+  DVSEventKernels::AccumulateVoxelGrid(events.data(), events.size(), width, height, bins, window, grid.data());
+
+  // The bins of each pixel add up to its event frame.
+  std::vector<float> frame(width * height, 0.0f);
+  DVSEventKernels::AccumulateFrame(events.data(), events.size(), width, height, window, false, frame.data());
+  for (auto i = 0u; i < width * height; ++i) {
+    float sum = 0.0f;
+    for (auto b = 0u; b < bins; ++b) {
+      sum += grid[b * width * height + i];
+    }
+    ASSERT_NEAR(sum, frame[i], 1e-3f);
+  }
+
+  // An event at each end of the window lands in the first and last bins.
+  std::vector<DVSEvent> ends;
+  ends.emplace_back(0u, 0u, 100, true);
+  ends.emplace_back(1u, 0u, 199, false);
+  ends.emplace_back(2u, 0u, 200, true); // outside the window
+  std::vector<float> small(bins * 4u, 0.0f);
+  DVSEventKernels::AccumulateVoxelGrid(ends.data(), ends.size(), 4u, 1u, bins, {100, 200}, small.data());
+  ASSERT_EQ(small[0], 1.0f);
+  ASSERT_EQ(small[(bins - 1u) * 4u + 1u], -1.0f);
+  float total = 0.0f;
+  for (float value : small) {
+    total += std::abs(value);
+  }
+  ASSERT_NEAR(total, 2.0f, 1e-6f);
+}
+
+TEST(benchmark_dvs, kernels) {
+  constexpr size_t width = 640u;
+  constexpr size_t height = 480u;
+  constexpr size_t count = 10000000u;
+  const auto events = MakeEvents(count, width, height);
+  const auto window = DVSEventKernels::GetTimeRange(events.data(), count);
+
+  auto report = [&](const char *name, const carla::StopWatch &stop_watch) {
+    const auto ms = static_cast<double>(stop_watch.GetElapsedTime());
+    carla::logging::log(name, count, "events:", ms, "ms,", 1e-3 * count / std::max(ms, 1.0), "M events/s");
+  };
+
+  {
+    std::vector<uint16_t> x(count), y(count);
+    std::vector<int64_t> t(count);
+    std::vector<int16_t> pol(count);
+    carla::StopWatch stop_watch;
+    DVSEventKernels::Decode(events.data(), count, x.data(), y.data(), t.data(), pol.data());
+    stop_watch.Stop();
+    report("decode", stop_watch);
+  }
+  {
+    std::vector<float> frame(width * height, 0.0f);
+    carla::StopWatch stop_watch;
+    DVSEventKernels::AccumulateFrame(events.data(), count, width, height, window, false, frame.data());
+    stop_watch.Stop();
+    report("event frame", stop_watch);
+  }
+  {
+    constexpr size_t bins = 5u;
+    std::vector<float> grid(bins * width * height, 0.0f);
+    carla::StopWatch stop_watch;
+    DVSEventKernels::AccumulateVoxelGrid(events.data(), count, width, height, bins, window, grid.data());
+    stop_watch.Stop();
+    report("voxel grid", stop_watch);
+  }
+  {
+    // The previous ToArrayX/Y/T/Pol, one pass per column without reserving.
+    carla::StopWatch stop_watch;
+    std::vector<uint16_t> x, y;
+    std::vector<int64_t> t;
+    std::vector<short> pol;
+    for (const auto &event : events) { x.push_back(event.x); }
+    for (const auto &event : events) { y.push_back(event.y); }
+    for (const auto &event : events) { t.push_back(event.t); }
+    for (const auto &event : events) { pol.push_back(2*static_cast<short>(event.pol) - 1); }
+    stop_watch.Stop();
+    report("previous decode", stop_watch);
+  }
+}
@@ -0,0 +1,279 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/StopWatch.h>
+#include <carla/client/detail/EpisodeState.h>
+#include <carla/sensor/CompositeSerializer.h>
+#include <carla/sensor/s11n/EpisodeStateDeltaEncoder.h>
+#include <carla/sensor/s11n/EpisodeStateSerializer.h>
+#include <carla/sensor/s11n/SensorHeaderSerializer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+
+using carla::ActorId;
+using carla::client::ActorSnapshot;
+using carla::client::detail::EpisodeState;
+using carla::sensor::data::ActorDynamicState;
+using carla::sensor::data::RawEpisodeState;
+using carla::sensor::s11n::EpisodeStateDeltaEncoder;
+using carla::sensor::s11n::EpisodeStateDeltaSettings;
+using carla::sensor::s11n::EpisodeStateSerializer;
+
+struct FakeWorldObserver;
+
+using EpisodeStateRegistry = carla::sensor::CompositeSerializer<
+    std::pair<FakeWorldObserver *, carla::sensor::s11n::EpisodeStateSerializer>>;
+
+static std::vector<ActorDynamicState> MakeActors(const size_t number_of_actors, const ActorId stride) {
+  std::vector<ActorId> ids(number_of_actors);
+  for (auto i = 0u; i < number_of_actors; ++i) {
+    ids[i] = 100u + static_cast<ActorId>(i) * stride;
+  }
+  std::shuffle(ids.begin(), ids.end(), std::mt19937(42u));
+  std::vector<ActorDynamicState> actors(number_of_actors);
+  for (auto i = 0u; i < number_of_actors; ++i) {
+    ActorDynamicState actor{};
+    actor.id = ids[i];
+    actor.transform.location.x = static_cast<float>(ids[i]);
+    actor.velocity.y = static_cast<float>(i);
+    std::memcpy(&actors[i], &actor, sizeof(ActorDynamicState));
+  }
+  return actors;
+}
+
+/// Episode state as written by the server.
+static carla::Buffer MakePayload(const std::vector<ActorDynamicState> &actors) {
+  using EpisodeHeader = carla::sensor::s11n::EpisodeStateSerializer::Header;
+  EpisodeHeader header;
+  header.episode_id = 1u;
+  header.platform_timestamp = 2.0;
+  header.delta_seconds = 0.05f;
+  carla::Buffer buffer(static_cast<uint64_t>(
+      sizeof(EpisodeHeader) + actors.size() * sizeof(ActorDynamicState)));
+  std::memcpy(buffer.data(), &header, sizeof(EpisodeHeader));
+  std::memcpy(buffer.data() + sizeof(EpisodeHeader), actors.data(), actors.size() * sizeof(ActorDynamicState));
+  return buffer;
+}
+
+/// Episode state as received by the client.
+static auto Deserialize(carla::Buffer &&message) {
+  auto result = EpisodeStateRegistry::Deserialize(std::move(message));
+  return boost::static_pointer_cast<const RawEpisodeState>(std::move(result));
+}
+
+static auto Deserialize(const uint64_t frame, const carla::Buffer &payload) {
+  using SensorHeader = carla::sensor::s11n::SensorHeaderSerializer::Header;
+  SensorHeader header{0u, frame, 1.0, carla::rpc::Transform{}};
+  carla::Buffer message(static_cast<uint64_t>(sizeof(SensorHeader) + payload.size()));
+  std::memcpy(message.data(), &header, sizeof(SensorHeader));
+  std::memcpy(message.data() + sizeof(SensorHeader), payload.data(), payload.size());
+  return Deserialize(std::move(message));
+}
+
+static auto MakeRawEpisodeState(
+    const size_t number_of_actors,
+    const uint64_t frame,
+    const ActorId stride = 1u) {
+  return Deserialize(frame, MakePayload(MakeActors(number_of_actors, stride)));
+}
+
+static void test_look_up_actors(const ActorId stride) {
+  constexpr size_t number_of_actors = 500u;
+  auto raw_state = MakeRawEpisodeState(number_of_actors, 10u, stride);
+  const EpisodeState state(raw_state);
+  ASSERT_EQ(state.GetEpisodeId(), 1u);
+  ASSERT_EQ(state.GetFrame(), 10u);
+  ASSERT_EQ(state.size(), number_of_actors);
+
+  // Iteration follows the order of the buffer.
+  auto actor = raw_state->begin();
+  for (const ActorSnapshot snapshot : state) {
+    ASSERT_EQ(snapshot.id, actor->id);
+    ASSERT_EQ(snapshot.velocity.y, actor->velocity.y);
+    ++actor;
+  }
+  std::vector<ActorId> ids(state.GetActorIds().begin(), state.GetActorIds().end());
+  ASSERT_EQ(ids.size(), number_of_actors);
+  ASSERT_EQ(ids.front(), raw_state->begin()->id);
+
+  for (auto i = 0u; i < number_of_actors; ++i) {
+    const ActorId id = 100u + i * stride;
+    ASSERT_TRUE(state.ContainsActorSnapshot(id));
+    const auto snapshot = state.GetActorSnapshotIfPresent(id);
+    ASSERT_TRUE(snapshot.has_value());
+    ASSERT_EQ(snapshot->id, id);
+    ASSERT_EQ(snapshot->transform.location.x, static_cast<float>(id));
+    ASSERT_EQ(state.ContainsActorSnapshot(id + 1u), stride == 1u && (i + 1u < number_of_actors));
+  }
+  ASSERT_FALSE(state.ContainsActorSnapshot(99u));
+  ASSERT_FALSE(state.GetActorSnapshotIfPresent(100u + number_of_actors * stride).has_value());
+  ASSERT_EQ(state.GetActorSnapshot(0u).id, 0u);
+}
+
+TEST(episode_state, look_up_actors) {
+  test_look_up_actors(1u);
+  test_look_up_actors(3u);
+  test_look_up_actors(1000u);
+
+  const EpisodeState empty(1u);
+  ASSERT_EQ(empty.size(), 0u);
+  ASSERT_FALSE(empty.ContainsActorSnapshot(100u));
+  ASSERT_TRUE(empty.begin() == empty.end());
+}
+
+/// Encode a sequence of frames where a few actors move, and some are added
+/// and removed. Calls @a check with the actors sent and the state received.
+template <typename CheckT>
+static void test_delta_frames(const EpisodeStateDeltaSettings &settings, CheckT &&check) {
+  EpisodeStateDeltaEncoder encoder;
+  encoder.SetSettings(settings);
+  auto actors = MakeActors(300u, 1u);
+  std::mt19937 rng(7u);
+  std::uniform_int_distribution<size_t> pick(0u, actors.size() - 1u);
+  std::uniform_real_distribution<float> step(-0.1f, 0.1f);
+  carla::SharedPtr<const RawEpisodeState> keyframe;
+  size_t full_bytes = 0u;
+  size_t sent_bytes = 0u;
+  size_t number_of_deltas = 0u;
+  for (uint64_t frame = 1u; frame <= 50u; ++frame) {
+    for (auto i = 0u; i < 20u; ++i) {
+      auto &actor = actors[pick(rng) % actors.size()];
+      actor.transform.location.x += step(rng);
+      actor.velocity.z += step(rng);
+    }
+    if (frame % 7u == 0u) {
+      actors.erase(actors.begin() + static_cast<long>(pick(rng) % actors.size()));
+    }
+    if (frame % 11u == 0u) {
+      ActorDynamicState actor{};
+      actor.id = 10000u + static_cast<ActorId>(frame);
+      actors.emplace_back(actor);
+    }
+
+    auto payload = MakePayload(actors);
+    full_bytes += payload.size();
+    auto encoded = encoder.Encode(frame, std::move(payload));
+    sent_bytes += encoded.size();
+    auto received = Deserialize(frame, encoded);
+    if (received->IsDeltaFrame()) {
+      ++number_of_deltas;
+      ASSERT_NE(keyframe, nullptr);
+      ASSERT_EQ(received->GetKeyframe(), keyframe->GetFrame());
+      ASSERT_LT(received->size(), actors.size());
+      // Deltas only apply to their keyframe.
+      ASSERT_TRUE(EpisodeStateSerializer::ApplyDelta(*received, *received).empty());
+      auto decoded = Deserialize(EpisodeStateSerializer::ApplyDelta(*keyframe, *received));
+      ASSERT_FALSE(decoded->IsDeltaFrame());
+      ASSERT_EQ(decoded->GetFrame(), frame);
+      check(actors, *decoded);
+    } else {
+      keyframe = received;
+      check(actors, *received);
+    }
+  }
+  ASSERT_GT(number_of_deltas, 0u);
+  carla::logging::log(
+      "episode state: sent", sent_bytes, "bytes instead of", full_bytes,
+      "with", number_of_deltas, "delta frames.");
+}
+
+TEST(episode_state, delta_frames_are_lossless) {
+  EpisodeStateDeltaSettings settings;
+  settings.keyframe_interval = 8u;
+  test_delta_frames(settings, [](const auto &expected, const RawEpisodeState &result) {
+    ASSERT_EQ(result.GetEpisodeId(), 1u);
+    ASSERT_EQ(result.GetSimulationState(), EpisodeStateSerializer::SimulationState::None);
+    ASSERT_EQ(result.size(), expected.size());
+    std::unordered_map<ActorId, const ActorDynamicState *> actors;
+    for (const auto &actor : result) {
+      actors.emplace(actor.id, &actor);
+    }
+    for (const auto &actor : expected) {
+      auto it = actors.find(actor.id);
+      ASSERT_NE(it, actors.end());
+      ASSERT_EQ(std::memcmp(it->second, &actor, sizeof(ActorDynamicState)), 0);
+    }
+  });
+}
+
+TEST(episode_state, delta_frames_within_epsilon) {
+  EpisodeStateDeltaSettings settings;
+  settings.keyframe_interval = 8u;
+  settings.location_epsilon = 0.2f;
+  settings.velocity_epsilon = 0.2f;
+  test_delta_frames(settings, [&](const auto &expected, const RawEpisodeState &result) {
+    ASSERT_EQ(result.size(), expected.size());
+    std::unordered_map<ActorId, const ActorDynamicState *> actors;
+    for (const auto &actor : result) {
+      actors.emplace(actor.id, &actor);
+    }
+    for (const auto &actor : expected) {
+      auto it = actors.find(actor.id);
+      ASSERT_NE(it, actors.end());
+      const ActorDynamicState received = *it->second;
+      ASSERT_NEAR(received.transform.location.x, actor.transform.location.x, settings.location_epsilon);
+      ASSERT_NEAR(received.velocity.z, actor.velocity.z, settings.velocity_epsilon);
+    }
+  });
+}
+
+TEST(benchmark_episode_state, construct_and_look_up) {
+  constexpr size_t number_of_actors = 5000u;
+  constexpr size_t rounds = 200u;
+  auto raw_state = MakeRawEpisodeState(number_of_actors, 10u);
+
+  // Previous implementation, a copy of every actor into a hash map.
+  carla::StopWatch copy_watch;
+  for (auto i = 0u; i < rounds; ++i) {
+    std::unordered_map<ActorId, ActorSnapshot> actors;
+    actors.reserve(raw_state->size());
+    for (auto &&actor : *raw_state) {
+      actors.emplace(actor.id, ActorSnapshot{
+          actor.id, actor.actor_state, actor.transform, actor.velocity,
+          actor.angular_velocity, actor.acceleration, actor.state});
+    }
+    ASSERT_EQ(actors.size(), number_of_actors);
+  }
+  copy_watch.Stop();
+
+  carla::StopWatch construct_watch;
+  for (auto i = 0u; i < rounds; ++i) {
+    const EpisodeState state(raw_state);
+    ASSERT_EQ(state.size(), number_of_actors);
+  }
+  construct_watch.Stop();
+
+  carla::StopWatch index_watch;
+  for (auto i = 0u; i < rounds; ++i) {
+    const EpisodeState state(raw_state);
+    ASSERT_TRUE(state.ContainsActorSnapshot(100u));
+  }
+  index_watch.Stop();
+
+  const EpisodeState state(raw_state);
+  carla::StopWatch look_up_watch;
+  for (auto i = 0u; i < rounds; ++i) {
+    for (ActorId id = 100u; id < 100u + number_of_actors; ++id) {
+      ASSERT_TRUE(state.GetActorSnapshotIfPresent(id).has_value());
+    }
+  }
+  look_up_watch.Stop();
+
+  const auto per_round = [](const carla::StopWatch &watch) {
+    return static_cast<double>(watch.GetElapsedTime()) / static_cast<double>(rounds);
+  };
+  carla::logging::log(
+      number_of_actors, "actors: state built in", per_round(construct_watch),
+      "ms, with the index built on first look-up in", per_round(index_watch),
+      "ms, copying to a hash map in", per_round(copy_watch), "ms.");
+  carla::logging::log(
+      number_of_actors, "look-ups in", per_round(look_up_watch), "ms.");
+}
@@ -6,11 +6,15 @@
 
 #include "test.h"
 
+#include <carla/StopWatch.h>
+#include <carla/image/ColorConverterKernels.h>
 #include <carla/image/ImageConverter.h>
 #include <carla/image/ImageIO.h>
 #include <carla/image/ImageView.h>
 
 #include <memory>
+#include <random>
+#include <vector>
 
 template <typename ViewT, typename PixelT>
 struct TestImage {
@@ -186,3 +190,149 @@ TEST(image, semantic_segmentation) {
     }
   }
 }
+
+using carla::image::ColorConverterKernels;
+
+/// BGRA8 image with @a padding bytes at the end of each row.
+struct PaddedImage {
+  PaddedImage(size_t width, size_t height, size_t padding)
+    : row_size(sizeof(boost::gil::bgra8_pixel_t) * width + padding),
+      data(row_size * height),
+      view(boost::gil::interleaved_view(
+          width,
+          height,
+          reinterpret_cast<boost::gil::bgra8_pixel_t *>(data.data()),
+          static_cast<std::ptrdiff_t>(row_size))) {}
+
+  size_t row_size;
+  std::vector<uint8_t> data;
+  boost::gil::bgra8_view_t view;
+};
+
+static PaddedImage MakeRandomImage(size_t width, size_t height, size_t padding) {
+  PaddedImage image(width, height, padding);
+  std::mt19937 engine(42u);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  for (auto &byte : image.data) {
+    byte = static_cast<uint8_t>(distribution(engine));
+  }
+  // Make sure the extremes of the depth range are covered.
+  const size_t count = std::min<size_t>(width, 9u);
+  std::fill_n(image.view.row_begin(0), count, boost::gil::bgra8_pixel_t(0u, 0u, 0u, 0u));
+  std::fill_n(image.view.row_end(height - 1u) - count, count, boost::gil::bgra8_pixel_t(255u, 255u, 255u, 255u));
+  return image;
+}
+
+static std::vector<ColorConverterKernels::InstructionSet> GetSupportedInstructionSets() {
+  using InstructionSet = ColorConverterKernels::InstructionSet;
+  // Each instruction set implies the ones before it.
+  std::vector<InstructionSet> result;
+  for (auto instructions : {InstructionSet::Scalar, InstructionSet::SSE41, InstructionSet::AVX2}) {
+    if (instructions <= ColorConverterKernels::GetSupportedInstructionSet()) {
+      result.emplace_back(instructions);
+    }
+  }
+  return result;
+}
+
+static const char *ToString(ColorConverterKernels::InstructionSet instructions) {
+  using InstructionSet = ColorConverterKernels::InstructionSet;
+  switch (instructions) {
+    case InstructionSet::AVX2:  return "AVX2";
+    case InstructionSet::SSE41: return "SSE4.1";
+    default:                    return "scalar";
+  }
+}
+
+template <typename CC>
+static void ConvertWithGil(boost::gil::bgra8_view_t &view) {
+  using namespace carla::image;
+  using ViewT = boost::gil::bgra8_view_t;
+  ImageConverter::CopyPixels(
+      ImageView::MakeColorConvertedView<ViewT, boost::gil::bgra8_pixel_t>(view, CC()),
+      view);
+}
+
+template <typename CC>
+static void CheckKernels(ColorConverterKernels::Conversion conversion, size_t width, size_t height) {
+  constexpr size_t padding = 12u;
+  auto expected = MakeRandomImage(width, height, padding);
+  const auto source = expected.data;
+  ConvertWithGil<CC>(expected.view);
+  for (auto instructions : GetSupportedInstructionSets()) {
+    auto result = MakeRandomImage(width, height, padding);
+    ASSERT_EQ(result.data, source);
+    ColorConverterKernels::ConvertInPlace(
+        conversion,
+        result.data.data(),
+        width,
+        height,
+        static_cast<std::ptrdiff_t>(result.row_size),
+        instructions);
+    for (auto y = 0u; y < height; ++y) {
+      for (auto x = 0u; x < width; ++x) {
+        ASSERT_EQ(result.view(x, y), expected.view(x, y))
+            << ToString(instructions) << " at XY(" << x << "," << y << ")";
+      }
+    }
+  }
+}
+
+TEST(image, color_converter_kernels) {
+  using namespace carla::image;
+  using Conversion = ColorConverterKernels::Conversion;
+  // Odd widths leave a scalar tail, the large image is converted in stripes.
+  for (auto size : {std::make_pair(37u, 5u), std::make_pair(1027u, 769u)}) {
+    CheckKernels<ColorConverter::Depth>(Conversion::Depth, size.first, size.second);
+    CheckKernels<ColorConverter::LogarithmicDepth>(Conversion::LogarithmicDepth, size.first, size.second);
+    CheckKernels<ColorConverter::CityScapesPalette>(Conversion::CityScapesPalette, size.first, size.second);
+  }
+}
+
+/// Average milliseconds taken by @a convert, always starting from @a source.
+template <typename F>
+static double TimeConversion(PaddedImage &image, const std::vector<uint8_t> &source, F &&convert) {
+  constexpr size_t rounds = 10u;
+  size_t microseconds = 0u;
+  for (auto i = 0u; i < rounds; ++i) {
+    std::copy(source.begin(), source.end(), image.data.begin());
+    carla::StopWatch watch;
+    convert();
+    watch.Stop();
+    microseconds += watch.GetElapsedTime<std::chrono::microseconds>();
+  }
+  return 1e-3 * static_cast<double>(microseconds) / static_cast<double>(rounds);
+}
+
+template <typename CC>
+static void BenchmarkKernels(ColorConverterKernels::Conversion conversion, const char *name) {
+  for (auto size : {std::make_pair(1920u, 1080u), std::make_pair(3840u, 2160u)}) {
+    auto image = MakeRandomImage(size.first, size.second, 0u);
+    const auto source = image.data;
+    carla::logging::log(
+        name, size.first, "x", size.second, ": Boost.GIL",
+        TimeConversion(image, source, [&]() { ConvertWithGil<CC>(image.view); }), "ms");
+    for (auto instructions : GetSupportedInstructionSets()) {
+      const auto convert = [&]() {
+        ColorConverterKernels::ConvertInPlace(
+            conversion,
+            image.data.data(),
+            size.first,
+            size.second,
+            static_cast<std::ptrdiff_t>(image.row_size),
+            instructions);
+      };
+      carla::logging::log(
+          name, size.first, "x", size.second, ":", ToString(instructions),
+          TimeConversion(image, source, convert), "ms");
+    }
+  }
+}
+
+TEST(benchmark_image, color_converter_kernels) {
+  using namespace carla::image;
+  using Conversion = ColorConverterKernels::Conversion;
+  BenchmarkKernels<ColorConverter::Depth>(Conversion::Depth, "Depth");
+  BenchmarkKernels<ColorConverter::LogarithmicDepth>(Conversion::LogarithmicDepth, "LogarithmicDepth");
+  BenchmarkKernels<ColorConverter::CityScapesPalette>(Conversion::CityScapesPalette, "CityScapesPalette");
+}
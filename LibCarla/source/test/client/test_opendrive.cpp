@@ -14,6 +14,7 @@
 #include <carla/geom/Math.h>
 #include <carla/opendrive/OpenDriveParser.h>
 #include <carla/road/MapBuilder.h>
+#include <carla/road/MapSerializer.h>
 #include <carla/road/element/RoadInfoElevation.h>
 #include <carla/road/element/RoadInfoGeometry.h>
 #include <carla/road/element/RoadInfoMarkRecord.h>
@@ -424,3 +425,157 @@ TEST(road, get_waypoint) {
     result.get();
   }
 }
+
+TEST(road, get_next_batch) {
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    carla::logging::log("Parsing", file);
+    auto m = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(m.has_value());
+    auto &map = *m;
+    auto waypoints = map.GenerateWaypoints(2.0);
+    std::vector<double> distances;
+    distances.reserve(waypoints.size());
+    for (auto i = 0u; i < waypoints.size(); ++i) {
+      distances.emplace_back(Random::Uniform(0.0001, 150.0));
+    }
+    Map::WaypointBatch next;
+    Map::WaypointBatch previous;
+    map.GetNext(waypoints, distances, next);
+    map.GetPrevious(waypoints, distances, previous);
+    ASSERT_EQ(next.offsets.size(), waypoints.size() + 1u);
+    ASSERT_EQ(next.offsets.back(), next.waypoints.size());
+    ASSERT_EQ(previous.offsets.size(), waypoints.size() + 1u);
+    ASSERT_EQ(previous.offsets.back(), previous.waypoints.size());
+    for (auto i = 0u; i < waypoints.size(); ++i) {
+      auto expected_next = map.GetNext(waypoints[i], distances[i]);
+      ASSERT_EQ(next.offsets[i + 1u] - next.offsets[i], expected_next.size());
+      for (auto j = 0u; j < expected_next.size(); ++j) {
+        const auto &wp = next.waypoints[next.offsets[i] + j];
+        ASSERT_EQ(wp, expected_next[j]);
+        ASSERT_EQ(wp.s, expected_next[j].s);
+      }
+      auto expected_previous = map.GetPrevious(waypoints[i], distances[i]);
+      ASSERT_EQ(previous.offsets[i + 1u] - previous.offsets[i], expected_previous.size());
+      for (auto j = 0u; j < expected_previous.size(); ++j) {
+        const auto &wp = previous.waypoints[previous.offsets[i] + j];
+        ASSERT_EQ(wp, expected_previous[j]);
+        ASSERT_EQ(wp.s, expected_previous[j].s);
+      }
+    }
+  }
+}
+
+TEST(road, get_waypoints_batch) {
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    carla::logging::log("Parsing", file);
+    auto m = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(m.has_value());
+    auto &map = *m;
+    std::vector<Location> locations;
+    for (auto i = 0u; i < 2'000u; ++i) {
+      locations.emplace_back(Random::Location(-500.0f, 500.0f));
+    }
+    for (const bool project_to_road : {true, false}) {
+      std::vector<boost::optional<Waypoint>> serial;
+      std::vector<boost::optional<Waypoint>> parallel;
+      map.GetWaypoints(locations, serial, project_to_road, static_cast<int32_t>(Lane::LaneType::Driving), 1u);
+      map.GetWaypoints(locations, parallel, project_to_road);
+      ASSERT_EQ(serial.size(), locations.size());
+      ASSERT_EQ(parallel.size(), locations.size());
+      for (auto i = 0u; i < locations.size(); ++i) {
+        const auto expected = project_to_road ?
+            map.GetClosestWaypointOnRoad(locations[i]) :
+            map.GetWaypoint(locations[i]);
+        ASSERT_EQ(serial[i].has_value(), expected.has_value());
+        ASSERT_EQ(parallel[i].has_value(), expected.has_value());
+        if (expected.has_value()) {
+          ASSERT_EQ(*serial[i], *expected);
+          ASSERT_EQ(serial[i]->s, expected->s);
+          ASSERT_EQ(*parallel[i], *expected);
+          ASSERT_EQ(parallel[i]->s, expected->s);
+        }
+      }
+    }
+  }
+}
+
+TEST(road, spiral_lookup_table) {
+  constexpr double max_error = 1e-4;
+  const std::vector<std::pair<double, double>> curvatures = {
+      {0.0, 0.02}, {0.05, -0.05}, {-0.1, 0.0}, {0.001, 0.3}};
+  for (const auto &curvature : curvatures) {
+    const double length = 60.0;
+    const Location start(10.0f, -5.0f, 0.0f);
+    GeometrySpiral exact(0.0, length, 0.3, start, curvature.first, curvature.second);
+    GeometrySpiral interpolated(0.0, length, 0.3, start, curvature.first, curvature.second);
+    ASSERT_FALSE(interpolated.HasLookupTable());
+    ASSERT_EQ(interpolated.BuildLookupTable(max_error, 0u), 0u);
+    ASSERT_FALSE(interpolated.HasLookupTable());
+    ASSERT_GT(interpolated.BuildLookupTable(max_error, 1024u * 1024u), 0u);
+    ASSERT_TRUE(interpolated.HasLookupTable());
+    for (double s = 0.0; s <= length; s += 0.01) {
+      const auto expected = exact.PosFromDist(s);
+      const auto result = interpolated.PosFromDist(s);
+      // The locations are single precision.
+      ASSERT_LT(Math::Distance(expected.location, result.location), max_error + 1e-5);
+      ASSERT_NEAR(expected.tangent, result.tangent, 1e-9);
+    }
+    const auto middle = exact.PosFromDist(0.5 * length);
+    const auto distance = interpolated.DistanceTo(middle.location);
+    ASSERT_NEAR(distance.first, 0.5 * length, 0.01);
+    ASSERT_NEAR(distance.second, 0.0, 0.01);
+  }
+}
+
+TEST(road, serialize_map) {
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    const auto xodr = util::OpenDrive::Load(file);
+    const auto hash = MapSerializer::HashOpenDrive(xodr);
+    auto map = OpenDriveParser::Load(xodr);
+    ASSERT_TRUE(map.has_value());
+    const auto data = MapSerializer::Serialize(*map, hash);
+    ASSERT_FALSE(data.empty());
+
+    auto restored = MapSerializer::Deserialize(data.data(), data.size(), hash);
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_EQ(restored->GetMap().GetRoads().size(), map->GetMap().GetRoads().size());
+    ASSERT_EQ(restored->GetMap().GetJunctions().size(), map->GetMap().GetJunctions().size());
+    ASSERT_EQ(restored->GetSignals().size(), map->GetSignals().size());
+    ASSERT_EQ(restored->GenerateTopology().size(), map->GenerateTopology().size());
+
+    const auto waypoints = map->GenerateWaypoints(2.0);
+    ASSERT_EQ(restored->GenerateWaypoints(2.0).size(), waypoints.size());
+    for (const auto &waypoint : waypoints) {
+      const auto expected = map->ComputeTransform(waypoint);
+      const auto result = restored->ComputeTransform(waypoint);
+      ASSERT_EQ(result.location, expected.location);
+      ASSERT_EQ(result.rotation, expected.rotation);
+      ASSERT_EQ(restored->GetNext(waypoint, 5.0), map->GetNext(waypoint, 5.0));
+    }
+    for (auto i = 0u; i < 200u; ++i) {
+      const auto &waypoint = waypoints[static_cast<size_t>(
+          Random::Uniform(0.0, static_cast<double>(waypoints.size() - 1u)))];
+      auto location = map->ComputeTransform(waypoint).location;
+      location += Location(1.0f, -1.0f, 0.0f);
+      const auto expected = map->GetClosestWaypointOnRoad(location);
+      const auto result = restored->GetClosestWaypointOnRoad(location);
+      ASSERT_EQ(result.has_value(), expected.has_value());
+      if (expected.has_value()) {
+        // The restored R-tree may break ties between segments differently, the
+        // result is the same up to the resolution of the segments.
+        ASSERT_NEAR(
+            Math::Distance(location, restored->ComputeTransform(*result).location),
+            Math::Distance(location, map->ComputeTransform(*expected).location),
+            0.1);
+      }
+    }
+
+    // Reject data of other files and corrupt data.
+    ASSERT_FALSE(MapSerializer::Deserialize(data.data(), data.size(), hash + 1u));
+    ASSERT_FALSE(MapSerializer::Deserialize(data.data(), data.size() - 1u, hash));
+    ASSERT_FALSE(MapSerializer::Deserialize(data.data(), data.size() / 2u, hash));
+    auto wrong_version = data;
+    ++wrong_version[4u];
+    ASSERT_FALSE(MapSerializer::Deserialize(wrong_version.data(), wrong_version.size(), hash));
+  }
+}
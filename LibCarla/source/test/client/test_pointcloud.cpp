@@ -0,0 +1,156 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/StopWatch.h>
+#include <carla/pointcloud/PointCloudIO.h>
+#include <carla/pointcloud/PointCloudWriter.h>
+#include <carla/sensor/data/LidarData.h>
+#include <carla/sensor/data/SemanticLidarData.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace carla::pointcloud;
+using carla::sensor::data::LidarDetection;
+using carla::sensor::data::SemanticLidarDetection;
+
+static std::vector<LidarDetection> MakeLidarDetections(size_t count) {
+  std::mt19937 engine(42u);
+  std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+  std::vector<LidarDetection> result;
+  result.reserve(count);
+  for (auto i = 0u; i < count; ++i) {
+    result.emplace_back(
+        distribution(engine),
+        distribution(engine),
+        distribution(engine),
+        std::abs(distribution(engine)) / 100.0f);
+  }
+  return result;
+}
+
+static std::string MakeTemporaryPath() {
+  namespace fs = boost::filesystem;
+  return (fs::temp_directory_path() / fs::unique_path("carla-%%%%-%%%%-%%%%.ply")).string();
+}
+
+static std::string ReadFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  return buffer.str();
+}
+
+/// Split @a ply in its header lines and its body.
+static std::pair<std::vector<std::string>, std::string> ParsePly(const std::string &ply) {
+  constexpr auto end_header = "end_header\n";
+  const auto body = ply.find(end_header);
+  EXPECT_NE(body, std::string::npos);
+  std::vector<std::string> lines;
+  std::istringstream header(ply.substr(0u, body));
+  for (std::string line; std::getline(header, line);) {
+    lines.emplace_back(line);
+  }
+  return {lines, ply.substr(body + std::strlen(end_header))};
+}
+
+template <typename PointT>
+static std::string AsBytes(const std::vector<PointT> &points) {
+  return {reinterpret_cast<const char *>(points.data()), sizeof(PointT) * points.size()};
+}
+
+TEST(pointcloud, binary_dump) {
+  const auto lidar = MakeLidarDetections(1000u);
+  std::ostringstream lidar_out;
+  PointCloudIO::Dump(lidar_out, lidar.begin(), lidar.end(), PointCloudIO::Format::BinaryLittleEndian);
+  auto ply = ParsePly(lidar_out.str());
+  ASSERT_GE(ply.first.size(), 3u);
+  ASSERT_EQ(ply.first[1u], "format binary_little_endian 1.0");
+  ASSERT_EQ(ply.first[2u], "element vertex 1000");
+  ASSERT_EQ(ply.second, AsBytes(lidar));
+
+  std::vector<SemanticLidarDetection> semantic;
+  for (auto i = 0u; i < 10u; ++i) {
+    const auto x = static_cast<float>(i);
+    semantic.emplace_back(x, 2.0f * x, 3.0f * x, 0.5f, i, 2u * i);
+  }
+  std::ostringstream semantic_out;
+  PointCloudIO::Dump(semantic_out, semantic.data(), semantic.data() + semantic.size(), PointCloudIO::Format::BinaryLittleEndian);
+  ply = ParsePly(semantic_out.str());
+  ASSERT_EQ(ply.first[2u], "element vertex 10");
+  ASSERT_EQ(ply.first.back(), "property uint32 ObjTag");
+  ASSERT_EQ(ply.second, AsBytes(semantic));
+}
+
+TEST(pointcloud, writer_appends_sweeps) {
+  const auto path = MakeTemporaryPath();
+  const auto sweep = MakeLidarDetections(100u);
+  {
+    PointCloudWriter writer(path);
+    for (auto i = 0u; i < 3u; ++i) {
+      writer.Write(sweep.data(), sweep.data() + sweep.size());
+      // The file must be valid after every sweep.
+      writer.Flush();
+      const auto ply = ParsePly(ReadFile(path));
+      std::istringstream vertex_line(ply.first[2u]);
+      std::string element, vertex;
+      size_t count;
+      vertex_line >> element >> vertex >> count;
+      ASSERT_EQ(count, (i + 1u) * sweep.size());
+      ASSERT_EQ(ply.second.size(), count * sizeof(LidarDetection));
+    }
+    const std::vector<SemanticLidarDetection> semantic(1u);
+    ASSERT_THROW(writer.Write(semantic.begin(), semantic.end()), std::invalid_argument);
+    ASSERT_EQ(writer.GetPointCount(), 3u * sweep.size());
+  }
+  const auto ply = ParsePly(ReadFile(path));
+  ASSERT_EQ(ply.second, AsBytes(sweep) + AsBytes(sweep) + AsBytes(sweep));
+  boost::filesystem::remove(path);
+}
+
+TEST(benchmark_pointcloud, save_to_disk) {
+  // About one second of a 64 channels lidar.
+  constexpr size_t number_of_points = 1300000u;
+  constexpr size_t sweeps = 10u;
+  const auto points = MakeLidarDetections(number_of_points);
+  const auto path = MakeTemporaryPath();
+  const auto log = [&](const char *name, const carla::StopWatch &watch) {
+    const auto seconds = 1e-3 * static_cast<double>(watch.GetElapsedTime());
+    carla::logging::log(
+        name, ":", static_cast<double>(number_of_points) / seconds, "points/s,",
+        boost::filesystem::file_size(path), "bytes.");
+  };
+
+  carla::StopWatch ascii_watch;
+  PointCloudIO::SaveToDisk(path, points.begin(), points.end(), PointCloudIO::Format::Ascii);
+  ascii_watch.Stop();
+  log("ASCII", ascii_watch);
+
+  carla::StopWatch binary_watch;
+  PointCloudIO::SaveToDisk(path, points.begin(), points.end(), PointCloudIO::Format::BinaryLittleEndian);
+  binary_watch.Stop();
+  log("binary", binary_watch);
+
+  {
+    const size_t sweep_size = number_of_points / sweeps;
+    PointCloudWriter writer(path);
+    carla::StopWatch writer_watch;
+    for (auto i = 0u; i < sweeps; ++i) {
+      writer.Write(points.data() + i * sweep_size, points.data() + (i + 1u) * sweep_size);
+    }
+    writer.Flush();
+    writer_watch.Stop();
+    log("writer", writer_watch);
+  }
+  boost::filesystem::remove(path);
+}
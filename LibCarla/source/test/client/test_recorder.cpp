@@ -0,0 +1,328 @@
+// Copyright (c) 2024 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/recorder/RecorderFile.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using carla::recorder::PacketId;
+using carla::recorder::PacketMask;
+using carla::recorder::RecorderFile;
+
+namespace fs = boost::filesystem;
+
+/// Writes recordings in the format of the recorder of the simulator.
+class RecordingBuilder {
+public:
+
+  RecordingBuilder() {
+    Write<uint16_t>(1u);
+    WriteString("CARLA_RECORDER");
+    Write<int64_t>(1700000000);
+    WriteString("Town10HD");
+  }
+
+  void BeginFrame(double delta_seconds) {
+    ++_frame_id;
+    if (_frame_id > 1u) {
+      _elapsed += delta_seconds;
+    }
+    BeginPacket(PacketId::FrameStart);
+    Write<uint64_t>(_frame_id);
+    const size_t duration_offset = _data.size();
+    Write<double>(-1.0);
+    Write<double>(_elapsed);
+    EndPacket();
+    if (_previous_duration_offset > 0u) {
+      std::memcpy(_data.data() + _previous_duration_offset, &delta_seconds, sizeof(double));
+    }
+    _previous_duration_offset = duration_offset;
+  }
+
+  void EndFrame() {
+    BeginPacket(PacketId::FrameEnd);
+    EndPacket();
+  }
+
+  void AddActor(uint32_t id, uint8_t type, const std::string &type_id) {
+    BeginPacket(PacketId::EventAdd);
+    Write<uint16_t>(1u);
+    Write<uint32_t>(id);
+    Write<uint8_t>(type);
+    for (auto i = 0u; i < 6u; ++i) {
+      Write<float>(0.0f);
+    }
+    Write<uint32_t>(0u);
+    WriteString(type_id);
+    Write<uint16_t>(1u);
+    Write<uint8_t>(0u);
+    WriteString("role_name");
+    WriteString("autopilot");
+    EndPacket();
+  }
+
+  void Collision(uint32_t id1, uint32_t id2, bool hero1 = false) {
+    BeginPacket(PacketId::Collision);
+    Write<uint16_t>(1u);
+    Write<uint32_t>(_collision_id++);
+    Write<uint32_t>(id1);
+    Write<uint32_t>(id2);
+    Write<bool>(hero1);
+    Write<bool>(false);
+    EndPacket();
+  }
+
+  void EmptyCollisions() {
+    BeginPacket(PacketId::Collision);
+    Write<uint16_t>(0u);
+    EndPacket();
+  }
+
+  void Position(uint32_t id, float x) {
+    BeginPacket(PacketId::Position);
+    Write<uint16_t>(1u);
+    Write<uint32_t>(id);
+    Write<float>(x);
+    for (auto i = 0u; i < 5u; ++i) {
+      Write<float>(0.0f);
+    }
+    EndPacket();
+  }
+
+  std::string Save() const {
+    const auto path = (fs::temp_directory_path() / fs::unique_path("carla-%%%%-%%%%-%%%%.log")).string();
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(_data.data()), static_cast<std::streamsize>(_data.size()));
+    return path;
+  }
+
+  size_t GetSize() const {
+    return _data.size();
+  }
+
+private:
+
+  template <typename T>
+  void Write(const T &value) {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+    _data.insert(_data.end(), bytes, bytes + sizeof(T));
+  }
+
+  void WriteString(const std::string &str) {
+    Write<uint16_t>(static_cast<uint16_t>(str.size()));
+    _data.insert(_data.end(), str.begin(), str.end());
+  }
+
+  void BeginPacket(PacketId id) {
+    Write<uint8_t>(static_cast<uint8_t>(id));
+    _packet_size_offset = _data.size();
+    Write<uint32_t>(0u);
+  }
+
+  void EndPacket() {
+    const auto size = static_cast<uint32_t>(_data.size() - _packet_size_offset - sizeof(uint32_t));
+    std::memcpy(_data.data() + _packet_size_offset, &size, sizeof(size));
+  }
+
+  std::vector<uint8_t> _data;
+
+  size_t _packet_size_offset = 0u;
+
+  size_t _previous_duration_offset = 0u;
+
+  uint64_t _frame_id = 0u;
+
+  double _elapsed = 0.0;
+
+  uint32_t _collision_id = 0u;
+};
+
+static void Remove(const std::string &path) {
+  fs::remove(path);
+  fs::remove(RecorderFile::GetIndexFilePath(path));
+}
+
+TEST(recorder, info_and_seek) {
+  RecordingBuilder builder;
+  for (auto i = 0u; i < 100u; ++i) {
+    builder.BeginFrame(0.05);
+    builder.EmptyCollisions();
+    builder.EndFrame();
+  }
+  const auto path = builder.Save();
+  {
+    RecorderFile file(path);
+    ASSERT_EQ(file.GetInfo().version, 1u);
+    ASSERT_EQ(file.GetInfo().map_file, "Town10HD");
+    ASSERT_EQ(file.GetFrames().size(), 100u);
+    ASSERT_NEAR(file.GetDuration(), 99 * 0.05, 1e-9);
+    ASSERT_NEAR(file.GetFrames().front().duration, 0.05, 1e-9);
+    ASSERT_EQ(file.GetFrames().back().duration, 0.0);
+    // empty collision packets are not flagged
+    ASSERT_EQ(file.GetFrames().front().packets, 0u);
+
+    const size_t index = file.FindFrameByTime(2.49);
+    ASSERT_EQ(index, 50u);
+    ASSERT_EQ(file.GetFrames()[index].id, 51u);
+    ASSERT_EQ(file.FindFrameByTime(100.0), file.GetFrames().size());
+    ASSERT_EQ(file.FindFrameById(42u), 41u);
+    ASSERT_EQ(file.FindFrameById(1000u), file.GetFrames().size());
+  }
+  Remove(path);
+}
+
+TEST(recorder, index_file) {
+  RecordingBuilder builder;
+  for (auto i = 0u; i < 20u; ++i) {
+    builder.BeginFrame(0.1);
+    builder.Position(1u, static_cast<float>(i));
+    builder.EndFrame();
+  }
+  const auto path = builder.Save();
+  {
+    RecorderFile file(path);
+    ASSERT_FALSE(file.IsIndexFromFile());
+    ASSERT_TRUE(file.WriteIndexFile());
+  }
+  {
+    RecorderFile file(path);
+    ASSERT_TRUE(file.IsIndexFromFile());
+    ASSERT_EQ(file.GetFrames().size(), 20u);
+    ASSERT_EQ(file.GetFrames()[5].packets, PacketMask(PacketId::Position));
+  }
+  {
+    RecorderFile file(path, false);
+    ASSERT_FALSE(file.IsIndexFromFile());
+  }
+  // A new recording with the same name invalidates the index.
+  builder.BeginFrame(0.1);
+  builder.EndFrame();
+  fs::rename(builder.Save(), path);
+  {
+    RecorderFile file(path);
+    ASSERT_FALSE(file.IsIndexFromFile());
+    ASSERT_EQ(file.GetFrames().size(), 21u);
+  }
+  Remove(path);
+}
+
+TEST(recorder, truncated_recording) {
+  RecordingBuilder builder;
+  for (auto i = 0u; i < 10u; ++i) {
+    builder.BeginFrame(0.1);
+    builder.Position(1u, 0.0f);
+    builder.EndFrame();
+  }
+  const auto full_size = builder.GetSize();
+  builder.BeginFrame(0.1);
+  builder.Position(1u, 0.0f);
+  const auto path = builder.Save();
+  fs::resize_file(path, full_size + 20u);
+  {
+    RecorderFile file(path);
+    ASSERT_EQ(file.GetFrames().size(), 10u);
+    size_t count = 0u;
+    file.ForEachPacket(0u, 100u, PacketMask(PacketId::Position),
+        [&](const carla::recorder::RecorderFrame &, PacketId id, const uint8_t *, uint32_t size) {
+      ASSERT_EQ(id, PacketId::Position);
+      ASSERT_EQ(size, 2u + 28u);
+      ++count;
+    });
+    ASSERT_EQ(count, 10u);
+  }
+  Remove(path);
+}
+
+TEST(recorder, not_a_recording) {
+  const auto path = (fs::temp_directory_path() / fs::unique_path("carla-%%%%-%%%%-%%%%.log")).string();
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "this is not a recording";
+  }
+  ASSERT_THROW(RecorderFile file(path), std::runtime_error);
+  ASSERT_THROW(RecorderFile file(path + ".missing"), std::runtime_error);
+  Remove(path);
+}
+
+TEST(recorder, collisions) {
+  RecordingBuilder builder;
+  builder.BeginFrame(0.1);
+  builder.AddActor(1u, 1u, "vehicle.tesla.model3");
+  builder.AddActor(2u, 2u, "walker.pedestrian.0001");
+  builder.AddActor(3u, 1u, "vehicle.audi.tt");
+  builder.EndFrame();
+  for (auto i = 2u; i <= 30u; ++i) {
+    builder.BeginFrame(0.1);
+    // a collision lasting three frames, and the same pair again later
+    if ((i >= 10u && i <= 12u) || i == 20u) {
+      builder.Collision(1u, 2u);
+    } else if (i == 25u) {
+      builder.Collision(3u, 1u, true);
+    } else {
+      builder.EmptyCollisions();
+    }
+    builder.EndFrame();
+  }
+  const auto path = builder.Save();
+  {
+    RecorderFile file(path);
+    ASSERT_EQ(file.GetActors().size(), 3u);
+    ASSERT_EQ(file.GetActors()[1].type_id, "walker.pedestrian.0001");
+
+    auto all = file.QueryCollisions('a', 'a');
+    ASSERT_EQ(all.size(), 3u);
+    ASSERT_EQ(all[0].frame, 10u);
+    ASSERT_EQ(all[0].category1, 'v');
+    ASSERT_EQ(all[0].category2, 'w');
+    ASSERT_EQ(all[0].type_id2, "walker.pedestrian.0001");
+    ASSERT_EQ(all[1].frame, 20u);
+    ASSERT_EQ(all[2].frame, 25u);
+
+    ASSERT_EQ(file.QueryCollisions('v', 'w').size(), 2u);
+    ASSERT_EQ(file.QueryCollisions('w', 'v').size(), 0u);
+    auto hero = file.QueryCollisions('h', 'v');
+    ASSERT_EQ(hero.size(), 1u);
+    ASSERT_EQ(hero[0].actor1, 3u);
+  }
+  Remove(path);
+}
+
+TEST(recorder, blocked_actors) {
+  RecordingBuilder builder;
+  builder.BeginFrame(1.0);
+  builder.AddActor(1u, 1u, "vehicle.tesla.model3");
+  builder.AddActor(2u, 1u, "vehicle.audi.tt");
+  builder.EndFrame();
+  for (auto i = 0u; i < 100u; ++i) {
+    builder.BeginFrame(1.0);
+    // actor 1 stops for 30 seconds, actor 2 stops at the end of the recording
+    const float x1 = (i >= 20u && i < 50u) ? 20000.0f : 1000.0f * static_cast<float>(i);
+    const float x2 = (i < 40u) ? 1000.0f * static_cast<float>(i) : 40000.0f;
+    builder.Position(1u, x1);
+    builder.Position(2u, x2);
+    builder.EndFrame();
+  }
+  const auto path = builder.Save();
+  {
+    RecorderFile file(path);
+    auto blocked = file.QueryBlocked(20.0, 100.0);
+    ASSERT_EQ(blocked.size(), 2u);
+    ASSERT_EQ(blocked[0].id, 2u);
+    ASSERT_EQ(blocked[1].id, 1u);
+    ASSERT_EQ(blocked[1].type_id, "vehicle.tesla.model3");
+    ASSERT_GE(blocked[1].duration, 28.0);
+    ASSERT_LE(blocked[1].duration, 30.0);
+    ASSERT_GT(blocked[0].duration, blocked[1].duration);
+    ASSERT_TRUE(file.QueryBlocked(100.0, 100.0).empty());
+  }
+  Remove(path);
+}
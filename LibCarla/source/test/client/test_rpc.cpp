@@ -7,12 +7,15 @@
 #include "test.h"
 
 #include <carla/MsgPackAdaptors.h>
+#include <carla/StopWatch.h>
 #include <carla/ThreadGroup.h>
 #include <carla/rpc/Actor.h>
 #include <carla/rpc/Client.h>
+#include <carla/rpc/MultiCall.h>
 #include <carla/rpc/Response.h>
 #include <carla/rpc/Server.h>
 
+#include <future>
 #include <thread>
 
 using namespace carla::rpc;
@@ -62,3 +65,102 @@ TEST(rpc, server_bind_sync_run_on_game_thread) {
   std::cout << "game thread: run " << i << " slices.\n";
   ASSERT_TRUE(done);
 }
+
+/// Run the game thread of @a server until @a done.
+static void run_game_thread(Server &server, const std::atomic_bool &done) {
+  for (auto i = 0u; (i < 1'000'000u) && !done; ++i) {
+    server.SyncRunFor(2ms);
+  }
+}
+
+TEST(rpc, multi_call) {
+  const uint16_t port = (TESTING_PORT != 0u ? TESTING_PORT : 2017u);
+
+  Server server(port);
+  const auto main_thread_id = std::this_thread::get_id();
+  server.BindSync("add", [=](int x, int y) -> Response<int> {
+    EXPECT_EQ(std::this_thread::get_id(), main_thread_id);
+    return x + y;
+  });
+  server.BindAsync("concat", [](std::string a, const std::string &b) -> Response<std::string> {
+    return a + b;
+  });
+  server.AsyncRun(1u);
+
+  std::atomic_bool done{false};
+
+  carla::ThreadGroup threads;
+  threads.CreateThread([&]() {
+    Client client("localhost", port);
+    std::vector<CallRequest> calls;
+    calls.emplace_back("add", 1, 2);
+    calls.emplace_back("concat", std::string("a"), std::string("b"));
+    calls.emplace_back("not_bound", 3);
+    calls.emplace_back("add", std::string("wrong arguments"));
+    const auto results = client.call(CallRequest::GetMultiCallFunctionName(), calls).as<std::vector<CallResult>>();
+    EXPECT_EQ(results.size(), calls.size());
+    if (results.size() == calls.size()) {
+      EXPECT_EQ(results[0u].As<Response<int>>().Get(), 3);
+      EXPECT_EQ(results[1u].As<Response<std::string>>().Get(), "ab");
+      EXPECT_TRUE(results[2u].HasError());
+      EXPECT_TRUE(results[3u].HasError());
+    }
+    done = true;
+  });
+
+  run_game_thread(server, done);
+  ASSERT_TRUE(done);
+}
+
+TEST(benchmark_rpc, call_latency) {
+  constexpr int number_of_calls = 200;
+  const uint16_t port = (TESTING_PORT != 0u ? TESTING_PORT : 2017u);
+
+  Server server(port);
+  server.BindSync("get_value", [](int x) -> Response<int> { return x; });
+  server.AsyncRun(2u);
+
+  std::atomic_bool done{false};
+
+  carla::ThreadGroup threads;
+  threads.CreateThread([&]() {
+    Client client("localhost", port);
+
+    carla::StopWatch sequential;
+    for (auto i = 0; i < number_of_calls; ++i) {
+      EXPECT_EQ(client.call("get_value", i).as<Response<int>>().Get(), i);
+    }
+    sequential.Stop();
+
+    carla::StopWatch pipelined;
+    std::vector<std::future<clmdep_msgpack::object_handle>> futures;
+    for (auto i = 0; i < number_of_calls; ++i) {
+      futures.emplace_back(client.async_call_with_response("get_value", i));
+    }
+    for (auto i = 0u; i < futures.size(); ++i) {
+      EXPECT_EQ(futures[i].get().as<Response<int>>().Get(), static_cast<int>(i));
+    }
+    pipelined.Stop();
+
+    carla::StopWatch multi_call;
+    std::vector<CallRequest> calls;
+    for (auto i = 0; i < number_of_calls; ++i) {
+      calls.emplace_back("get_value", i);
+    }
+    const auto results = client.call(CallRequest::GetMultiCallFunctionName(), calls).as<std::vector<CallResult>>();
+    multi_call.Stop();
+    EXPECT_EQ(results.size(), calls.size());
+    for (auto i = 0u; i < results.size(); ++i) {
+      EXPECT_EQ(results[i].As<Response<int>>().Get(), static_cast<int>(i));
+    }
+
+    carla::logging::log(
+        number_of_calls, "calls in", sequential.GetElapsedTime(), "ms sequential,",
+        pipelined.GetElapsedTime(), "ms pipelined,",
+        multi_call.GetElapsedTime(), "ms in a single multi-call.");
+    done = true;
+  });
+
+  run_game_thread(server, done);
+  ASSERT_TRUE(done);
+}
@@ -134,3 +134,40 @@ TEST(buffer, buffer_pool) {
   // Now delete the pool to test the weak reference inside the buffers.
   pool.reset();
 }
+
+TEST(buffer, buffer_pool_size_classes) {
+  auto pool = std::make_shared<carla::BufferPool>(2u * 1024u * 1024u);
+  {
+    auto small = pool->Pop(100u);
+    auto big = pool->Pop(1000000u);
+    ASSERT_EQ(small.size(), 100u);
+    ASSERT_EQ(big.size(), 1000000u);
+  }
+  auto statistics = pool->GetStatistics();
+  ASSERT_EQ(statistics.misses, 2u);
+  ASSERT_EQ(statistics.hits, 0u);
+  ASSERT_EQ(statistics.buffers_held, 2u);
+  {
+    // Each request is served from its own size class.
+    auto big = pool->Pop(1000000u);
+    auto small = pool->Pop(200u);
+    ASSERT_EQ(big.size(), 1000000u);
+    ASSERT_EQ(small.size(), 200u);
+  }
+  statistics = pool->GetStatistics();
+  ASSERT_EQ(statistics.misses, 2u);
+  ASSERT_EQ(statistics.hits, 2u);
+  // Going over the cap releases the least recently requested buffers.
+  {
+    auto huge = pool->Pop(1500000u);
+  }
+  statistics = pool->GetStatistics();
+  ASSERT_EQ(statistics.evictions, 1u);
+  ASSERT_EQ(statistics.buffers_held, 2u);
+  ASSERT_LE(statistics.bytes_held, 2u * 1024u * 1024u);
+  ASSERT_EQ(statistics.bytes_held_high_water_mark, statistics.bytes_held);
+  pool->Trim(0u);
+  statistics = pool->GetStatistics();
+  ASSERT_EQ(statistics.bytes_held, 0u);
+  ASSERT_EQ(statistics.buffers_held, 0u);
+}
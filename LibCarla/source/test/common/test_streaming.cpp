@@ -9,13 +9,20 @@
 #include <carla/ThreadGroup.h>
 #include <carla/streaming/Client.h>
 #include <carla/streaming/Server.h>
+#include <carla/streaming/detail/DeliveryQueue.h>
 #include <carla/streaming/detail/Dispatcher.h>
+#include <carla/streaming/detail/shm/Client.h>
+#include <carla/streaming/detail/shm/SharedMemoryRing.h>
 #include <carla/streaming/detail/tcp/Client.h>
+#include <carla/streaming/detail/tcp/MultiplexedClient.h>
 #include <carla/streaming/detail/tcp/Server.h>
 #include <carla/streaming/low_level/Client.h>
 #include <carla/streaming/low_level/Server.h>
 
+#include <algorithm>
 #include <atomic>
+#include <future>
+#include <mutex>
 
 using namespace std::chrono_literals;
 
@@ -188,6 +195,72 @@ struct DoneGuard {
   std::atomic_bool &done;
 };
 
+TEST(streaming, low_level_tcp_synchronous_send_queue) {
+  using namespace carla::streaming;
+  using namespace carla::streaming::detail;
+  constexpr size_t number_of_messages = 1000u;
+
+  boost::asio::io_context io_context;
+  tcp::Server::endpoint ep(boost::asio::ip::tcp::v4(), TESTING_PORT);
+
+  tcp::Server srv(io_context, ep);
+  srv.SetTimeout(1s);
+  srv.SetSynchronousMode(true);
+  tcp::SendQueueSettings settings;
+  settings.policy = tcp::SendQueuePolicy::DropNewest;
+  settings.max_queued_messages = 2u;
+  srv.SetSendQueueSettings(settings);
+
+  std::atomic_size_t message_count{0u};
+  std::shared_ptr<tcp::ServerSession> server_session;
+  std::atomic_bool done{false};
+
+  const std::string msg = "Hola!";
+
+  srv.Listen([&](std::shared_ptr<tcp::ServerSession> session) {
+    server_session = session;
+    carla::Buffer Buf(boost::asio::buffer(msg.c_str(), msg.size()));
+    carla::SharedBufferView BufView = carla::BufferView::CreateFrom(std::move(Buf));
+    // In synchronous mode the policy is ignored and every message is sent.
+    for (auto i = 0u; i < number_of_messages; ++i) {
+      carla::SharedBufferView View = BufView;
+      session->Write(View);
+    }
+    done = true;
+  }, [](std::shared_ptr<tcp::ServerSession>) {});
+
+  Dispatcher dispatcher{make_endpoint<tcp::Client::protocol_type>(srv.GetLocalEndpoint())};
+  auto stream = dispatcher.MakeStream();
+  auto c = std::make_shared<tcp::Client>(io_context, stream.token(), [&](carla::Buffer message) {
+    ASSERT_EQ(util::buffer::as_string(message), msg);
+    ++message_count;
+  });
+  c->Connect();
+
+  carla::ThreadGroup threads;
+  threads.CreateThreads(
+      std::max(2u, std::thread::hardware_concurrency()),
+      [&]() { io_context.run(); });
+
+  auto is_finished = [&]() {
+    return done &&
+        (message_count == number_of_messages) &&
+        (server_session->GetStatistics().sent_messages == number_of_messages);
+  };
+  for (auto i = 0u; (i < 500u) && !is_finished(); ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  io_context.stop();
+  ASSERT_TRUE(done);
+  ASSERT_EQ(message_count, number_of_messages);
+  const auto statistics = server_session->GetStatistics();
+  ASSERT_EQ(statistics.sent_messages, number_of_messages);
+  ASSERT_EQ(statistics.dropped_messages, 0u);
+  ASSERT_EQ(statistics.queued_messages, 0u);
+  ASSERT_EQ(statistics.sent_bytes, number_of_messages * (sizeof(message_size_type) + msg.size()));
+  c->Stop();
+}
+
 TEST(streaming, stream_outlives_server) {
   using namespace carla::streaming;
   using namespace util::buffer;
@@ -277,3 +350,338 @@ TEST(streaming, multi_stream) {
     }
   }
 }
+
+TEST(streaming, delivery_policies) {
+  using namespace carla::streaming;
+  using namespace util::buffer;
+  constexpr size_t number_of_messages = 10u;
+
+  for (auto policy : {DeliveryPolicy::KeepAll, DeliveryPolicy::KeepLatest, DeliveryPolicy::Coalesce}) {
+    io_context_running io;
+    std::atomic_bool release{false};
+    std::vector<std::string> received;
+    std::mutex mutex;
+    auto queue = std::make_shared<detail::DeliveryQueue>(
+        io.service,
+        DeliveryOptions{policy, 3u},
+        [&](carla::Buffer message) {
+          while (!release) {
+            std::this_thread::sleep_for(1ms);
+          }
+          std::lock_guard<std::mutex> lock(mutex);
+          received.push_back(as_string(message));
+        });
+    // The first message blocks the callback, the rest are queued by policy.
+    for (auto i = 0u; i < number_of_messages; ++i) {
+      const std::string text = std::to_string(i);
+      queue->Push(carla::Buffer(boost::asio::buffer(text)));
+      if (i == 0u) {
+        std::this_thread::sleep_for(10ms);
+      }
+    }
+    release = true;
+    std::this_thread::sleep_for(20ms);
+
+    const auto stats = queue->GetStats();
+    ASSERT_EQ(stats.received, number_of_messages);
+    ASSERT_EQ(stats.queue_depth, 0u);
+    ASSERT_EQ(stats.delivered + stats.skipped, number_of_messages);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received.size(), stats.delivered);
+    ASSERT_EQ(received.front(), "0");
+    ASSERT_EQ(received.back(), std::to_string(number_of_messages - 1u));
+    switch (policy) {
+      case DeliveryPolicy::KeepAll:
+        ASSERT_EQ(stats.skipped, 0u);
+        ASSERT_EQ(stats.max_queue_depth, number_of_messages - 1u);
+        break;
+      case DeliveryPolicy::KeepLatest:
+        ASSERT_EQ(stats.delivered, 4u);
+        ASSERT_EQ(stats.max_queue_depth, 3u);
+        break;
+      case DeliveryPolicy::Coalesce:
+        ASSERT_EQ(stats.delivered, 2u);
+        ASSERT_EQ(stats.max_queue_depth, 1u);
+        break;
+    }
+  }
+}
+
+TEST(streaming, slow_callback_does_not_block_reads) {
+  using namespace carla::streaming;
+  using namespace util::buffer;
+  constexpr size_t number_of_messages = 100u;
+  const std::string message = "Hi slow client!";
+
+  Server srv(TESTING_PORT);
+  srv.AsyncRun(2u);
+  auto stream = srv.MakeStream();
+
+  Client c;
+  c.AsyncRun(1u);
+  std::atomic_size_t callbacks{0u};
+  c.Subscribe(stream.token(), [&](auto) {
+    std::this_thread::sleep_for(20ms);
+    ++callbacks;
+  }, DeliveryOptions{DeliveryPolicy::Coalesce, 1u});
+
+  carla::Buffer Buf(boost::asio::buffer(message.c_str(), message.size()));
+  carla::SharedBufferView BufView = carla::BufferView::CreateFrom(std::move(Buf));
+  std::this_thread::sleep_for(6ms);
+  for (auto i = 0u; i < number_of_messages; ++i) {
+    std::this_thread::sleep_for(1ms);
+    carla::SharedBufferView View = BufView;
+    stream.Write(View);
+  }
+  std::this_thread::sleep_for(50ms);
+
+  const auto stats = c.GetDeliveryStats(stream.token());
+  // Every message was read even though the callback could not keep up.
+  ASSERT_GE(stats.received, number_of_messages - 3u);
+  ASSERT_GT(stats.skipped, 0u);
+  ASSERT_LE(stats.max_queue_depth, 1u);
+  ASSERT_EQ(stats.received, stats.delivered + stats.skipped + stats.queue_depth);
+  ASSERT_LT(callbacks, number_of_messages / 2u);
+  c.UnSubscribe(stream.token());
+}
+
+TEST(streaming, shared_memory_stream) {
+  using namespace carla::streaming;
+  using namespace carla::streaming::detail;
+  using namespace util::buffer;
+  constexpr size_t number_of_messages = 100u;
+
+  if (!shm::IsSupported()) {
+    return;
+  }
+
+  Server srv(TESTING_PORT);
+  srv.SetSharedMemoryTransport(true, 4096u);
+  srv.AsyncRun(2u);
+  auto stream = srv.MakeStream();
+
+  token_type token{stream.token()};
+  ASSERT_TRUE(token.has_shared_memory());
+  token.set_address(carla::streaming::make_localhost_address());
+
+  io_context_running io;
+  std::atomic_size_t message_count{0u};
+  const std::string message = "Hello shared memory!";
+
+  auto c = std::make_shared<shm::Client>(io.service, token, [&](carla::Buffer buffer) {
+    ASSERT_EQ(as_string(buffer), message);
+    ++message_count;
+  });
+  c->Connect();
+  ASSERT_TRUE(c->IsUsingSharedMemory());
+  ASSERT_TRUE(stream.AreClientsListening());
+
+  carla::Buffer Buf(boost::asio::buffer(message.c_str(), message.size()));
+  carla::SharedBufferView BufView = carla::BufferView::CreateFrom(std::move(Buf));
+  for (auto i = 0u; i < number_of_messages; ++i) {
+    std::this_thread::sleep_for(2ms);
+    carla::SharedBufferView View = BufView;
+    stream.Write(View);
+  }
+  for (auto i = 0u; (i < 100u) && (message_count < number_of_messages); ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_EQ(message_count, number_of_messages);
+  c->Stop();
+}
+
+TEST(streaming, multiplexed_streams) {
+  using namespace carla::streaming;
+  using namespace util::buffer;
+  constexpr size_t number_of_messages = 100u;
+  constexpr size_t number_of_streams = 4u;
+
+  Server srv(TESTING_PORT);
+  srv.AsyncRun(2u);
+
+  Client c;
+  c.SetMultiplexing(true);
+  c.AsyncRun(2u);
+
+  std::vector<Stream> streams;
+  std::vector<std::atomic_size_t> counts(number_of_streams);
+  for (auto i = 0u; i < number_of_streams; ++i) {
+    streams.emplace_back(srv.MakeStream());
+    counts[i] = 0u;
+    const std::string expected = "stream " + std::to_string(i);
+    DeliveryOptions options;
+    options.priority = static_cast<uint8_t>(i);
+    c.Subscribe(streams[i].token(), [&counts, i, expected](auto buffer) {
+      ASSERT_EQ(as_string(buffer), expected);
+      ++counts[i];
+    }, options);
+  }
+  for (auto i = 0u; (i < 100u) && !streams.back().AreClientsListening(); ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+
+  std::vector<std::string> messages;
+  for (auto i = 0u; i < number_of_streams; ++i) {
+    messages.emplace_back("stream " + std::to_string(i));
+  }
+  for (auto j = 0u; j < number_of_messages; ++j) {
+    std::this_thread::sleep_for(2ms);
+    for (auto i = 0u; i < number_of_streams; ++i) {
+      carla::Buffer buffer(boost::asio::buffer(messages[i].c_str(), messages[i].size()));
+      streams[i].Write(carla::BufferView::CreateFrom(std::move(buffer)));
+    }
+  }
+  auto all_received = [&]() {
+    return std::all_of(counts.begin(), counts.end(), [](const auto &count) {
+      return count >= number_of_messages - 3u;
+    });
+  };
+  for (auto i = 0u; (i < 100u) && !all_received(); ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  for (auto &count : counts) {
+    ASSERT_GE(count, number_of_messages - 3u);
+  }
+}
+
+TEST(streaming, multiplexed_priority) {
+  using namespace carla::streaming;
+  using namespace carla::streaming::detail;
+  using namespace util::buffer;
+  constexpr size_t number_of_messages = 5u;
+
+  boost::asio::io_context io_context;
+  tcp::Server srv(io_context, tcp::Server::endpoint(boost::asio::ip::tcp::v4(), TESTING_PORT));
+  srv.SetTimeout(1s);
+  tcp::SendQueueSettings settings;
+  settings.max_queued_messages = 2u * number_of_messages;
+  srv.SetSendQueueSettings(settings);
+
+  std::mutex mutex;
+  std::vector<std::shared_ptr<Session>> channels;
+  srv.EnableMultiplexing([&](std::shared_ptr<Session> channel) {
+    std::lock_guard<std::mutex> lock(mutex);
+    channels.emplace_back(channel);
+  }, [](std::shared_ptr<Session>) {});
+  srv.Listen(
+      [](std::shared_ptr<tcp::ServerSession>) { FAIL(); },
+      [](std::shared_ptr<tcp::ServerSession>) {});
+
+  Dispatcher dispatcher{make_endpoint<tcp::Client::protocol_type>(srv.GetLocalEndpoint())};
+  auto low = dispatcher.MakeStream();
+  auto high = dispatcher.MakeStream();
+
+  std::vector<std::string> received;
+  auto c = std::make_shared<tcp::MultiplexedClient>(
+      io_context,
+      token_type(low.token()).to_tcp_endpoint());
+  c->Subscribe(low.token(), 0u, [&](carla::Buffer buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    received.emplace_back(as_string(buffer));
+  });
+  c->Subscribe(high.token(), 10u, [&](carla::Buffer buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    received.emplace_back(as_string(buffer));
+  });
+
+  // A single thread, so the messages queue up while it is kept busy.
+  carla::ThreadGroup threads;
+  threads.CreateThread([&]() { io_context.run(); });
+
+  auto channel_count = [&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return channels.size();
+  };
+  for (auto i = 0u; (i < 100u) && (channel_count() < 2u); ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_EQ(channel_count(), 2u);
+  ASSERT_FALSE(c->IsFallingBack());
+
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  boost::asio::post(io_context, [released]() { released.wait(); });
+
+  const std::string low_message = "low";
+  const std::string high_message = "high";
+  for (auto &channel : channels) {
+    const auto &message =
+        channel->get_stream_id() == token_type(high.token()).get_stream_id() ?
+            high_message :
+            low_message;
+    for (auto i = 0u; i < number_of_messages; ++i) {
+      carla::Buffer buffer(boost::asio::buffer(message.c_str(), message.size()));
+      channel->Write(Session::MakeMessage(carla::BufferView::CreateFrom(std::move(buffer))));
+    }
+  }
+  release.set_value();
+
+  auto received_count = [&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return received.size();
+  };
+  for (auto i = 0u; (i < 100u) && (received_count() < 2u * number_of_messages); ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  io_context.stop();
+  ASSERT_EQ(received.size(), 2u * number_of_messages);
+  // At most one message of the first channel written was already on its way.
+  const auto first_high = std::find(received.begin(), received.end(), high_message);
+  ASSERT_LE(std::distance(received.begin(), first_high), 1);
+  ASSERT_EQ(std::count(first_high, first_high + number_of_messages, high_message), number_of_messages);
+  for (auto &channel : channels) {
+    const auto statistics = channel->GetStatistics();
+    ASSERT_EQ(statistics.sent_messages, number_of_messages);
+    ASSERT_EQ(statistics.dropped_messages, 0u);
+  }
+  c->Stop();
+}
+
+TEST(streaming, multiplexed_fallback) {
+  using namespace carla::streaming;
+  using namespace carla::streaming::detail;
+  using namespace util::buffer;
+  constexpr size_t number_of_messages = 100u;
+
+  io_context_running io;
+  tcp::Server srv(io.service, tcp::Server::endpoint(boost::asio::ip::tcp::v4(), TESTING_PORT));
+  srv.SetTimeout(1s);
+
+  // Multiplexing not enabled.
+  Dispatcher dispatcher{make_endpoint<tcp::Client::protocol_type>(srv.GetLocalEndpoint())};
+  srv.Listen([&](std::shared_ptr<tcp::ServerSession> session) {
+    if (!dispatcher.RegisterSession(session)) {
+      session->Close();
+    }
+  }, [&](std::shared_ptr<tcp::ServerSession> session) {
+    dispatcher.DeregisterSession(session);
+  });
+  auto stream = dispatcher.MakeStream();
+
+  std::atomic_size_t message_count{0u};
+  const std::string message = "Hello!";
+  auto c = std::make_shared<tcp::MultiplexedClient>(
+      io.service,
+      token_type(stream.token()).to_tcp_endpoint());
+  c->Subscribe(stream.token(), 0u, [&](carla::Buffer buffer) {
+    ASSERT_EQ(as_string(buffer), message);
+    ++message_count;
+  });
+  for (auto i = 0u; (i < 100u) && !stream.AreClientsListening(); ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_TRUE(c->IsFallingBack());
+
+  carla::Buffer Buf(boost::asio::buffer(message.c_str(), message.size()));
+  carla::SharedBufferView BufView = carla::BufferView::CreateFrom(std::move(Buf));
+  for (auto i = 0u; i < number_of_messages; ++i) {
+    std::this_thread::sleep_for(2ms);
+    carla::SharedBufferView View = BufView;
+    stream.Write(View);
+  }
+  for (auto i = 0u; (i < 100u) && (message_count < number_of_messages - 3u); ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_GE(message_count, number_of_messages - 3u);
+  c->Stop();
+}
@@ -30,13 +30,20 @@ static auto make_special_message(size_t size) {
 class Benchmark {
 public:
 
-  Benchmark(uint16_t port, size_t message_size, double success_ratio)
+  static int64_t now() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+  }
+
+  Benchmark(uint16_t port, size_t message_size, double success_ratio, bool shared_memory)
     : _server(port),
       _client(),
       _message(make_special_message(message_size)),
       _client_callback(),
       _work_to_do(_client_callback),
-      _success_ratio(success_ratio) {}
+      _success_ratio(success_ratio) {
+    _server.SetSharedMemoryTransport(shared_memory);
+  }
 
   void AddStream() {
     Stream stream = _server.MakeStream();
@@ -47,6 +54,7 @@ public:
       boost::asio::post(_client_callback, [this]() {
         CARLA_PROFILE_FPS(client, listen_callback);
         ++_number_of_messages_received;
+        _last_receive_time = now();
       });
     });
 
@@ -71,6 +79,7 @@ public:
       _threads.CreateThread([=]() mutable {
         for (auto i = 0u; i < number_of_messages; ++i) {
           std::this_thread::sleep_for(11ms); // ~90FPS.
+          _last_write_time = now();
           {
             CARLA_PROFILE_SCOPE(game, write_to_stream);
             stream.Write(_message);
@@ -96,7 +105,9 @@ public:
 
     _client_callback.stop();
     _threads.JoinAll();
-    std::cout << " done." << std::endl;
+    std::cout << " done, last message received "
+              << (_last_receive_time - _last_write_time) / 1000
+              << "us after starting the last write." << std::endl;
 
 #ifdef NDEBUG
     ASSERT_GE(_number_of_messages_received, threshold);
@@ -126,6 +137,10 @@ private:
   std::vector<Stream> _streams;
 
   std::atomic_size_t _number_of_messages_received{0u};
+
+  std::atomic<int64_t> _last_write_time{0};
+
+  std::atomic<int64_t> _last_receive_time{0};
 };
 
 static size_t get_max_concurrency() {
@@ -136,10 +151,13 @@ static size_t get_max_concurrency() {
 static void benchmark_image(
     const size_t dimensions,
     const size_t number_of_streams = 1u,
-    const double success_ratio = 1.0) {
+    const double success_ratio = 1.0,
+    const bool shared_memory = false) {
   constexpr auto number_of_messages = 100u;
-  carla::logging::log("Benchmark:", number_of_streams, "streams at 90FPS.");
-  Benchmark benchmark(TESTING_PORT, 4u * dimensions, success_ratio);
+  carla::logging::log(
+      "Benchmark:", number_of_streams, "streams at 90FPS over",
+      shared_memory ? "shared memory." : "TCP.");
+  Benchmark benchmark(TESTING_PORT, 4u * dimensions, success_ratio, shared_memory);
   benchmark.AddStreams(number_of_streams);
   benchmark.Run(number_of_messages);
 }
@@ -167,3 +185,27 @@ TEST(benchmark_streaming, image_800x600_mt) {
 TEST(benchmark_streaming, image_1920x1080_mt) {
   benchmark_image(1920u * 1080u, get_max_concurrency(), 0.9);
 }
+
+TEST(benchmark_streaming, image_200x200_shared_memory) {
+  benchmark_image(200u * 200u, 1u, 1.0, true);
+}
+
+TEST(benchmark_streaming, image_800x600_shared_memory) {
+  benchmark_image(800u * 600u, 1u, 0.9, true);
+}
+
+TEST(benchmark_streaming, image_1920x1080_shared_memory) {
+  benchmark_image(1920u * 1080u, 1u, 0.9, true);
+}
+
+TEST(benchmark_streaming, image_3840x2160_shared_memory) {
+  benchmark_image(3840u * 2160u, 1u, 0.9, true);
+}
+
+TEST(benchmark_streaming, image_200x200_mt_shared_memory) {
+  benchmark_image(200u * 200u, get_max_concurrency(), 1.0, true);
+}
+
+TEST(benchmark_streaming, image_1920x1080_mt_shared_memory) {
+  benchmark_image(1920u * 1080u, get_max_concurrency(), 0.9, true);
+}
@@ -12,6 +12,7 @@
 #include <carla/rpc/TrafficLightState.h>
 #include <carla/trafficmanager/TrafficManager.h>
 
+#include <boost/python/stl_iterator.hpp>
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 
 #include <ostream>
@@ -114,6 +115,16 @@ void export_actor() {
       .def("get_angular_velocity", &cc::Actor::GetAngularVelocity)
       .def("get_acceleration", &cc::Actor::GetAcceleration)
       .def("get_component_world_transform", &cc::Actor::GetComponentWorldTransform, (arg("component_name")))
+      .def("get_component_world_transforms", +[](const cc::Actor &self, const boost::python::list &component_names) {
+        std::vector<std::string> names{
+            boost::python::stl_input_iterator<std::string>(component_names),
+            boost::python::stl_input_iterator<std::string>()};
+        boost::python::list result;
+        for (auto &transform : self.GetComponentWorldTransforms(names)) {
+          result.append(transform);
+        }
+        return result;
+      }, (arg("component_names")))
       .def("get_component_relative_transform", &cc::Actor::GetComponentRelativeTransform, (arg("component_name")))
       .def("get_bone_world_transforms", CALL_RETURNING_LIST(cc::Actor,GetBoneWorldTransforms))
       .def("get_bone_relative_transforms", CALL_RETURNING_LIST(cc::Actor,GetBoneRelativeTransforms))
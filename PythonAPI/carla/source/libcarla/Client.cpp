@@ -9,6 +9,7 @@
 #include "carla/client/World.h"
 #include "carla/Logging.h"
 #include "carla/rpc/ActorId.h"
+#include "carla/rpc/CommandBatch.h"
 #include "carla/trafficmanager/TrafficManager.h"
 
 #include <thread>
@@ -174,6 +175,42 @@ static auto ApplyBatchCommandsSync(
   return result;
 }
 
+static std::vector<carla::rpc::CommandBatch> ToCommandBatches(const boost::python::object &batches) {
+  boost::python::extract<carla::rpc::CommandBatch> single(batches);
+  if (single.check()) {
+    return {single()};
+  }
+  return {
+    boost::python::stl_input_iterator<carla::rpc::CommandBatch>(batches),
+    boost::python::stl_input_iterator<carla::rpc::CommandBatch>()};
+}
+
+static void ApplyCommandBatch(
+    const carla::client::Client &self,
+    const boost::python::object &batches,
+    bool do_tick) {
+  auto cmds = ToCommandBatches(batches);
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.ApplyCommandBatch(std::move(cmds), do_tick);
+}
+
+static auto ApplyCommandBatchSync(
+    const carla::client::Client &self,
+    const boost::python::object &batches,
+    bool do_tick) {
+  auto cmds = ToCommandBatches(batches);
+  std::vector<uint32_t> failed;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    failed = self.ApplyCommandBatchSync(std::move(cmds), do_tick);
+  }
+  boost::python::list result;
+  for (auto index : failed) {
+    result.append(index);
+  }
+  return result;
+}
+
 void export_client() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -216,8 +253,11 @@ void export_client() {
     .def("set_replayer_time_factor", &cc::Client::SetReplayerTimeFactor, (arg("time_factor")))
     .def("set_replayer_ignore_hero", &cc::Client::SetReplayerIgnoreHero, (arg("ignore_hero")))
     .def("set_replayer_ignore_spectator", &cc::Client::SetReplayerIgnoreSpectator, (arg("ignore_spectator")))
+    .def("set_stream_multiplexing", &cc::Client::SetStreamMultiplexing, (arg("enabled")))
     .def("apply_batch", &ApplyBatchCommands, (arg("commands"), arg("do_tick")=false))
     .def("apply_batch_sync", &ApplyBatchCommandsSync, (arg("commands"), arg("do_tick")=false))
+    .def("apply_command_batch", &ApplyCommandBatch, (arg("batches"), arg("do_tick")=false))
+    .def("apply_command_batch_sync", &ApplyCommandBatchSync, (arg("batches"), arg("do_tick")=false))
     .def("get_trafficmanager", CONST_CALL_WITHOUT_GIL_1(cc::Client, GetInstanceTM, uint16_t), (arg("port")=ctm::TM_DEFAULT_PORT))
   ;
 }
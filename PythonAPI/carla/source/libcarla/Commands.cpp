@@ -6,8 +6,14 @@
 
 #include <carla/PythonUtil.h>
 #include <carla/rpc/Command.h>
+#include <carla/rpc/CommandBatch.h>
 #include <carla/rpc/CommandResponse.h>
 
+#include <boost/python/stl_iterator.hpp>
+
+#include <cstring>
+#include <memory>
+
 #define TM_DEFAULT_PORT     8000
 
 namespace command_impl {
@@ -42,6 +48,188 @@ namespace command_impl {
     return self;
   }
 
+  // ===========================================================================
+  // -- CommandBatch -----------------------------------------------------------
+  // ===========================================================================
+
+  template <typename T>
+  static void StoreValue(unsigned char *destination, T value) {
+    std::memcpy(destination, &value, sizeof(T));
+  }
+
+  static void StoreValue(const carla::rpc::CommandBatch::Column &column, unsigned char *destination, double value) {
+    switch (column.format) {
+      case 'f': StoreValue(destination, static_cast<float>(value)); break;
+      case 'i': StoreValue(destination, static_cast<int32_t>(value)); break;
+      case 'I': StoreValue(destination, static_cast<uint32_t>(value)); break;
+      case '?': StoreValue(destination, static_cast<uint8_t>(value != 0.0)); break;
+      default:
+        PyErr_SetString(PyExc_TypeError, "unknown column format");
+        boost::python::throw_error_already_set();
+    }
+  }
+
+  template <typename T>
+  static double LoadValue(const char *source) {
+    T value;
+    std::memcpy(&value, source, sizeof(T));
+    return static_cast<double>(value);
+  }
+
+  static double LoadValue(char format, const char *source) {
+    switch (format) {
+      case 'f': return LoadValue<float>(source);
+      case 'd': return LoadValue<double>(source);
+      case 'b': return LoadValue<int8_t>(source);
+      case 'B': return LoadValue<uint8_t>(source);
+      case '?': return LoadValue<uint8_t>(source);
+      case 'h': return LoadValue<int16_t>(source);
+      case 'H': return LoadValue<uint16_t>(source);
+      case 'i': return LoadValue<int32_t>(source);
+      case 'I': return LoadValue<uint32_t>(source);
+      case 'l': return LoadValue<long>(source);
+      case 'L': return LoadValue<unsigned long>(source);
+      case 'q': return LoadValue<long long>(source);
+      case 'Q': return LoadValue<unsigned long long>(source);
+      default:
+        PyErr_SetString(PyExc_TypeError, "unsupported buffer format, expected a numeric array");
+        boost::python::throw_error_already_set();
+        return 0.0;
+    }
+  }
+
+  /// Copies a C-contiguous buffer (e.g. a NumPy array) into a column. The
+  /// bytes are copied as they are when the formats match, otherwise each value
+  /// is converted.
+  static void FillColumnFromBuffer(
+      carla::rpc::CommandBatch &batch,
+      size_t column,
+      PyObject *object) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(object, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+      boost::python::throw_error_already_set();
+    }
+    std::unique_ptr<Py_buffer, void(*)(Py_buffer *)> release(&view, PyBuffer_Release);
+    const auto &layout = batch.GetColumn(column);
+    const size_t count = batch.size() * layout.components;
+    if (static_cast<size_t>(view.len) != count * static_cast<size_t>(view.itemsize)) {
+      PyErr_SetString(PyExc_ValueError, (std::string("wrong number of values for column '") + layout.name + "'").c_str());
+      boost::python::throw_error_already_set();
+    }
+    // Skip the byte order character, only the native order is supported.
+    const char *format = view.format != nullptr ? view.format : "B";
+    if (*format == '@' || *format == '=' || *format == '<') {
+      ++format;
+    }
+    auto *destination = batch.GetColumnData(column);
+    if ((*format == layout.format) && (view.itemsize == layout.value_size)) {
+      std::memcpy(destination, view.buf, count * layout.value_size);
+      return;
+    }
+    const char *source = static_cast<const char *>(view.buf);
+    for (size_t i = 0u; i < count; ++i) {
+      StoreValue(layout, destination, LoadValue(*format, source));
+      source += view.itemsize;
+      destination += layout.value_size;
+    }
+  }
+
+  /// Fills a column from a buffer, a single number repeated for every command,
+  /// or a sequence of numbers (or of sequences of numbers for columns with
+  /// several components). None leaves the column zero-initialized.
+  static void FillColumn(
+      carla::rpc::CommandBatch &batch,
+      size_t column,
+      const boost::python::object &values) {
+    namespace py = boost::python;
+    if (values.is_none()) {
+      return;
+    }
+    PyObject *object = values.ptr();
+    if (PyObject_CheckBuffer(object)) {
+      FillColumnFromBuffer(batch, column, object);
+      return;
+    }
+    const auto &layout = batch.GetColumn(column);
+    auto *destination = batch.GetColumnData(column);
+    if (PyFloat_Check(object) || PyLong_Check(object)) {
+      const double value = py::extract<double>(values);
+      for (size_t i = 0u; i < batch.size() * layout.components; ++i) {
+        StoreValue(layout, destination, value);
+        destination += layout.value_size;
+      }
+      return;
+    }
+    if (static_cast<size_t>(py::len(values)) != batch.size()) {
+      PyErr_SetString(PyExc_ValueError, (std::string("wrong number of values for column '") + layout.name + "'").c_str());
+      py::throw_error_already_set();
+    }
+    for (py::stl_input_iterator<py::object> it(values), end; it != end; ++it) {
+      if (layout.components == 1u) {
+        StoreValue(layout, destination, py::extract<double>(*it));
+        destination += layout.value_size;
+        continue;
+      }
+      const py::object item = *it;
+      if (static_cast<size_t>(py::len(item)) != layout.components) {
+        PyErr_SetString(PyExc_ValueError, (std::string("wrong number of components for column '") + layout.name + "'").c_str());
+        py::throw_error_already_set();
+      }
+      for (size_t j = 0u; j < layout.components; ++j) {
+        StoreValue(layout, destination, py::extract<double>(item[j]));
+        destination += layout.value_size;
+      }
+    }
+  }
+
+  static carla::rpc::CommandBatch MakeBatch(
+      carla::rpc::CommandBatch::Type type,
+      const boost::python::object &actor_ids,
+      std::initializer_list<boost::python::object> columns) {
+    carla::rpc::CommandBatch batch{type, static_cast<size_t>(boost::python::len(actor_ids))};
+    FillColumn(batch, 0u, actor_ids);
+    size_t column = 1u;
+    for (const auto &values : columns) {
+      FillColumn(batch, column++, values);
+    }
+    return batch;
+  }
+
+  using BatchType = carla::rpc::CommandBatch::Type;
+  using boost::python::object;
+
+  static carla::rpc::CommandBatch MakeVehicleControlBatch(
+      object actor_ids, object throttle, object steer, object brake, object gear,
+      object hand_brake, object reverse, object manual_gear_shift) {
+    return MakeBatch(BatchType::ApplyVehicleControl, actor_ids,
+        {throttle, steer, brake, gear, hand_brake, reverse, manual_gear_shift});
+  }
+
+  static carla::rpc::CommandBatch MakeWalkerControlBatch(
+      object actor_ids, object direction, object speed, object jump) {
+    return MakeBatch(BatchType::ApplyWalkerControl, actor_ids, {direction, speed, jump});
+  }
+
+  static carla::rpc::CommandBatch MakeTransformBatch(
+      object actor_ids, object location, object rotation) {
+    return MakeBatch(BatchType::ApplyTransform, actor_ids, {location, rotation});
+  }
+
+  static carla::rpc::CommandBatch MakeWalkerStateBatch(
+      object actor_ids, object location, object rotation, object speed) {
+    return MakeBatch(BatchType::ApplyWalkerState, actor_ids, {location, rotation, speed});
+  }
+
+  static carla::rpc::CommandBatch MakeTargetVelocityBatch(
+      object actor_ids, object velocity) {
+    return MakeBatch(BatchType::ApplyTargetVelocity, actor_ids, {velocity});
+  }
+
+  static carla::rpc::CommandBatch MakeVehicleLightStateBatch(
+      object actor_ids, object light_state) {
+    return MakeBatch(BatchType::SetVehicleLightState, actor_ids, {light_state});
+  }
+
 } // namespace command_impl
 
 void export_commands() {
@@ -221,6 +409,29 @@ void export_commands() {
     .def_readwrite("light_state", &cr::Command::SetVehicleLightState::light_state)
   ;
 
+  class_<cr::CommandBatch>("CommandBatch", no_init)
+    .def("__len__", &cr::CommandBatch::size)
+    .def("apply_vehicle_control", &command_impl::MakeVehicleControlBatch,
+        (arg("actor_ids"), arg("throttle")=object(), arg("steer")=object(), arg("brake")=object(),
+         arg("gear")=object(), arg("hand_brake")=object(), arg("reverse")=object(), arg("manual_gear_shift")=object()))
+    .staticmethod("apply_vehicle_control")
+    .def("apply_walker_control", &command_impl::MakeWalkerControlBatch,
+        (arg("actor_ids"), arg("direction"), arg("speed")=object(), arg("jump")=object()))
+    .staticmethod("apply_walker_control")
+    .def("apply_transform", &command_impl::MakeTransformBatch,
+        (arg("actor_ids"), arg("location"), arg("rotation")))
+    .staticmethod("apply_transform")
+    .def("apply_walker_state", &command_impl::MakeWalkerStateBatch,
+        (arg("actor_ids"), arg("location"), arg("rotation"), arg("speed")=object()))
+    .staticmethod("apply_walker_state")
+    .def("apply_target_velocity", &command_impl::MakeTargetVelocityBatch,
+        (arg("actor_ids"), arg("velocity")))
+    .staticmethod("apply_target_velocity")
+    .def("set_vehicle_light_state", &command_impl::MakeVehicleLightStateBatch,
+        (arg("actor_ids"), arg("light_state")))
+    .staticmethod("set_vehicle_light_state")
+  ;
+
   implicitly_convertible<cr::Command::SpawnActor, cr::Command>();
   implicitly_convertible<cr::Command::DestroyActor, cr::Command>();
   implicitly_convertible<cr::Command::ApplyVehicleControl, cr::Command>();
@@ -72,6 +72,81 @@ static auto GetLaneValidities(const carla::client::Landmark &self){
   return result;
 }
 
+static boost::python::list GetWaypointBatch(
+    const carla::client::Map &self,
+    const boost::python::object &py_waypoints,
+    const boost::python::object &py_distance,
+    const bool next) {
+  namespace py = boost::python;
+  using WaypointPtr = carla::SharedPtr<carla::client::Waypoint>;
+  const std::vector<WaypointPtr> waypoints{
+      py::stl_input_iterator<WaypointPtr>(py_waypoints),
+      py::stl_input_iterator<WaypointPtr>()};
+  // The distance can be either a single value for every waypoint or a list
+  // with a value per waypoint.
+  std::vector<double> distances;
+  py::extract<double> single_distance(py_distance);
+  if (single_distance.check()) {
+    distances.assign(waypoints.size(), single_distance());
+  } else {
+    distances.assign(
+        py::stl_input_iterator<double>(py_distance),
+        py::stl_input_iterator<double>());
+  }
+  std::vector<WaypointPtr> waypoint_batch;
+  std::vector<size_t> offsets;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    waypoint_batch = next ?
+        self.GetNext(waypoints, distances, offsets) :
+        self.GetPrevious(waypoints, distances, offsets);
+  }
+  py::list result;
+  for (auto i = 0u; i + 1u < offsets.size(); ++i) {
+    py::list item;
+    for (auto j = offsets[i]; j < offsets[i + 1u]; ++j) {
+      item.append(waypoint_batch[j]);
+    }
+    result.append(item);
+  }
+  return result;
+}
+
+static boost::python::list GetWaypoints(
+    const carla::client::Map &self,
+    const boost::python::object &py_locations,
+    const bool project_to_road,
+    const int32_t lane_type) {
+  namespace py = boost::python;
+  const std::vector<carla::geom::Location> locations{
+      py::stl_input_iterator<carla::geom::Location>(py_locations),
+      py::stl_input_iterator<carla::geom::Location>()};
+  std::vector<carla::SharedPtr<carla::client::Waypoint>> waypoints;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    waypoints = self.GetWaypoints(locations, project_to_road, lane_type);
+  }
+  py::list result;
+  for (auto &waypoint : waypoints) {
+    result.append(waypoint);
+  }
+  return result;
+}
+
+static boost::python::list GetNextWaypoints(
+    const carla::client::Map &self,
+    const boost::python::object &waypoints,
+    const boost::python::object &distance) {
+  return GetWaypointBatch(self, waypoints, distance, true);
+}
+
+static boost::python::list GetPreviousWaypoints(
+    const carla::client::Map &self,
+    const boost::python::object &waypoints,
+    const boost::python::object &distance) {
+  return GetWaypointBatch(self, waypoints, distance, false);
+}
+
 static carla::geom::GeoLocation ToGeolocation(
     const carla::client::Map &self,
     const carla::geom::Location &location) {
@@ -159,9 +234,12 @@ void export_map() {
     .add_property("name", CALL_RETURNING_COPY(cc::Map, GetName))
     .def("get_spawn_points", CALL_RETURNING_LIST(cc::Map, GetRecommendedSpawnPoints))
     .def("get_waypoint", &cc::Map::GetWaypoint, (arg("location"), arg("project_to_road")=true, arg("lane_type")=cr::Lane::LaneType::Driving))
+    .def("get_waypoints", &GetWaypoints, (arg("locations"), arg("project_to_road")=true, arg("lane_type")=cr::Lane::LaneType::Driving))
     .def("get_waypoint_xodr", &cc::Map::GetWaypointXODR, (arg("road_id"), arg("lane_id"), arg("s")))
     .def("get_topology", &GetTopology)
     .def("generate_waypoints", CALL_RETURNING_LIST_1(cc::Map, GenerateWaypoints, double), (args("distance")))
+    .def("get_next_waypoints", &GetNextWaypoints, (arg("waypoints"), arg("distance")))
+    .def("get_previous_waypoints", &GetPreviousWaypoints, (arg("waypoints"), arg("distance")))
     .def("transform_to_geolocation", &ToGeolocation, (arg("location")))
     .def("to_opendrive", CALL_RETURNING_COPY(cc::Map, GetOpenDrive))
     .def("save_to_disk", &SaveOpenDriveToDisk, (arg("path")=""))
@@ -14,6 +14,19 @@ static void SubscribeToStream(carla::client::Sensor &self, boost::python::object
   self.Listen(MakeCallback(std::move(callback)));
 }
 
+static void SubscribeToServerSideStream(
+    carla::client::ServerSideSensor &self,
+    boost::python::object callback,
+    carla::streaming::DeliveryPolicy policy,
+    size_t queue_size,
+    uint8_t priority) {
+  carla::streaming::DeliveryOptions options;
+  options.policy = policy;
+  options.queue_size = queue_size;
+  options.priority = priority;
+  self.Listen(MakeCallback(std::move(callback)), options);
+}
+
 static void SubscribeToGBuffer(
   carla::client::ServerSideSensor &self,
   uint32_t GBufferId,
@@ -24,6 +37,27 @@ static void SubscribeToGBuffer(
 void export_sensor() {
   using namespace boost::python;
   namespace cc = carla::client;
+  namespace cs = carla::streaming;
+
+  enum_<cs::DeliveryPolicy>("SensorDeliveryPolicy")
+    .value("KeepAll", cs::DeliveryPolicy::KeepAll)
+    .value("KeepLatest", cs::DeliveryPolicy::KeepLatest)
+    .value("Coalesce", cs::DeliveryPolicy::Coalesce)
+  ;
+
+  class_<cs::DeliveryStats>("SensorDeliveryStats", no_init)
+    .def_readonly("received", &cs::DeliveryStats::received)
+    .def_readonly("delivered", &cs::DeliveryStats::delivered)
+    .def_readonly("skipped", &cs::DeliveryStats::skipped)
+    .def_readonly("queue_depth", &cs::DeliveryStats::queue_depth)
+    .def_readonly("max_queue_depth", &cs::DeliveryStats::max_queue_depth)
+    .add_property("mean_latency", +[](const cs::DeliveryStats &self) {
+      return 1e-6 * static_cast<double>(self.mean_latency);
+    })
+    .add_property("max_latency", +[](const cs::DeliveryStats &self) {
+      return 1e-6 * static_cast<double>(self.max_latency);
+    })
+  ;
 
   class_<cc::Sensor, bases<cc::Actor>, boost::noncopyable, boost::shared_ptr<cc::Sensor>>("Sensor", no_init)
     .add_property("is_listening", &cc::Sensor::IsListening)
@@ -35,6 +69,8 @@ void export_sensor() {
 
   class_<cc::ServerSideSensor, bases<cc::Sensor>, boost::noncopyable, boost::shared_ptr<cc::ServerSideSensor>>
       ("ServerSideSensor", no_init)
+    .def("listen", &SubscribeToServerSideStream, (arg("callback"), arg("delivery_policy")=cs::DeliveryPolicy::KeepAll, arg("queue_size")=1u, arg("priority")=0u))
+    .def("get_delivery_stats", CONST_CALL_WITHOUT_GIL(cc::ServerSideSensor, GetDeliveryStats))
     .def("listen_to_gbuffer", &SubscribeToGBuffer, (arg("gbuffer_id"), arg("callback")))
     .def("is_listening_gbuffer", &cc::ServerSideSensor::IsListeningGBuffer, (arg("gbuffer_id")))
     .def("stop_gbuffer", &cc::ServerSideSensor::StopGBuffer, (arg("gbuffer_id")))
@@ -9,6 +9,8 @@
 #include <carla/image/ImageIO.h>
 #include <carla/image/ImageView.h>
 #include <carla/pointcloud/PointCloudIO.h>
+#include <carla/pointcloud/PointCloudWriter.h>
+#include <carla/sensor/AsyncDiskWriter.h>
 #include <carla/sensor/SensorData.h>
 #include <carla/sensor/data/CollisionEvent.h>
 #include <carla/sensor/data/IMUMeasurement.h>
@@ -28,6 +30,9 @@
 #include <ostream>
 #include <iostream>
 #include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
 #include <vector>
 #include <algorithm>
 #include <thread>
@@ -177,16 +182,262 @@ enum class EColorConverter {
   CityScapesPalette
 };
 
+// =============================================================================
+// -- Zero-copy views of the sensor data ---------------------------------------
+// =============================================================================
+
+#if PY_MAJOR_VERSION >= 3
+
+/// Python object exporting a typed view of the data of a sensor measurement
+/// through the buffer protocol. It holds a reference to the measurement, so
+/// the data stays valid while any view of it exists.
+struct SensorDataBuffer {
+  PyObject_HEAD
+  PyObject *owner;
+  void *data;
+  const char *format;
+  Py_ssize_t itemsize;
+  int ndim;
+  Py_ssize_t shape[3];
+  Py_ssize_t strides[3];
+};
+
+static int SensorDataBuffer_GetBuffer(PyObject *exporter, Py_buffer *view, int flags) {
+  auto *self = reinterpret_cast<SensorDataBuffer *>(exporter);
+  if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "sensor data views are read-only");
+    return -1;
+  }
+  bool is_contiguous = true;
+  Py_ssize_t length = self->itemsize;
+  for (auto i = self->ndim - 1; i >= 0; --i) {
+    is_contiguous = is_contiguous && ((self->shape[i] <= 1) || (self->strides[i] == length));
+    length *= self->shape[i];
+  }
+  if (!is_contiguous && ((flags & PyBUF_STRIDES) != PyBUF_STRIDES)) {
+    PyErr_SetString(PyExc_BufferError, "sensor data view is not contiguous, strides are required");
+    return -1;
+  }
+  const bool with_shape = ((flags & PyBUF_ND) == PyBUF_ND);
+  view->buf = self->data;
+  view->obj = boost::python::incref(exporter);
+  view->len = length;
+  view->readonly = 1;
+  view->itemsize = with_shape ? self->itemsize : 1;
+  view->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) ? const_cast<char *>(self->format) : nullptr;
+  view->ndim = with_shape ? self->ndim : 1;
+  view->shape = with_shape ? self->shape : nullptr;
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  return 0;
+}
+
+static void SensorDataBuffer_Dealloc(PyObject *exporter) {
+  boost::python::xdecref(reinterpret_cast<SensorDataBuffer *>(exporter)->owner);
+  PyObject_Free(exporter);
+}
+
+static PyBufferProcs SensorDataBufferProcs = { &SensorDataBuffer_GetBuffer, nullptr };
+
+static PyTypeObject SensorDataBufferType{};
+
+static void RegisterSensorDataBuffer() {
+  // Static types are never deallocated.
+  SensorDataBufferType.ob_base.ob_base.ob_refcnt = 1;
+  SensorDataBufferType.tp_name = "carla.SensorDataBuffer";
+  SensorDataBufferType.tp_basicsize = sizeof(SensorDataBuffer);
+  SensorDataBufferType.tp_dealloc = &SensorDataBuffer_Dealloc;
+  SensorDataBufferType.tp_as_buffer = &SensorDataBufferProcs;
+  SensorDataBufferType.tp_flags = Py_TPFLAGS_DEFAULT;
+  SensorDataBufferType.tp_doc = "Exports a read-only view of the data of a sensor measurement.";
+  if (PyType_Ready(&SensorDataBufferType) < 0) {
+    boost::python::throw_error_already_set();
+  }
+}
+
+#endif // PY_MAJOR_VERSION >= 3
+
+/// Format character of the buffer protocol (PEP 3118) of each type exported.
 template <typename T>
-static auto GetRawDataAsBuffer(T &self) {
-  auto *data = reinterpret_cast<unsigned char *>(self.data());
-  auto size = static_cast<Py_ssize_t>(sizeof(typename T::value_type) * self.size());
+struct BufferFormat;
+
+template <> struct BufferFormat<uint8_t>  { static const char *Get() { return "B"; } };
+template <> struct BufferFormat<int16_t>  { static const char *Get() { return "h"; } };
+template <> struct BufferFormat<uint16_t> { static const char *Get() { return "H"; } };
+template <> struct BufferFormat<uint32_t> { static const char *Get() { return "I"; } };
+template <> struct BufferFormat<int64_t>  { static const char *Get() { return "q"; } };
+template <> struct BufferFormat<float>    { static const char *Get() { return "f"; } };
+template <> struct BufferFormat<bool>     { static const char *Get() { return "?"; } };
+
+/// Return a read-only memoryview of @a data, an array of @a ValueT with the
+/// given shape and strides in bytes, that keeps @a owner alive.
+template <typename ValueT>
+static boost::python::object MakeSensorDataView(
+    const boost::python::object &owner,
+    void *data,
+    std::initializer_list<Py_ssize_t> shape,
+    std::initializer_list<Py_ssize_t> strides) {
 #if PY_MAJOR_VERSION >= 3
-  auto *ptr = PyMemoryView_FromMemory(reinterpret_cast<char *>(data), size, PyBUF_READ);
+  DEBUG_ASSERT(shape.size() == strides.size());
+  DEBUG_ASSERT(shape.size() <= 3u);
+  boost::python::handle<> handle(PyType_GenericAlloc(&SensorDataBufferType, 0));
+  auto *exporter = reinterpret_cast<SensorDataBuffer *>(handle.get());
+  exporter->owner = boost::python::incref(owner.ptr());
+  exporter->data = data;
+  exporter->format = BufferFormat<ValueT>::Get();
+  exporter->itemsize = static_cast<Py_ssize_t>(sizeof(ValueT));
+  exporter->ndim = static_cast<int>(shape.size());
+  std::copy(shape.begin(), shape.end(), exporter->shape);
+  std::copy(strides.begin(), strides.end(), exporter->strides);
+  return boost::python::object(boost::python::handle<>(PyMemoryView_FromObject(handle.get())));
 #else
-  auto *ptr = PyBuffer_FromMemory(data, size);
+  (void) owner; (void) data; (void) shape; (void) strides;
+  throw std::runtime_error("typed views of sensor data require Python 3");
 #endif
+}
+
+/// Return a read-only memoryview of @a values shaped @a shape, in C order,
+/// that owns the values.
+template <typename ValueT>
+static boost::python::object MakeOwnedView(
+    std::vector<ValueT> &&values,
+    std::initializer_list<Py_ssize_t> shape) {
+  auto owned = std::make_unique<std::vector<ValueT>>(std::move(values));
+  boost::python::object owner{boost::python::handle<>(PyCapsule_New(owned.get(), nullptr, +[](PyObject *capsule) {
+    delete static_cast<std::vector<ValueT> *>(PyCapsule_GetPointer(capsule, nullptr));
+  }))};
+  auto *data = owned.release()->data();
+  const auto item = static_cast<Py_ssize_t>(sizeof(ValueT));
+  const auto *dims = shape.begin();
+  switch (shape.size()) {
+    case 1u:
+      return MakeSensorDataView<ValueT>(owner, data, shape, {item});
+    case 2u:
+      return MakeSensorDataView<ValueT>(owner, data, shape, {dims[1] * item, item});
+    default:
+      return MakeSensorDataView<ValueT>(owner, data, shape, {dims[1] * dims[2] * item, dims[2] * item, item});
+  }
+}
+
+/// Time window given from Python, the whole stream if any bound is None.
+static carla::sensor::data::DVSEventKernels::TimeWindow GetDVSTimeWindow(
+    const carla::sensor::data::DVSEventArray &self,
+    const boost::python::object &start,
+    const boost::python::object &end) {
+  auto window = self.GetTimeRange();
+  if (!start.is_none()) {
+    window.begin = boost::python::extract<int64_t>(start);
+  }
+  if (!end.is_none()) {
+    window.end = boost::python::extract<int64_t>(end);
+  }
+  return window;
+}
+
+static boost::python::object DVSToEventFrame(
+    const carla::sensor::data::DVSEventArray &self,
+    boost::python::object start,
+    boost::python::object end,
+    bool split_polarity) {
+  const auto window = GetDVSTimeWindow(self, start, end);
+  std::vector<float> frame;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    frame = self.ToEventFrame(window.begin, window.end, split_polarity);
+  }
+  const auto height = static_cast<Py_ssize_t>(self.GetHeight());
+  const auto width = static_cast<Py_ssize_t>(self.GetWidth());
+  if (split_polarity) {
+    return MakeOwnedView(std::move(frame), {2, height, width});
+  }
+  return MakeOwnedView(std::move(frame), {height, width});
+}
+
+static boost::python::object DVSToVoxelGrid(
+    const carla::sensor::data::DVSEventArray &self,
+    size_t bins,
+    boost::python::object start,
+    boost::python::object end) {
+  const auto window = GetDVSTimeWindow(self, start, end);
+  std::vector<float> grid;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    grid = self.ToVoxelGrid(bins, window.begin, window.end);
+  }
+  return MakeOwnedView(std::move(grid), {
+      static_cast<Py_ssize_t>(bins),
+      static_cast<Py_ssize_t>(self.GetHeight()),
+      static_cast<Py_ssize_t>(self.GetWidth())});
+}
+
+static boost::python::object DVSToColumns(const carla::sensor::data::DVSEventArray &self) {
+  const auto size = self.size();
+  std::vector<uint16_t> x(size);
+  std::vector<uint16_t> y(size);
+  std::vector<int64_t> t(size);
+  std::vector<int16_t> pol(size);
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    carla::sensor::data::DVSEventKernels::Decode(self.data(), size, x.data(), y.data(), t.data(), pol.data());
+  }
+  const auto length = static_cast<Py_ssize_t>(size);
+  return boost::python::make_tuple(
+      MakeOwnedView(std::move(x), {length}),
+      MakeOwnedView(std::move(y), {length}),
+      MakeOwnedView(std::move(t), {length}),
+      MakeOwnedView(std::move(pol), {length}));
+}
+
+template <typename T>
+static boost::python::object GetRawDataAsBuffer(boost::python::object self) {
+  T &measurement = boost::python::extract<T &>(self);
+  auto *data = reinterpret_cast<unsigned char *>(measurement.data());
+  auto size = static_cast<Py_ssize_t>(sizeof(typename T::value_type) * measurement.size());
+#if PY_MAJOR_VERSION >= 3
+  return MakeSensorDataView<uint8_t>(self, data, {size}, {1});
+#else
+  auto *ptr = PyBuffer_FromMemory(data, size);
   return boost::python::object(boost::python::handle<>(ptr));
+#endif
+}
+
+/// View of the field at @a FieldOffset of every element of the measurement,
+/// with @a Columns consecutive values of type @a FieldT. Shaped (size,) if
+/// there is a single column, (size, Columns) otherwise.
+template <typename T, typename FieldT, size_t FieldOffset, size_t Columns = 1u>
+static boost::python::object GetFieldView(boost::python::object self) {
+  T &measurement = boost::python::extract<T &>(self);
+  static_assert(
+      FieldOffset + Columns * sizeof(FieldT) <= sizeof(typename T::value_type),
+      "Field out of bounds");
+  auto *data = reinterpret_cast<unsigned char *>(measurement.data()) + FieldOffset;
+  const auto size = static_cast<Py_ssize_t>(measurement.size());
+  const auto stride = static_cast<Py_ssize_t>(sizeof(typename T::value_type));
+  if (Columns == 1u) {
+    return MakeSensorDataView<FieldT>(self, data, {size}, {stride});
+  }
+  return MakeSensorDataView<FieldT>(
+      self,
+      data,
+      {size, static_cast<Py_ssize_t>(Columns)},
+      {stride, static_cast<Py_ssize_t>(sizeof(FieldT))});
+}
+
+/// View of the pixels of an image shaped (height, width, Channels).
+template <typename T, typename ChannelT, size_t Channels>
+static boost::python::object GetImageView(boost::python::object self) {
+  T &image = boost::python::extract<T &>(self);
+  using pixel_type = typename T::value_type;
+  static_assert(Channels * sizeof(ChannelT) == sizeof(pixel_type), "Invalid number of channels");
+  const auto height = static_cast<Py_ssize_t>(image.GetHeight());
+  const auto width = static_cast<Py_ssize_t>(image.GetWidth());
+  const auto pixel_size = static_cast<Py_ssize_t>(sizeof(pixel_type));
+  return MakeSensorDataView<ChannelT>(
+      self,
+      image.data(),
+      {height, width, static_cast<Py_ssize_t>(Channels)},
+      {width * pixel_size, pixel_size, static_cast<Py_ssize_t>(sizeof(ChannelT))});
 }
 
 template <typename T>
@@ -324,39 +575,90 @@ static FakeImage ColorCodedFlow (
 }
 
 template <typename T>
-static std::string SaveImageToDisk(T &self, std::string path, EColorConverter cc) {
-  carla::PythonUtil::ReleaseGIL unlock;
+static std::string WriteImage(const T &image, std::string path, EColorConverter cc, const carla::image::io::write_options &options) {
   using namespace carla::image;
-  auto view = ImageView::MakeView(self);
+  auto view = ImageView::MakeView(image);
+  if (cc == EColorConverter::Raw) {
+    return ImageIO::WriteView(
+        std::move(path),
+        view,
+        options);
+  }
+  // Convert a copy of the image at once, writing a color-converted view would
+  // convert the pixels one by one.
+  boost::gil::bgra8_image_t converted(view.dimensions());
+  auto converted_view = boost::gil::view(converted);
+  ImageConverter::CopyPixels(view, converted_view);
   switch (cc) {
-    case EColorConverter::Raw:
-      return ImageIO::WriteView(
-          std::move(path),
-          view);
     case EColorConverter::Depth:
+      ImageConverter::ConvertInPlace(converted_view, ColorConverter::Depth());
+      // Depth is saved in grayscale, any of the color channels holds it.
       return ImageIO::WriteView(
           std::move(path),
-          ImageView::MakeColorConvertedView(view, ColorConverter::Depth()));
+          boost::gil::nth_channel_view(converted_view, 0),
+          options);
     case EColorConverter::LogarithmicDepth:
+      ImageConverter::ConvertInPlace(converted_view, ColorConverter::LogarithmicDepth());
       return ImageIO::WriteView(
           std::move(path),
-          ImageView::MakeColorConvertedView(view, ColorConverter::LogarithmicDepth()));
+          boost::gil::nth_channel_view(converted_view, 0),
+          options);
     case EColorConverter::CityScapesPalette:
+      ImageConverter::ConvertInPlace(converted_view, ColorConverter::CityScapesPalette());
       return ImageIO::WriteView(
           std::move(path),
-          ImageView::MakeColorConvertedView(view, ColorConverter::CityScapesPalette()));
+          converted_view,
+          options);
     default:
       throw std::invalid_argument("invalid color converter!");
   }
 }
 
+/// Keeps the sensor data alive until the writer is done with it. Python's
+/// shared pointers cannot be released without the GIL, so the one owned by
+/// LibCarla is taken instead.
+template <typename T>
+static carla::SharedPtr<const T> ShareForWriting(T &self) {
+  return boost::static_pointer_cast<const T>(self.shared_from_this());
+}
+
 template <typename T>
-static std::string SavePointCloudToDisk(T &self, std::string path) {
+static std::string SaveImageToDisk(T &self, std::string path, EColorConverter cc, carla::sensor::AsyncDiskWriter *writer) {
   carla::PythonUtil::ReleaseGIL unlock;
-  return carla::pointcloud::PointCloudIO::SaveToDisk(std::move(path), self.begin(), self.end());
+  if (writer == nullptr) {
+    return WriteImage(self, std::move(path), cc, carla::image::io::write_options());
+  }
+  auto image = ShareForWriting(self);
+  const auto options = writer->GetOptions().image;
+  writer->Write([=]() { WriteImage(*image, path, cc, options); });
+  return path;
+}
+
+template <typename T>
+static std::string SavePointCloudToDisk(T &self, std::string path, carla::pointcloud::PointCloudIO::Format format, carla::sensor::AsyncDiskWriter *writer) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  if (writer == nullptr) {
+    return carla::pointcloud::PointCloudIO::SaveToDisk(std::move(path), self.begin(), self.end(), format);
+  }
+  auto measurement = ShareForWriting(self);
+  writer->Write([=]() {
+    carla::pointcloud::PointCloudIO::SaveToDisk(path, measurement->begin(), measurement->end(), format);
+  });
+  return path;
+}
+
+template <typename T>
+static std::string SavePointCloudToWriter(T &self, carla::pointcloud::PointCloudWriter &writer) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  writer.Write(self.begin(), self.end());
+  return writer.GetPath();
 }
 
 void export_sensor_data() {
+#if PY_MAJOR_VERSION >= 3
+  RegisterSensorDataBuffer();
+#endif // PY_MAJOR_VERSION >= 3
+
   using namespace boost::python;
   namespace cc = carla::client;
   namespace cr = carla::rpc;
@@ -387,6 +689,65 @@ void export_sensor_data() {
     .value("CityScapesPalette", EColorConverter::CityScapesPalette)
   ;
 
+  using PointCloudFormat = carla::pointcloud::PointCloudIO::Format;
+  using carla::pointcloud::PointCloudWriter;
+
+  enum_<PointCloudFormat>("PointCloudFormat")
+    .value("Ascii", PointCloudFormat::Ascii)
+    .value("BinaryLittleEndian", PointCloudFormat::BinaryLittleEndian)
+  ;
+
+  class_<PointCloudWriter, boost::noncopyable, boost::shared_ptr<PointCloudWriter>>("PointCloudWriter", no_init)
+    .def(init<std::string, PointCloudFormat>((arg("path"), arg("format")=PointCloudFormat::BinaryLittleEndian)))
+    .add_property("path", CALL_RETURNING_COPY(PointCloudWriter, GetPath))
+    .add_property("format", &PointCloudWriter::GetFormat)
+    .add_property("point_count", &PointCloudWriter::GetPointCount)
+    .def("flush", +[](PointCloudWriter &self) {
+      carla::PythonUtil::ReleaseGIL unlock;
+      self.Flush();
+    })
+    .def("close", +[](PointCloudWriter &self) {
+      carla::PythonUtil::ReleaseGIL unlock;
+      self.Close();
+    })
+  ;
+
+  using carla::sensor::AsyncDiskWriter;
+
+  class_<AsyncDiskWriter, boost::noncopyable, boost::shared_ptr<AsyncDiskWriter>>("AsyncDiskWriter", no_init)
+    .def("__init__", make_constructor(+[](
+        size_t worker_threads,
+        size_t max_queue_size,
+        bool drop_when_full,
+        int png_compression_level,
+        int jpeg_quality) {
+      AsyncDiskWriter::Options options;
+      options.worker_threads = worker_threads;
+      options.max_queue_size = max_queue_size;
+      options.drop_when_full = drop_when_full;
+      options.image.png_compression_level = png_compression_level;
+      options.image.jpeg_quality = jpeg_quality;
+      return boost::make_shared<AsyncDiskWriter>(options);
+    }, default_call_policies(), (
+        arg("worker_threads")=2u,
+        arg("max_queue_size")=64u,
+        arg("drop_when_full")=false,
+        arg("png_compression_level")=3,
+        arg("jpeg_quality")=100)))
+    .add_property("queue_size", &AsyncDiskWriter::GetQueueSize)
+    .add_property("written_count", &AsyncDiskWriter::GetWrittenCount)
+    .add_property("failed_count", &AsyncDiskWriter::GetFailedCount)
+    .add_property("dropped_count", &AsyncDiskWriter::GetDroppedCount)
+    .def("flush", +[](AsyncDiskWriter &self) {
+      carla::PythonUtil::ReleaseGIL unlock;
+      self.Flush();
+    })
+    .def("wait_for", +[](AsyncDiskWriter &self, double seconds) {
+      carla::PythonUtil::ReleaseGIL unlock;
+      return self.WaitFor(TimeDurationFromSeconds(seconds));
+    }, (arg("seconds")))
+  ;
+
   // The values here should match the ones in the enum EGBufferTextureID,
   // from the CARLA fork of Unreal Engine (Renderer/Public/GBufferView.h).
   enum_<int>("GBufferTextureID")
@@ -410,8 +771,9 @@ void export_sensor_data() {
     .add_property("height", &csd::Image::GetHeight)
     .add_property("fov", &csd::Image::GetFOVAngle)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::Image>)
+    .add_property("array", &GetImageView<csd::Image, uint8_t, 4u>)
     .def("convert", &ConvertImage<csd::Image>, (arg("color_converter")))
-    .def("save_to_disk", &SaveImageToDisk<csd::Image>, (arg("path"), arg("color_converter")=EColorConverter::Raw))
+    .def("save_to_disk", &SaveImageToDisk<csd::Image>, (arg("path"), arg("color_converter")=EColorConverter::Raw, arg("disk_writer")=object()))
     .def("__len__", &csd::Image::size)
     .def("__iter__", iterator<csd::Image>())
     .def("__getitem__", +[](const csd::Image &self, size_t pos) -> csd::Color {
@@ -428,6 +790,7 @@ void export_sensor_data() {
     .add_property("height", &csd::OpticalFlowImage::GetHeight)
     .add_property("fov", &csd::OpticalFlowImage::GetFOVAngle)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::OpticalFlowImage>)
+    .add_property("array", &GetImageView<csd::OpticalFlowImage, float, 2u>)
     .def("get_color_coded_flow", &ColorCodedFlow)
     .def("__len__", &csd::OpticalFlowImage::size)
     .def("__iter__", iterator<csd::OpticalFlowImage>())
@@ -444,8 +807,12 @@ void export_sensor_data() {
     .add_property("horizontal_angle", &csd::LidarMeasurement::GetHorizontalAngle)
     .add_property("channels", &csd::LidarMeasurement::GetChannelCount)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::LidarMeasurement>)
+    .add_property("array", &GetFieldView<csd::LidarMeasurement, float, 0u, 4u>)
+    .add_property("xyz", &GetFieldView<csd::LidarMeasurement, float, offsetof(csd::LidarDetection, point), 3u>)
+    .add_property("intensity", &GetFieldView<csd::LidarMeasurement, float, offsetof(csd::LidarDetection, intensity)>)
     .def("get_point_count", &csd::LidarMeasurement::GetPointCount, (arg("channel")))
-    .def("save_to_disk", &SavePointCloudToDisk<csd::LidarMeasurement>, (arg("path")))
+    .def("save_to_disk", &SavePointCloudToDisk<csd::LidarMeasurement>, (arg("path"), arg("format")=PointCloudFormat::Ascii, arg("disk_writer")=object()))
+    .def("save_to_disk", &SavePointCloudToWriter<csd::LidarMeasurement>, (arg("writer")))
     .def("__len__", &csd::LidarMeasurement::size)
     .def("__iter__", iterator<csd::LidarMeasurement>())
     .def("__getitem__", +[](const csd::LidarMeasurement &self, size_t pos) -> csd::LidarDetection {
@@ -461,8 +828,13 @@ void export_sensor_data() {
     .add_property("horizontal_angle", &csd::SemanticLidarMeasurement::GetHorizontalAngle)
     .add_property("channels", &csd::SemanticLidarMeasurement::GetChannelCount)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::SemanticLidarMeasurement>)
+    .add_property("xyz", &GetFieldView<csd::SemanticLidarMeasurement, float, offsetof(csd::SemanticLidarDetection, point), 3u>)
+    .add_property("cos_inc_angle", &GetFieldView<csd::SemanticLidarMeasurement, float, offsetof(csd::SemanticLidarDetection, cos_inc_angle)>)
+    .add_property("object_idx", &GetFieldView<csd::SemanticLidarMeasurement, uint32_t, offsetof(csd::SemanticLidarDetection, object_idx)>)
+    .add_property("object_tag", &GetFieldView<csd::SemanticLidarMeasurement, uint32_t, offsetof(csd::SemanticLidarDetection, object_tag)>)
     .def("get_point_count", &csd::SemanticLidarMeasurement::GetPointCount, (arg("channel")))
-    .def("save_to_disk", &SavePointCloudToDisk<csd::SemanticLidarMeasurement>, (arg("path")))
+    .def("save_to_disk", &SavePointCloudToDisk<csd::SemanticLidarMeasurement>, (arg("path"), arg("format")=PointCloudFormat::Ascii, arg("disk_writer")=object()))
+    .def("save_to_disk", &SavePointCloudToWriter<csd::SemanticLidarMeasurement>, (arg("writer")))
     .def("__len__", &csd::SemanticLidarMeasurement::size)
     .def("__iter__", iterator<csd::SemanticLidarMeasurement>())
     .def("__getitem__", +[](const csd::SemanticLidarMeasurement &self, size_t pos) -> csd::SemanticLidarDetection {
@@ -510,6 +882,11 @@ void export_sensor_data() {
 
   class_<csd::RadarMeasurement, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::RadarMeasurement>>("RadarMeasurement", no_init)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::RadarMeasurement>)
+    .add_property("array", &GetFieldView<csd::RadarMeasurement, float, 0u, 4u>)
+    .add_property("velocity", &GetFieldView<csd::RadarMeasurement, float, offsetof(csd::RadarDetection, velocity)>)
+    .add_property("azimuth", &GetFieldView<csd::RadarMeasurement, float, offsetof(csd::RadarDetection, azimuth)>)
+    .add_property("altitude", &GetFieldView<csd::RadarMeasurement, float, offsetof(csd::RadarDetection, altitude)>)
+    .add_property("depth", &GetFieldView<csd::RadarMeasurement, float, offsetof(csd::RadarDetection, depth)>)
     .def("get_detection_count", &csd::RadarMeasurement::GetDetectionAmount)
     .def("__len__", &csd::RadarMeasurement::size)
     .def("__iter__", iterator<csd::RadarMeasurement>())
@@ -557,6 +934,10 @@ void export_sensor_data() {
     .add_property("height", &csd::DVSEventArray::GetHeight)
     .add_property("fov", &csd::DVSEventArray::GetFOVAngle)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::DVSEventArray>)
+    .add_property("x", &GetFieldView<csd::DVSEventArray, uint16_t, offsetof(csd::DVSEvent, x)>)
+    .add_property("y", &GetFieldView<csd::DVSEventArray, uint16_t, offsetof(csd::DVSEvent, y)>)
+    .add_property("t", &GetFieldView<csd::DVSEventArray, int64_t, offsetof(csd::DVSEvent, t)>)
+    .add_property("pol", &GetFieldView<csd::DVSEventArray, bool, offsetof(csd::DVSEvent, pol)>)
     .def("__len__", &csd::DVSEventArray::size)
     .def("__iter__", iterator<csd::DVSEventArray>())
     .def("__getitem__", +[](const csd::DVSEventArray &self, size_t pos) -> csd::DVSEvent {
@@ -571,6 +952,13 @@ void export_sensor_data() {
     .def("to_array_y", CALL_RETURNING_LIST(csd::DVSEventArray, ToArrayY))
     .def("to_array_t", CALL_RETURNING_LIST(csd::DVSEventArray, ToArrayT))
     .def("to_array_pol", CALL_RETURNING_LIST(csd::DVSEventArray, ToArrayPol))
+    .add_property("time_range", +[](const csd::DVSEventArray &self) {
+      const auto window = self.GetTimeRange();
+      return boost::python::make_tuple(window.begin, window.end);
+    })
+    .def("to_columns", &DVSToColumns)
+    .def("to_event_frame", &DVSToEventFrame, (arg("start")=object(), arg("end")=object(), arg("split_polarity")=false))
+    .def("to_voxel_grid", &DVSToVoxelGrid, (arg("bins"), arg("start")=object(), arg("end")=object()))
     .def(self_ns::str(self_ns::self))
   ;
 }
@@ -93,6 +93,22 @@ static auto GetVehiclesLightStates(carla::client::World &self) {
   return dict;
 }
 
+static auto GetVehiclesPhysicsControl(const carla::client::World &self, const boost::python::list &actor_ids) {
+  std::vector<carla::ActorId> ids{
+      boost::python::stl_input_iterator<carla::ActorId>(actor_ids),
+      boost::python::stl_input_iterator<carla::ActorId>()};
+  std::vector<carla::rpc::VehiclePhysicsControl> physics_controls;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    physics_controls = self.GetVehiclesPhysicsControl(ids);
+  }
+  boost::python::list result;
+  for (auto &physics_control : physics_controls) {
+    result.append(physics_control);
+  }
+  return result;
+}
+
 static auto GetLevelBBs(const carla::client::World &self, uint8_t queried_tag) {
   boost::python::list result;
   for (const auto &bb : self.GetLevelBBs(queried_tag)) {
@@ -314,6 +330,7 @@ void export_world() {
     .def("unload_map_layer", CONST_CALL_WITHOUT_GIL_1(cc::World, UnloadLevelLayer, cr::MapLayer), arg("map_layers"))
     .def("get_blueprint_library", CONST_CALL_WITHOUT_GIL(cc::World, GetBlueprintLibrary))
     .def("get_vehicles_light_states", &GetVehiclesLightStates)
+    .def("get_vehicles_physics_control", &GetVehiclesPhysicsControl, (arg("actor_ids")))
     .def("get_map", CONST_CALL_WITHOUT_GIL(cc::World, GetMap))
     .def("get_random_location_from_navigation", CALL_RETURNING_OPTIONAL_WITHOUT_GIL(cc::World, GetRandomLocationFromNavigation))
     .def("get_spectator", CONST_CALL_WITHOUT_GIL(cc::World, GetSpectator))
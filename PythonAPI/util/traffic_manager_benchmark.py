@@ -0,0 +1,163 @@
+#!/usr/bin/env python
+
+# Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma de
+# Barcelona (UAB).
+#
+# This work is licensed under the terms of the MIT license.
+# For a copy, see <https://opensource.org/licenses/MIT>.
+
+"""
+Measures the Traffic Manager cycle time for different amounts of vehicles and
+worker threads. The simulator runs in synchronous mode with rendering disabled,
+so the time spent in each tick is dominated by the Traffic Manager.
+
+    python traffic_manager_benchmark.py --vehicles 100 400 800 --threads 1 2 4 8
+"""
+
+import glob
+import os
+import sys
+
+try:
+    sys.path.append(glob.glob('../carla/dist/carla-*%d.%d-%s.egg' % (
+        sys.version_info.major,
+        sys.version_info.minor,
+        'win-amd64' if os.name == 'nt' else 'linux-x86_64'))[0])
+except IndexError:
+    pass
+
+import carla
+
+import argparse
+import random
+import time
+
+
+def spawn_vehicles(client, world, traffic_manager, number_of_vehicles):
+    blueprints = [bp for bp in world.get_blueprint_library().filter('vehicle.*')
+                  if int(bp.get_attribute('number_of_wheels')) == 4]
+    spawn_points = world.get_map().get_spawn_points()
+    random.shuffle(spawn_points)
+
+    batch = []
+    for transform in spawn_points[:number_of_vehicles]:
+        blueprint = random.choice(blueprints)
+        batch.append(carla.command.SpawnActor(blueprint, transform).then(
+            carla.command.SetAutopilot(carla.command.FutureActor, True, traffic_manager.get_port())))
+
+    vehicles = []
+    for response in client.apply_batch_sync(batch, True):
+        if not response.error:
+            vehicles.append(response.actor_id)
+    return vehicles
+
+
+def run_benchmark(args, client, world, traffic_manager, number_of_vehicles, number_of_threads):
+    random.seed(args.seed)
+    traffic_manager.set_random_device_seed(args.seed)
+    traffic_manager.set_worker_threads(number_of_threads)
+
+    vehicles = spawn_vehicles(client, world, traffic_manager, number_of_vehicles)
+    try:
+        for _ in range(args.warmup):
+            world.tick()
+
+        tick_times = []
+        for _ in range(args.ticks):
+            start = time.time()
+            world.tick()
+            tick_times.append(time.time() - start)
+    finally:
+        client.apply_batch_sync([carla.command.DestroyActor(x) for x in vehicles], True)
+        world.tick()
+
+    tick_times.sort()
+    mean = sum(tick_times) / len(tick_times)
+    median = tick_times[len(tick_times) // 2]
+    print('{:>10d} {:>10d} {:>10d} {:>12.2f} {:>12.2f}'.format(
+        number_of_vehicles, len(vehicles), number_of_threads, mean * 1000.0, median * 1000.0))
+
+
+def main():
+    argparser = argparse.ArgumentParser(description=__doc__)
+    argparser.add_argument(
+        '--host',
+        metavar='H',
+        default='127.0.0.1',
+        help='IP of the host server (default: 127.0.0.1)')
+    argparser.add_argument(
+        '-p', '--port',
+        metavar='P',
+        default=2000,
+        type=int,
+        help='TCP port to listen to (default: 2000)')
+    argparser.add_argument(
+        '--tm-port',
+        metavar='P',
+        default=8000,
+        type=int,
+        help='Port to communicate with TM (default: 8000)')
+    argparser.add_argument(
+        '--vehicles',
+        metavar='N',
+        default=[100, 200, 400, 800],
+        type=int,
+        nargs='+',
+        help='Amounts of vehicles to spawn (default: 100 200 400 800)')
+    argparser.add_argument(
+        '--threads',
+        metavar='N',
+        default=[1, 2, 4, 8],
+        type=int,
+        nargs='+',
+        help='Amounts of TM worker threads (default: 1 2 4 8)')
+    argparser.add_argument(
+        '--ticks',
+        metavar='N',
+        default=200,
+        type=int,
+        help='Ticks measured per configuration (default: 200)')
+    argparser.add_argument(
+        '--warmup',
+        metavar='N',
+        default=20,
+        type=int,
+        help='Ticks discarded before measuring (default: 20)')
+    argparser.add_argument(
+        '-s', '--seed',
+        metavar='S',
+        default=0,
+        type=int,
+        help='Random seed used by the TM and the spawning (default: 0)')
+    args = argparser.parse_args()
+
+    client = carla.Client(args.host, args.port)
+    client.set_timeout(20.0)
+    world = client.get_world()
+    original_settings = world.get_settings()
+
+    traffic_manager = client.get_trafficmanager(args.tm_port)
+    try:
+        settings = world.get_settings()
+        settings.synchronous_mode = True
+        settings.fixed_delta_seconds = 0.05
+        settings.no_rendering_mode = True
+        world.apply_settings(settings)
+        traffic_manager.set_synchronous_mode(True)
+
+        print('{:>10s} {:>10s} {:>10s} {:>12s} {:>12s}'.format(
+            'requested', 'spawned', 'threads', 'mean (ms)', 'median (ms)'))
+        for number_of_vehicles in args.vehicles:
+            for number_of_threads in args.threads:
+                run_benchmark(args, client, world, traffic_manager, number_of_vehicles, number_of_threads)
+    finally:
+        traffic_manager.set_worker_threads(1)
+        traffic_manager.set_synchronous_mode(False)
+        world.apply_settings(original_settings)
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
@@ -0,0 +1,161 @@
+#!/usr/bin/env python
+
+# Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma de
+# Barcelona (UAB).
+#
+# This work is licensed under the terms of the MIT license.
+# For a copy, see <https://opensource.org/licenses/MIT>.
+
+"""
+Measures the client tick time for different amounts of pedestrians driven by
+AI controllers. The simulator runs in synchronous mode with rendering disabled,
+so the time spent in each tick is dominated by the crowd update of the walker
+navigation.
+
+    python walker_benchmark.py --walkers 250 500 1000 2000
+"""
+
+import glob
+import os
+import sys
+
+try:
+    sys.path.append(glob.glob('../carla/dist/carla-*%d.%d-%s.egg' % (
+        sys.version_info.major,
+        sys.version_info.minor,
+        'win-amd64' if os.name == 'nt' else 'linux-x86_64'))[0])
+except IndexError:
+    pass
+
+import carla
+
+import argparse
+import random
+import time
+
+
+def spawn_walkers(client, world, number_of_walkers):
+    blueprints = world.get_blueprint_library().filter('walker.pedestrian.*')
+    for blueprint in blueprints:
+        if blueprint.has_attribute('is_invincible'):
+            blueprint.set_attribute('is_invincible', 'false')
+
+    batch = []
+    for _ in range(number_of_walkers):
+        location = world.get_random_location_from_navigation()
+        if location is not None:
+            batch.append(carla.command.SpawnActor(random.choice(blueprints), carla.Transform(location)))
+
+    walkers = []
+    for response in client.apply_batch_sync(batch, True):
+        if not response.error:
+            walkers.append(response.actor_id)
+
+    controller_bp = world.get_blueprint_library().find('controller.ai.walker')
+    batch = [carla.command.SpawnActor(controller_bp, carla.Transform(), walker) for walker in walkers]
+    controllers = []
+    for response in client.apply_batch_sync(batch, True):
+        if not response.error:
+            controllers.append(response.actor_id)
+    world.tick()
+
+    for controller in world.get_actors(controllers):
+        controller.start()
+        controller.go_to_location(world.get_random_location_from_navigation())
+        controller.set_max_speed(1.0 + random.random())
+    return walkers, controllers
+
+
+def run_benchmark(args, client, world, number_of_walkers):
+    random.seed(args.seed)
+    world.set_pedestrians_seed(args.seed)
+
+    walkers, controllers = spawn_walkers(client, world, number_of_walkers)
+    try:
+        for _ in range(args.warmup):
+            world.tick()
+
+        tick_times = []
+        for _ in range(args.ticks):
+            start = time.time()
+            world.tick()
+            tick_times.append(time.time() - start)
+    finally:
+        for controller in world.get_actors(controllers):
+            controller.stop()
+        client.apply_batch_sync([carla.command.DestroyActor(x) for x in controllers + walkers], True)
+        world.tick()
+
+    tick_times.sort()
+    mean = sum(tick_times) / len(tick_times)
+    median = tick_times[len(tick_times) // 2]
+    print('{:>10d} {:>10d} {:>12.2f} {:>12.2f} {:>14.2f}'.format(
+        number_of_walkers, len(walkers), mean * 1000.0, median * 1000.0,
+        mean * 1e6 / max(len(walkers), 1)))
+
+
+def main():
+    argparser = argparse.ArgumentParser(description=__doc__)
+    argparser.add_argument(
+        '--host',
+        metavar='H',
+        default='127.0.0.1',
+        help='IP of the host server (default: 127.0.0.1)')
+    argparser.add_argument(
+        '-p', '--port',
+        metavar='P',
+        default=2000,
+        type=int,
+        help='TCP port to listen to (default: 2000)')
+    argparser.add_argument(
+        '--walkers',
+        metavar='N',
+        default=[250, 500, 1000, 2000],
+        type=int,
+        nargs='+',
+        help='Amounts of walkers to spawn (default: 250 500 1000 2000)')
+    argparser.add_argument(
+        '--ticks',
+        metavar='N',
+        default=200,
+        type=int,
+        help='Ticks measured per configuration (default: 200)')
+    argparser.add_argument(
+        '--warmup',
+        metavar='N',
+        default=20,
+        type=int,
+        help='Ticks discarded before measuring (default: 20)')
+    argparser.add_argument(
+        '-s', '--seed',
+        metavar='S',
+        default=0,
+        type=int,
+        help='Random seed used by the spawning and the crowd (default: 0)')
+    args = argparser.parse_args()
+
+    client = carla.Client(args.host, args.port)
+    client.set_timeout(20.0)
+    world = client.get_world()
+    original_settings = world.get_settings()
+
+    try:
+        settings = world.get_settings()
+        settings.synchronous_mode = True
+        settings.fixed_delta_seconds = 0.05
+        settings.no_rendering_mode = True
+        world.apply_settings(settings)
+
+        print('{:>10s} {:>10s} {:>12s} {:>12s} {:>14s}'.format(
+            'requested', 'spawned', 'mean (ms)', 'median (ms)', 'per walker (us)'))
+        for number_of_walkers in args.walkers:
+            run_benchmark(args, client, world, number_of_walkers)
+    finally:
+        world.apply_settings(original_settings)
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
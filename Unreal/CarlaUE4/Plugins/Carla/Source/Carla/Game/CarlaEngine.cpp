@@ -44,6 +44,24 @@ static uint32 FCarlaEngine_GetNumberOfThreadsForRPCServer()
   return std::max(std::thread::hardware_concurrency(), 4u) - 2u;
 }
 
+static carla::sensor::s11n::EpisodeStateDeltaSettings FCarlaEngine_GetEpisodeStateDeltaSettings()
+{
+  carla::sensor::s11n::EpisodeStateDeltaSettings Settings;
+  uint32 KeyframeInterval = 0u;
+  if (FParse::Value(FCommandLine::Get(), TEXT("-carla-episode-keyframe-interval="), KeyframeInterval))
+  {
+    Settings.keyframe_interval = KeyframeInterval;
+  }
+  FParse::Value(FCommandLine::Get(), TEXT("-carla-episode-location-epsilon="), Settings.location_epsilon);
+  FParse::Value(FCommandLine::Get(), TEXT("-carla-episode-rotation-epsilon="), Settings.rotation_epsilon);
+  FParse::Value(FCommandLine::Get(), TEXT("-carla-episode-velocity-epsilon="), Settings.velocity_epsilon);
+  if (Settings.keyframe_interval > 1u)
+  {
+    UE_LOG(LogCarla, Log, TEXT("Episode state delta frames enabled, keyframe every %u frames"), Settings.keyframe_interval);
+  }
+  return Settings;
+}
+
 static TOptional<double> FCarlaEngine_GetFixedDeltaSeconds()
 {
   return FApp::IsBenchmarking() ? FApp::GetFixedDeltaTime() : TOptional<double>{};
@@ -88,6 +106,7 @@ void FCarlaEngine::NotifyInitGame(const UCarlaSettings &Settings)
     Server.AsyncRun(FCarlaEngine_GetNumberOfThreadsForRPCServer());
 
     WorldObserver.SetStream(BroadcastStream);
+    WorldObserver.SetDeltaSettings(FCarlaEngine_GetEpisodeStateDeltaSettings());
 
     OnPreTickHandle = FWorldDelegates::OnWorldTickStart.AddRaw(
         this,
@@ -384,5 +384,7 @@ void FWorldObserver::BroadcastTick(
       MapChange,
       PendingLightUpdates);
 
+  buffer = DeltaEncoder.Encode(FCarlaEngine::GetFrameCounter(), std::move(buffer));
+
   AsyncStream.SerializeAndSend(*this, std::move(buffer));
 }
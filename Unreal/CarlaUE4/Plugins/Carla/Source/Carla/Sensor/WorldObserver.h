@@ -8,6 +8,10 @@
 
 #include "Carla/Sensor/DataStream.h"
 
+#include <compiler/disable-ue4-macros.h>
+#include <carla/sensor/s11n/EpisodeStateDeltaEncoder.h>
+#include <compiler/enable-ue4-macros.h>
+
 class UCarlaEpisode;
 
 /// Serializes and sends all the actors in the current UCarlaEpisode.
@@ -24,6 +28,13 @@ public:
     Stream = std::move(InStream);
   }
 
+  /// Send the actors changed since the last keyframe instead of every actor
+  /// each frame, see carla::sensor::s11n::EpisodeStateDeltaEncoder.
+  void SetDeltaSettings(const carla::sensor::s11n::EpisodeStateDeltaSettings &Settings)
+  {
+    DeltaEncoder.SetSettings(Settings);
+  }
+
   /// Return the token that allows subscribing to this sensor's stream.
   auto GetToken() const
   {
@@ -47,4 +58,6 @@ public:
 private:
 
   FDataMultiStream Stream;
+
+  carla::sensor::s11n::EpisodeStateDeltaEncoder DeltaEncoder;
 };
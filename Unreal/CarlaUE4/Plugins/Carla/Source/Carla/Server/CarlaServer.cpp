@@ -44,6 +44,7 @@
 #include <carla/rpc/BoneTransformDataIn.h>
 #include <carla/rpc/Command.h>
 #include <carla/rpc/CommandResponse.h>
+#include <carla/rpc/CommandBatch.h>
 #include <carla/rpc/DebugShape.h>
 #include <carla/rpc/EnvironmentObject.h>
 #include <carla/rpc/EpisodeInfo.h>
@@ -2827,6 +2828,74 @@ BIND_SYNC(is_sensor_enabled_for_ros) << [this](carla::streaming::detail::stream_
     return result;
   };
 
+  // Applies every command of a batch with the handler of its type, appending
+  // the indices of the failed commands to `failed`.
+  auto apply_commands_of_batch = [=](
+      const cr::CommandBatch &batch,
+      uint32_t first_index,
+      std::vector<uint32_t> &failed,
+      auto command)
+  {
+    for (uint32_t i = 0u; i < batch.size(); ++i)
+    {
+      batch.Get(i, command);
+      if (command_visitor(command).HasError())
+      {
+        failed.emplace_back(first_index + i);
+      }
+    }
+  };
+
+  BIND_SYNC(apply_command_batch) << [=](
+      const std::vector<cr::CommandBatch> &batches,
+      bool do_tick_cue)
+  {
+    using Type = cr::CommandBatch::Type;
+    std::vector<uint32_t> failed;
+    uint32_t first_index = 0u;
+    for (const auto &batch : batches)
+    {
+      if (!batch.IsValid())
+      {
+        for (uint32_t i = 0u; i < batch.size(); ++i)
+        {
+          failed.emplace_back(first_index + i);
+        }
+        first_index += static_cast<uint32_t>(batch.size());
+        continue;
+      }
+      switch (batch.GetType())
+      {
+        case Type::ApplyVehicleControl:
+          apply_commands_of_batch(batch, first_index, failed, C::ApplyVehicleControl{});
+          break;
+        case Type::ApplyWalkerControl:
+          apply_commands_of_batch(batch, first_index, failed, C::ApplyWalkerControl{});
+          break;
+        case Type::ApplyTransform:
+          apply_commands_of_batch(batch, first_index, failed, C::ApplyTransform{});
+          break;
+        case Type::ApplyWalkerState:
+          apply_commands_of_batch(batch, first_index, failed, C::ApplyWalkerState{});
+          break;
+        case Type::ApplyTargetVelocity:
+          apply_commands_of_batch(batch, first_index, failed, C::ApplyTargetVelocity{});
+          break;
+        case Type::SetVehicleLightState:
+          apply_commands_of_batch(batch, first_index, failed, C::SetVehicleLightState{});
+          break;
+        default:
+          break;
+      }
+      first_index += static_cast<uint32_t>(batch.size());
+    }
+    if (do_tick_cue)
+    {
+      tick_cue();
+    }
+    return failed;
+  };
+
   // ~~ Light Subsystem ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   BIND_SYNC(query_lights_state) << [this](std::string client) -> R<std::vector<cr::LightState>>
@@ -2930,6 +2999,12 @@ FCarlaServer::~FCarlaServer() {
 FDataMultiStream FCarlaServer::Start(uint16_t RPCPort, uint16_t StreamingPort, uint16_t SecondaryPort)
 {
   Pimpl = MakeUnique<FPimpl>(RPCPort, StreamingPort, SecondaryPort);
+  if (FParse::Param(FCommandLine::Get(), TEXT("-carla-streaming-shared-memory")))
+  {
+    // Sensor streams are also published through shared memory for clients
+    // running on this host.
+    Pimpl->StreamingServer.SetSharedMemoryTransport(true);
+  }
   StreamingPort = Pimpl->StreamingServer.GetLocalEndpoint().port();
   SecondaryPort = Pimpl->SecondaryServer->GetLocalEndpoint().port();
 